@@ -7,6 +7,9 @@
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture as texture identifier. Read the FAQ about ImTextureID/ImTextureRef!
 //  [x] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset) [Desktop OpenGL only!]
 //  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
+//  [x] Renderer: Single-channel textures support (ImGuiBackendFlags_RendererHasTexAlpha8) [Desktop GL 3.3+ and GL ES 3.0+ only!]
+//  [x] Renderer: Instanced quads support (ImGuiBackendFlags_RendererHasInstancedQuads), opt-in with ImGui_ImplOpenGL3_EnableInstancedQuads() [Desktop GL 3.3+ and GL ES 3.0+ only!]
+//  [x] Renderer: Distance field textures support (ImGuiBackendFlags_RendererHasDistanceFields), e.g. fonts atlases using ImFontAtlasFlags_DistanceField [GLSL 1.30+ and GLSL ES 3.00+ only!]
 
 // About WebGL/ES:
 // - You need to '#define IMGUI_IMPL_OPENGL_ES2' or '#define IMGUI_IMPL_OPENGL_ES3' to use WebGL or OpenGL ES.
@@ -23,6 +26,14 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2026-10-19: OpenGL: Added support for textures with ImTextureData::UseDistanceField (e.g. ImFontAtlasFlags_DistanceField atlases): a shader uniform switches alpha to a distance threshold antialiased with fwidth(). Advertised with ImGuiBackendFlags_RendererHasDistanceFields. [GLSL 1.30+, GLSL ES 3.00+]
+//  2026-10-18: OpenGL: Added optional instanced quads, enabled with ImGui_ImplOpenGL3_EnableInstancedQuads(): ImDrawList stores text glyphs, images and plain rectangles as ImDrawQuad records drawn with glDrawArraysInstanced(). Advertised with ImGuiBackendFlags_RendererHasInstancedQuads. [Desktop GL 3.3+, GL ES 3.0+]
+//  2026-10-18: OpenGL: Added optional program binary cache, enabled with ImGui_ImplOpenGL3_SetProgramBinaryCacheDir(): linked shader program is stored with glGetProgramBinary() and reloaded on next init if driver vendor/renderer/version and shader sources match. [Desktop GL 4.1+, GL ES 3.0+]
+//  2026-10-18: OpenGL: Added ImGui_ImplOpenGL3_RenderDrawDataRegions() to only redraw some regions of the framebuffer (e.g. damage computed by ImDrawDamageTracker).
+//  2026-10-18: OpenGL: Added optional ImGui_ImplOpenGL3_EnableStateOwnership() for apps owning the whole GL context: skips backup/restore of GL state and glGet*() queries, keeps a persistent VAO and only re-applies state that changed.
+//  2026-10-18: OpenGL: Added optional asynchronous texture uploads, enabled with ImGui_ImplOpenGL3_EnableAsyncTextureUploads(): texture rectangles are packed into a ring of pixel buffer objects recycled with fences. [Desktop GL 3.2+, GL ES 3.0+]
+//  2026-10-18: OpenGL: Added support for ImTextureFormat_Alpha8 textures, stored as GL_R8 with a swizzle to (1,1,1,R). Advertised with ImGuiBackendFlags_RendererHasTexAlpha8. [Desktop GL 3.3+, GL ES 3.0+]
+//  2026-10-18: OpenGL: Added optional streaming path, enabled with ImGui_ImplOpenGL3_EnableStreamingBuffers(): all draw lists are written once per frame into a ring buffer with glMapBufferRange() + fences. [Desktop GL 3.2+, GL ES 3.0+]
 //  2025-09-18: Call platform_io.ClearRendererHandlers() on shutdown.
 //  2025-07-22: OpenGL: Add and call embedded loader shutdown during ImGui_ImplOpenGL3_Shutdown() to facilitate multiple init/shutdown cycles in same process. (#8792)
 //  2025-07-15: OpenGL: Set GL_UNPACK_ALIGNMENT to 1 before updating textures (#8802) + restore non-WebGL/ES update path that doesn't require a CPU-side copy.
@@ -125,6 +136,7 @@
 #include "imgui_impl_opengl3.h"
 #include <stdio.h>
 #include <stdint.h>     // intptr_t
+#include <math.h>       // floorf, ceilf
 #if defined(__APPLE__)
 #include <TargetConditionals.h>
 #endif
@@ -218,6 +230,28 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 #endif
 
+// Desktop GL 3.3+ and GL ES 3.0+ have GL_R8 textures with GL_TEXTURE_SWIZZLE_X parameters
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && (defined(IMGUI_IMPL_OPENGL_ES3) || defined(GL_VERSION_3_3))
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+#endif
+
+// Desktop GL 3.2+ and GL ES 3.0+ have glMapBufferRange() and fence sync objects, which WebGL doesn't have.
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(__EMSCRIPTEN__) && (defined(IMGUI_IMPL_OPENGL_ES3) || defined(GL_VERSION_3_2))
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING_BUFFERS
+#define IMGUI_IMPL_OPENGL_STREAMING_FRAMES      3   // Number of ring buffer regions, one per frame potentially in flight
+#define IMGUI_IMPL_OPENGL_UPLOAD_BUFFERS        4   // Number of pixel buffer objects used for asynchronous texture uploads
+#endif
+
+// Desktop GL 4.1+ (or GL_ARB_get_program_binary) and GL ES 3.0+ have glGetProgramBinary()/glProgramBinary(), which WebGL doesn't have.
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(__EMSCRIPTEN__) && (defined(IMGUI_IMPL_OPENGL_ES3) || defined(GL_VERSION_4_1))
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+#endif
+
+// Desktop GL 3.3+ and GL ES 3.0+ have glDrawArraysInstanced() and glVertexAttribDivisor(), plus gl_VertexID in GLSL 1.30+ and GLSL ES 3.00.
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && (defined(IMGUI_IMPL_OPENGL_ES3) || defined(GL_VERSION_3_3))
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+#endif
+
 // [Debugging]
 //#define IMGUI_IMPL_OPENGL_DEBUG
 #ifdef IMGUI_IMPL_OPENGL_DEBUG
@@ -240,6 +274,7 @@ struct ImGui_ImplOpenGL3_Data
     GLuint          ShaderHandle;
     GLint           AttribLocationTex;       // Uniforms location
     GLint           AttribLocationProjMtx;
+    GLint           AttribLocationDistanceField;
     GLuint          AttribLocationVtxPos;    // Vertex attributes location
     GLuint          AttribLocationVtxUV;
     GLuint          AttribLocationVtxColor;
@@ -249,7 +284,41 @@ struct ImGui_ImplOpenGL3_Data
     bool            HasPolygonMode;
     bool            HasBindSampler;
     bool            HasClipOrigin;
+    bool            HasTextureSwizzle;
     bool            UseBufferSubData;
+    bool            HasStreamingBuffers;
+    bool            UseStreamingBuffers;     // See ImGui_ImplOpenGL3_EnableStreamingBuffers()
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING_BUFFERS
+    GLuint          StreamVboHandle, StreamElementsHandle;
+    GLsizeiptr      StreamVertexRegionSize;  // Size of one ring buffer region (in bytes). Buffers are IMGUI_IMPL_OPENGL_STREAMING_FRAMES times larger.
+    GLsizeiptr      StreamIndexRegionSize;
+    unsigned int    StreamFrameIndex;
+    GLsync          StreamFences[IMGUI_IMPL_OPENGL_STREAMING_FRAMES];
+    bool            UseAsyncTextureUploads;  // See ImGui_ImplOpenGL3_EnableAsyncTextureUploads()
+    GLuint          UploadPboHandles[IMGUI_IMPL_OPENGL_UPLOAD_BUFFERS];
+    GLsizeiptr      UploadPboSizes[IMGUI_IMPL_OPENGL_UPLOAD_BUFFERS];
+    GLsync          UploadFences[IMGUI_IMPL_OPENGL_UPLOAD_BUFFERS];
+    unsigned int    UploadPboIndex;
+#endif
+    bool            OwnsGLState;             // See ImGui_ImplOpenGL3_EnableStateOwnership()
+    bool            OwnedStateValid;         // When OwnsGLState: state set by ImGui_ImplOpenGL3_SetupRenderState() is still in place
+    bool            OwnedClipOriginLowerLeft;
+    GLuint          OwnedVaoHandle;
+    bool            HasProgramBinary;
+    ImVector<char>  ProgramBinaryCachePath;  // See ImGui_ImplOpenGL3_SetProgramBinaryCacheDir(). Zero-terminated, empty when disabled.
+    bool            HasInstancing;
+    bool            UseInstancedQuads;       // See ImGui_ImplOpenGL3_EnableInstancedQuads()
+    GLuint          QuadShaderHandle;
+    GLint           QuadAttribLocationTex;   // Uniforms location
+    GLint           QuadAttribLocationProjMtx;
+    GLint           QuadAttribLocationDistanceField;
+    GLuint          QuadAttribLocationPos;   // Per-instance attributes location
+    GLuint          QuadAttribLocationSize;
+    GLuint          QuadAttribLocationUvMin;
+    GLuint          QuadAttribLocationUvMax;
+    GLuint          QuadAttribLocationColor;
+    GLuint          QuadVboHandle;
+    GLuint          OwnedQuadVaoHandle;
     ImVector<char>  TempBuffer;
 
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
@@ -403,6 +472,17 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     bd->HasBindSampler = (bd->GlVersion >= 330 || bd->GlProfileIsES3);
 #endif
     bd->HasClipOrigin = (bd->GlVersion >= 450);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    bd->HasTextureSwizzle = (bd->GlVersion >= 330 || bd->GlProfileIsES3);
+    if (bd->HasTextureSwizzle)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasTexAlpha8;  // We can create ImTextureFormat_Alpha8 textures, e.g. set 'io.Fonts->TexDesiredFormat = ImTextureFormat_Alpha8'.
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING_BUFFERS
+    bd->HasStreamingBuffers = (bd->GlVersion >= 320 || bd->GlProfileIsES3);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    bd->HasProgramBinary = (bd->GlVersion >= 410 || bd->GlProfileIsES3);
+#endif
 #ifdef IMGUI_IMPL_OPENGL_HAS_EXTENSIONS
     GLint num_extensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
@@ -411,8 +491,30 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
         const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
         if (extension != nullptr && strcmp(extension, "GL_ARB_clip_control") == 0)
             bd->HasClipOrigin = true;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+        if (extension != nullptr && strcmp(extension, "GL_ARB_get_program_binary") == 0)
+            bd->HasProgramBinary = true;
+#endif
+    }
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    // Drivers are allowed to support zero binary formats, in which case glGetProgramBinary() is useless.
+    if (bd->HasProgramBinary)
+    {
+        GLint num_binary_formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_binary_formats);
+        bd->HasProgramBinary = (num_binary_formats > 0);
     }
 #endif
+    // Our distance field shader path needs fwidth() (GLSL 1.30+ or GLSL ES 3.00)
+    int glsl_version_n = 130;
+    sscanf(bd->GlslVersionString, "#version %d", &glsl_version_n);
+    if (glsl_version_n >= 130)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasDistanceFields;  // We can sample ImTextureData::UseDistanceField textures, e.g. set 'io.Fonts->Flags |= ImFontAtlasFlags_DistanceField'.
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    // Our instanced quad shader needs gl_VertexID and integer operations (GLSL 1.30+ or GLSL ES 3.00)
+    bd->HasInstancing = (bd->GlVersion >= 330 || bd->GlProfileIsES3) && glsl_version_n >= 130;
+#endif
 
     return true;
 }
@@ -428,7 +530,7 @@ void    ImGui_ImplOpenGL3_Shutdown()
 
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures);
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasTexAlpha8 | ImGuiBackendFlags_RendererHasInstancedQuads | ImGuiBackendFlags_RendererHasDistanceFields);
     platform_io.ClearRendererHandlers();
     IM_DELETE(bd);
 
@@ -437,6 +539,90 @@ void    ImGui_ImplOpenGL3_Shutdown()
 #endif
 }
 
+bool    ImGui_ImplOpenGL3_EnableStreamingBuffers(bool enable)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    if (enable && !bd->HasStreamingBuffers)
+        return false;
+    bd->UseStreamingBuffers = enable;
+    bd->OwnedStateValid = false;
+    return true;
+}
+
+void    ImGui_ImplOpenGL3_EnableStateOwnership(bool enable)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    bd->OwnsGLState = enable;
+    bd->OwnedStateValid = false;
+}
+
+void    ImGui_ImplOpenGL3_InvalidateOwnedState()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    bd->OwnedStateValid = false;
+}
+
+bool    ImGui_ImplOpenGL3_EnableAsyncTextureUploads(bool enable)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    if (enable && !bd->HasStreamingBuffers) // Same requirements: glMapBufferRange() + fence sync objects
+        return false;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING_BUFFERS
+    bd->UseAsyncTextureUploads = enable;
+#endif
+    return true;
+}
+
+bool    ImGui_ImplOpenGL3_SetProgramBinaryCacheDir(const char* dir)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    bd->ProgramBinaryCachePath.clear();
+    if (dir == nullptr || dir[0] == 0)
+        return true;
+    if (!bd->HasProgramBinary)
+        return false;
+
+    // Store full path to cache file, e.g. "<dir>/imgui_impl_opengl3.bin"
+    const char* filename = "imgui_impl_opengl3.bin";
+    const int dir_len = (int)strlen(dir);
+    const bool need_separator = (dir[dir_len - 1] != '/' && dir[dir_len - 1] != '\\');
+    bd->ProgramBinaryCachePath.resize(dir_len + (need_separator ? 1 : 0) + (int)strlen(filename) + 1);
+    char* p = bd->ProgramBinaryCachePath.Data;
+    memcpy(p, dir, (size_t)dir_len);
+    p += dir_len;
+    if (need_separator)
+        *p++ = '/';
+    strcpy(p, filename);
+    return true;
+}
+
+static bool ImGui_ImplOpenGL3_CreateQuadProgram();
+
+bool    ImGui_ImplOpenGL3_EnableInstancedQuads(bool enable)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    ImGuiIO& io = ImGui::GetIO();
+    if (enable && !bd->HasInstancing)
+        return false;
+
+    // Device objects may already exist: create our program now rather than recreating everything.
+    if (enable && bd->ShaderHandle != 0 && bd->QuadShaderHandle == 0)
+        if (!ImGui_ImplOpenGL3_CreateQuadProgram())
+            return false;
+    bd->UseInstancedQuads = enable;
+    if (enable)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasInstancedQuads;  // Next NewFrame() will set ImDrawListFlags_InstancedQuads on draw lists
+    else
+        io.BackendFlags &= ~ImGuiBackendFlags_RendererHasInstancedQuads;
+    return true;
+}
+
 void    ImGui_ImplOpenGL3_NewFrame()
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
@@ -449,36 +635,108 @@ void    ImGui_ImplOpenGL3_NewFrame()
             IM_ASSERT(0 && "ImGui_ImplOpenGL3_CreateDeviceObjects() failed!");
 }
 
+// Point vertex attributes at ImDrawVert data starting at 'vtx_buffer_offset' (in bytes) in the bound GL_ARRAY_BUFFER.
+static void ImGui_ImplOpenGL3_SetupVertexAttribPointers(GLsizeiptr vtx_buffer_offset)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(vtx_buffer_offset + offsetof(ImDrawVert, pos))));
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(vtx_buffer_offset + offsetof(ImDrawVert, uv))));
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)(vtx_buffer_offset + offsetof(ImDrawVert, col))));
+}
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+// Point per-instance attributes at ImDrawQuad data starting at 'quad_buffer_offset' (in bytes) in the bound GL_ARRAY_BUFFER.
+static void ImGui_ImplOpenGL3_SetupQuadAttribPointers(GLsizeiptr quad_buffer_offset)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    GL_CALL(glVertexAttribPointer(bd->QuadAttribLocationPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawQuad), (GLvoid*)(quad_buffer_offset + offsetof(ImDrawQuad, Pos))));
+    GL_CALL(glVertexAttribPointer(bd->QuadAttribLocationSize,  2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawQuad), (GLvoid*)(quad_buffer_offset + offsetof(ImDrawQuad, Size))));
+    GL_CALL(glVertexAttribPointer(bd->QuadAttribLocationUvMin, 2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawQuad), (GLvoid*)(quad_buffer_offset + offsetof(ImDrawQuad, UvMin))));
+    GL_CALL(glVertexAttribPointer(bd->QuadAttribLocationUvMax, 2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawQuad), (GLvoid*)(quad_buffer_offset + offsetof(ImDrawQuad, UvMax))));
+    GL_CALL(glVertexAttribPointer(bd->QuadAttribLocationColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawQuad), (GLvoid*)(quad_buffer_offset + offsetof(ImDrawQuad, Col))));
+}
+
+// Upload quads of all draw lists into one buffer and return a VAO with per-instance attributes enabled (0 when there is nothing to draw).
+// Leaves 'vertex_array_object' and 'vbo_handle' bound.
+static GLuint ImGui_ImplOpenGL3_SetupQuads(ImDrawData* draw_data, GLuint vertex_array_object, GLuint vbo_handle)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (bd->QuadShaderHandle == 0 || draw_data->TotalQuadCount == 0)
+        return 0;
+
+    // Same as our main VAO: temporary unless we own the GL state
+    GLuint quad_vertex_array_object = bd->OwnsGLState ? bd->OwnedQuadVaoHandle : 0;
+    if (quad_vertex_array_object == 0)
+    {
+        GL_CALL(glGenVertexArrays(1, &quad_vertex_array_object));
+        GL_CALL(glBindVertexArray(quad_vertex_array_object));
+        const GLuint locations[] = { bd->QuadAttribLocationPos, bd->QuadAttribLocationSize, bd->QuadAttribLocationUvMin, bd->QuadAttribLocationUvMax, bd->QuadAttribLocationColor };
+        for (GLuint location : locations)
+        {
+            GL_CALL(glEnableVertexAttribArray(location));
+            GL_CALL(glVertexAttribDivisor(location, 1));
+        }
+        GL_CALL(glBindVertexArray(vertex_array_object));
+        if (bd->OwnsGLState)
+            bd->OwnedQuadVaoHandle = quad_vertex_array_object;
+    }
+
+    if (bd->QuadVboHandle == 0)
+        GL_CALL(glGenBuffers(1, &bd->QuadVboHandle));
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->QuadVboHandle));
+    GL_CALL(glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)draw_data->TotalQuadCount * (int)sizeof(ImDrawQuad), nullptr, GL_STREAM_DRAW));
+    GLintptr write_offset = 0;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        const GLsizeiptr list_quad_size = (GLsizeiptr)draw_list->QuadBuffer.Size * (int)sizeof(ImDrawQuad);
+        if (list_quad_size > 0)
+            GL_CALL(glBufferSubData(GL_ARRAY_BUFFER, write_offset, list_quad_size, (const GLvoid*)draw_list->QuadBuffer.Data));
+        write_offset += list_quad_size;
+    }
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, vbo_handle));
+    return quad_vertex_array_object;
+}
+#endif
+
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
 
-    // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, polygon fill
-    glEnable(GL_BLEND);
-    glBlendEquation(GL_FUNC_ADD);
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_CULL_FACE);
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_STENCIL_TEST);
-    glEnable(GL_SCISSOR_TEST);
+    // When we own the GL state and it hasn't been invalidated, everything but the viewport and projection matrix is still in place.
+    const bool full_setup = !bd->OwnsGLState || !bd->OwnedStateValid;
+    if (full_setup)
+    {
+        // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, polygon fill
+        glActiveTexture(GL_TEXTURE0);
+        glEnable(GL_BLEND);
+        glBlendEquation(GL_FUNC_ADD);
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        glDisable(GL_CULL_FACE);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_STENCIL_TEST);
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    if (!bd->GlProfileIsES3 && bd->GlVersion >= 310)
-        glDisable(GL_PRIMITIVE_RESTART);
+        if (!bd->GlProfileIsES3 && bd->GlVersion >= 310)
+            glDisable(GL_PRIMITIVE_RESTART);
 #endif
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
-    if (bd->HasPolygonMode)
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        if (bd->HasPolygonMode)
+            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 #endif
+    }
+    glEnable(GL_SCISSOR_TEST); // Always: disabled after rendering when we own the GL state, so the app can glClear() the whole framebuffer.
 
     // Support for GL 4.5 rarely used glClipControl(GL_UPPER_LEFT)
 #if defined(GL_CLIP_ORIGIN)
     bool clip_origin_lower_left = true;
-    if (bd->HasClipOrigin)
+    if (!full_setup)
+        clip_origin_lower_left = bd->OwnedClipOriginLowerLeft;
+    else if (bd->HasClipOrigin)
     {
         GLenum current_clip_origin = 0; glGetIntegerv(GL_CLIP_ORIGIN, (GLint*)&current_clip_origin);
         if (current_clip_origin == GL_UPPER_LEFT)
             clip_origin_lower_left = false;
     }
+    bd->OwnedClipOriginLowerLeft = clip_origin_lower_left;
 #endif
 
     // Setup viewport, orthographic projection matrix
@@ -498,9 +756,28 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
         { 0.0f,         0.0f,        -1.0f,   0.0f },
         { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
     };
-    glUseProgram(bd->ShaderHandle);
-    glUniform1i(bd->AttribLocationTex, 0);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    // Instanced quads program uses the same projection. We leave the main program bound.
+    const bool setup_quads = (bd->QuadShaderHandle != 0 && draw_data->TotalQuadCount > 0);
+    if (setup_quads)
+    {
+        glUseProgram(bd->QuadShaderHandle);
+        glUniform1i(bd->QuadAttribLocationTex, 0);
+        glUniformMatrix4fv(bd->QuadAttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+        glUniform1i(bd->QuadAttribLocationDistanceField, 0);
+    }
+#else
+    const bool setup_quads = false;
+#endif
+    if (full_setup || setup_quads)
+        glUseProgram(bd->ShaderHandle);
+    if (full_setup)
+        glUniform1i(bd->AttribLocationTex, 0);
     glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+    glUniform1i(bd->AttribLocationDistanceField, 0); // Enabled per command by ImGui_ImplOpenGL3_RenderDrawDataRegions()
+    if (!full_setup)
+        return;
+    bd->OwnedStateValid = bd->OwnsGLState;
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->HasBindSampler)
@@ -513,90 +790,166 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 #endif
 
     // Bind vertex/index buffers and setup attributes for ImDrawVert
-    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
-    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle));
+    GLuint vbo_handle = bd->VboHandle;
+    GLuint elements_handle = bd->ElementsHandle;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING_BUFFERS
+    if (bd->UseStreamingBuffers)
+    {
+        vbo_handle = bd->StreamVboHandle;
+        elements_handle = bd->StreamElementsHandle;
+    }
+#endif
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, vbo_handle));
+    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elements_handle));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxPos));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxUV));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxColor));
-    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, pos)));
-    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, uv)));
-    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, col)));
+    ImGui_ImplOpenGL3_SetupVertexAttribPointers(0);
 }
 
-// OpenGL3 Render function.
-// Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
-// This is in order to be able to run within an OpenGL engine that doesn't do so.
-void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING_BUFFERS
+// Wait until the GPU has finished reading from a ring buffer region, before we overwrite it.
+static void ImGui_ImplOpenGL3_WaitStreamingFence(GLsync* fence)
 {
-    // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
-    int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
-    int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
-    if (fb_width <= 0 || fb_height <= 0)
+    if (*fence == nullptr)
         return;
+    GLenum result = glClientWaitSync(*fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    while (result == GL_TIMEOUT_EXPIRED)
+        result = glClientWaitSync(*fence, 0, 1000000); // 1 ms
+    glDeleteSync(*fence);
+    *fence = nullptr;
+}
 
-    ImGui_ImplOpenGL3_InitLoader(); // Lazily init loader if not already done for e.g. DLL boundaries.
-
+// Write vertices/indices of all draw lists into the current ring buffer region, with one glMapBufferRange() call per buffer.
+// The region is not in use by the GPU anymore (guarded by its fence), so we can map it unsynchronized.
+// Output offsets of the region: in vertices for the vertex buffer, in bytes for the index buffer.
+static void ImGui_ImplOpenGL3_UploadStreamingBuffers(ImDrawData* draw_data, GLsizeiptr* out_vtx_offset, GLsizeiptr* out_idx_offset)
+{
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    const GLsizeiptr vtx_size = (GLsizeiptr)draw_data->TotalVtxCount * (int)sizeof(ImDrawVert);
+    const GLsizeiptr idx_size = (GLsizeiptr)draw_data->TotalIdxCount * (int)sizeof(ImDrawIdx);
 
-    // Catch up with texture updates. Most of the times, the list will have 1 element with an OK status, aka nothing to do.
-    // (This almost always points to ImGui::GetPlatformIO().Textures[] but is part of ImDrawData to allow overriding or disabling texture updates).
-    if (draw_data->Textures != nullptr)
-        for (ImTextureData* tex : *draw_data->Textures)
-            if (tex->Status != ImTextureStatus_OK)
-                ImGui_ImplOpenGL3_UpdateTexture(tex);
+    // Grow buffers if needed. glBufferData() orphans previous storage which may still be used by frames in flight, so previous fences can be discarded.
+    if (bd->StreamVertexRegionSize < vtx_size || bd->StreamIndexRegionSize < idx_size)
+    {
+        for (GLsync& fence : bd->StreamFences)
+            if (fence != nullptr) { glDeleteSync(fence); fence = nullptr; }
+        if (bd->StreamVertexRegionSize < vtx_size)
+            bd->StreamVertexRegionSize = vtx_size + 5000 * (int)sizeof(ImDrawVert);
+        if (bd->StreamIndexRegionSize < idx_size)
+            bd->StreamIndexRegionSize = idx_size + 10000 * (int)sizeof(ImDrawIdx);
+        GL_CALL(glBufferData(GL_ARRAY_BUFFER, bd->StreamVertexRegionSize * IMGUI_IMPL_OPENGL_STREAMING_FRAMES, nullptr, GL_STREAM_DRAW));
+        GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, bd->StreamIndexRegionSize * IMGUI_IMPL_OPENGL_STREAMING_FRAMES, nullptr, GL_STREAM_DRAW));
+    }
 
-    // Backup GL state
-    GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
-    glActiveTexture(GL_TEXTURE0);
-    GLuint last_program; glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
-    GLuint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    GLuint last_sampler; if (bd->HasBindSampler) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler); } else { last_sampler = 0; }
-#endif
-    GLuint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
-#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
-    GLint last_element_array_buffer; glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_pos; last_vtx_attrib_state_pos.GetState(bd->AttribLocationVtxPos);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_uv; last_vtx_attrib_state_uv.GetState(bd->AttribLocationVtxUV);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_color; last_vtx_attrib_state_color.GetState(bd->AttribLocationVtxColor);
-#endif
-#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GLuint last_vertex_array_object; glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
-#endif
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
-    GLint last_polygon_mode[2]; if (bd->HasPolygonMode) { glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode); }
-#endif
-    GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
-    GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
-    GLenum last_blend_src_rgb; glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
-    GLenum last_blend_dst_rgb; glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
-    GLenum last_blend_src_alpha; glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
-    GLenum last_blend_dst_alpha; glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
-    GLenum last_blend_equation_rgb; glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
-    GLenum last_blend_equation_alpha; glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
-    GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
-    GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
-    GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
-    GLboolean last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
-    GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    GLboolean last_enable_primitive_restart = (!bd->GlProfileIsES3 && bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
+    const int region = (int)(bd->StreamFrameIndex % IMGUI_IMPL_OPENGL_STREAMING_FRAMES);
+    ImGui_ImplOpenGL3_WaitStreamingFence(&bd->StreamFences[region]);
+    const GLintptr vtx_region_offset = (GLintptr)region * bd->StreamVertexRegionSize;
+    const GLintptr idx_region_offset = (GLintptr)region * bd->StreamIndexRegionSize;
+    *out_vtx_offset = vtx_region_offset / (int)sizeof(ImDrawVert);
+    *out_idx_offset = idx_region_offset;
+    if (vtx_size == 0 || idx_size == 0)
+        return;
+
+    const GLbitfield map_flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+    ImDrawVert* vtx_dst = (ImDrawVert*)glMapBufferRange(GL_ARRAY_BUFFER, vtx_region_offset, vtx_size, map_flags);
+    ImDrawIdx* idx_dst = (ImDrawIdx*)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, idx_region_offset, idx_size, map_flags);
+    GLintptr vtx_write_offset = vtx_region_offset;
+    GLintptr idx_write_offset = idx_region_offset;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        const GLsizeiptr list_vtx_size = (GLsizeiptr)draw_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
+        const GLsizeiptr list_idx_size = (GLsizeiptr)draw_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
+        if (vtx_dst) { memcpy(vtx_dst, draw_list->VtxBuffer.Data, (size_t)list_vtx_size); vtx_dst += draw_list->VtxBuffer.Size; }
+        else         { GL_CALL(glBufferSubData(GL_ARRAY_BUFFER, vtx_write_offset, list_vtx_size, draw_list->VtxBuffer.Data)); } // Mapping failed: fallback to a copy per list
+        if (idx_dst) { memcpy(idx_dst, draw_list->IdxBuffer.Data, (size_t)list_idx_size); idx_dst += draw_list->IdxBuffer.Size; }
+        else         { GL_CALL(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, idx_write_offset, list_idx_size, draw_list->IdxBuffer.Data)); }
+        vtx_write_offset += list_vtx_size;
+        idx_write_offset += list_idx_size;
+    }
+    if (vtx_dst) GL_CALL(glUnmapBuffer(GL_ARRAY_BUFFER));
+    if (idx_dst) GL_CALL(glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER));
+}
 #endif
 
+// Setup render state and issue draw calls for all command lists. Does not backup/restore any GL state.
+// When 'regions != nullptr', commands are only drawn inside of those (non-overlapping) regions.
+static void ImGui_ImplOpenGL3_RenderCommandLists(ImDrawData* draw_data, int fb_width, int fb_height, const ImVec4* regions, int regions_count)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+
     // Setup desired GL state
     // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
     // The renderer would actually work without any VAO bound, but then our VertexAttrib calls would overwrite the default one currently bound.
+    // When we own the GL state we keep a persistent VAO instead.
     GLuint vertex_array_object = 0;
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GL_CALL(glGenVertexArrays(1, &vertex_array_object));
+    if (bd->OwnsGLState)
+    {
+        if (bd->OwnedVaoHandle == 0)
+        {
+            GL_CALL(glGenVertexArrays(1, &bd->OwnedVaoHandle));
+            bd->OwnedStateValid = false;
+        }
+        vertex_array_object = bd->OwnedVaoHandle;
+    }
+    else
+        GL_CALL(glGenVertexArrays(1, &vertex_array_object));
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING_BUFFERS
+    if (bd->UseStreamingBuffers && bd->StreamVboHandle == 0)
+    {
+        GL_CALL(glGenBuffers(1, &bd->StreamVboHandle));
+        GL_CALL(glGenBuffers(1, &bd->StreamElementsHandle));
+    }
 #endif
     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+    GLuint vbo_handle = bd->VboHandle;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING_BUFFERS
+    if (bd->UseStreamingBuffers)
+        vbo_handle = bd->StreamVboHandle;
+#endif
+    IM_UNUSED(vbo_handle);
 
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
+    // When we own the GL state, skip redundant glScissor()/glBindTexture() calls between consecutive commands.
+    // (Invalidated after user callbacks, which may have changed them)
+    GLint bound_scissor[4] = { 0, 0, -1, -1 };
+    GLuint bound_texture = 0;
+    bool bound_texture_valid = false;
+    bool bound_distance_field = false;  // Value of the DistanceField uniform in our main program (reset by ImGui_ImplOpenGL3_SetupRenderState())
+
+    // Streaming path: upload all lists at once, then offset each list into the shared buffers.
+    // When glDrawElementsBaseVertex() is not available (GL ES 3.0), we re-point vertex attributes for each list instead.
+    bool use_streaming = false;
+    bool use_base_vertex = false;
+    GLsizeiptr global_vtx_offset = 0;   // In vertices
+    GLsizeiptr global_idx_offset = 0;   // In bytes
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
+    use_base_vertex = (bd->GlVersion >= 320);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING_BUFFERS
+    if (bd->UseStreamingBuffers)
+    {
+        ImGui_ImplOpenGL3_UploadStreamingBuffers(draw_data, &global_vtx_offset, &global_idx_offset);
+        use_streaming = true;
+    }
+#endif
+
+    // Instanced quads: all lists are uploaded at once, then drawn with our quad program and VAO.
+    // We switch back and forth with the main program/VAO only when a command mixes or alternates triangles and quads.
+    GLuint quad_vertex_array_object = 0;
+    GLsizeiptr global_quad_offset = 0;  // In quads
+    GLsizeiptr bound_quad_offset = -1;  // In bytes
+    bool quad_state_bound = false;
+    bool quad_bound_distance_field = false;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    quad_vertex_array_object = ImGui_ImplOpenGL3_SetupQuads(draw_data, vertex_array_object, vbo_handle);
+#endif
+
     // Render command lists
     for (const ImDrawList* draw_list : draw_data->CmdLists)
     {
@@ -608,9 +961,24 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         // - We are now back to using exclusively glBufferData(). So bd->UseBufferSubData IS ALWAYS FALSE in this code.
         //   We are keeping the old code path for a while in case people finding new issues may want to test the bd->UseBufferSubData path.
         // - See https://github.com/ocornut/imgui/issues/4468 and please report any corruption issues.
+        // - The opt-in streaming path already uploaded all lists above.
         const GLsizeiptr vtx_buffer_size = (GLsizeiptr)draw_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
         const GLsizeiptr idx_buffer_size = (GLsizeiptr)draw_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
-        if (bd->UseBufferSubData)
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+        // Index buffer binding and attribute pointers are VAO state: switch back before touching them.
+        if (quad_state_bound && !(use_streaming && use_base_vertex))
+        {
+            GL_CALL(glUseProgram(bd->ShaderHandle));
+            GL_CALL(glBindVertexArray(vertex_array_object));
+            quad_state_bound = false;
+        }
+#endif
+        if (use_streaming)
+        {
+            if (!use_base_vertex)
+                ImGui_ImplOpenGL3_SetupVertexAttribPointers(global_vtx_offset * (int)sizeof(ImDrawVert));
+        }
+        else if (bd->UseBufferSubData)
         {
             if (bd->VertexBufferSize < vtx_buffer_size)
             {
@@ -639,9 +1007,23 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
+                    bd->OwnedStateValid = false;
+                    bound_scissor[2] = -1;
+                    bound_texture_valid = false;
+                    bound_distance_field = quad_bound_distance_field = false;
+                    quad_state_bound = false;
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                    if (use_streaming && !use_base_vertex)
+                        ImGui_ImplOpenGL3_SetupVertexAttribPointers(global_vtx_offset * (int)sizeof(ImDrawVert));
+                }
                 else
+                {
                     pcmd->UserCallback(draw_list, pcmd);
+                    bd->OwnedStateValid = false; // May have changed any state: full setup on next frame
+                    bound_scissor[2] = -1;
+                    bound_texture_valid = false;
+                }
             }
             else
             {
@@ -651,25 +1033,215 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
                     continue;
 
-                // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
-                GL_CALL(glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y)));
-
-                // Bind texture, Draw
-                GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
+                // When only redrawing some regions, draw command once for each region it overlaps
+                for (int region_n = 0; region_n < (regions != nullptr ? regions_count : 1); region_n++)
+                {
+                    // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
+                    GLint scissor[4] = { (int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y) };
+                    if (regions != nullptr)
+                    {
+                        // Region expanded to whole pixels (floor min, ceil max), so that it covers exactly the pixels cleared by caller with the same rounding
+                        const ImVec4& region = regions[region_n];
+                        const int region_x0 = (int)floorf((region.x - clip_off.x) * clip_scale.x);
+                        const int region_x1 = (int)ceilf((region.z - clip_off.x) * clip_scale.x);
+                        const int region_y0 = fb_height - (int)ceilf((region.w - clip_off.y) * clip_scale.y);
+                        const int region_y1 = fb_height - (int)floorf((region.y - clip_off.y) * clip_scale.y);
+                        const int x0 = scissor[0] > region_x0 ? scissor[0] : region_x0;
+                        const int y0 = scissor[1] > region_y0 ? scissor[1] : region_y0;
+                        const int x1 = scissor[0] + scissor[2] < region_x1 ? scissor[0] + scissor[2] : region_x1;
+                        const int y1 = scissor[1] + scissor[3] < region_y1 ? scissor[1] + scissor[3] : region_y1;
+                        if (x1 <= x0 || y1 <= y0)
+                            continue;
+                        scissor[0] = x0;
+                        scissor[1] = y0;
+                        scissor[2] = x1 - x0;
+                        scissor[3] = y1 - y0;
+                    }
+                    if (!bd->OwnsGLState || memcmp(scissor, bound_scissor, sizeof(scissor)) != 0)
+                    {
+                        GL_CALL(glScissor(scissor[0], scissor[1], scissor[2], scissor[3]));
+                        memcpy(bound_scissor, scissor, sizeof(scissor));
+                    }
+
+                    // Bind texture, Draw
+                    const GLuint texture = (GLuint)(intptr_t)pcmd->GetTexID();
+                    if (!bd->OwnsGLState || !bound_texture_valid || texture != bound_texture)
+                    {
+                        GL_CALL(glBindTexture(GL_TEXTURE_2D, texture));
+                        bound_texture = texture;
+                        bound_texture_valid = true;
+                    }
+                    const bool distance_field = (pcmd->TexRef._TexData != nullptr && pcmd->TexRef._TexData->UseDistanceField);
+                    if (pcmd->ElemCount > 0)
+                    {
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+                        if (quad_state_bound)
+                        {
+                            GL_CALL(glUseProgram(bd->ShaderHandle));
+                            GL_CALL(glBindVertexArray(vertex_array_object));
+                            quad_state_bound = false;
+                        }
+#endif
+                        if (distance_field != bound_distance_field)
+                        {
+                            GL_CALL(glUniform1i(bd->AttribLocationDistanceField, distance_field ? 1 : 0));
+                            bound_distance_field = distance_field;
+                        }
+                        const void* idx_ptr = (const void*)(intptr_t)(global_idx_offset + pcmd->IdxOffset * sizeof(ImDrawIdx));
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
-                if (bd->GlVersion >= 320)
-                    GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset));
-                else
+                        if (use_base_vertex)
+                            GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, idx_ptr, (GLint)(pcmd->VtxOffset + global_vtx_offset)));
+                        else
+#endif
+                        GL_CALL(glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, idx_ptr));
+                    }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+                    // Quads of a command are drawn after its triangles: one instance per quad, corners are generated from gl_VertexID.
+                    if (pcmd->QuadCount > 0 && quad_vertex_array_object != 0)
+                    {
+                        if (!quad_state_bound)
+                        {
+                            GL_CALL(glUseProgram(bd->QuadShaderHandle));
+                            GL_CALL(glBindVertexArray(quad_vertex_array_object));
+                            quad_state_bound = true;
+                        }
+                        if (distance_field != quad_bound_distance_field)
+                        {
+                            GL_CALL(glUniform1i(bd->QuadAttribLocationDistanceField, distance_field ? 1 : 0));
+                            quad_bound_distance_field = distance_field;
+                        }
+                        const GLsizeiptr quad_buffer_offset = (global_quad_offset + (GLsizeiptr)pcmd->QuadOffset) * (int)sizeof(ImDrawQuad);
+                        if (quad_buffer_offset != bound_quad_offset)
+                        {
+                            GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->QuadVboHandle));
+                            ImGui_ImplOpenGL3_SetupQuadAttribPointers(quad_buffer_offset);
+                            GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, vbo_handle));
+                            bound_quad_offset = quad_buffer_offset;
+                        }
+                        GL_CALL(glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)pcmd->QuadCount));
+                    }
 #endif
-                GL_CALL(glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx))));
+                }
             }
         }
+        if (use_streaming)
+        {
+            global_vtx_offset += draw_list->VtxBuffer.Size;
+            global_idx_offset += idx_buffer_size;
+        }
+        global_quad_offset += draw_list->QuadBuffer.Size;
     }
+    IM_UNUSED(global_quad_offset);
+    IM_UNUSED(bound_quad_offset);
+    IM_UNUSED(quad_vertex_array_object);
+    IM_UNUSED(quad_state_bound);
+    IM_UNUSED(quad_bound_distance_field);
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    // Leave main program/VAO bound, as expected by ImGui_ImplOpenGL3_SetupRenderState() when we own the GL state
+    if (quad_state_bound)
+    {
+        GL_CALL(glUseProgram(bd->ShaderHandle));
+        GL_CALL(glBindVertexArray(vertex_array_object));
+    }
+    if (quad_vertex_array_object != 0 && !bd->OwnsGLState)
+        GL_CALL(glDeleteVertexArrays(1, &quad_vertex_array_object));
+#endif
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING_BUFFERS
+    // Protect the ring buffer region we just used until the GPU is done with it
+    if (use_streaming)
+    {
+        const int region = (int)(bd->StreamFrameIndex % IMGUI_IMPL_OPENGL_STREAMING_FRAMES);
+        bd->StreamFences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        bd->StreamFrameIndex++;
+    }
+#endif
 
     // Destroy the temporary VAO
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
+    if (!bd->OwnsGLState)
+        GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
 #endif
+}
+
+// OpenGL3 Render function.
+// Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
+// This is in order to be able to run within an OpenGL engine that doesn't do so.
+void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
+{
+    ImGui_ImplOpenGL3_RenderDrawDataRegions(draw_data, nullptr, 0);
+}
+
+// Only redraw inside of 'regions' (non-overlapping, in ImDrawCmd::ClipRect coordinates). The framebuffer is expected to still contain the previous contents outside of them.
+// Regions are expanded to whole framebuffer pixels (floor min, ceil max): clear them with the same rounding. Passing regions == nullptr redraws everything.
+void    ImGui_ImplOpenGL3_RenderDrawDataRegions(ImDrawData* draw_data, const ImVec4* regions, int regions_count)
+{
+    // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
+    int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    if (fb_width <= 0 || fb_height <= 0)
+        return;
+
+    ImGui_ImplOpenGL3_InitLoader(); // Lazily init loader if not already done for e.g. DLL boundaries.
+
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+
+    // Catch up with texture updates. Most of the times, the list will have 1 element with an OK status, aka nothing to do.
+    // (This almost always points to ImGui::GetPlatformIO().Textures[] but is part of ImDrawData to allow overriding or disabling texture updates).
+    if (draw_data->Textures != nullptr)
+        for (ImTextureData* tex : *draw_data->Textures)
+            if (tex->Status != ImTextureStatus_OK)
+                ImGui_ImplOpenGL3_UpdateTexture(tex);
+
+    // When the app declared owning the whole GL context, we don't need to backup/restore anything
+    if (bd->OwnsGLState)
+    {
+        ImGui_ImplOpenGL3_RenderCommandLists(draw_data, fb_width, fb_height, regions, regions_count);
+        glDisable(GL_SCISSOR_TEST);
+        return;
+    }
+
+    // Backup GL state
+    GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
+    glActiveTexture(GL_TEXTURE0);
+    GLuint last_program; glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
+    GLuint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+    GLuint last_sampler; if (bd->HasBindSampler) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler); } else { last_sampler = 0; }
+#endif
+    GLuint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
+#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
+    GLint last_element_array_buffer; glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
+    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_pos; last_vtx_attrib_state_pos.GetState(bd->AttribLocationVtxPos);
+    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_uv; last_vtx_attrib_state_uv.GetState(bd->AttribLocationVtxUV);
+    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_color; last_vtx_attrib_state_color.GetState(bd->AttribLocationVtxColor);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    GLuint last_vertex_array_object; glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
+    GLint last_polygon_mode[2]; if (bd->HasPolygonMode) { glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode); }
+#endif
+    GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
+    GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
+    GLenum last_blend_src_rgb; glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
+    GLenum last_blend_dst_rgb; glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
+    GLenum last_blend_src_alpha; glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
+    GLenum last_blend_dst_alpha; glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
+    GLenum last_blend_equation_rgb; glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
+    GLenum last_blend_equation_alpha; glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
+    GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
+    GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
+    GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
+    GLboolean last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
+    GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+    GLboolean last_enable_primitive_restart = (!bd->GlProfileIsES3 && bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
+#endif
+
+    ImGui_ImplOpenGL3_RenderCommandLists(draw_data, fb_width, fb_height, regions, regions_count);
 
     // Restore modified GL state
     // This "glIsProgram()" check is required because if the program is "pending deletion" at the time of binding backup, it will have been deleted by now and will cause an OpenGL error. See #6220.
@@ -721,8 +1293,93 @@ static void ImGui_ImplOpenGL3_DestroyTexture(ImTextureData* tex)
     tex->SetStatus(ImTextureStatus_Destroyed);
 }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING_BUFFERS
+// Upload texture rectangles through a pixel buffer object: all rectangles are packed into one mapped buffer, then glTexSubImage2D()
+// sources from it and returns without waiting for the copy. Buffers are recycled in a ring: when the GPU is still reading from the next
+// buffer we orphan its storage instead of waiting for its fence.
+// The texture needs to be bound and GL_UNPACK_ROW_LENGTH set to 0. Return false if the buffer couldn't be mapped: caller should upload from CPU memory.
+static bool ImGui_ImplOpenGL3_UploadTextureRectsAsync(ImTextureData* tex, const ImTextureRect* rects, int rects_count, GLenum gl_format)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    GLsizeiptr total_size = 0;
+    for (int n = 0; n < rects_count; n++)
+        total_size += (GLsizeiptr)rects[n].w * rects[n].h * tex->BytesPerPixel;
+    if (total_size == 0)
+        return true;
+
+    GLint last_pixel_unpack_buffer = 0;
+    if (!bd->OwnsGLState)
+        GL_CALL(glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &last_pixel_unpack_buffer));
+    const int index = (int)(bd->UploadPboIndex++ % IMGUI_IMPL_OPENGL_UPLOAD_BUFFERS);
+    if (bd->UploadPboHandles[index] == 0)
+        GL_CALL(glGenBuffers(1, &bd->UploadPboHandles[index]));
+    GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, bd->UploadPboHandles[index]));
+
+    bool orphan = (bd->UploadPboSizes[index] < total_size);
+    if (GLsync fence = bd->UploadFences[index])
+    {
+        const GLenum result = glClientWaitSync(fence, 0, 0);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+            orphan = true;
+        glDeleteSync(fence);
+        bd->UploadFences[index] = nullptr;
+    }
+    if (orphan)
+    {
+        if (bd->UploadPboSizes[index] < total_size)
+            bd->UploadPboSizes[index] = total_size;
+        GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, bd->UploadPboSizes[index], nullptr, GL_STREAM_DRAW));
+    }
+
+    char* dst = (char*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, total_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (dst == nullptr)
+    {
+        GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, last_pixel_unpack_buffer));
+        return false;
+    }
+    for (int n = 0; n < rects_count; n++)
+    {
+        const ImTextureRect& r = rects[n];
+        const int dst_pitch = r.w * tex->BytesPerPixel;
+        for (int y = 0; y < r.h; y++, dst += dst_pitch)
+            memcpy(dst, tex->GetPixelsAt(r.x, r.y + y), dst_pitch);
+    }
+    GL_CALL(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+
+    GLintptr src_offset = 0;
+    for (int n = 0; n < rects_count; n++)
+    {
+        const ImTextureRect& r = rects[n];
+        GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, gl_format, GL_UNSIGNED_BYTE, (const GLvoid*)src_offset));
+        src_offset += (GLintptr)r.w * r.h * tex->BytesPerPixel;
+    }
+    bd->UploadFences[index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, last_pixel_unpack_buffer));
+    return true;
+}
+#endif
+
+// Pixel format used to upload and store a texture
+static void ImGui_ImplOpenGL3_GetTextureFormat(ImTextureFormat format, GLint* out_internal_format, GLenum* out_format)
+{
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    if (format == ImTextureFormat_Alpha8)
+    {
+        *out_internal_format = GL_R8;
+        *out_format = GL_RED;
+        return;
+    }
+#endif
+    IM_ASSERT(format == ImTextureFormat_RGBA32);
+    IM_UNUSED(format);
+    *out_internal_format = GL_RGBA;
+    *out_format = GL_RGBA;
+}
+
 void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
 {
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+
     // FIXME: Consider backing up and restoring
     if (tex->Status == ImTextureStatus_WantCreate || tex->Status == ImTextureStatus_WantUpdates)
     {
@@ -739,21 +1396,45 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
         // Create and upload new texture to graphics system
         //IMGUI_DEBUG_LOG("UpdateTexture #%03d: WantCreate %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
         IM_ASSERT(tex->TexID == 0 && tex->BackendUserData == nullptr);
-        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
+        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32 || (tex->Format == ImTextureFormat_Alpha8 && (ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasTexAlpha8)));
         const void* pixels = tex->GetPixels();
         GLuint gl_texture_id = 0;
+        GLint gl_internal_format;
+        GLenum gl_format;
+        ImGui_ImplOpenGL3_GetTextureFormat(tex->Format, &gl_internal_format, &gl_format);
 
         // Upload texture to graphics system
         // (Bilinear sampling is required by default. Set 'io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines' or 'style.AntiAliasedLinesUseTex = false' to allow point/nearest sampling)
-        GLint last_texture;
-        GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
+        GLint last_texture = 0;
+        if (!bd->OwnsGLState)
+            GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
         GL_CALL(glGenTextures(1, &gl_texture_id));
         GL_CALL(glBindTexture(GL_TEXTURE_2D, gl_texture_id));
         GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
         GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
         GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
         GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
-        GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex->Width, tex->Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+        if (tex->Format == ImTextureFormat_Alpha8)
+        {
+            // Sample single-channel texture as white + alpha, same as the RGBA32 version of it would be
+            GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_ONE));
+            GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_ONE));
+            GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_ONE));
+            GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED));
+        }
+#endif
+        bool uploaded = false;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING_BUFFERS
+        if (bd->UseAsyncTextureUploads)
+        {
+            ImTextureRect full_rect = { 0, 0, (unsigned short)tex->Width, (unsigned short)tex->Height };
+            GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, gl_internal_format, tex->Width, tex->Height, 0, gl_format, GL_UNSIGNED_BYTE, nullptr));
+            uploaded = ImGui_ImplOpenGL3_UploadTextureRectsAsync(tex, &full_rect, 1, gl_format);
+        }
+#endif
+        if (!uploaded)
+            GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, gl_internal_format, tex->Width, tex->Height, 0, gl_format, GL_UNSIGNED_BYTE, pixels));
 
         // Store identifiers
         tex->SetTexID((ImTextureID)(intptr_t)gl_texture_id);
@@ -766,30 +1447,41 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
     {
         // Update selected blocks. We only ever write to textures regions which have never been used before!
         // This backend choose to use tex->Updates[] but you can use tex->UpdateRect to upload a single region.
-        GLint last_texture;
-        GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
+        GLint last_texture = 0;
+        if (!bd->OwnsGLState)
+            GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
 
         GLuint gl_tex_id = (GLuint)(intptr_t)tex->TexID;
+        GLint gl_internal_format;
+        GLenum gl_format;
+        ImGui_ImplOpenGL3_GetTextureFormat(tex->Format, &gl_internal_format, &gl_format);
         GL_CALL(glBindTexture(GL_TEXTURE_2D, gl_tex_id));
+        bool uploaded = false;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING_BUFFERS
+        if (bd->UseAsyncTextureUploads)
+            uploaded = ImGui_ImplOpenGL3_UploadTextureRectsAsync(tex, tex->Updates.Data, tex->Updates.Size, gl_format);
+#endif
+        if (!uploaded)
+        {
 #if GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
-        GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, tex->Width));
-        for (ImTextureRect& r : tex->Updates)
-            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, tex->GetPixelsAt(r.x, r.y)));
-        GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+            GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, tex->Width));
+            for (ImTextureRect& r : tex->Updates)
+                GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, gl_format, GL_UNSIGNED_BYTE, tex->GetPixelsAt(r.x, r.y)));
+            GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
 #else
-        // GL ES doesn't have GL_UNPACK_ROW_LENGTH, so we need to (A) copy to a contiguous buffer or (B) upload line by line.
-        ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
-        for (ImTextureRect& r : tex->Updates)
-        {
-            const int src_pitch = r.w * tex->BytesPerPixel;
-            bd->TempBuffer.resize(r.h * src_pitch);
-            char* out_p = bd->TempBuffer.Data;
-            for (int y = 0; y < r.h; y++, out_p += src_pitch)
-                memcpy(out_p, tex->GetPixelsAt(r.x, r.y + y), src_pitch);
-            IM_ASSERT(out_p == bd->TempBuffer.end());
-            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, bd->TempBuffer.Data));
-        }
+            // GL ES doesn't have GL_UNPACK_ROW_LENGTH, so we need to (A) copy to a contiguous buffer or (B) upload line by line.
+            for (ImTextureRect& r : tex->Updates)
+            {
+                const int src_pitch = r.w * tex->BytesPerPixel;
+                bd->TempBuffer.resize(r.h * src_pitch);
+                char* out_p = bd->TempBuffer.Data;
+                for (int y = 0; y < r.h; y++, out_p += src_pitch)
+                    memcpy(out_p, tex->GetPixelsAt(r.x, r.y + y), src_pitch);
+                IM_ASSERT(out_p == bd->TempBuffer.end());
+                GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, gl_format, GL_UNSIGNED_BYTE, bd->TempBuffer.Data));
+            }
 #endif
+        }
         tex->SetStatus(ImTextureStatus_OK);
         GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture)); // Restore state
     }
@@ -835,6 +1527,223 @@ static bool CheckProgram(GLuint handle, const char* desc)
     return (GLboolean)status == GL_TRUE;
 }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+// Program binary cache file layout: header, followed by KeySize bytes of key, followed by BinarySize bytes of program binary.
+// The key contains driver vendor/renderer/version strings and a hash of shader sources: any mismatch means the file is ignored and overwritten.
+struct ImGui_ImplOpenGL3_ProgramBinaryHeader
+{
+    char            Magic[8];
+    unsigned int    KeySize;
+    unsigned int    BinaryFormat;
+    unsigned int    BinarySize;
+};
+static const char ImGui_ImplOpenGL3_ProgramBinaryMagic[8] = { 'I', 'M', 'G', 'L', 'P', 'R', 'G', '1' };
+
+static void ImGui_ImplOpenGL3_AppendKeyString(ImVector<char>* key, const char* str)
+{
+    const int len = str ? (int)strlen(str) : 0;
+    key->resize(key->Size + len + 1);
+    memcpy(key->Data + key->Size - len - 1, str, (size_t)len);
+    key->back() = '\n';
+}
+
+static void ImGui_ImplOpenGL3_BuildProgramBinaryKey(ImVector<char>* key, const char* vertex_shader, const char* fragment_shader)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    key->resize(0);
+    ImGui_ImplOpenGL3_AppendKeyString(key, (const char*)glGetString(GL_VENDOR));
+    ImGui_ImplOpenGL3_AppendKeyString(key, (const char*)glGetString(GL_RENDERER));
+    ImGui_ImplOpenGL3_AppendKeyString(key, (const char*)glGetString(GL_VERSION));
+
+    // FNV-1a hash of the exact sources we would compile
+    unsigned int hash = 2166136261u;
+    const char* sources[3] = { bd->GlslVersionString, vertex_shader, fragment_shader };
+    for (const char* src : sources)
+        for (const char* c = src; *c; c++)
+            hash = (hash ^ (unsigned char)*c) * 16777619u;
+    char hash_str[16];
+    snprintf(hash_str, IM_ARRAYSIZE(hash_str), "%08X", hash);
+    ImGui_ImplOpenGL3_AppendKeyString(key, hash_str);
+}
+
+// Return a linked program, or 0 if the cache file is missing, stale or rejected by the driver.
+static GLuint ImGui_ImplOpenGL3_LoadProgramBinary(const ImVector<char>& key, const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr)
+        return 0;
+    ImVector<char> file_data;
+    long file_size = (fseek(f, 0, SEEK_END) == 0) ? ftell(f) : -1;
+    if (file_size > (long)sizeof(ImGui_ImplOpenGL3_ProgramBinaryHeader) && fseek(f, 0, SEEK_SET) == 0)
+    {
+        file_data.resize((int)file_size);
+        if (fread(file_data.Data, 1, (size_t)file_size, f) != (size_t)file_size)
+            file_data.clear();
+    }
+    fclose(f);
+    if (file_data.empty())
+        return 0;
+
+    ImGui_ImplOpenGL3_ProgramBinaryHeader header;
+    memcpy(&header, file_data.Data, sizeof(header));
+    const char* file_key = file_data.Data + sizeof(header);
+    if (memcmp(header.Magic, ImGui_ImplOpenGL3_ProgramBinaryMagic, sizeof(header.Magic)) != 0 || header.KeySize != (unsigned int)key.Size || header.BinarySize == 0)
+        return 0;
+    if ((long)sizeof(header) + (long)header.KeySize + (long)header.BinarySize != file_size || memcmp(file_key, key.Data, (size_t)key.Size) != 0)
+        return 0;
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, (GLenum)header.BinaryFormat, file_key + header.KeySize, (GLsizei)header.BinarySize);
+    GLint status = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if ((GLboolean)status == GL_TRUE)
+    {
+#ifdef IMGUI_IMPL_OPENGL_DEBUG
+        printf("Loaded program binary from '%s' (%u bytes)\n", path, header.BinarySize); // [DEBUG]
+#endif
+        return program;
+    }
+
+    // Driver rejected the binary (e.g. format no longer supported): consume the error it may have raised and recompile.
+    glGetError();
+    glDeleteProgram(program);
+    return 0;
+}
+
+static void ImGui_ImplOpenGL3_SaveProgramBinary(GLuint program, const ImVector<char>& key, const char* path)
+{
+    GLint binary_size = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_size);
+    if (binary_size <= 0)
+        return;
+
+    ImGui_ImplOpenGL3_ProgramBinaryHeader header;
+    memcpy(header.Magic, ImGui_ImplOpenGL3_ProgramBinaryMagic, sizeof(header.Magic));
+    header.KeySize = (unsigned int)key.Size;
+    ImVector<char> binary;
+    binary.resize((int)binary_size);
+    GLsizei binary_written = 0;
+    GLenum binary_format = 0;
+    glGetProgramBinary(program, binary_size, &binary_written, &binary_format, binary.Data);
+    if (binary_written <= 0)
+        return;
+    header.BinaryFormat = (unsigned int)binary_format;
+    header.BinarySize = (unsigned int)binary_written;
+
+    // Write to a temporary file then rename it, so an interrupted write never leaves a truncated cache file behind.
+    ImVector<char> tmp_path;
+    tmp_path.resize((int)strlen(path) + 5);
+    snprintf(tmp_path.Data, (size_t)tmp_path.Size, "%s.tmp", path);
+    FILE* f = fopen(tmp_path.Data, "wb");
+    if (f == nullptr)
+        return;
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    ok &= fwrite(key.Data, 1, (size_t)key.Size, f) == (size_t)key.Size;
+    ok &= fwrite(binary.Data, 1, (size_t)binary_written, f) == (size_t)binary_written;
+    ok &= fclose(f) == 0;
+    if (ok)
+    {
+        remove(path);
+        ok = rename(tmp_path.Data, path) == 0;
+    }
+    if (!ok)
+        remove(tmp_path.Data);
+}
+#endif // #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+
+// Program drawing one ImDrawQuad per instance as a 4 vertices triangle strip. Shares the layout of our GLSL 1.30 and GLSL ES 3.00 fragment shaders.
+static bool ImGui_ImplOpenGL3_CreateQuadProgram()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    const GLchar* vertex_shader =
+        "#ifdef GL_ES\n"
+        "precision highp float;\n"
+        "#endif\n"
+        "uniform mat4 ProjMtx;\n"
+        "in vec2 QuadPos;\n"
+        "in vec2 QuadSize;\n"
+        "in vec2 QuadUvMin;\n"
+        "in vec2 QuadUvMax;\n"
+        "in vec4 QuadColor;\n"
+        "out vec2 Frag_UV;\n"
+        "out vec4 Frag_Color;\n"
+        "void main()\n"
+        "{\n"
+        "    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));\n"
+        "    Frag_UV = mix(QuadUvMin, QuadUvMax, corner);\n"
+        "    Frag_Color = QuadColor;\n"
+        "    gl_Position = ProjMtx * vec4(QuadPos + QuadSize * corner, 0, 1);\n"
+        "}\n";
+
+    const GLchar* fragment_shader =
+        "#ifdef GL_ES\n"
+        "precision mediump float;\n"
+        "#endif\n"
+        "uniform sampler2D Texture;\n"
+        "uniform bool DistanceField;\n"
+        "in vec2 Frag_UV;\n"
+        "in vec4 Frag_Color;\n"
+        "out vec4 Out_Color;\n"
+        "void main()\n"
+        "{\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (DistanceField)\n"
+        "        tex.a = clamp((tex.a - 0.5) / max(fwidth(tex.a), 0.0001) + 0.5, 0.0, 1.0);\n"
+        "    Out_Color = Frag_Color * tex;\n"
+        "}\n";
+
+    const GLchar* vertex_shader_with_version[2] = { bd->GlslVersionString, vertex_shader };
+    GLuint vert_handle;
+    GL_CALL(vert_handle = glCreateShader(GL_VERTEX_SHADER));
+    glShaderSource(vert_handle, 2, vertex_shader_with_version, nullptr);
+    glCompileShader(vert_handle);
+    const GLchar* fragment_shader_with_version[2] = { bd->GlslVersionString, fragment_shader };
+    GLuint frag_handle;
+    GL_CALL(frag_handle = glCreateShader(GL_FRAGMENT_SHADER));
+    glShaderSource(frag_handle, 2, fragment_shader_with_version, nullptr);
+    glCompileShader(frag_handle);
+
+    GLuint program = 0;
+    if (CheckShader(vert_handle, "quad vertex shader") && CheckShader(frag_handle, "quad fragment shader"))
+    {
+        program = glCreateProgram();
+        glAttachShader(program, vert_handle);
+        glAttachShader(program, frag_handle);
+        glLinkProgram(program);
+        if (!CheckProgram(program, "quad shader program"))
+        {
+            glDeleteProgram(program);
+            program = 0;
+        }
+        else
+        {
+            glDetachShader(program, vert_handle);
+            glDetachShader(program, frag_handle);
+        }
+    }
+    glDeleteShader(vert_handle);
+    glDeleteShader(frag_handle);
+    if (program == 0)
+        return false;
+
+    bd->QuadShaderHandle = program;
+    bd->QuadAttribLocationTex = glGetUniformLocation(program, "Texture");
+    bd->QuadAttribLocationProjMtx = glGetUniformLocation(program, "ProjMtx");
+    bd->QuadAttribLocationDistanceField = glGetUniformLocation(program, "DistanceField");
+    bd->QuadAttribLocationPos = (GLuint)glGetAttribLocation(program, "QuadPos");
+    bd->QuadAttribLocationSize = (GLuint)glGetAttribLocation(program, "QuadSize");
+    bd->QuadAttribLocationUvMin = (GLuint)glGetAttribLocation(program, "QuadUvMin");
+    bd->QuadAttribLocationUvMax = (GLuint)glGetAttribLocation(program, "QuadUvMax");
+    bd->QuadAttribLocationColor = (GLuint)glGetAttribLocation(program, "QuadColor");
+    bd->OwnedStateValid = false;
+    return true;
+#else
+    IM_UNUSED(bd);
+    return false;
+#endif
+}
+
 bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
@@ -927,33 +1836,45 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
     const GLchar* fragment_shader_glsl_130 =
         "uniform sampler2D Texture;\n"
+        "uniform bool DistanceField;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (DistanceField)\n"
+        "        tex.a = clamp((tex.a - 0.5) / max(fwidth(tex.a), 0.0001) + 0.5, 0.0, 1.0);\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_300_es =
         "precision mediump float;\n"
         "uniform sampler2D Texture;\n"
+        "uniform bool DistanceField;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (DistanceField)\n"
+        "        tex.a = clamp((tex.a - 0.5) / max(fwidth(tex.a), 0.0001) + 0.5, 0.0, 1.0);\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_410_core =
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "uniform sampler2D Texture;\n"
+        "uniform bool DistanceField;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (DistanceField)\n"
+        "        tex.a = clamp((tex.a - 0.5) / max(fwidth(tex.a), 0.0001) + 0.5, 0.0, 1.0);\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     // Select shaders matching our GLSL versions
@@ -980,42 +1901,72 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         fragment_shader = fragment_shader_glsl_130;
     }
 
-    // Create shaders
-    const GLchar* vertex_shader_with_version[2] = { bd->GlslVersionString, vertex_shader };
-    GLuint vert_handle;
-    GL_CALL(vert_handle = glCreateShader(GL_VERTEX_SHADER));
-    glShaderSource(vert_handle, 2, vertex_shader_with_version, nullptr);
-    glCompileShader(vert_handle);
-    if (!CheckShader(vert_handle, "vertex shader"))
-        return false;
-
-    const GLchar* fragment_shader_with_version[2] = { bd->GlslVersionString, fragment_shader };
-    GLuint frag_handle;
-    GL_CALL(frag_handle = glCreateShader(GL_FRAGMENT_SHADER));
-    glShaderSource(frag_handle, 2, fragment_shader_with_version, nullptr);
-    glCompileShader(frag_handle);
-    if (!CheckShader(frag_handle, "fragment shader"))
-        return false;
-
-    // Link
-    bd->ShaderHandle = glCreateProgram();
-    glAttachShader(bd->ShaderHandle, vert_handle);
-    glAttachShader(bd->ShaderHandle, frag_handle);
-    glLinkProgram(bd->ShaderHandle);
-    if (!CheckProgram(bd->ShaderHandle, "shader program"))
-        return false;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    // Try loading a previously linked program from the binary cache, validated against driver strings and shader sources
+    const bool use_program_binary_cache = bd->HasProgramBinary && !bd->ProgramBinaryCachePath.empty();
+    ImVector<char> program_binary_key;
+    if (use_program_binary_cache)
+    {
+        ImGui_ImplOpenGL3_BuildProgramBinaryKey(&program_binary_key, vertex_shader, fragment_shader);
+        bd->ShaderHandle = ImGui_ImplOpenGL3_LoadProgramBinary(program_binary_key, bd->ProgramBinaryCachePath.Data);
+    }
+#endif
 
-    glDetachShader(bd->ShaderHandle, vert_handle);
-    glDetachShader(bd->ShaderHandle, frag_handle);
-    glDeleteShader(vert_handle);
-    glDeleteShader(frag_handle);
+    if (bd->ShaderHandle == 0)
+    {
+        // Create shaders
+        const GLchar* vertex_shader_with_version[2] = { bd->GlslVersionString, vertex_shader };
+        GLuint vert_handle;
+        GL_CALL(vert_handle = glCreateShader(GL_VERTEX_SHADER));
+        glShaderSource(vert_handle, 2, vertex_shader_with_version, nullptr);
+        glCompileShader(vert_handle);
+        if (!CheckShader(vert_handle, "vertex shader"))
+            return false;
+
+        const GLchar* fragment_shader_with_version[2] = { bd->GlslVersionString, fragment_shader };
+        GLuint frag_handle;
+        GL_CALL(frag_handle = glCreateShader(GL_FRAGMENT_SHADER));
+        glShaderSource(frag_handle, 2, fragment_shader_with_version, nullptr);
+        glCompileShader(frag_handle);
+        if (!CheckShader(frag_handle, "fragment shader"))
+            return false;
+
+        // Link
+        bd->ShaderHandle = glCreateProgram();
+        glAttachShader(bd->ShaderHandle, vert_handle);
+        glAttachShader(bd->ShaderHandle, frag_handle);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+        if (use_program_binary_cache)
+            glProgramParameteri(bd->ShaderHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+        glLinkProgram(bd->ShaderHandle);
+        if (!CheckProgram(bd->ShaderHandle, "shader program"))
+            return false;
+
+        glDetachShader(bd->ShaderHandle, vert_handle);
+        glDetachShader(bd->ShaderHandle, frag_handle);
+        glDeleteShader(vert_handle);
+        glDeleteShader(frag_handle);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+        if (use_program_binary_cache)
+            ImGui_ImplOpenGL3_SaveProgramBinary(bd->ShaderHandle, program_binary_key, bd->ProgramBinaryCachePath.Data);
+#endif
+    }
 
     bd->AttribLocationTex = glGetUniformLocation(bd->ShaderHandle, "Texture");
     bd->AttribLocationProjMtx = glGetUniformLocation(bd->ShaderHandle, "ProjMtx");
+    bd->AttribLocationDistanceField = glGetUniformLocation(bd->ShaderHandle, "DistanceField"); // -1 with GLSL 1.20 shader
     bd->AttribLocationVtxPos = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Position");
     bd->AttribLocationVtxUV = (GLuint)glGetAttribLocation(bd->ShaderHandle, "UV");
     bd->AttribLocationVtxColor = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Color");
 
+    // Optional instanced quads program. On failure we keep going without it: draw lists will keep using triangles.
+    if (bd->UseInstancedQuads && !ImGui_ImplOpenGL3_CreateQuadProgram())
+    {
+        bd->UseInstancedQuads = false;
+        ImGui::GetIO().BackendFlags &= ~ImGuiBackendFlags_RendererHasInstancedQuads;
+    }
+
     // Create buffers
     glGenBuffers(1, &bd->VboHandle);
     glGenBuffers(1, &bd->ElementsHandle);
@@ -1038,7 +1989,27 @@ void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
     if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
     if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING_BUFFERS
+    if (bd->StreamVboHandle)      { glDeleteBuffers(1, &bd->StreamVboHandle); bd->StreamVboHandle = 0; }
+    if (bd->StreamElementsHandle) { glDeleteBuffers(1, &bd->StreamElementsHandle); bd->StreamElementsHandle = 0; }
+    for (GLsync& fence : bd->StreamFences)
+        if (fence != nullptr) { glDeleteSync(fence); fence = nullptr; }
+    bd->StreamVertexRegionSize = bd->StreamIndexRegionSize = 0;
+    for (int n = 0; n < IMGUI_IMPL_OPENGL_UPLOAD_BUFFERS; n++)
+    {
+        if (bd->UploadPboHandles[n]) { glDeleteBuffers(1, &bd->UploadPboHandles[n]); bd->UploadPboHandles[n] = 0; }
+        if (bd->UploadFences[n])     { glDeleteSync(bd->UploadFences[n]); bd->UploadFences[n] = nullptr; }
+        bd->UploadPboSizes[n] = 0;
+    }
+#endif
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    if (bd->OwnedVaoHandle) { glDeleteVertexArrays(1, &bd->OwnedVaoHandle); bd->OwnedVaoHandle = 0; }
+    if (bd->OwnedQuadVaoHandle) { glDeleteVertexArrays(1, &bd->OwnedQuadVaoHandle); bd->OwnedQuadVaoHandle = 0; }
+#endif
+    bd->OwnedStateValid = false;
     if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
+    if (bd->QuadShaderHandle) { glDeleteProgram(bd->QuadShaderHandle); bd->QuadShaderHandle = 0; }
+    if (bd->QuadVboHandle)  { glDeleteBuffers(1, &bd->QuadVboHandle); bd->QuadVboHandle = 0; }
 
     // Destroy all textures
     for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
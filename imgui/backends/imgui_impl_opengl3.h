@@ -7,6 +7,7 @@
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture as texture identifier. Read the FAQ about ImTextureID/ImTextureRef!
 //  [x] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset) [Desktop OpenGL only!]
 //  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
+//  [x] Renderer: Single-channel textures support (ImGuiBackendFlags_RendererHasTexAlpha8) [Desktop GL 3.3+ and GL ES 3.0+ only!]
 
 // About WebGL/ES:
 // - You need to '#define IMGUI_IMPL_OPENGL_ES2' or '#define IMGUI_IMPL_OPENGL_ES3' to use WebGL or OpenGL ES.
@@ -35,6 +36,7 @@ IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_Init(const char* glsl_version = nullpt
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_Shutdown();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_NewFrame();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_RenderDrawDataRegions(ImDrawData* draw_data, const ImVec4* regions, int regions_count); // Partial redraw, e.g. of ImDrawDamageTracker::DamageRects[]. You need to clear those regions yourself, expanded to whole pixels (floor min, ceil max).
 
 // (Optional) Called by Init/NewFrame/Shutdown
 IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateDeviceObjects();
@@ -43,6 +45,31 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 // (Advanced) Use e.g. if you need to precisely control the timing of texture updates (e.g. for staged rendering), by setting ImDrawData::Textures = NULL to handle this manually.
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex);
 
+// (Optional) Declare that the app owns the whole GL context and only renders through us, or re-applies its own state before drawing.
+// The backend then skips backing up/restoring GL state and the associated glGet*() queries, and skips re-applying state which is still in place.
+// Our blend state, program, VAO and buffer bindings are left in place after rendering (scissor test is disabled so glClear() is not clipped).
+// Call ImGui_ImplOpenGL3_InvalidateOwnedState() after changing GL state yourself outside of ImDrawList callbacks.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_EnableStateOwnership(bool enable);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_InvalidateOwnedState();
+
+// (Optional) Features using more recent GL versions. Unless noted otherwise, they require Desktop GL 3.2+ or GL ES 3.0+ (not WebGL).
+// Call after ImGui_ImplOpenGL3_Init(). Return false if not supported by the current context.
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_EnableStreamingBuffers(bool enable);      // Upload all draw lists of a frame into a ring buffer with one glMapBufferRange() per buffer, instead of two glBufferData() calls per ImDrawList.
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_EnableAsyncTextureUploads(bool enable);   // Upload texture updates (e.g. new glyphs) through a ring of pixel buffer objects, so glTexSubImage2D() doesn't stall on the copy.
+
+// Cache the linked shader program in a file under 'dir' using glGetProgramBinary(), and reload it instead of compiling on next init (e.g. after EGL context loss).
+// The cache is keyed by GL_VENDOR/GL_RENDERER/GL_VERSION and shader sources, and we fall back to compiling if the driver rejects it. Pass nullptr to disable.
+// Requires Desktop GL 4.1+ (or GL_ARB_get_program_binary) or GL ES 3.0+. Call before the first NewFrame().
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_SetProgramBinaryCacheDir(const char* dir);
+
+// Let draw lists output text glyphs, images and plain rectangles as one ImDrawQuad each (36 bytes instead of 4 vertices + 6 indices),
+// expanded in the vertex shader and drawn with glDrawArraysInstanced(). Sets ImGuiBackendFlags_RendererHasInstancedQuads, applied on next ImGui::NewFrame().
+// Requires Desktop GL 3.3+ or GL ES 3.0+ with GLSL 1.30+.
+// Code post-processing vertices it just emitted (e.g. ShadeVertsXXX functions, rotating text) must clear ImDrawListFlags_InstancedQuads
+// around the draw calls, as quads have no vertices to modify: see how imgui_tables.cpp renders angled headers.
+// (The ImDrawCmd::QuadOffset/QuadCount fields used by this make every ImDrawCmd 8 bytes larger, whether this is enabled or not.)
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_EnableInstancedQuads(bool enable);
+
 // Configuration flags to add in your imconfig file:
 //#define IMGUI_IMPL_OPENGL_ES2     // Enable ES 2 (Auto-detected on Emscripten)
 //#define IMGUI_IMPL_OPENGL_ES3     // Enable ES 3 (Auto-detected on iOS/Android)
@@ -0,0 +1,789 @@
+// dear imgui: Renderer Backend for a CPU software rasterizer
+// This needs to be used along with a Platform Backend (e.g. Android, SDL, Win32) or standalone for headless rendering.
+
+// Rasterizes ImDrawData into a 32-bit pixel buffer that you own: no GPU, no graphics API, no external dependency.
+// Use cases: headless screenshot generation, pixel-exact regression tests and benchmarks on CI machines without a GPU,
+// and a fallback path for devices with broken or missing OpenGL ES drivers (blit the buffer with e.g. ANativeWindow_lock()).
+// Output is deterministic for a given ImDrawData on all platforms, whichever of the SSE2/NEON/scalar code paths gets compiled.
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftRaster_Texture*' as texture identifier. Read the FAQ about ImTextureID/ImTextureRef!
+//  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
+//  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
+//  [X] Renderer: Single-channel textures support (ImGuiBackendFlags_RendererHasTexAlpha8).
+//  [X] Renderer: Instanced quads support (ImGuiBackendFlags_RendererHasInstancedQuads).
+//  [X] Renderer: Expose selected render state for draw callbacks to use. Access in '(ImGui_ImplXXXX_RenderState*)GetPlatformIO().Renderer_RenderState'.
+
+// You can copy and use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
+// Learn about Dear ImGui:
+// - FAQ                  https://dearimgui.com/faq
+// - Getting Started      https://dearimgui.com/getting-started
+// - Documentation        https://dearimgui.com/docs (same as your local docs/ folder).
+// - Introduction, links and more at the top of imgui.cpp
+
+// CHANGELOG
+//  2026-10-18: Initial version.
+
+// Rasterization rules are those of GPUs, so output closely matches the OpenGL/DirectX backends:
+// - A pixel is covered when its center is inside the triangle. Vertices are snapped to 1/256th of a pixel and coverage is computed
+//   with exact integer math and a top-left style tie-breaking rule: triangles sharing an edge never touch the same pixel twice.
+// - Blending is SRC_ALPHA/ONE_MINUS_SRC_ALPHA for colors and ONE/ONE_MINUS_SRC_ALPHA for alpha, rounded to nearest.
+// - Textures are sampled with bilinear filtering and clamp-to-edge addressing.
+// Most of Dear ImGui output is axis-aligned rectangles (text, filled rectangles, images): ImDrawQuad records and pairs of
+// triangles laid out like ImDrawList::PrimRect()/PrimRectUV() are detected and filled row by row without per-pixel edge tests.
+// Spans of pixels are blended 4 at a time with SSE2 or NEON when available. Define IMGUI_DISABLE_SSE or IMGUI_DISABLE_NEON to use scalar code.
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_softraster.h"
+#include <stdint.h>     // intptr_t
+#include <string.h>     // memcpy, memset
+#include <math.h>       // floorf
+
+// Clang warnings with -Weverything
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsign-conversion"    // warning: implicit conversion changes signedness
+#pragma clang diagnostic ignored "-Wfloat-equal"        // warning: comparing floating-point with '==' or '!=' is unsafe
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wfloat-equal"          // warning: comparing floating-point with '==' or '!=' is unsafe
+#endif
+
+// SIMD
+#if !defined(IMGUI_DISABLE_SSE) && (defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define IMGUI_IMPL_SOFTRASTER_USE_SSE2
+#include <emmintrin.h>
+#elif !defined(IMGUI_DISABLE_NEON) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define IMGUI_IMPL_SOFTRASTER_USE_NEON
+#include <arm_neon.h>
+#endif
+
+// Software rasterizer data
+struct ImGui_ImplSoftRaster_Data
+{
+    ImVector<ImU32>     RowBuffer;      // Colors of the span being rasterized, blended into the buffer in one go
+
+    ImGui_ImplSoftRaster_Data()   { memset((void*)this, 0, sizeof(*this)); }
+};
+
+// Destination and state of the draw command being rasterized
+struct ImGui_ImplSoftRaster_Target
+{
+    unsigned char*                          Pixels;
+    int                                     Pitch;
+    int                                     ClipX0, ClipY0, ClipX1, ClipY1; // Scissor rectangle intersected with the buffer (max is exclusive)
+    const ImGui_ImplSoftRaster_Texture*     Texture;                        // nullptr samples as opaque white
+    ImU32*                                  RowBuffer;
+};
+
+// Backend data stored in io.BackendRendererUserData to allow support for multiple Dear ImGui contexts
+// It is STRONGLY preferred that you use docking branch with multi-viewports (== single Dear ImGui context + multiple windows) instead of multiple Dear ImGui contexts.
+static ImGui_ImplSoftRaster_Data* ImGui_ImplSoftRaster_GetBackendData()
+{
+    return ImGui::GetCurrentContext() ? (ImGui_ImplSoftRaster_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
+}
+
+// Functions
+bool ImGui_ImplSoftRaster_Init()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IMGUI_CHECKVERSION();
+    IM_ASSERT(io.BackendRendererUserData == nullptr && "Already initialized a renderer backend!");
+
+    // Setup backend capabilities flags
+    ImGui_ImplSoftRaster_Data* bd = IM_NEW(ImGui_ImplSoftRaster_Data)();
+    io.BackendRendererUserData = (void*)bd;
+    io.BackendRendererName = "imgui_impl_softraster";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;      // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;       // We can honor ImGuiPlatformIO::Textures[] requests during render.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexAlpha8;      // We can sample ImTextureFormat_Alpha8 textures, e.g. set 'io.Fonts->TexDesiredFormat = ImTextureFormat_Alpha8'.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasInstancedQuads; // We can honor ImDrawCmd::QuadCount/QuadOffset. Quads are our fastest path, so always enabled.
+
+    return true;
+}
+
+void ImGui_ImplSoftRaster_Shutdown()
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    IM_ASSERT(bd != nullptr && "No renderer backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+    ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
+
+    ImGui_ImplSoftRaster_DestroyDeviceObjects();
+
+    io.BackendRendererName = nullptr;
+    io.BackendRendererUserData = nullptr;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasTexAlpha8 | ImGuiBackendFlags_RendererHasInstancedQuads);
+    platform_io.ClearRendererHandlers();
+    bd->RowBuffer.clear();
+    IM_DELETE(bd);
+}
+
+void ImGui_ImplSoftRaster_NewFrame()
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoftRaster_Init()?");
+    IM_UNUSED(bd);
+}
+
+//-----------------------------------------------------------------------------
+// Pixel operations
+//-----------------------------------------------------------------------------
+// All code paths (SSE2, NEON, scalar) compute the exact same values, so output doesn't depend on the target CPU.
+// - Multiply: x * y / 255 rounded to nearest, computed as t = x * y + 128; (t + (t >> 8)) >> 8.
+// - Blend: (src * a + dst * (255 - a)) / 255 for colors and (src_a * 255 + dst_a * (255 - a)) / 255 for alpha, same rounding.
+//-----------------------------------------------------------------------------
+
+static inline ImU32 ImGui_ImplSoftRaster_BlendPixel(ImU32 dst, ImU32 src)
+{
+    const ImU32 a = (src >> IM_COL32_A_SHIFT) & 0xFF;
+    if (a == 0)
+        return dst;
+    if (a == 255)
+        return src;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        const ImU32 t = ((src >> shift) & 0xFF) * (shift == IM_COL32_A_SHIFT ? 255 : a) + ((dst >> shift) & 0xFF) * (255 - a) + 128;
+        out |= ((t + (t >> 8)) >> 8) << shift;
+    }
+    return out;
+}
+
+static inline ImU32 ImGui_ImplSoftRaster_MulColors(ImU32 col_a, ImU32 col_b)
+{
+    if (col_a == 0xFFFFFFFF)
+        return col_b;
+    if (col_b == 0xFFFFFFFF)
+        return col_a;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        const ImU32 t = ((col_a >> shift) & 0xFF) * ((col_b >> shift) & 0xFF) + 128;
+        out |= ((t + (t >> 8)) >> 8) << shift;
+    }
+    return out;
+}
+
+#if defined(IMGUI_IMPL_SOFTRASTER_USE_SSE2)
+// 16-bit lanes holding the alpha channel of 2 unpacked pixels
+#define IMGUI_IMPL_SOFTRASTER_SSE2_ALPHA_LANES()    _mm_slli_epi64(_mm_srli_epi64(_mm_set1_epi32(-1), 48), IM_COL32_A_SHIFT * 2)
+#define IMGUI_IMPL_SOFTRASTER_SSE2_ALPHA_SHUFFLE    _MM_SHUFFLE(IM_COL32_A_SHIFT / 8, IM_COL32_A_SHIFT / 8, IM_COL32_A_SHIFT / 8, IM_COL32_A_SHIFT / 8)
+
+// Blend 2 unpacked source pixels over 2 unpacked destination pixels
+static inline __m128i ImGui_ImplSoftRaster_Blend2_SSE2(__m128i dst16, __m128i src16, __m128i alpha_lanes)
+{
+    const __m128i c255 = _mm_set1_epi16(255);
+    const __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src16, IMGUI_IMPL_SOFTRASTER_SSE2_ALPHA_SHUFFLE), IMGUI_IMPL_SOFTRASTER_SSE2_ALPHA_SHUFFLE);
+    const __m128i src_mul = _mm_or_si128(_mm_andnot_si128(alpha_lanes, a), _mm_and_si128(alpha_lanes, c255));
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(src16, src_mul), _mm_mullo_epi16(dst16, _mm_sub_epi16(c255, a)));
+    t = _mm_add_epi16(t, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+#elif defined(IMGUI_IMPL_SOFTRASTER_USE_NEON)
+// Multiply-add 8 pixels worth of channels then divide by 255
+static inline uint8x8_t ImGui_ImplSoftRaster_Div255_NEON(uint16x8_t t)
+{
+    t = vaddq_u16(t, vdupq_n_u16(128));
+    return vshrn_n_u16(vsraq_n_u16(t, t, 8), 8);
+}
+#endif
+
+// Blend a constant color over 'count' pixels
+static void ImGui_ImplSoftRaster_FillSpan(ImU32* dst, int count, ImU32 col)
+{
+    const ImU32 a = (col >> IM_COL32_A_SHIFT) & 0xFF;
+    if (a == 0)
+        return;
+    int i = 0;
+    if (a == 255)
+    {
+#if defined(IMGUI_IMPL_SOFTRASTER_USE_SSE2)
+        const __m128i col4 = _mm_set1_epi32((int)col);
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_si128((__m128i*)(void*)(dst + i), col4);
+#elif defined(IMGUI_IMPL_SOFTRASTER_USE_NEON)
+        const uint32x4_t col4 = vdupq_n_u32(col);
+        for (; i + 4 <= count; i += 4)
+            vst1q_u32(dst + i, col4);
+#endif
+        for (; i < count; i++)
+            dst[i] = col;
+        return;
+    }
+
+#if defined(IMGUI_IMPL_SOFTRASTER_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha_lanes = IMGUI_IMPL_SOFTRASTER_SSE2_ALPHA_LANES();
+    const __m128i src16 = _mm_unpacklo_epi8(_mm_set1_epi32((int)col), zero);
+    const __m128i src_mul = _mm_or_si128(_mm_andnot_si128(alpha_lanes, _mm_set1_epi16((short)a)), _mm_and_si128(alpha_lanes, _mm_set1_epi16(255)));
+    const __m128i src_term = _mm_add_epi16(_mm_mullo_epi16(src16, src_mul), _mm_set1_epi16(128));
+    const __m128i inv_a = _mm_set1_epi16((short)(255 - a));
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i d = _mm_loadu_si128((const __m128i*)(const void*)(dst + i));
+        __m128i t_lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv_a), src_term);
+        __m128i t_hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv_a), src_term);
+        t_lo = _mm_srli_epi16(_mm_add_epi16(t_lo, _mm_srli_epi16(t_lo, 8)), 8);
+        t_hi = _mm_srli_epi16(_mm_add_epi16(t_hi, _mm_srli_epi16(t_hi, 8)), 8);
+        _mm_storeu_si128((__m128i*)(void*)(dst + i), _mm_packus_epi16(t_lo, t_hi));
+    }
+#elif defined(IMGUI_IMPL_SOFTRASTER_USE_NEON)
+    const ImU32 src_mul = (a * 0x01010101u) | (0xFFu << IM_COL32_A_SHIFT);
+    const uint16x8_t src_term = vmull_u8(vreinterpret_u8_u32(vdup_n_u32(col)), vreinterpret_u8_u32(vdup_n_u32(src_mul)));
+    const uint8x8_t inv_a = vdup_n_u8((uint8_t)(255 - a));
+    for (; i + 4 <= count; i += 4)
+    {
+        const uint8x16_t d = vld1q_u8((const uint8_t*)(dst + i));
+        const uint8x8_t r_lo = ImGui_ImplSoftRaster_Div255_NEON(vmlal_u8(src_term, vget_low_u8(d), inv_a));
+        const uint8x8_t r_hi = ImGui_ImplSoftRaster_Div255_NEON(vmlal_u8(src_term, vget_high_u8(d), inv_a));
+        vst1q_u8((uint8_t*)(dst + i), vcombine_u8(r_lo, r_hi));
+    }
+#endif
+    for (; i < count; i++)
+        dst[i] = ImGui_ImplSoftRaster_BlendPixel(dst[i], col);
+}
+
+// Blend 'count' source pixels over 'count' destination pixels
+static void ImGui_ImplSoftRaster_BlendSpan(ImU32* dst, const ImU32* src, int count)
+{
+    int i = 0;
+#if defined(IMGUI_IMPL_SOFTRASTER_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha_mask = _mm_set1_epi32((int)(0xFFu << IM_COL32_A_SHIFT));
+    const __m128i alpha_lanes = IMGUI_IMPL_SOFTRASTER_SSE2_ALPHA_LANES();
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i s = _mm_loadu_si128((const __m128i*)(const void*)(src + i));
+        const __m128i s_alpha = _mm_and_si128(s, alpha_mask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(s_alpha, zero)) == 0xFFFF)
+            continue; // Fully transparent (e.g. space between glyphs)
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(s_alpha, alpha_mask)) == 0xFFFF)
+        {
+            _mm_storeu_si128((__m128i*)(void*)(dst + i), s);
+            continue;
+        }
+        const __m128i d = _mm_loadu_si128((const __m128i*)(const void*)(dst + i));
+        const __m128i r_lo = ImGui_ImplSoftRaster_Blend2_SSE2(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(s, zero), alpha_lanes);
+        const __m128i r_hi = ImGui_ImplSoftRaster_Blend2_SSE2(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(s, zero), alpha_lanes);
+        _mm_storeu_si128((__m128i*)(void*)(dst + i), _mm_packus_epi16(r_lo, r_hi));
+    }
+#elif defined(IMGUI_IMPL_SOFTRASTER_USE_NEON)
+    const uint32x4_t alpha_mask = vdupq_n_u32(0xFFu << IM_COL32_A_SHIFT);
+    for (; i + 4 <= count; i += 4)
+    {
+        const uint32x4_t s = vld1q_u32(src + i);
+        const uint32x4_t s_alpha = vandq_u32(s, alpha_mask);
+        const uint64x2_t any_alpha = vreinterpretq_u64_u32(s_alpha);
+        if ((vgetq_lane_u64(any_alpha, 0) | vgetq_lane_u64(any_alpha, 1)) == 0)
+            continue; // Fully transparent (e.g. space between glyphs)
+        const uint64x2_t opaque = vreinterpretq_u64_u32(vceqq_u32(s_alpha, alpha_mask));
+        if ((vgetq_lane_u64(opaque, 0) & vgetq_lane_u64(opaque, 1)) == ~(uint64_t)0)
+        {
+            vst1q_u32(dst + i, s);
+            continue;
+        }
+        // Broadcast alpha to all channels, source alpha is multiplied by 255 (ONE) instead of itself
+        const uint8x16_t a = vreinterpretq_u8_u32(vmulq_n_u32(vshrq_n_u32(s_alpha, IM_COL32_A_SHIFT), 0x01010101u));
+        const uint8x16_t src_mul = vorrq_u8(a, vreinterpretq_u8_u32(alpha_mask));
+        const uint8x16_t inv_a = vmvnq_u8(a);
+        const uint8x16_t s8 = vreinterpretq_u8_u32(s);
+        const uint8x16_t d8 = vld1q_u8((const uint8_t*)(dst + i));
+        const uint8x8_t r_lo = ImGui_ImplSoftRaster_Div255_NEON(vmlal_u8(vmull_u8(vget_low_u8(s8), vget_low_u8(src_mul)), vget_low_u8(d8), vget_low_u8(inv_a)));
+        const uint8x8_t r_hi = ImGui_ImplSoftRaster_Div255_NEON(vmlal_u8(vmull_u8(vget_high_u8(s8), vget_high_u8(src_mul)), vget_high_u8(d8), vget_high_u8(inv_a)));
+        vst1q_u8((uint8_t*)(dst + i), vcombine_u8(r_lo, r_hi));
+    }
+#endif
+    for (; i < count; i++)
+        dst[i] = ImGui_ImplSoftRaster_BlendPixel(dst[i], src[i]);
+}
+
+//-----------------------------------------------------------------------------
+// Texture sampling
+//-----------------------------------------------------------------------------
+
+static inline int ImGui_ImplSoftRaster_ClampInt(int v, int mn, int mx)
+{
+    return v < mn ? mn : v > mx ? mx : v;
+}
+
+static inline ImU32 ImGui_ImplSoftRaster_FetchTexel(const ImGui_ImplSoftRaster_Texture* tex, int x, int y)
+{
+    const unsigned char* row = (const unsigned char*)tex->Pixels + (size_t)y * (size_t)tex->Pitch;
+    if (tex->BytesPerPixel == 1)
+        return IM_COL32(255, 255, 255, row[x]);
+    ImU32 texel;
+    memcpy(&texel, row + (size_t)x * 4, 4);
+    return texel;
+}
+
+// Linear interpolation of 4 channels, 'w' = 0..255 weight of 'col_b'
+static inline ImU32 ImGui_ImplSoftRaster_LerpColors(ImU32 col_a, ImU32 col_b, ImU32 w)
+{
+    const ImU32 rb = (((col_a & 0x00FF00FF) * (256 - w) + (col_b & 0x00FF00FF) * w) >> 8) & 0x00FF00FF;
+    const ImU32 ag = (((col_a >> 8) & 0x00FF00FF) * (256 - w) + ((col_b >> 8) & 0x00FF00FF) * w) & 0xFF00FF00;
+    return rb | ag;
+}
+
+// Texel coordinate (texel centers at integer values) to 16.16 fixed point. Clamped so that scaled up UV coordinates can't overflow.
+static inline int ImGui_ImplSoftRaster_TexelToFixed(float t)
+{
+    t = t < -32767.0f ? -32767.0f : t > 32767.0f ? 32767.0f : t;
+    return (int)floorf(t * 65536.0f);
+}
+
+// Bilinear filtering, clamp-to-edge. Text and images drawn at their native size hit texel centers and read a single texel.
+static inline ImU32 ImGui_ImplSoftRaster_SampleTexture(const ImGui_ImplSoftRaster_Texture* tex, int fx, int fy)
+{
+    const ImU32 wx = (ImU32)(fx >> 8) & 0xFF;
+    const ImU32 wy = (ImU32)(fy >> 8) & 0xFF;
+    const int x0 = ImGui_ImplSoftRaster_ClampInt(fx >> 16, 0, tex->Width - 1);
+    const int y0 = ImGui_ImplSoftRaster_ClampInt(fy >> 16, 0, tex->Height - 1);
+    const int x1 = ImGui_ImplSoftRaster_ClampInt((fx >> 16) + 1, 0, tex->Width - 1);
+    const int y1 = ImGui_ImplSoftRaster_ClampInt((fy >> 16) + 1, 0, tex->Height - 1);
+    ImU32 top = ImGui_ImplSoftRaster_FetchTexel(tex, x0, y0);
+    if (wx != 0)
+        top = ImGui_ImplSoftRaster_LerpColors(top, ImGui_ImplSoftRaster_FetchTexel(tex, x1, y0), wx);
+    if (wy == 0)
+        return top;
+    ImU32 bottom = ImGui_ImplSoftRaster_FetchTexel(tex, x0, y1);
+    if (wx != 0)
+        bottom = ImGui_ImplSoftRaster_LerpColors(bottom, ImGui_ImplSoftRaster_FetchTexel(tex, x1, y1), wx);
+    return ImGui_ImplSoftRaster_LerpColors(top, bottom, wy);
+}
+
+static inline ImU32 ImGui_ImplSoftRaster_SampleTextureUV(const ImGui_ImplSoftRaster_Texture* tex, ImVec2 uv)
+{
+    if (tex == nullptr)
+        return 0xFFFFFFFF;
+    return ImGui_ImplSoftRaster_SampleTexture(tex, ImGui_ImplSoftRaster_TexelToFixed(uv.x * (float)tex->Width - 0.5f), ImGui_ImplSoftRaster_TexelToFixed(uv.y * (float)tex->Height - 0.5f));
+}
+
+//-----------------------------------------------------------------------------
+// Rasterization
+//-----------------------------------------------------------------------------
+
+// Positions are snapped to 1/256th of a pixel (8 bits of sub-pixel precision, same as most GPUs)
+static inline ImS64 ImGui_ImplSoftRaster_ToFixed(float v)
+{
+    v = v < -65536.0f ? -65536.0f : v > 65536.0f ? 65536.0f : v;
+    return (ImS64)floorf(v * 256.0f + 0.5f);
+}
+
+static inline ImS64 ImGui_ImplSoftRaster_FloorDiv(ImS64 a, ImS64 b) // b > 0
+{
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+static inline ImS64 ImGui_ImplSoftRaster_CeilDiv(ImS64 a, ImS64 b) // b > 0
+{
+    return -ImGui_ImplSoftRaster_FloorDiv(-a, b);
+}
+
+static inline ImU32* ImGui_ImplSoftRaster_GetRow(const ImGui_ImplSoftRaster_Target* target, int y)
+{
+    return (ImU32*)(void*)(target->Pixels + (size_t)y * (size_t)target->Pitch);
+}
+
+// Axis-aligned rectangle with UV linearly mapped along each axis and a single color
+static void ImGui_ImplSoftRaster_RasterQuad(const ImGui_ImplSoftRaster_Target* target, float x0, float y0, float x1, float y1, ImVec2 uv0, ImVec2 uv1, ImU32 col)
+{
+    if (x1 < x0) { float tmp = x0; x0 = x1; x1 = tmp; tmp = uv0.x; uv0.x = uv1.x; uv1.x = tmp; }
+    if (y1 < y0) { float tmp = y0; y0 = y1; y1 = tmp; tmp = uv0.y; uv0.y = uv1.y; uv1.y = tmp; }
+
+    // Pixels whose center is in [x0,x1) x [y0,y1): same coverage as the 2 triangles would have
+    const int px0 = (int)ImGui_ImplSoftRaster_ClampInt((int)ImGui_ImplSoftRaster_CeilDiv(ImGui_ImplSoftRaster_ToFixed(x0) - 128, 256), target->ClipX0, target->ClipX1);
+    const int px1 = (int)ImGui_ImplSoftRaster_ClampInt((int)ImGui_ImplSoftRaster_CeilDiv(ImGui_ImplSoftRaster_ToFixed(x1) - 128, 256), target->ClipX0, target->ClipX1);
+    const int py0 = (int)ImGui_ImplSoftRaster_ClampInt((int)ImGui_ImplSoftRaster_CeilDiv(ImGui_ImplSoftRaster_ToFixed(y0) - 128, 256), target->ClipY0, target->ClipY1);
+    const int py1 = (int)ImGui_ImplSoftRaster_ClampInt((int)ImGui_ImplSoftRaster_CeilDiv(ImGui_ImplSoftRaster_ToFixed(y1) - 128, 256), target->ClipY0, target->ClipY1);
+    if (px0 >= px1 || py0 >= py1)
+        return;
+    const int count = px1 - px0;
+
+    // Constant UV (e.g. filled rectangles sampling the font atlas white pixel): sample once
+    const ImGui_ImplSoftRaster_Texture* tex = target->Texture;
+    if (tex == nullptr || (uv0.x == uv1.x && uv0.y == uv1.y))
+    {
+        const ImU32 fill_col = ImGui_ImplSoftRaster_MulColors(ImGui_ImplSoftRaster_SampleTextureUV(tex, uv0), col);
+        if (((fill_col >> IM_COL32_A_SHIFT) & 0xFF) == 0)
+            return;
+        for (int py = py0; py < py1; py++)
+            ImGui_ImplSoftRaster_FillSpan(ImGui_ImplSoftRaster_GetRow(target, py) + px0, count, fill_col);
+        return;
+    }
+
+    // Texel coordinates at pixel centers, stepped in 16.16 fixed point along the row
+    const float u_step = (uv1.x - uv0.x) * (float)tex->Width / (x1 - x0);
+    const float v_step = (uv1.y - uv0.y) * (float)tex->Height / (y1 - y0);
+    const int fu_start = ImGui_ImplSoftRaster_TexelToFixed(uv0.x * (float)tex->Width + ((float)px0 + 0.5f - x0) * u_step - 0.5f);
+    const int fu_step = ImGui_ImplSoftRaster_TexelToFixed(u_step);
+    ImU32* row_buf = target->RowBuffer;
+    for (int py = py0; py < py1; py++)
+    {
+        const int fv = ImGui_ImplSoftRaster_TexelToFixed(uv0.y * (float)tex->Height + ((float)py + 0.5f - y0) * v_step - 0.5f);
+        int fu = fu_start;
+        for (int n = 0; n < count; n++, fu += fu_step)
+            row_buf[n] = ImGui_ImplSoftRaster_MulColors(ImGui_ImplSoftRaster_SampleTexture(tex, fu, fv), col);
+        ImGui_ImplSoftRaster_BlendSpan(ImGui_ImplSoftRaster_GetRow(target, py) + px0, row_buf, count);
+    }
+}
+
+// Attribute plane equation: value at (x,y) = a0 + ddx * (x - x0) + ddy * (y - y0)
+static inline void ImGui_ImplSoftRaster_GetGradients(float a0, float a1, float a2, float e1x, float e1y, float e2x, float e2y, float inv_area, float* out_ddx, float* out_ddy)
+{
+    *out_ddx = ((a1 - a0) * e2y - (a2 - a0) * e1y) * inv_area;
+    *out_ddy = ((a2 - a0) * e1x - (a1 - a0) * e2x) * inv_area;
+}
+
+// Generic triangle. Vertices positions are in framebuffer space.
+static void ImGui_ImplSoftRaster_RasterTriangle(const ImGui_ImplSoftRaster_Target* target, const ImDrawVert* v0, const ImDrawVert* v1, const ImDrawVert* v2)
+{
+    ImS64 x[3] = { ImGui_ImplSoftRaster_ToFixed(v0->pos.x), ImGui_ImplSoftRaster_ToFixed(v1->pos.x), ImGui_ImplSoftRaster_ToFixed(v2->pos.x) };
+    ImS64 y[3] = { ImGui_ImplSoftRaster_ToFixed(v0->pos.y), ImGui_ImplSoftRaster_ToFixed(v1->pos.y), ImGui_ImplSoftRaster_ToFixed(v2->pos.y) };
+    ImS64 area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (area == 0)
+        return;
+    if (area < 0)
+    {
+        // Normalize winding so that inside == all edge functions positive
+        const ImDrawVert* tmp_v = v1; v1 = v2; v2 = tmp_v;
+        ImS64 tmp = x[1]; x[1] = x[2]; x[2] = tmp;
+        tmp = y[1]; y[1] = y[2]; y[2] = tmp;
+        area = -area;
+    }
+
+    // Bounding box of covered pixel centers, clipped
+    ImS64 min_x = x[0], max_x = x[0], min_y = y[0], max_y = y[0];
+    for (int n = 1; n < 3; n++)
+    {
+        min_x = (x[n] < min_x) ? x[n] : min_x; max_x = (x[n] > max_x) ? x[n] : max_x;
+        min_y = (y[n] < min_y) ? y[n] : min_y; max_y = (y[n] > max_y) ? y[n] : max_y;
+    }
+    const int bx0 = ImGui_ImplSoftRaster_ClampInt((int)ImGui_ImplSoftRaster_CeilDiv(min_x - 128, 256), target->ClipX0, target->ClipX1);
+    const int bx1 = ImGui_ImplSoftRaster_ClampInt((int)ImGui_ImplSoftRaster_FloorDiv(max_x - 128, 256) + 1, target->ClipX0, target->ClipX1);
+    const int by0 = ImGui_ImplSoftRaster_ClampInt((int)ImGui_ImplSoftRaster_CeilDiv(min_y - 128, 256), target->ClipY0, target->ClipY1);
+    const int by1 = ImGui_ImplSoftRaster_ClampInt((int)ImGui_ImplSoftRaster_FloorDiv(max_y - 128, 256) + 1, target->ClipY0, target->ClipY1);
+    if (bx0 >= bx1 || by0 >= by1)
+        return;
+
+    // Edge functions E(px,py) = dx * (py - ya) - dy * (px - xa), evaluated at pixel centers.
+    // Pixels exactly on an edge belong to the triangle for which that edge goes up (or right when horizontal), never to both.
+    struct Edge { ImS64 Dx, Dy, Xa, Ya; bool Inclusive; };
+    Edge edges[3];
+    for (int n = 0; n < 3; n++)
+    {
+        const int next = (n + 1) % 3;
+        Edge& e = edges[n];
+        e.Dx = x[next] - x[n];
+        e.Dy = y[next] - y[n];
+        e.Xa = x[n];
+        e.Ya = y[n];
+        e.Inclusive = (e.Dy < 0) || (e.Dy == 0 && e.Dx > 0);
+    }
+
+    // Interpolated attributes: UV in texel units, then colors channels (in byte order)
+    const ImGui_ImplSoftRaster_Texture* tex = target->Texture;
+    const bool uv_const = (tex == nullptr) || (v0->uv.x == v1->uv.x && v0->uv.x == v2->uv.x && v0->uv.y == v1->uv.y && v0->uv.y == v2->uv.y);
+    const bool col_const = (v0->col == v1->col && v0->col == v2->col);
+    const ImU32 const_texel = uv_const ? ImGui_ImplSoftRaster_SampleTextureUV(tex, v0->uv) : 0;
+    const ImU32 flat_col = (uv_const && col_const) ? ImGui_ImplSoftRaster_MulColors(const_texel, v0->col) : 0;
+    if (uv_const && col_const && ((flat_col >> IM_COL32_A_SHIFT) & 0xFF) == 0)
+        return;
+
+    const float x0f = (float)x[0] / 256.0f, y0f = (float)y[0] / 256.0f;
+    const float e1x = (float)(x[1] - x[0]) / 256.0f, e1y = (float)(y[1] - y[0]) / 256.0f;
+    const float e2x = (float)(x[2] - x[0]) / 256.0f, e2y = (float)(y[2] - y[0]) / 256.0f;
+    const float inv_area = 65536.0f / (float)area;
+    float attr0[6], ddx[6], ddy[6];
+    const int attr_first = uv_const ? 2 : 0;
+    const int attr_last = col_const ? 2 : 6;
+    if (!uv_const)
+    {
+        attr0[0] = v0->uv.x * (float)tex->Width - 0.5f;
+        attr0[1] = v0->uv.y * (float)tex->Height - 0.5f;
+        ImGui_ImplSoftRaster_GetGradients(attr0[0], v1->uv.x * (float)tex->Width - 0.5f, v2->uv.x * (float)tex->Width - 0.5f, e1x, e1y, e2x, e2y, inv_area, &ddx[0], &ddy[0]);
+        ImGui_ImplSoftRaster_GetGradients(attr0[1], v1->uv.y * (float)tex->Height - 0.5f, v2->uv.y * (float)tex->Height - 0.5f, e1x, e1y, e2x, e2y, inv_area, &ddx[1], &ddy[1]);
+    }
+    if (!col_const)
+        for (int c = 0; c < 4; c++)
+        {
+            attr0[2 + c] = (float)((v0->col >> (c * 8)) & 0xFF);
+            ImGui_ImplSoftRaster_GetGradients(attr0[2 + c], (float)((v1->col >> (c * 8)) & 0xFF), (float)((v2->col >> (c * 8)) & 0xFF), e1x, e1y, e2x, e2y, inv_area, &ddx[2 + c], &ddy[2 + c]);
+        }
+
+    ImU32* row_buf = target->RowBuffer;
+    for (int py = by0; py < by1; py++)
+    {
+        // Solve each edge function for the range of covered pixels in this row
+        const ImS64 cy = (ImS64)py * 256 + 128;
+        ImS64 span_x0 = bx0, span_x1 = bx1;
+        for (const Edge& e : edges)
+        {
+            const ImS64 k = e.Dx * (cy - e.Ya) - e.Dy * (128 - e.Xa); // E(px) = k - 256 * Dy * px
+            if (e.Dy > 0)
+            {
+                const ImS64 last = e.Inclusive ? ImGui_ImplSoftRaster_FloorDiv(k, e.Dy * 256) : ImGui_ImplSoftRaster_CeilDiv(k, e.Dy * 256) - 1;
+                if (last + 1 < span_x1)
+                    span_x1 = last + 1;
+            }
+            else if (e.Dy < 0)
+            {
+                const ImS64 first = e.Inclusive ? ImGui_ImplSoftRaster_CeilDiv(-k, -e.Dy * 256) : ImGui_ImplSoftRaster_FloorDiv(-k, -e.Dy * 256) + 1;
+                if (first > span_x0)
+                    span_x0 = first;
+            }
+            else if (k < 0 || (k == 0 && !e.Inclusive))
+            {
+                span_x1 = span_x0;
+            }
+        }
+        if (span_x0 >= span_x1)
+            continue;
+        const int px0 = (int)span_x0;
+        const int count = (int)(span_x1 - span_x0);
+        ImU32* dst = ImGui_ImplSoftRaster_GetRow(target, py) + px0;
+        if (uv_const && col_const)
+        {
+            ImGui_ImplSoftRaster_FillSpan(dst, count, flat_col);
+            continue;
+        }
+
+        // Step attributes along the span
+        float attr[6];
+        const float dx = (float)px0 + 0.5f - x0f;
+        const float dy = (float)py + 0.5f - y0f;
+        for (int a = attr_first; a < attr_last; a++)
+            attr[a] = attr0[a] + ddx[a] * dx + ddy[a] * dy;
+        for (int n = 0; n < count; n++)
+        {
+            ImU32 col = v0->col;
+            if (!col_const)
+            {
+                col = 0;
+                for (int c = 0; c < 4; c++)
+                    col |= (ImU32)ImGui_ImplSoftRaster_ClampInt((int)(attr[2 + c] + 0.5f), 0, 255) << (c * 8);
+            }
+            const ImU32 texel = uv_const ? const_texel : ImGui_ImplSoftRaster_SampleTexture(tex, ImGui_ImplSoftRaster_TexelToFixed(attr[0]), ImGui_ImplSoftRaster_TexelToFixed(attr[1]));
+            row_buf[n] = ImGui_ImplSoftRaster_MulColors(texel, col);
+            for (int a = attr_first; a < attr_last; a++)
+                attr[a] += ddx[a];
+        }
+        ImGui_ImplSoftRaster_BlendSpan(dst, row_buf, count);
+    }
+}
+
+// Two triangles (a,b,c) + (a,c,d) forming an axis-aligned rectangle with axis-aligned UV and a single color, as output by PrimRect()/PrimRectUV()
+static bool ImGui_ImplSoftRaster_IsAxisAlignedQuad(const ImDrawVert& a, const ImDrawVert& b, const ImDrawVert& c, const ImDrawVert& d)
+{
+    return a.pos.y == b.pos.y && b.pos.x == c.pos.x && c.pos.y == d.pos.y && d.pos.x == a.pos.x
+        && a.uv.y == b.uv.y && b.uv.x == c.uv.x && c.uv.y == d.uv.y && d.uv.x == a.uv.x
+        && a.col == b.col && a.col == c.col && a.col == d.col;
+}
+
+void ImGui_ImplSoftRaster_RenderDrawData(ImDrawData* draw_data, void* pixels, int width, int height, int pitch)
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoftRaster_Init()?");
+    IM_ASSERT(pixels != nullptr && pitch >= width * 4);
+
+    // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
+    int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    if (fb_width <= 0 || fb_height <= 0)
+        return;
+
+    // Catch up with texture updates. Most of the times, the list will have 1 element with an OK status, aka nothing to do.
+    // (This almost always points to ImGui::GetPlatformIO().Textures[] but is part of ImDrawData to allow overriding or disabling texture updates).
+    if (draw_data->Textures != nullptr)
+        for (ImTextureData* tex : *draw_data->Textures)
+            if (tex->Status != ImTextureStatus_OK)
+                ImGui_ImplSoftRaster_UpdateTexture(tex);
+
+    // Only touch pixels which are both in the framebuffer and in the user buffer
+    if (fb_width > width)
+        fb_width = width;
+    if (fb_height > height)
+        fb_height = height;
+    if (fb_width <= 0 || fb_height <= 0)
+        return;
+    bd->RowBuffer.resize(fb_width);
+
+    // Setup render state structure (for callbacks and custom texture bindings)
+    ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
+    ImGui_ImplSoftRaster_RenderState render_state;
+    render_state.Pixels = pixels;
+    render_state.Width = width;
+    render_state.Height = height;
+    render_state.Pitch = pitch;
+    platform_io.Renderer_RenderState = &render_state;
+
+    ImGui_ImplSoftRaster_Target target;
+    target.Pixels = (unsigned char*)pixels;
+    target.Pitch = pitch;
+    target.RowBuffer = bd->RowBuffer.Data;
+
+    // Will project scissor/clipping rectangles into framebuffer space
+    ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+    ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+
+    // Render command lists
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &draw_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback)
+            {
+                // User callback, registered via ImDrawList::AddCallback()
+                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(draw_list, pcmd);
+                continue;
+            }
+
+            // Project scissor/clipping rectangles into framebuffer space
+            ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+            ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+            if (clip_min.x < 0.0f) { clip_min.x = 0.0f; }
+            if (clip_min.y < 0.0f) { clip_min.y = 0.0f; }
+            if (clip_max.x > (float)fb_width) { clip_max.x = (float)fb_width; }
+            if (clip_max.y > (float)fb_height) { clip_max.y = (float)fb_height; }
+            if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
+                continue;
+            target.ClipX0 = (int)clip_min.x;
+            target.ClipY0 = (int)clip_min.y;
+            target.ClipX1 = target.ClipX0 + (int)(clip_max.x - clip_min.x);
+            target.ClipY1 = target.ClipY0 + (int)(clip_max.y - clip_min.y);
+            target.Texture = (const ImGui_ImplSoftRaster_Texture*)(intptr_t)pcmd->GetTexID();
+
+            // Triangles
+            const ImDrawVert* vtx_buffer = draw_list->VtxBuffer.Data + pcmd->VtxOffset;
+            const ImDrawIdx* idx_buffer = draw_list->IdxBuffer.Data + pcmd->IdxOffset;
+            for (unsigned int idx_n = 0; idx_n + 3 <= pcmd->ElemCount; )
+            {
+                const ImDrawIdx* idx = idx_buffer + idx_n;
+                if (idx_n + 6 <= pcmd->ElemCount && idx[3] == idx[0] && idx[4] == idx[2])
+                {
+                    const ImDrawVert& a = vtx_buffer[idx[0]];
+                    const ImDrawVert& c = vtx_buffer[idx[2]];
+                    if (ImGui_ImplSoftRaster_IsAxisAlignedQuad(a, vtx_buffer[idx[1]], c, vtx_buffer[idx[5]]))
+                    {
+                        ImGui_ImplSoftRaster_RasterQuad(&target,
+                            (a.pos.x - clip_off.x) * clip_scale.x, (a.pos.y - clip_off.y) * clip_scale.y,
+                            (c.pos.x - clip_off.x) * clip_scale.x, (c.pos.y - clip_off.y) * clip_scale.y,
+                            a.uv, c.uv, a.col);
+                        idx_n += 6;
+                        continue;
+                    }
+                }
+                ImDrawVert tri[3];
+                for (int n = 0; n < 3; n++)
+                {
+                    tri[n] = vtx_buffer[idx[n]];
+                    tri[n].pos.x = (tri[n].pos.x - clip_off.x) * clip_scale.x;
+                    tri[n].pos.y = (tri[n].pos.y - clip_off.y) * clip_scale.y;
+                }
+                ImGui_ImplSoftRaster_RasterTriangle(&target, &tri[0], &tri[1], &tri[2]);
+                idx_n += 3;
+            }
+
+            // Instanced quads are drawn after the triangles of the same command
+            const ImDrawQuad* quad_buffer = draw_list->QuadBuffer.Data + pcmd->QuadOffset;
+            for (unsigned int quad_n = 0; quad_n < pcmd->QuadCount; quad_n++)
+            {
+                const ImDrawQuad& q = quad_buffer[quad_n];
+                ImGui_ImplSoftRaster_RasterQuad(&target,
+                    (q.Pos.x - clip_off.x) * clip_scale.x, (q.Pos.y - clip_off.y) * clip_scale.y,
+                    (q.Pos.x + q.Size.x - clip_off.x) * clip_scale.x, (q.Pos.y + q.Size.y - clip_off.y) * clip_scale.y,
+                    q.UvMin, q.UvMax, q.Col);
+            }
+        }
+    }
+    platform_io.Renderer_RenderState = nullptr;
+}
+
+static void ImGui_ImplSoftRaster_CopyTextureRect(ImGui_ImplSoftRaster_Texture* backend_tex, ImTextureData* tex, int x, int y, int w, int h)
+{
+    for (int row = 0; row < h; row++)
+    {
+        unsigned char* dst = (unsigned char*)backend_tex->Pixels + (size_t)(y + row) * (size_t)backend_tex->Pitch + (size_t)x * (size_t)backend_tex->BytesPerPixel;
+        memcpy(dst, tex->GetPixelsAt(x, y + row), (size_t)w * (size_t)backend_tex->BytesPerPixel);
+#ifdef IMGUI_USE_BGRA_PACKED_COLOR
+        // ImTextureFormat_RGBA32 is R,G,B,A in memory, our texels are IM_COL32() values
+        if (backend_tex->BytesPerPixel == 4)
+            for (int n = 0; n < w; n++)
+            {
+                unsigned char tmp = dst[n * 4 + 0];
+                dst[n * 4 + 0] = dst[n * 4 + 2];
+                dst[n * 4 + 2] = tmp;
+            }
+#endif
+    }
+}
+
+void ImGui_ImplSoftRaster_UpdateTexture(ImTextureData* tex)
+{
+    if (tex->Status == ImTextureStatus_WantCreate)
+    {
+        // Create texture: texture storage directly follows the ImGui_ImplSoftRaster_Texture header in a single allocation
+        //IMGUI_DEBUG_LOG("UpdateTexture #%03d: WantCreate %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
+        IM_ASSERT(tex->TexID == 0 && tex->BackendUserData == nullptr);
+        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32 || tex->Format == ImTextureFormat_Alpha8);
+        const int bytes_per_pixel = tex->BytesPerPixel;
+        ImGui_ImplSoftRaster_Texture* backend_tex = (ImGui_ImplSoftRaster_Texture*)IM_ALLOC(sizeof(ImGui_ImplSoftRaster_Texture) + (size_t)tex->Width * (size_t)tex->Height * (size_t)bytes_per_pixel);
+        backend_tex->Pixels = (void*)(backend_tex + 1);
+        backend_tex->Width = tex->Width;
+        backend_tex->Height = tex->Height;
+        backend_tex->Pitch = tex->Width * bytes_per_pixel;
+        backend_tex->BytesPerPixel = bytes_per_pixel;
+        ImGui_ImplSoftRaster_CopyTextureRect(backend_tex, tex, 0, 0, tex->Width, tex->Height);
+
+        // Store identifiers
+        tex->SetTexID((ImTextureID)(intptr_t)backend_tex);
+        tex->BackendUserData = backend_tex;
+        tex->SetStatus(ImTextureStatus_OK);
+    }
+    else if (tex->Status == ImTextureStatus_WantUpdates)
+    {
+        // Update selected blocks. We only ever write to textures regions which have never been used before!
+        // This backend choose to use tex->Updates[] but you can use tex->UpdateRect to upload a single region.
+        ImGui_ImplSoftRaster_Texture* backend_tex = (ImGui_ImplSoftRaster_Texture*)tex->BackendUserData;
+        for (ImTextureRect& r : tex->Updates)
+            ImGui_ImplSoftRaster_CopyTextureRect(backend_tex, tex, r.x, r.y, r.w, r.h);
+        tex->SetStatus(ImTextureStatus_OK);
+    }
+    else if (tex->Status == ImTextureStatus_WantDestroy)
+    {
+        if (ImGui_ImplSoftRaster_Texture* backend_tex = (ImGui_ImplSoftRaster_Texture*)tex->BackendUserData)
+            IM_FREE(backend_tex);
+
+        // Clear identifiers and mark as destroyed (in order to allow e.g. calling InvalidateDeviceObjects while running)
+        tex->SetTexID(ImTextureID_Invalid);
+        tex->BackendUserData = nullptr;
+        tex->SetStatus(ImTextureStatus_Destroyed);
+    }
+}
+
+void ImGui_ImplSoftRaster_CreateDeviceObjects()
+{
+}
+
+void ImGui_ImplSoftRaster_DestroyDeviceObjects()
+{
+    // Destroy all textures
+    for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
+        if (tex->RefCount == 1)
+        {
+            tex->SetStatus(ImTextureStatus_WantDestroy);
+            ImGui_ImplSoftRaster_UpdateTexture(tex);
+        }
+}
+
+//-----------------------------------------------------------------------------
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+
+#endif // #ifndef IMGUI_DISABLE
@@ -0,0 +1,67 @@
+// dear imgui: Renderer Backend for a CPU software rasterizer
+// This needs to be used along with a Platform Backend (e.g. Android, SDL, Win32) or standalone for headless rendering.
+
+// Rasterizes ImDrawData into a 32-bit pixel buffer that you own: no GPU, no graphics API, no external dependency.
+// Use cases: headless screenshot generation, pixel-exact regression tests and benchmarks on CI machines without a GPU,
+// and a fallback path for devices with broken or missing OpenGL ES drivers (blit the buffer with e.g. ANativeWindow_lock()).
+// Output is deterministic for a given ImDrawData on all platforms, whichever of the SSE2/NEON/scalar code paths gets compiled.
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftRaster_Texture*' as texture identifier. Read the FAQ about ImTextureID/ImTextureRef!
+//  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
+//  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
+//  [X] Renderer: Single-channel textures support (ImGuiBackendFlags_RendererHasTexAlpha8).
+//  [X] Renderer: Instanced quads support (ImGuiBackendFlags_RendererHasInstancedQuads).
+//  [X] Renderer: Expose selected render state for draw callbacks to use. Access in '(ImGui_ImplXXXX_RenderState*)GetPlatformIO().Renderer_RenderState'.
+
+// You can copy and use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
+// Learn about Dear ImGui:
+// - FAQ                  https://dearimgui.com/faq
+// - Getting Started      https://dearimgui.com/getting-started
+// - Documentation        https://dearimgui.com/docs (same as your local docs/ folder).
+// - Introduction, links and more at the top of imgui.cpp
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+#ifndef IMGUI_DISABLE
+
+// Follow "Getting Started" link and check examples/ folder to learn about using backends!
+// - Output pixels are 32-bit IM_COL32() values (R,G,B,A bytes in memory by default), top row first. 'pitch' is in bytes.
+// - Pixels are blended over the existing contents of the buffer: clear it yourself beforehand.
+// - The buffer doesn't need to match the framebuffer size (DisplaySize * FramebufferScale): anything outside of it is clipped.
+IMGUI_IMPL_API bool     ImGui_ImplSoftRaster_Init();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_NewFrame();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_RenderDrawData(ImDrawData* draw_data, void* pixels, int width, int height, int pitch);
+
+// Called by Init/NewFrame/Shutdown
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_CreateDeviceObjects();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_DestroyDeviceObjects();
+
+// (Advanced) Use e.g. if you need to precisely control the timing of texture updates (e.g. for staged rendering), by setting ImDrawData::Textures = NULL to handle this manually.
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_UpdateTexture(ImTextureData* tex);
+
+// Texture identifier: to display your own image, fill one of those and pass its address as ImTextureID, e.g. 'ImGui::Image((ImTextureID)(intptr_t)&my_texture, size)'.
+// Pixels are sampled with bilinear filtering and clamp-to-edge addressing. The memory needs to stay valid until the frame is rendered.
+struct ImGui_ImplSoftRaster_Texture
+{
+    const void*     Pixels;
+    int             Width;
+    int             Height;
+    int             Pitch;          // In bytes
+    int             BytesPerPixel;  // 4: IM_COL32() values, 1: alpha only (sampled as white + alpha)
+};
+
+// [BETA] Selected render state data shared with callbacks.
+// This is temporarily stored in GetPlatformIO().Renderer_RenderState during the ImGui_ImplSoftRaster_RenderDrawData() call.
+// (Please open an issue if you feel you need access to more data)
+struct ImGui_ImplSoftRaster_RenderState
+{
+    void*           Pixels;
+    int             Width;
+    int             Height;
+    int             Pitch;
+};
+
+#endif // #ifndef IMGUI_DISABLE
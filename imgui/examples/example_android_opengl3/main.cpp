@@ -7,18 +7,27 @@
 // - Introduction, links and more at the top of imgui.cpp
 
 #include "imgui.h"
+#include "imgui_internal.h"
 #include "imgui_impl_android.h"
 #include "imgui_impl_opengl3.h"
+#include "imgui_impl_softraster.h"
 #include <android/log.h>
 #include <android_native_app_glue.h>
 #include <android/asset_manager.h>
 #include <EGL/egl.h>
+#include <EGL/eglext.h>
 #include <GLES3/gl3.h>
 #include <string>
 #include <vector>
 #include <algorithm>
 #include <random>
 #include <ctime>
+#include <cmath>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 // Data
 static EGLDisplay           g_EglDisplay = EGL_NO_DISPLAY;
@@ -28,14 +37,61 @@ static struct android_app*  g_App = nullptr;
 static bool                 g_Initialized = false;
 static char                 g_LogTag[] = "ImGuiExample";
 static std::string          g_IniFilename = "";
+static std::string          g_FontCacheFilename = "";
+static int                  g_RedrawFrames = 0;         // Frames to render before the main loop is allowed to block again
+static double               g_NextRedrawTime = 0.0;     // Monotonic time at which a displayed countdown changes (0.0 = none)
+
+// Partial redraw: only clear and redraw regions which changed since the back buffer was last presented
+static ImDrawDamageTracker  g_DamageTracker;
+static bool                 g_EglHasBufferAge = false;  // EGL_EXT_buffer_age: tells how many frames old the back buffer contents are
+static PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC g_EglSwapBuffersWithDamage = nullptr; // EGL_KHR/EXT_swap_buffers_with_damage: tells compositor what changed
+
+// Concatenate all windows into as few draw lists/draw calls as possible: draw call overhead dominates on tiled mobile GPUs
+static ImDrawDataMerger     g_DrawDataMerger;
+
+// Fallback for devices where OpenGL ES can't be initialized (e.g. broken drivers): rasterize on the CPU into the window buffer
+static bool                 g_UseSoftwareRenderer = false;
+
+// Helper threads running ParallelFor() jobs along with the main thread, started in Init() and joined in Shutdown()
+struct WorkerPool
+{
+    std::vector<std::thread>    Threads;
+    std::mutex                  Mutex;
+    std::condition_variable     WakeCond;               // Signaled when a batch is submitted or on quit
+    std::condition_variable     DoneCond;               // Signaled when the last busy helper leaves a batch
+    void                        (*JobFn)(void* job_data, int job_n) = nullptr;
+    void*                       JobData = nullptr;
+    int                         JobsCount = 0;          // 0 when no batch is in progress
+    std::atomic<int>            NextJob{0};
+    int                         BatchIndex = 0;         // Incremented for every batch, so helpers know when there is a new one
+    int                         BusyCount = 0;          // Helpers currently running jobs of the batch
+    bool                        Quit = false;
+};
+static WorkerPool           g_WorkerPool;
+
+// Timed exam settings
+static bool                 g_TimedExam = false;
+static const double         g_QuestionTimeLimit = 30.0; // Seconds per question
+static const double         g_ExamTimeLimit = 240.0;    // Seconds for the whole exam
+static double               g_ExamStartTime = 0.0;      // Monotonic time at which the exam countdown started
+static double               g_QuestionStartTime = 0.0;  // Monotonic time at which the current question was shown
+static double               g_QuizHiddenTime = 0.0;     // Monotonic time at which the quiz window was hidden (0.0 = shown): countdowns are paused meanwhile
 
 // Forward declarations of helper functions
 static void Init(struct android_app* app);
 static void Shutdown();
+static void ShutdownEgl();
 static void MainLoopStep();
 static int ShowSoftKeyboardInput();
 static int PollUnicodeChars();
 static int GetAssetData(const char* filename, void** out_data);
+static double GetMonotonicTime();
+static void WorkerPoolStart();
+static void WorkerPoolStop();
+static void ParallelFor(ImGuiContext* ctx, void (*job_fn)(void* job_data, int job_n), void* job_data, int jobs_count);
+static void GetFramebufferRect(const ImDrawData* draw_data, const ImVec4& rect, EGLint out_rect[4]);
+static int GetPollTimeout();
+static void RenderSoftware(ImDrawData* draw_data, const ImVec4& clear_color);
 
 // Main code
 static void handleAppCmd(struct android_app* app, int32_t appCmd)
@@ -52,12 +108,18 @@ static void handleAppCmd(struct android_app* app, int32_t appCmd)
         break;
     case APP_CMD_GAINED_FOCUS:
     case APP_CMD_LOST_FOCUS:
+    case APP_CMD_WINDOW_RESIZED:
+    case APP_CMD_WINDOW_REDRAW_NEEDED:
+    case APP_CMD_CONFIG_CHANGED:
+        g_RedrawFrames = 3;
         break;
     }
 }
 
 static int32_t handleInputEvent(struct android_app* app, AInputEvent* inputEvent)
 {
+    // Dear ImGui needs a few frames to settle after an input (e.g. hover, then press, then release)
+    g_RedrawFrames = 3;
     return ImGui_ImplAndroid_HandleInputEvent(inputEvent);
 }
 
@@ -72,7 +134,8 @@ void android_main(struct android_app* app)
         struct android_poll_source* out_data;
 
         // Poll all events. If the app is not visible, this loop blocks until g_Initialized == true.
-        while (ALooper_pollOnce(g_Initialized ? 0 : -1, nullptr, &out_events, (void**)&out_data) >= 0)
+        // Once visible, it only blocks until the next input event or the next countdown change (see GetPollTimeout()).
+        while (ALooper_pollOnce(GetPollTimeout(), nullptr, &out_events, (void**)&out_data) >= 0)
         {
             // Process one event
             if (out_data != nullptr)
@@ -134,7 +197,30 @@ void Init(struct android_app* app)
             __android_log_print(ANDROID_LOG_ERROR, g_LogTag, "%s", "eglCreateContext() returned EGL_NO_CONTEXT");
 
         g_EglSurface = eglCreateWindowSurface(g_EglDisplay, egl_config, g_App->window, nullptr);
-        eglMakeCurrent(g_EglDisplay, g_EglSurface, g_EglSurface, g_EglContext);
+        if (g_EglSurface == EGL_NO_SURFACE)
+            __android_log_print(ANDROID_LOG_ERROR, g_LogTag, "%s", "eglCreateWindowSurface() returned EGL_NO_SURFACE");
+        else if (eglMakeCurrent(g_EglDisplay, g_EglSurface, g_EglSurface, g_EglContext) != EGL_TRUE)
+            __android_log_print(ANDROID_LOG_ERROR, g_LogTag, "%s", "eglMakeCurrent() returned with an error");
+
+        // Optional extensions for partial redraw
+        const char* egl_extensions = eglQueryString(g_EglDisplay, EGL_EXTENSIONS);
+        g_EglHasBufferAge = (egl_extensions != nullptr && strstr(egl_extensions, "EGL_EXT_buffer_age") != nullptr);
+        g_EglSwapBuffersWithDamage = nullptr;
+        if (egl_extensions != nullptr && strstr(egl_extensions, "EGL_KHR_swap_buffers_with_damage") != nullptr)
+            g_EglSwapBuffersWithDamage = (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC)eglGetProcAddress("eglSwapBuffersWithDamageKHR");
+        else if (egl_extensions != nullptr && strstr(egl_extensions, "EGL_EXT_swap_buffers_with_damage") != nullptr)
+            g_EglSwapBuffersWithDamage = (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC)eglGetProcAddress("eglSwapBuffersWithDamageEXT");
+        g_DamageTracker.Clear();
+    }
+
+    // Fall back to the software renderer when OpenGL ES is unusable.
+    // EGL needs to let go of the window before we can lock its buffers ourselves.
+    g_UseSoftwareRenderer = (g_EglContext == EGL_NO_CONTEXT || g_EglSurface == EGL_NO_SURFACE || eglGetCurrentContext() != g_EglContext);
+    if (g_UseSoftwareRenderer)
+    {
+        __android_log_print(ANDROID_LOG_WARN, g_LogTag, "%s", "OpenGL ES initialization failed, using software renderer");
+        ShutdownEgl();
+        ANativeWindow_setBuffersGeometry(g_App->window, 0, 0, WINDOW_FORMAT_RGBA_8888);
     }
 
     // Setup Dear ImGui context
@@ -147,13 +233,38 @@ void Init(struct android_app* app)
     g_IniFilename = std::string(app->activity->internalDataPath) + "/imgui.ini";
     io.IniFilename = g_IniFilename.c_str();;
 
+    // Reuse glyphs rasterized by previous launches instead of rasterizing them again at startup.
+    g_FontCacheFilename = std::string(app->activity->internalDataPath) + "/imgui_fonts.cache";
+    io.FontCacheFilename = g_FontCacheFilename.c_str();
+
+    // Rasterize batches of new glyphs (e.g. the first time a question in a new script is displayed) on several cores.
+    WorkerPoolStart();
+    ImGui::GetPlatformIO().Platform_ParallelForFn = ParallelFor;
+
     // Setup Dear ImGui style
     ImGui::StyleColorsDark();
     //ImGui::StyleColorsLight();
 
     // Setup Platform/Renderer backends
     ImGui_ImplAndroid_Init(g_App->window);
-    ImGui_ImplOpenGL3_Init("#version 300 es");
+    if (g_UseSoftwareRenderer)
+    {
+        ImGui_ImplSoftRaster_Init();
+    }
+    else
+    {
+        ImGui_ImplOpenGL3_Init("#version 300 es");
+        ImGui_ImplOpenGL3_EnableStateOwnership(true); // We own the whole GL context: no need to backup/restore GL state every frame
+        ImGui_ImplOpenGL3_SetProgramBinaryCacheDir(app->activity->internalDataPath); // Reuse linked shader program across launches and context loss
+        ImGui_ImplOpenGL3_EnableInstancedQuads(true); // Text and plain rectangles as one instanced quad each, instead of 4 vertices + 6 indices
+    }
+
+    // Store the font atlas as a single-channel texture when the renderer supports it (1/4 of the memory and upload bandwidth)
+    if (io.BackendFlags & ImGuiBackendFlags_RendererHasTexAlpha8)
+        io.Fonts->TexDesiredFormat = ImTextureFormat_Alpha8;
+
+    // Questions come in many scripts and sizes over a long kiosk session: evict glyphs of past questions instead of letting the atlas grow forever
+    io.Fonts->TexMemoryBudget = 4 * 1024 * 1024;
 
     // Load Fonts
     // - If no fonts are loaded, dear imgui will use the default font. You can also load multiple fonts and use ImGui::PushFont()/PopFont() to select them.
@@ -192,6 +303,7 @@ void Init(struct android_app* app)
     ImGui::GetStyle().ScaleAllSizes(3.0f);
 
     g_Initialized = true;
+    g_RedrawFrames = 3;
 }
 
 
@@ -599,7 +711,9 @@ void ShowQuizWindow(bool* p_open, ImFont* bigFont)
     static int currentQuestion = 0;
     static std::vector<int> selectedOption;  // user selections
     static std::vector<bool> showFeedback;   // feedback per question
+    static std::vector<double> answerTime;   // seconds from question shown to answer, -1.0 if unanswered
     static bool quizFinished = false;
+    const double now = GetMonotonicTime();
 
     // Initialize random 10-question quiz once
     if (!initialized)
@@ -618,9 +732,38 @@ void ShowQuizWindow(bool* p_open, ImFont* bigFont)
         // Initialize user data
         selectedOption.assign(10, -1);
         showFeedback.assign(10, false);
+        answerTime.assign(10, -1.0);
+        g_ExamStartTime = g_QuestionStartTime = now;
         initialized = true;
     }
 
+    // Timed exam: auto-advance on timeout, and schedule the next redraw for when the displayed countdown changes
+    double questionTimeLeft = g_QuestionTimeLimit - (now - g_QuestionStartTime);
+    double examTimeLeft = g_ExamTimeLimit - (now - g_ExamStartTime);
+    if (g_TimedExam && !quizFinished)
+    {
+        if (examTimeLeft <= 0.0)
+        {
+            quizFinished = true;
+        }
+        else if (questionTimeLeft <= 0.0)
+        {
+            if (currentQuestion < 10 - 1)
+                currentQuestion++;
+            else
+                quizFinished = true;
+            g_QuestionStartTime = now;
+            questionTimeLeft = g_QuestionTimeLimit;
+        }
+        if (!quizFinished)
+        {
+            // Countdowns are displayed in whole seconds rounded up, so they change when crossing the next integer below
+            double questionNextChange = questionTimeLeft - (ceil(questionTimeLeft) - 1.0);
+            double examNextChange = examTimeLeft - (ceil(examTimeLeft) - 1.0);
+            g_NextRedrawTime = now + (questionNextChange < examNextChange ? questionNextChange : examNextChange);
+        }
+    }
+
     ImGui::SetNextWindowPos(ImVec2(100, 100), ImGuiCond_Always);
     ImGui::SetNextWindowSize(ImVec2(900, 800), ImGuiCond_Always);
     ImGui::Begin("##quiz", p_open, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoTitleBar);
@@ -631,6 +774,13 @@ void ShowQuizWindow(bool* p_open, ImFont* bigFont)
     {
         QuizQuestion& q = quiz[examIndices[currentQuestion]];
 
+        if (g_TimedExam)
+        {
+            int examSecondsLeft = (int)ceil(examTimeLeft);
+            ImGui::TextColored(ImVec4(1,1,0,1), "Q%d/10  Time left: %ds  (Exam %d:%02d)", currentQuestion + 1, (int)ceil(questionTimeLeft), examSecondsLeft / 60, examSecondsLeft % 60);
+            ImGui::Separator();
+        }
+
         // Question text with wrapping
         ImGui::PushTextWrapPos(880); // slightly less than window width
         ImGui::TextColored(ImVec4(1,0,0,1), "%s", q.question);
@@ -652,7 +802,10 @@ void ShowQuizWindow(bool* p_open, ImFont* bigFont)
             if (!showFeedback[currentQuestion])
             {
                 if (ImGui::RadioButton(q.options[i], &selectedOption[currentQuestion], i))
+                {
                     showFeedback[currentQuestion] = true;
+                    answerTime[currentQuestion] = now - g_QuestionStartTime;
+                }
             }
             else
             {
@@ -670,11 +823,14 @@ void ShowQuizWindow(bool* p_open, ImFont* bigFont)
                 currentQuestion++;
             else
                 quizFinished = true;
+            g_QuestionStartTime = now;
         }
     }
     else
     {
         int totalCorrect = 0;
+        int totalAnswered = 0;
+        double totalAnswerTime = 0.0;
         ImGui::TextColored(ImVec4(0,1,0,1), "Quiz Complete!");
         ImGui::Separator();
 
@@ -687,6 +843,16 @@ void ShowQuizWindow(bool* p_open, ImFont* bigFont)
             ImGui::PushTextWrapPos(880);
             ImGui::TextColored(ImVec4(1,1,0,1), "Q%d: %s", i+1, q.question);
             ImGui::PopTextWrapPos();
+            if (answerTime[i] >= 0.0)
+            {
+                ImGui::Text("  Answered in %.3f s", answerTime[i]);
+                totalAnswered++;
+                totalAnswerTime += answerTime[i];
+            }
+            else
+            {
+                ImGui::TextColored(ImVec4(1,0,0,1), "  Not answered");
+            }
 
             for (int j = 0; j < 4; j++)
             {
@@ -703,6 +869,8 @@ void ShowQuizWindow(bool* p_open, ImFont* bigFont)
 
         ImGui::Text("Total Correct: %d / 10", totalCorrect);
         ImGui::Text("Average: %.2f%%", totalCorrect * 10.0f); // 10 questions → each 10%
+        if (totalAnswered > 0)
+            ImGui::Text("Average answer time: %.3f s", totalAnswerTime / totalAnswered);
 
         if (ImGui::Button("Restart Quiz"))
         {
@@ -724,7 +892,7 @@ void ShowQuizWindow(bool* p_open, ImFont* bigFont)
 void MainLoopStep()
 {
     ImGuiIO& io = ImGui::GetIO();
-    if (g_EglDisplay == EGL_NO_DISPLAY)
+    if (g_EglDisplay == EGL_NO_DISPLAY && !g_UseSoftwareRenderer)
         return;
 
     static bool show_demo_window = true;
@@ -733,6 +901,10 @@ void MainLoopStep()
     static bool font_initialized = false;
     static ImFont* bigFont = nullptr;
 
+    if (g_RedrawFrames > 0)
+        g_RedrawFrames--;
+    g_NextRedrawTime = 0.0;
+
     // --- Setup large font (only once) ---
     if (!font_initialized)
     {
@@ -750,8 +922,15 @@ void MainLoopStep()
         ShowSoftKeyboardInput();
     WantTextInputLast = io.WantTextInput;
 
+    // Keep redrawing while a text field is active so the cursor blinks
+    if (io.WantTextInput)
+        g_RedrawFrames = 1;
+
     // Start the Dear ImGui frame
-    ImGui_ImplOpenGL3_NewFrame();
+    if (g_UseSoftwareRenderer)
+        ImGui_ImplSoftRaster_NewFrame();
+    else
+        ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplAndroid_NewFrame();
     ImGui::NewFrame();
 
@@ -768,12 +947,28 @@ void MainLoopStep()
 	    ImGui::SetNextWindowPos(ImVec2(150, 1600), ImGuiCond_Always);    // position (x=100, y=50)
 	    ImGui::SetNextWindowSize(ImVec2(800, 600), ImGuiCond_Always);  // size (width=800, height=600)
 
+	    // Mostly static panel: reuse last frame vertices for everything submitted before the first item which changed
+	    ImGui::SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags_RetainDrawList);
 	    ImGui::Begin("Hacker Space Weekend Project 1.0",
 	                 nullptr,
 	                 ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
 
 	    // Your existing content
-	    ImGui::Checkbox("LinuxCommandsMCQ", &show_another_window);
+	    if (ImGui::Checkbox("LinuxCommandsMCQ", &show_another_window))
+	    {
+	        // Pause quiz countdowns while the quiz window is hidden: shift their start times by the time spent hidden
+	        const double now = GetMonotonicTime();
+	        if (!show_another_window)
+	            g_QuizHiddenTime = now;
+	        else if (g_QuizHiddenTime != 0.0)
+	        {
+	            g_ExamStartTime += now - g_QuizHiddenTime;
+	            g_QuestionStartTime += now - g_QuizHiddenTime;
+	            g_QuizHiddenTime = 0.0;
+	        }
+	    }
+	    if (ImGui::Checkbox("Timed exam", &g_TimedExam) && g_TimedExam)
+	        g_ExamStartTime = g_QuestionStartTime = (g_QuizHiddenTime != 0.0) ? g_QuizHiddenTime : GetMonotonicTime(); // Start both countdowns from now (or from when they were paused)
 
 
 	    ImGui::Text("All coding is released under GPLv2.");
@@ -785,6 +980,7 @@ void MainLoopStep()
 
 	    ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
 	                1000.0f / io.Framerate, io.Framerate);
+	    ImGui::Text("Draw calls: %d (%d before merging)", g_DrawDataMerger.DrawCallsAfter, g_DrawDataMerger.DrawCallsBefore);
 	    ImGui::End();
 	}
 
@@ -827,14 +1023,61 @@ void MainLoopStep()
 
     // Rendering
     ImGui::Render();
+    ImDrawData* draw_data = ImGui::GetDrawData();
+    if (g_UseSoftwareRenderer)
+    {
+        RenderSoftware(draw_data, clear_color);
+        return;
+    }
+
+    // Find which regions need to be redrawn into the back buffer, based on how old its contents are
+    // (without EGL_EXT_buffer_age, contents are undefined and everything is redrawn)
+    static ImVector<ImVec4> redraw_rects;
+    EGLint buffer_age = 0;
+    if (g_EglHasBufferAge)
+        eglQuerySurface(g_EglDisplay, g_EglSurface, EGL_BUFFER_AGE_EXT, &buffer_age);
+    g_DamageTracker.Update(draw_data);
+    const bool partial_redraw = g_DamageTracker.GetDamageForBufferAge(buffer_age, &redraw_rects);
+    g_DrawDataMerger.Merge(draw_data); // After damage tracking, which identifies commands by draw list index
+
     glViewport(0, 0, (int)io.DisplaySize.x, (int)io.DisplaySize.y);
     glClearColor(clear_color.x * clear_color.w,
                  clear_color.y * clear_color.w,
                  clear_color.z * clear_color.w,
                  clear_color.w);
-    glClear(GL_COLOR_BUFFER_BIT);
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-    eglSwapBuffers(g_EglDisplay, g_EglSurface);
+    if (partial_redraw)
+    {
+        glEnable(GL_SCISSOR_TEST);
+        for (const ImVec4& rect : redraw_rects)
+        {
+            EGLint fb_rect[4];
+            GetFramebufferRect(draw_data, rect, fb_rect);
+            glScissor(fb_rect[0], fb_rect[1], fb_rect[2], fb_rect[3]);
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+        glDisable(GL_SCISSOR_TEST);
+        if (!redraw_rects.empty())
+            ImGui_ImplOpenGL3_RenderDrawDataRegions(draw_data, redraw_rects.Data, redraw_rects.Size);
+    }
+    else
+    {
+        glClear(GL_COLOR_BUFFER_BIT);
+        ImGui_ImplOpenGL3_RenderDrawData(draw_data);
+    }
+
+    // Tell the compositor what changed since the previous frame
+    if (g_EglSwapBuffersWithDamage != nullptr && !g_DamageTracker.FullDamage && g_DamageTracker.DamageRects.Size > 0)
+    {
+        ImVector<EGLint> swap_rects;
+        swap_rects.resize(g_DamageTracker.DamageRects.Size * 4);
+        for (int n = 0; n < g_DamageTracker.DamageRects.Size; n++)
+            GetFramebufferRect(draw_data, g_DamageTracker.DamageRects[n], &swap_rects[n * 4]);
+        g_EglSwapBuffersWithDamage(g_EglDisplay, g_EglSurface, swap_rects.Data, g_DamageTracker.DamageRects.Size);
+    }
+    else
+    {
+        eglSwapBuffers(g_EglDisplay, g_EglSurface);
+    }
 }
 
 
@@ -844,10 +1087,24 @@ void Shutdown()
         return;
 
     // Cleanup
-    ImGui_ImplOpenGL3_Shutdown();
+    if (g_UseSoftwareRenderer)
+        ImGui_ImplSoftRaster_Shutdown();
+    else
+        ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplAndroid_Shutdown();
+    g_DrawDataMerger.ClearFreeMemory();
     ImGui::DestroyContext();
+    WorkerPoolStop();
 
+    ShutdownEgl();
+    ANativeWindow_release(g_App->window);
+
+    g_UseSoftwareRenderer = false;
+    g_Initialized = false;
+}
+
+static void ShutdownEgl()
+{
     if (g_EglDisplay != EGL_NO_DISPLAY)
     {
         eglMakeCurrent(g_EglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
@@ -864,13 +1121,46 @@ void Shutdown()
     g_EglDisplay = EGL_NO_DISPLAY;
     g_EglContext = EGL_NO_CONTEXT;
     g_EglSurface = EGL_NO_SURFACE;
-    ANativeWindow_release(g_App->window);
-
-    g_Initialized = false;
 }
 
 // Helper functions
 
+// Convert a rectangle in ImDrawCmd::ClipRect coordinates to a (x, y, width, height) framebuffer rectangle with bottom-left origin, as used by glScissor() and EGL.
+// Expanded to whole pixels (floor min, ceil max) exactly like ImGui_ImplOpenGL3_RenderDrawDataRegions() does, so that cleared and redrawn pixels match.
+static void GetFramebufferRect(const ImDrawData* draw_data, const ImVec4& rect, EGLint out_rect[4])
+{
+    const int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    const int x0 = (int)floorf((rect.x - draw_data->DisplayPos.x) * draw_data->FramebufferScale.x);
+    const int x1 = (int)ceilf((rect.z - draw_data->DisplayPos.x) * draw_data->FramebufferScale.x);
+    const int y0 = fb_height - (int)ceilf((rect.w - draw_data->DisplayPos.y) * draw_data->FramebufferScale.y);
+    const int y1 = fb_height - (int)floorf((rect.y - draw_data->DisplayPos.y) * draw_data->FramebufferScale.y);
+    out_rect[0] = (EGLint)x0;
+    out_rect[1] = (EGLint)y0;
+    out_rect[2] = (EGLint)(x1 - x0);
+    out_rect[3] = (EGLint)(y1 - y0);
+}
+
+// Clear the window buffer and rasterize into it with the CPU. WINDOW_FORMAT_RGBA_8888 has the same byte order as IM_COL32().
+// Unlike the OpenGL ES path, everything is redrawn: we only render after an input or a countdown change anyway.
+static void RenderSoftware(ImDrawData* draw_data, const ImVec4& clear_color)
+{
+    ANativeWindow_Buffer buffer;
+    if (ANativeWindow_lock(g_App->window, &buffer, nullptr) != 0)
+        return;
+    if (buffer.format == WINDOW_FORMAT_RGBA_8888 || buffer.format == WINDOW_FORMAT_RGBX_8888)
+    {
+        const ImU32 clear_col = ImGui::ColorConvertFloat4ToU32(ImVec4(clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w));
+        for (int y = 0; y < buffer.height; y++)
+        {
+            ImU32* row = (ImU32*)buffer.bits + y * buffer.stride;
+            for (int x = 0; x < buffer.width; x++)
+                row[x] = clear_col;
+        }
+        ImGui_ImplSoftRaster_RenderDrawData(draw_data, buffer.bits, buffer.width, buffer.height, buffer.stride * 4);
+    }
+    ANativeWindow_unlockAndPost(g_App->window);
+}
+
 // Unfortunately, there is no way to show the on-screen input from native code.
 // Therefore, we call ShowSoftKeyboardInput() of the main activity implemented in MainActivity.kt via JNI.
 static int ShowSoftKeyboardInput()
@@ -940,6 +1230,111 @@ static int PollUnicodeChars()
     return 0;
 }
 
+// Monotonic clock in seconds with nanosecond resolution, unaffected by wall clock changes.
+static double GetMonotonicTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+static void WorkerPoolRunJobs(WorkerPool& pool)
+{
+    for (int n = pool.NextJob++; n < pool.JobsCount; n = pool.NextJob++)
+        pool.JobFn(pool.JobData, n);
+}
+
+static void WorkerPoolThread()
+{
+    WorkerPool& pool = g_WorkerPool;
+    std::unique_lock<std::mutex> lock(pool.Mutex);
+    int batch_index = pool.BatchIndex;
+    while (true)
+    {
+        pool.WakeCond.wait(lock, [&]() { return pool.Quit || pool.BatchIndex != batch_index; });
+        if (pool.Quit)
+            return;
+        batch_index = pool.BatchIndex;
+        if (pool.JobsCount == 0) // Woke up after the batch was completed
+            continue;
+        pool.BusyCount++;
+        lock.unlock();
+        WorkerPoolRunJobs(pool);
+        lock.lock();
+        if (--pool.BusyCount == 0)
+            pool.DoneCond.notify_one();
+    }
+}
+
+// Start up to 3 helper threads: along with the calling one, jobs run on up to 4 cores.
+static void WorkerPoolStart()
+{
+    const int helpers_count = std::min((int)std::thread::hardware_concurrency(), 4) - 1;
+    for (int n = 0; n < helpers_count; n++)
+        g_WorkerPool.Threads.emplace_back(WorkerPoolThread);
+}
+
+static void WorkerPoolStop()
+{
+    WorkerPool& pool = g_WorkerPool;
+    {
+        std::lock_guard<std::mutex> lock(pool.Mutex);
+        pool.Quit = true;
+    }
+    pool.WakeCond.notify_all();
+    for (std::thread& thread : pool.Threads)
+        thread.join();
+    pool.Threads.clear();
+    pool.Quit = false;
+}
+
+// Run jobs on the calling thread and the worker pool. Used by Dear ImGui to rasterize glyphs.
+// Batches may be as small as 2 glyphs, so helper threads are kept around rather than spawned for each batch.
+static void ParallelFor(ImGuiContext*, void (*job_fn)(void* job_data, int job_n), void* job_data, int jobs_count)
+{
+    WorkerPool& pool = g_WorkerPool;
+    if (pool.Threads.empty() || jobs_count < 2)
+    {
+        for (int n = 0; n < jobs_count; n++)
+            job_fn(job_data, n);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pool.Mutex);
+        pool.JobFn = job_fn;
+        pool.JobData = job_data;
+        pool.JobsCount = jobs_count;
+        pool.NextJob = 0;
+        pool.BatchIndex++;
+    }
+    pool.WakeCond.notify_all();
+    WorkerPoolRunJobs(pool);
+
+    // All jobs have been picked: wait for helpers to finish theirs, then close the batch so late helpers skip it
+    std::unique_lock<std::mutex> lock(pool.Mutex);
+    pool.DoneCond.wait(lock, [&]() { return pool.BusyCount == 0; });
+    pool.JobsCount = 0;
+    pool.JobFn = nullptr;
+    pool.JobData = nullptr;
+}
+
+// How long the main loop may block in ALooper_pollOnce(), in milliseconds (-1 = until the next event).
+// We only render when something may have changed: after input/app events, or when a countdown display changes.
+static int GetPollTimeout()
+{
+    if (!g_Initialized)
+        return -1;
+    if (g_RedrawFrames > 0)
+        return 0;
+    if (g_NextRedrawTime > 0.0)
+    {
+        double wait = g_NextRedrawTime - GetMonotonicTime();
+        return wait > 0.0 ? (int)ceil(wait * 1000.0) : 0;
+    }
+    return -1;
+}
+
 // Helper to retrieve data placed into the assets/ directory (android/app/src/main/assets)
 static int GetAssetData(const char* filename, void** outData)
 {
@@ -72,7 +72,7 @@ CODE
 // [SECTION] MISC HELPERS/UTILITIES (Color functions)
 // [SECTION] ImGuiStorage
 // [SECTION] ImGuiTextFilter
-// [SECTION] ImGuiTextBuffer, ImGuiTextIndex
+// [SECTION] ImGuiTextBuffer, ImGuiTextIndex, ImGuiTextSizeCache
 // [SECTION] ImGuiListClipper
 // [SECTION] STYLING
 // [SECTION] RENDER HELPERS
@@ -1252,6 +1252,10 @@ static const ImVec2 TOOLTIP_DEFAULT_OFFSET_MOUSE = ImVec2(16, 10);      // Multi
 static const ImVec2 TOOLTIP_DEFAULT_OFFSET_TOUCH = ImVec2(0, -20);      // Multiplied by g.Style.MouseCursorScale
 static const ImVec2 TOOLTIP_DEFAULT_PIVOT_TOUCH = ImVec2(0.5f, 1.0f);   // Multiplied by g.Style.MouseCursorScale
 
+// CalcTextSize() cache (when io.ConfigTextSizeCache is enabled)
+static const int TEXT_SIZE_CACHE_UNUSED_FRAMES  = 60;       // Evict entries unused for this many frames when the cache needs room.
+static const int TEXT_SIZE_CACHE_MAX_ENTRIES    = 16384;    // Beyond this amount of recently used entries, evict all those not used during the current frame.
+
 //-------------------------------------------------------------------------
 // [SECTION] FORWARD DECLARATIONS
 //-------------------------------------------------------------------------
@@ -1519,6 +1523,7 @@ ImGuiIO::ImGuiIO()
     DeltaTime = 1.0f / 60.0f;
     IniSavingRate = 5.0f;
     IniFilename = "imgui.ini"; // Important: "imgui.ini" is relative to current working dir, most apps will want to lock this to an absolute path (e.g. same path as executables).
+    FontCacheFilename = NULL;
     LogFilename = "imgui_log.txt";
     UserData = NULL;
 
@@ -1554,6 +1559,7 @@ ImGuiIO::ImGuiIO()
     ConfigWindowsMoveFromTitleBarOnly = false;
     ConfigWindowsCopyContentsWithCtrlC = false;
     ConfigScrollbarScrollByPage = true;
+    ConfigTextSizeCache = false;
     ConfigMemoryCompactTimer = 60.0f;
     ConfigDebugIsDebuggerPresent = false;
     ConfigDebugHighlightIdConflicts = true;
@@ -2439,6 +2445,47 @@ bool    ImFileClose(ImFileHandle f)     { return fclose(f) == 0; }
 ImU64   ImFileGetSize(ImFileHandle f)   { long off = 0, sz = 0; return ((off = ftell(f)) != -1 && !fseek(f, 0, SEEK_END) && (sz = ftell(f)) != -1 && !fseek(f, off, SEEK_SET)) ? (ImU64)sz : (ImU64)-1; }
 ImU64   ImFileRead(void* data, ImU64 sz, ImU64 count, ImFileHandle f)           { return fread(data, (size_t)sz, (size_t)count, f); }
 ImU64   ImFileWrite(const void* data, ImU64 sz, ImU64 count, ImFileHandle f)    { return fwrite(data, (size_t)sz, (size_t)count, f); }
+
+// Used to replace a file with a fully written temporary file, so a crash while writing doesn't leave a truncated file behind.
+// The replacement is atomic with POSIX rename() and with MoveFileExW() within a NTFS volume.
+bool    ImFileRename(const char* old_filename, const char* new_filename)
+{
+#if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS)
+    // Windows rename() fails if destination exists, and doesn't handle UTF-8 filenames
+    const int old_wsize = ::MultiByteToWideChar(CP_UTF8, 0, old_filename, -1, NULL, 0);
+    const int new_wsize = ::MultiByteToWideChar(CP_UTF8, 0, new_filename, -1, NULL, 0);
+    wchar_t local_temp_stack[FILENAME_MAX];
+    ImVector<wchar_t> local_temp_heap;
+    if (old_wsize + new_wsize > IM_ARRAYSIZE(local_temp_stack))
+        local_temp_heap.resize(old_wsize + new_wsize);
+    wchar_t* old_wbuf = local_temp_heap.Data ? local_temp_heap.Data : local_temp_stack;
+    wchar_t* new_wbuf = old_wbuf + old_wsize;
+    ::MultiByteToWideChar(CP_UTF8, 0, old_filename, -1, old_wbuf, old_wsize);
+    ::MultiByteToWideChar(CP_UTF8, 0, new_filename, -1, new_wbuf, new_wsize);
+    return ::MoveFileExW(old_wbuf, new_wbuf, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+#ifdef _WIN32
+    remove(new_filename); // Not atomic
+#endif
+    return rename(old_filename, new_filename) == 0;
+#endif
+}
+
+bool    ImFileRemove(const char* filename)
+{
+#if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS)
+    const int filename_wsize = ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, NULL, 0);
+    wchar_t local_temp_stack[FILENAME_MAX];
+    ImVector<wchar_t> local_temp_heap;
+    if (filename_wsize > IM_ARRAYSIZE(local_temp_stack))
+        local_temp_heap.resize(filename_wsize);
+    wchar_t* filename_wbuf = local_temp_heap.Data ? local_temp_heap.Data : local_temp_stack;
+    ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, filename_wbuf, filename_wsize);
+    return ::DeleteFileW(filename_wbuf) != 0;
+#else
+    return remove(filename) == 0;
+#endif
+}
 #endif // #ifndef IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS
 
 // Helper: Load file content into memory
@@ -2544,14 +2591,171 @@ int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char*
     return wanted;
 }
 
+// Same as ImTextCharFromUtf8() with a fast path for ASCII and well-formed 2 and 3 bytes sequences (anything else, including all errors, is handled by the former).
+// Reading s[1] then s[2] is safe without 'in_text_end': a zero terminator fails the continuation byte test before we read past it.
+static inline int ImTextCharFromUtf8_inline(unsigned int* out_char, const char* in_text, const char* in_text_end)
+{
+    const unsigned char* s = (const unsigned char*)in_text;
+    const unsigned int c0 = s[0];
+    if (c0 < 0x80)
+    {
+        *out_char = c0;
+        return 1;
+    }
+    const ptrdiff_t avail = in_text_end ? in_text_end - in_text : 4;
+    if (c0 >= 0xC2 && c0 < 0xE0 && avail >= 2 && (s[1] & 0xC0) == 0x80)
+    {
+        *out_char = ((c0 & 0x1F) << 6) | (s[1] & 0x3F);
+        return 2;
+    }
+    if ((c0 & 0xF0) == 0xE0 && avail >= 3 && (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80)
+    {
+        const unsigned int c = ((c0 & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+        if (c >= 0x800 && (c < 0xD800 || c > 0xDFFF)) // Otherwise non-canonical encoding or surrogate half
+        {
+            *out_char = c;
+            return 3;
+        }
+    }
+    return ImTextCharFromUtf8(out_char, in_text, in_text_end);
+}
+
+// Bulk conversion helpers: process blocks of 16 ASCII characters (0x01..0x7F, as a zero terminates strings) at a time.
+// Return false without writing anything if the block contains any other value, for the caller to process it one character at a time.
+#if defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)
+#define IM_TEXT_ASCII_BLOCK_SIZE    16
+
+// Read 16 UTF-8 bytes from 'in_text', write 16 ImWchar to 'out_buf' (if not NULL).
+static inline bool ImTextAsciiBlockFromUtf8(ImWchar* out_buf, const char* in_text)
+{
+#if defined(IMGUI_ENABLE_SSE)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)in_text);
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(v, zero)) != 0xFFFF) // As signed bytes, 0x80..0xFF are negative
+        return false;
+    if (out_buf == NULL)
+        return true;
+    const __m128i lo = _mm_unpacklo_epi8(v, zero);
+    const __m128i hi = _mm_unpackhi_epi8(v, zero);
+#ifdef IMGUI_USE_WCHAR32
+    _mm_storeu_si128((__m128i*)(void*)(out_buf + 0), _mm_unpacklo_epi16(lo, zero));
+    _mm_storeu_si128((__m128i*)(void*)(out_buf + 4), _mm_unpackhi_epi16(lo, zero));
+    _mm_storeu_si128((__m128i*)(void*)(out_buf + 8), _mm_unpacklo_epi16(hi, zero));
+    _mm_storeu_si128((__m128i*)(void*)(out_buf + 12), _mm_unpackhi_epi16(hi, zero));
+#else
+    _mm_storeu_si128((__m128i*)(void*)(out_buf + 0), lo);
+    _mm_storeu_si128((__m128i*)(void*)(out_buf + 8), hi);
+#endif
+#else
+    const uint8x16_t v = vld1q_u8((const uint8_t*)(const void*)in_text);
+    const uint64x2_t ok = vreinterpretq_u64_u8(vcltq_u8(vsubq_u8(v, vdupq_n_u8(1)), vdupq_n_u8(0x7F)));
+    if ((vgetq_lane_u64(ok, 0) & vgetq_lane_u64(ok, 1)) != ~(uint64_t)0)
+        return false;
+    if (out_buf == NULL)
+        return true;
+    const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+    const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+#ifdef IMGUI_USE_WCHAR32
+    vst1q_u32((uint32_t*)(void*)(out_buf + 0), vmovl_u16(vget_low_u16(lo)));
+    vst1q_u32((uint32_t*)(void*)(out_buf + 4), vmovl_u16(vget_high_u16(lo)));
+    vst1q_u32((uint32_t*)(void*)(out_buf + 8), vmovl_u16(vget_low_u16(hi)));
+    vst1q_u32((uint32_t*)(void*)(out_buf + 12), vmovl_u16(vget_high_u16(hi)));
+#else
+    vst1q_u16((uint16_t*)(void*)(out_buf + 0), lo);
+    vst1q_u16((uint16_t*)(void*)(out_buf + 8), hi);
+#endif
+#endif
+    return true;
+}
+
+// Read 16 ImWchar from 'in_text', write 16 UTF-8 bytes to 'out_buf' (if not NULL).
+static inline bool ImTextAsciiBlockToUtf8(char* out_buf, const ImWchar* in_text)
+{
+#if defined(IMGUI_ENABLE_SSE)
+    // As signed integers, characters >= 0x8000 (or >= 0x80000000) are negative
+#ifdef IMGUI_USE_WCHAR32
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi32(0x80);
+    const __m128i v0 = _mm_loadu_si128((const __m128i*)(const void*)(in_text + 0));
+    const __m128i v1 = _mm_loadu_si128((const __m128i*)(const void*)(in_text + 4));
+    const __m128i v2 = _mm_loadu_si128((const __m128i*)(const void*)(in_text + 8));
+    const __m128i v3 = _mm_loadu_si128((const __m128i*)(const void*)(in_text + 12));
+    __m128i ok = _mm_and_si128(_mm_cmpgt_epi32(v0, zero), _mm_cmplt_epi32(v0, max));
+    ok = _mm_and_si128(ok, _mm_and_si128(_mm_cmpgt_epi32(v1, zero), _mm_cmplt_epi32(v1, max)));
+    ok = _mm_and_si128(ok, _mm_and_si128(_mm_cmpgt_epi32(v2, zero), _mm_cmplt_epi32(v2, max)));
+    ok = _mm_and_si128(ok, _mm_and_si128(_mm_cmpgt_epi32(v3, zero), _mm_cmplt_epi32(v3, max)));
+    if (_mm_movemask_epi8(ok) != 0xFFFF)
+        return false;
+    if (out_buf != NULL)
+        _mm_storeu_si128((__m128i*)(void*)out_buf, _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3)));
+#else
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16(0x80);
+    const __m128i v0 = _mm_loadu_si128((const __m128i*)(const void*)(in_text + 0));
+    const __m128i v1 = _mm_loadu_si128((const __m128i*)(const void*)(in_text + 8));
+    __m128i ok = _mm_and_si128(_mm_cmpgt_epi16(v0, zero), _mm_cmplt_epi16(v0, max));
+    ok = _mm_and_si128(ok, _mm_and_si128(_mm_cmpgt_epi16(v1, zero), _mm_cmplt_epi16(v1, max)));
+    if (_mm_movemask_epi8(ok) != 0xFFFF)
+        return false;
+    if (out_buf != NULL)
+        _mm_storeu_si128((__m128i*)(void*)out_buf, _mm_packus_epi16(v0, v1));
+#endif
+#else
+    // (c - 1) < 0x7F as unsigned integers
+#ifdef IMGUI_USE_WCHAR32
+    const uint32x4_t one = vdupq_n_u32(1);
+    const uint32x4_t max = vdupq_n_u32(0x7F);
+    const uint32x4_t v0 = vld1q_u32((const uint32_t*)(const void*)(in_text + 0));
+    const uint32x4_t v1 = vld1q_u32((const uint32_t*)(const void*)(in_text + 4));
+    const uint32x4_t v2 = vld1q_u32((const uint32_t*)(const void*)(in_text + 8));
+    const uint32x4_t v3 = vld1q_u32((const uint32_t*)(const void*)(in_text + 12));
+    uint32x4_t ok = vandq_u32(vcltq_u32(vsubq_u32(v0, one), max), vcltq_u32(vsubq_u32(v1, one), max));
+    ok = vandq_u32(ok, vandq_u32(vcltq_u32(vsubq_u32(v2, one), max), vcltq_u32(vsubq_u32(v3, one), max)));
+    const uint64x2_t ok64 = vreinterpretq_u64_u32(ok);
+    if ((vgetq_lane_u64(ok64, 0) & vgetq_lane_u64(ok64, 1)) != ~(uint64_t)0)
+        return false;
+    if (out_buf != NULL)
+        vst1q_u8((uint8_t*)(void*)out_buf, vcombine_u8(vmovn_u16(vcombine_u16(vmovn_u32(v0), vmovn_u32(v1))), vmovn_u16(vcombine_u16(vmovn_u32(v2), vmovn_u32(v3)))));
+#else
+    const uint16x8_t one = vdupq_n_u16(1);
+    const uint16x8_t max = vdupq_n_u16(0x7F);
+    const uint16x8_t v0 = vld1q_u16((const uint16_t*)(const void*)(in_text + 0));
+    const uint16x8_t v1 = vld1q_u16((const uint16_t*)(const void*)(in_text + 8));
+    const uint64x2_t ok64 = vreinterpretq_u64_u16(vandq_u16(vcltq_u16(vsubq_u16(v0, one), max), vcltq_u16(vsubq_u16(v1, one), max)));
+    if ((vgetq_lane_u64(ok64, 0) & vgetq_lane_u64(ok64, 1)) != ~(uint64_t)0)
+        return false;
+    if (out_buf != NULL)
+        vst1q_u8((uint8_t*)(void*)out_buf, vcombine_u8(vmovn_u16(v0), vmovn_u16(v1)));
+#endif
+#endif
+    return true;
+}
+#endif // #if defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)
+
 int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
 {
     ImWchar* buf_out = buf;
     ImWchar* buf_end = buf + buf_size;
+#ifdef IM_TEXT_ASCII_BLOCK_SIZE
+    const char* in_text_end_blocks = in_text_end ? in_text_end : in_text + ImStrlen(in_text); // Blocks may not be read past a zero terminator
+    const char* in_text_next_block = in_text;
+#endif
     while (buf_out < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
+#ifdef IM_TEXT_ASCII_BLOCK_SIZE
+        if (in_text >= in_text_next_block && in_text_end_blocks - in_text >= IM_TEXT_ASCII_BLOCK_SIZE && buf_end - 1 - buf_out >= IM_TEXT_ASCII_BLOCK_SIZE)
+        {
+            if (ImTextAsciiBlockFromUtf8(buf_out, in_text))
+            {
+                in_text += IM_TEXT_ASCII_BLOCK_SIZE;
+                buf_out += IM_TEXT_ASCII_BLOCK_SIZE;
+                continue;
+            }
+            in_text_next_block = in_text + IM_TEXT_ASCII_BLOCK_SIZE; // Process this block one character at a time
+        }
+#endif
         unsigned int c;
-        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        in_text += ImTextCharFromUtf8_inline(&c, in_text, in_text_end);
         *buf_out++ = (ImWchar)c;
     }
     *buf_out = 0;
@@ -2563,10 +2767,26 @@ int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const cha
 int ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end)
 {
     int char_count = 0;
+#ifdef IM_TEXT_ASCII_BLOCK_SIZE
+    const char* in_text_end_blocks = in_text_end ? in_text_end : in_text + ImStrlen(in_text); // Blocks may not be read past a zero terminator
+    const char* in_text_next_block = in_text;
+#endif
     while ((!in_text_end || in_text < in_text_end) && *in_text)
     {
+#ifdef IM_TEXT_ASCII_BLOCK_SIZE
+        if (in_text >= in_text_next_block && in_text_end_blocks - in_text >= IM_TEXT_ASCII_BLOCK_SIZE )
+        {
+            if (ImTextAsciiBlockFromUtf8(NULL, in_text))
+            {
+                in_text += IM_TEXT_ASCII_BLOCK_SIZE;
+                char_count += IM_TEXT_ASCII_BLOCK_SIZE;
+                continue;
+            }
+            in_text_next_block = in_text + IM_TEXT_ASCII_BLOCK_SIZE; // Process this block one character at a time
+        }
+#endif
         unsigned int c;
-        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        in_text += ImTextCharFromUtf8_inline(&c, in_text, in_text_end);
         char_count++;
     }
     return char_count;
@@ -2635,8 +2855,24 @@ int ImTextStrToUtf8(char* out_buf, int out_buf_size, const ImWchar* in_text, con
 {
     char* buf_p = out_buf;
     const char* buf_end = out_buf + out_buf_size;
+#ifdef IM_TEXT_ASCII_BLOCK_SIZE
+    const ImWchar* in_text_end_blocks = in_text_end ? in_text_end : in_text + ImStrlenW(in_text); // Blocks may not be read past a zero terminator
+    const ImWchar* in_text_next_block = in_text;
+#endif
     while (buf_p < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
+#ifdef IM_TEXT_ASCII_BLOCK_SIZE
+        if (in_text >= in_text_next_block && in_text_end_blocks - in_text >= IM_TEXT_ASCII_BLOCK_SIZE && buf_end - 1 - buf_p >= IM_TEXT_ASCII_BLOCK_SIZE)
+        {
+            if (ImTextAsciiBlockToUtf8(buf_p, in_text))
+            {
+                in_text += IM_TEXT_ASCII_BLOCK_SIZE;
+                buf_p += IM_TEXT_ASCII_BLOCK_SIZE;
+                continue;
+            }
+            in_text_next_block = in_text + IM_TEXT_ASCII_BLOCK_SIZE; // Process this block one character at a time
+        }
+#endif
         unsigned int c = (unsigned int)(*in_text++);
         if (c < 0x80)
             *buf_p++ = (char)c;
@@ -2650,8 +2886,24 @@ int ImTextStrToUtf8(char* out_buf, int out_buf_size, const ImWchar* in_text, con
 int ImTextCountUtf8BytesFromStr(const ImWchar* in_text, const ImWchar* in_text_end)
 {
     int bytes_count = 0;
+#ifdef IM_TEXT_ASCII_BLOCK_SIZE
+    const ImWchar* in_text_end_blocks = in_text_end ? in_text_end : in_text + ImStrlenW(in_text); // Blocks may not be read past a zero terminator
+    const ImWchar* in_text_next_block = in_text;
+#endif
     while ((!in_text_end || in_text < in_text_end) && *in_text)
     {
+#ifdef IM_TEXT_ASCII_BLOCK_SIZE
+        if (in_text >= in_text_next_block && in_text_end_blocks - in_text >= IM_TEXT_ASCII_BLOCK_SIZE )
+        {
+            if (ImTextAsciiBlockToUtf8(NULL, in_text))
+            {
+                in_text += IM_TEXT_ASCII_BLOCK_SIZE;
+                bytes_count += IM_TEXT_ASCII_BLOCK_SIZE;
+                continue;
+            }
+            in_text_next_block = in_text + IM_TEXT_ASCII_BLOCK_SIZE; // Process this block one character at a time
+        }
+#endif
         unsigned int c = (unsigned int)(*in_text++);
         if (c < 0x80)
             bytes_count++;
@@ -3011,7 +3263,7 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 }
 
 //-----------------------------------------------------------------------------
-// [SECTION] ImGuiTextBuffer, ImGuiTextIndex
+// [SECTION] ImGuiTextBuffer, ImGuiTextIndex, ImGuiTextSizeCache
 //-----------------------------------------------------------------------------
 
 // On some platform vsnprintf() takes va_list by reference and modifies it.
@@ -3095,6 +3347,97 @@ void ImGuiTextIndex::append(const char* base, int old_size, int new_size)
 }
 IM_MSVC_RUNTIME_CHECKS_RESTORE
 
+// Hash text contents 8 bytes at a time: several times faster than ImHashData() (CRC32), which would be as slow as measuring small texts.
+ImU64 ImGuiTextSizeCache::HashText(const char* text, int text_len)
+{
+    const ImU64 mul = 0xFF51AFD7ED558CCDULL;
+    ImU64 h = 0x9E3779B97F4A7C15ULL ^ (ImU64)text_len;
+    const char* p = text;
+    const char* p_end = text + text_len;
+    for (; p_end - p >= 8; p += 8)
+    {
+        ImU64 v;
+        memcpy(&v, p, 8);
+        h = (h ^ v) * mul;
+        h ^= h >> 32;
+    }
+    if (p < p_end)
+    {
+        ImU64 v = 0;
+        memcpy(&v, p, (size_t)(p_end - p));
+        h = (h ^ v) * mul;
+    }
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h != 0 ? h : 1; // 0 marks empty slots
+}
+
+ImGuiTextSizeCacheEntry* ImGuiTextSizeCache::Find(ImU64 text_hash, int text_len, ImFontBaked* baked, float font_size, float wrap_width)
+{
+    IM_ASSERT(text_hash != 0);
+    if (Entries.Size == 0)
+        return NULL;
+    const int mask = Entries.Size - 1;
+    for (int n = (int)(text_hash & (ImU64)mask); ; n = (n + 1) & mask) // Table is never more than half full so this terminates
+    {
+        ImGuiTextSizeCacheEntry* entry = &Entries.Data[n];
+        if (entry->TextHash == 0)
+            return NULL;
+        if (entry->TextHash == text_hash && entry->TextLen == text_len && entry->FontBaked == baked && entry->FontSize == font_size && entry->WrapWidth == wrap_width)
+            return entry;
+    }
+}
+
+void ImGuiTextSizeCache::Add(ImU64 text_hash, int text_len, ImFontBaked* baked, float font_size, float wrap_width, const ImVec2& size, int frame_count)
+{
+    IM_ASSERT(text_hash != 0);
+    if ((EntriesCount + 1) * 2 > Entries.Size)
+        Rebuild(frame_count);
+    const int mask = Entries.Size - 1;
+    int n = (int)(text_hash & (ImU64)mask);
+    while (Entries.Data[n].TextHash != 0)
+        n = (n + 1) & mask;
+    ImGuiTextSizeCacheEntry* entry = &Entries.Data[n];
+    entry->FontBaked = baked;
+    entry->TextHash = text_hash;
+    entry->TextLen = text_len;
+    entry->FontSize = font_size;
+    entry->WrapWidth = wrap_width;
+    entry->LastFrameUsed = frame_count;
+    entry->Size = size;
+    EntriesCount++;
+}
+
+// Called when the table is half full: evict entries which haven't been used recently, then resize so the table is at most a quarter full.
+void ImGuiTextSizeCache::Rebuild(int frame_count)
+{
+    int keep_frame = frame_count - TEXT_SIZE_CACHE_UNUSED_FRAMES;
+    int keep_count = 0;
+    for (const ImGuiTextSizeCacheEntry& entry : Entries)
+        if (entry.TextHash != 0 && entry.LastFrameUsed >= keep_frame)
+            keep_count++;
+    if (keep_count > TEXT_SIZE_CACHE_MAX_ENTRIES)
+    {
+        // Too many distinct texts measured recently: only keep those used during the current frame.
+        keep_frame = frame_count;
+        keep_count = 0;
+        for (const ImGuiTextSizeCacheEntry& entry : Entries)
+            if (entry.TextHash != 0 && entry.LastFrameUsed >= keep_frame)
+                keep_count++;
+    }
+
+    ImVector<ImGuiTextSizeCacheEntry> old_entries;
+    old_entries.swap(Entries);
+    Entries.resize(ImMax(ImUpperPowerOfTwo((keep_count + 1) * 4), 64));
+    memset(Entries.Data, 0, (size_t)Entries.size_in_bytes());
+    EvictedCount += EntriesCount - keep_count;
+    EntriesCount = 0;
+    for (const ImGuiTextSizeCacheEntry& entry : old_entries)
+        if (entry.TextHash != 0 && entry.LastFrameUsed >= keep_frame)
+            Add(entry.TextHash, entry.TextLen, entry.FontBaked, entry.FontSize, entry.WrapWidth, entry.Size, entry.LastFrameUsed);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiListClipper
 //-----------------------------------------------------------------------------
@@ -4214,6 +4557,8 @@ ImGuiContext::ImGuiContext(ImFontAtlas* shared_font_atlas)
 
     SettingsLoaded = false;
     SettingsDirtyTimer = 0.0f;
+    FontCacheLoaded = false;
+    FontCacheDirtyTimer = 0.0f;
     HookIdNext = 0;
 
     memset(LocalizationTable, 0, sizeof(LocalizationTable));
@@ -4329,6 +4674,10 @@ void ImGui::Shutdown()
     IM_ASSERT_USER_ERROR(g.IO.BackendPlatformUserData == NULL, "Forgot to shutdown Platform backend?");
     IM_ASSERT_USER_ERROR(g.IO.BackendRendererUserData == NULL, "Forgot to shutdown Renderer backend?");
 
+    // Save glyph cache before the atlas may be destroyed
+    if (g.FontCacheLoaded && g.IO.FontCacheFilename && g.IO.Fonts->GlyphCache && g.IO.Fonts->GlyphCache->Dirty)
+        ImFontAtlasGlyphCacheSaveToDisk(g.IO.Fonts, g.IO.FontCacheFilename);
+
     // The fonts atlas can be used prior to calling NewFrame(), so we clear it even if g.Initialized is FALSE (which would happen if we never called NewFrame)
     for (ImFontAtlas* atlas : g.FontAtlases)
     {
@@ -4392,6 +4741,7 @@ void ImGui::Shutdown()
     g.InputTextState.ClearFreeMemory();
     g.InputTextLineIndex.clear();
     g.InputTextDeactivatedState.ClearFreeMemory();
+    g.TextSizeCache.ClearFreeMemory();
 
     g.SettingsWindows.clear();
     g.SettingsHandlers.clear();
@@ -4507,6 +4857,7 @@ void ImGui::GcCompactTransientMiscBuffers()
     g.ItemFlagsStack.clear();
     g.GroupStack.clear();
     g.InputTextLineIndex.clear();
+    g.TextSizeCache.ClearFreeMemory();
     g.MultiSelectTempDataStacked = 0;
     g.MultiSelectTempData.clear_destruct();
     TableGcCompactSettings();
@@ -5357,6 +5708,8 @@ static void SetupDrawListSharedData()
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
     if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowVtxOffset;
+    if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasInstancedQuads)
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_InstancedQuads;
     g.DrawListSharedData.InitialFringeScale = 1.0f; // FIXME-DPI: Change this for some DPI scaling experiments.
 }
 
@@ -5384,6 +5737,7 @@ void ImGui::NewFrame()
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
     g.MenusIdSubmittedThisFrame.resize(0);
+    g.TextSizeCache.NewFrame();
 
     // Calculate frame-rate for the user, as a purely luxurious feature
     g.FramerateSecPerFrameAccum += g.IO.DeltaTime - g.FramerateSecPerFrame[g.FramerateSecPerFrameIdx];
@@ -5662,6 +6016,8 @@ static void AddWindowToDrawData(ImGuiWindow* window, int layer)
     g.IO.MetricsRenderWindows++;
     if (window->DrawList->_Splitter._Count > 1)
         window->DrawList->ChannelsMerge(); // Merge if user forgot to merge back. Also required in Docking branch for ImGuiWindowFlags_DockNodeHost windows.
+    if (window->DrawList->_Retained != NULL)
+        window->DrawList->_RetainedEndFrame();
     ImGui::AddDrawListToDrawDataEx(&viewport->DrawDataP, viewport->DrawDataBuilder.Layers[layer], window->DrawList);
     for (ImGuiWindow* child : window->DC.ChildWindows)
         if (IsWindowActiveAndVisible(child)) // Clipped children may have been marked not active
@@ -5709,7 +6065,7 @@ static void InitViewportDrawData(ImGuiViewportP* viewport)
 
     draw_data->Valid = true;
     draw_data->CmdListsCount = 0;
-    draw_data->TotalVtxCount = draw_data->TotalIdxCount = 0;
+    draw_data->TotalVtxCount = draw_data->TotalIdxCount = draw_data->TotalQuadCount = 0;
     draw_data->DisplayPos = viewport->Pos;
     draw_data->DisplaySize = viewport->Size;
     draw_data->FramebufferScale = io.DisplayFramebufferScale;
@@ -5753,12 +6109,14 @@ static void ImGui::RenderDimmedBackgroundBehindWindow(ImGuiWindow* window, ImU32
         // and draw list have been trimmed already, hence the explicit recreation of a draw command if missing.
         // FIXME: This is creating complication, might be simpler if we could inject a drawlist in drawdata at a given position and not attempt to manipulate ImDrawCmd order.
         ImDrawList* draw_list = window->RootWindow->DrawList;
+        if (draw_list->_Retained != NULL)
+            draw_list->_RetainedOnUntrackedWrite(0); // Reordering CmdBuffer[] below invalidates every journaled command
         if (draw_list->CmdBuffer.Size == 0)
             draw_list->AddDrawCmd();
         draw_list->PushClipRect(viewport_rect.Min - ImVec2(1, 1), viewport_rect.Max + ImVec2(1, 1), false); // FIXME: Need to stricty ensure ImDrawCmd are not merged (ElemCount==6 checks below will verify that)
         draw_list->AddRectFilled(viewport_rect.Min, viewport_rect.Max, col);
         ImDrawCmd cmd = draw_list->CmdBuffer.back();
-        IM_ASSERT(cmd.ElemCount == 6);
+        IM_ASSERT((cmd.ElemCount == 6 && cmd.QuadCount == 0) || (cmd.ElemCount == 0 && cmd.QuadCount == 1));
         draw_list->CmdBuffer.pop_back();
         draw_list->CmdBuffer.push_front(cmd);
         draw_list->AddDrawCmd(); // We need to create a command as CmdBuffer.back().IdxOffset won't be correct if we append to same command.
@@ -6015,6 +6373,24 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
+
+    // Lookup cache (optional). Bypassed while PushPasswordFont() has swapped the baked font tables, as the same ImFontBaked then measures differently.
+    ImU64 text_hash = 0;
+    int text_len = 0;
+    if (g.IO.ConfigTextSizeCache && g.FontBaked != NULL && g.InputTextPasswordFontBackupBaked.IndexLookup.Size == 0)
+    {
+        text_len = text_display_end ? (int)(text_display_end - text) : (int)ImStrlen(text);
+        text_hash = ImGuiTextSizeCache::HashText(text, text_len);
+        if (ImGuiTextSizeCacheEntry* entry = g.TextSizeCache.Find(text_hash, text_len, g.FontBaked, font_size, wrap_width))
+        {
+            g.TextSizeCache.FrameHits++;
+            entry->LastFrameUsed = g.FrameCount;
+            return entry->Size;
+        }
+        g.TextSizeCache.FrameMisses++;
+        text_display_end = text + text_len;
+    }
+
     ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
 
     // Round
@@ -6024,6 +6400,10 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     // - https://embarkstudios.github.io/rust-gpu/api/src/libm/math/ceilf.rs.html
     text_size.x = IM_TRUNC(text_size.x + 0.99999f);
 
+    // Loading glyphs while measuring may have discarded unused baked fonts (clearing the cache), never the one currently in use.
+    if (text_hash != 0)
+        g.TextSizeCache.Add(text_hash, text_len, g.FontBaked, font_size, wrap_width, text_size, g.FrameCount);
+
     return text_size;
 }
 
@@ -7423,6 +7803,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         window->HasCloseButton = (p_open != NULL);
         window->ClipRect = ImVec4(-FLT_MAX, -FLT_MAX, +FLT_MAX, +FLT_MAX);
         window->IDStack.resize(1);
+        window->DrawList->_SetRetained((g.NextWindowData.HasFlags & ImGuiNextWindowDataFlags_HasRefreshPolicy) && (g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_RetainDrawList));
         window->DrawList->_ResetForNewFrame();
         window->DC.CurrentTableIdx = -1;
 
@@ -7787,7 +8168,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         // DRAWING
 
         // Setup draw list and outer clipping rectangle
-        IM_ASSERT(window->DrawList->CmdBuffer.Size == 1 && window->DrawList->CmdBuffer[0].ElemCount == 0);
+        IM_ASSERT(window->DrawList->CmdBuffer.Size == 1 && window->DrawList->CmdBuffer[0].ElemCount == 0 && window->DrawList->CmdBuffer[0].QuadCount == 0);
         window->DrawList->PushTexture(g.Font->ContainerAtlas->TexRef);
         PushClipRect(host_rect.Min, host_rect.Max, false);
 
@@ -7802,8 +8183,8 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
                 // - We disable this when the parent window has zero vertices, which is a common pattern leading to laying out multiple overlapping childs
                 ImGuiWindow* previous_child = parent_window->DC.ChildWindows.Size >= 2 ? parent_window->DC.ChildWindows[parent_window->DC.ChildWindows.Size - 2] : NULL;
                 bool previous_child_overlapping = previous_child ? previous_child->Rect().Overlaps(window->Rect()) : false;
-                bool parent_is_empty = (parent_window->DrawList->VtxBuffer.Size == 0);
-                if (window->DrawList->CmdBuffer.back().ElemCount == 0 && !parent_is_empty && !previous_child_overlapping)
+                bool parent_is_empty = (parent_window->DrawList->VtxBuffer.Size == 0 && parent_window->DrawList->QuadBuffer.Size == 0);
+                if (window->DrawList->CmdBuffer.back().ElemCount == 0 && window->DrawList->CmdBuffer.back().QuadCount == 0 && !parent_is_empty && !previous_child_overlapping)
                     render_decorations_in_parent = true;
             }
             if (render_decorations_in_parent)
@@ -8750,6 +9131,8 @@ static void ImGui::UpdateTexturesNewFrame()
     const bool has_textures = (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTextures) != 0;
     for (ImFontAtlas* atlas : g.FontAtlases)
     {
+        if (atlas->Flags & ImFontAtlasFlags_DistanceField)
+            IM_ASSERT_USER_ERROR(g.IO.BackendFlags & ImGuiBackendFlags_RendererHasDistanceFields, "Font atlas uses ImFontAtlasFlags_DistanceField but renderer backend doesn't set ImGuiBackendFlags_RendererHasDistanceFields!");
         if (atlas->OwnerContext == &g)
         {
             ImFontAtlasUpdateNewFrame(atlas, g.FrameCount, has_textures);
@@ -15191,6 +15574,25 @@ void ImGui::UpdateSettings()
             g.SettingsDirtyTimer = 0.0f;
         }
     }
+
+    // Load glyph cache on first frame, before the atlas gets updated, then save it at the same rate as settings
+    if (!g.FontCacheLoaded)
+    {
+        if (g.IO.FontCacheFilename && g.IO.Fonts->GlyphCache == NULL)
+            ImFontAtlasGlyphCacheLoadFromDisk(g.IO.Fonts, g.IO.FontCacheFilename);
+        g.FontCacheLoaded = true;
+    }
+    if (g.IO.FontCacheFilename && g.IO.Fonts->GlyphCache && g.IO.Fonts->GlyphCache->Dirty)
+    {
+        if (g.FontCacheDirtyTimer <= 0.0f)
+            g.FontCacheDirtyTimer = g.IO.IniSavingRate;
+        g.FontCacheDirtyTimer -= g.IO.DeltaTime;
+        if (g.FontCacheDirtyTimer <= 0.0f)
+        {
+            ImFontAtlasGlyphCacheSaveToDisk(g.IO.Fonts, g.IO.FontCacheFilename);
+            g.FontCacheDirtyTimer = 0.0f;
+        }
+    }
 }
 
 void ImGui::MarkIniSettingsDirty()
@@ -15531,6 +15933,8 @@ void ImGuiPlatformIO::ClearPlatformHandlers()
     Platform_OpenInShellUserData = NULL;
     Platform_SetImeDataFn = NULL;
     Platform_ImeUserData = NULL;
+    Platform_ParallelForFn = NULL;
+    Platform_ParallelForUserData = NULL;
 }
 
 void ImGuiPlatformIO::ClearRendererHandlers()
@@ -16170,6 +16574,12 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
     if (Button("Clear All"))
         ImFontAtlasBuildClear(atlas);
     SetItemTooltip("Destroy cache and custom rectangles.");
+    BeginDisabled(!atlas->RendererHasTextures || (io.BackendFlags & ImGuiBackendFlags_RendererHasDistanceFields) == 0);
+    CheckboxFlags("ImFontAtlasFlags_DistanceField", &atlas->Flags, ImFontAtlasFlags_DistanceField); // Glyphs are rebuilt on next frame
+    EndDisabled();
+    SameLine(); MetricsHelpMarker("Bake each font once at its reference size, as signed distance fields scaled by the renderer.\nRequires ImGuiBackendFlags_RendererHasDistanceFields.");
+    if (ImFontAtlasGlyphCache* glyph_cache = atlas->GlyphCache)
+        Text("Glyph cache: %d entries, %d KB, %d hits, %d misses%s", glyph_cache->Entries.Size, glyph_cache->Pixels.Size / 1024, glyph_cache->HitsCount, glyph_cache->MissesCount, glyph_cache->Dirty ? " (unsaved)" : "");
 
     for (int tex_n = 0; tex_n < atlas->TexList.Size; tex_n++)
     {
@@ -16181,7 +16591,16 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
     const int packed_surface_sqrt = (int)sqrtf((float)atlas->Builder->RectsPackedSurface);
     const int discarded_surface_sqrt = (int)sqrtf((float)atlas->Builder->RectsDiscardedSurface);
     Text("Packed rects: %d, area: about %d px ~%dx%d px", atlas->Builder->RectsPackedCount, atlas->Builder->RectsPackedSurface, packed_surface_sqrt, packed_surface_sqrt);
-    Text("incl. Discarded rects: %d, area: about %d px ~%dx%d px", atlas->Builder->RectsDiscardedCount, atlas->Builder->RectsDiscardedSurface, discarded_surface_sqrt, discarded_surface_sqrt);
+    Text("Free slots: %d, area: about %d px ~%dx%d px", atlas->Builder->RectsDiscardedCount, atlas->Builder->RectsDiscardedSurface, discarded_surface_sqrt, discarded_surface_sqrt);
+    SameLine(); MetricsHelpMarker("Space left by discarded rectangles, reused by new rectangles fitting in it.");
+    Text("Shelves: %d, height: %d px, defragmentation: %d rects moved", atlas->Builder->PackShelves.Size, atlas->Builder->PackShelvesHeight, atlas->Builder->RectsMovedCount);
+    const int occupancy = (int)(100.0f * atlas->Builder->RectsPackedSurface / ImMax(atlas->TexData->Width * atlas->TexData->Height, 1));
+    if (atlas->TexMemoryBudget > 0)
+        Text("Occupancy: %d%%, memory: %d KB, budget: %d KB", occupancy, atlas->TexData->GetSizeInBytes() / 1024, atlas->TexMemoryBudget / 1024);
+    else
+        Text("Occupancy: %d%%, memory: %d KB, no budget", occupancy, atlas->TexData->GetSizeInBytes() / 1024);
+    Text("Glyphs evicted: %d, reloaded: %d", atlas->Builder->GlyphsEvictedCount, atlas->Builder->GlyphsReloadedCount);
+    SameLine(); MetricsHelpMarker("Past ImFontAtlas::TexMemoryBudget, glyphs not rendered for a few frames are evicted (least recently used first) instead of growing the texture, and loaded again when needed.");
 
     ImFontAtlasRectId highlight_r_id = ImFontAtlasRectId_Invalid;
     if (TreeNode("Rects Index", "Rects Index (%d)", atlas->Builder->RectsPackedCount)) // <-- Use count of used rectangles
@@ -16249,7 +16668,7 @@ void ImGui::DebugNodeTexture(ImTextureData* tex, int int_id, const ImFontAtlasRe
         PopStyleVar();
 
         char texid_desc[30];
-        Text("Status = %s (%d), Format = %s (%d), UseColors = %d", ImTextureDataGetStatusName(tex->Status), tex->Status, ImTextureDataGetFormatName(tex->Format), tex->Format, tex->UseColors);
+        Text("Status = %s (%d), Format = %s (%d), UseColors = %d, UseDistanceField = %d", ImTextureDataGetStatusName(tex->Status), tex->Status, ImTextureDataGetFormatName(tex->Format), tex->Format, tex->UseColors, tex->UseDistanceField);
         Text("TexID = %s, BackendUserData = %p", FormatTextureRefForDebugDisplay(texid_desc, IM_ARRAYSIZE(texid_desc), tex->GetTexRef()), tex->BackendUserData);
         TreePop();
     }
@@ -16507,6 +16926,20 @@ void ImGui::ShowMetricsWindow(bool* p_open)
             TreePop();
         }
 
+    // Details for CalcTextSize() cache
+    if (TreeNode("TextSizeCache", "Text Size Cache (%d)", g.TextSizeCache.EntriesCount))
+    {
+        ImGuiTextSizeCache* cache = &g.TextSizeCache;
+        Checkbox("io.ConfigTextSizeCache", &io.ConfigTextSizeCache);
+        const int lookups = cache->LastFrameHits + cache->LastFrameMisses;
+        Text("Last frame: %d hits, %d misses (%.1f%% hit rate)", cache->LastFrameHits, cache->LastFrameMisses, lookups > 0 ? cache->LastFrameHits * 100.0f / lookups : 0.0f);
+        Text("Entries: %d / %d slots (%d bytes)", cache->EntriesCount, cache->Entries.Size, cache->Entries.size_in_bytes());
+        Text("Evicted: %d", cache->EvictedCount);
+        if (SmallButton("Clear"))
+            cache->ClearFreeMemory();
+        TreePop();
+    }
+
     // Details for Popups
     if (TreeNode("Popups", "Popups (%d)", g.OpenPopupStack.Size))
     {
@@ -16921,9 +17354,13 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
     IM_UNUSED(viewport); // Used in docking branch
     ImGuiMetricsConfig* cfg = &g.DebugMetricsConfig;
     int cmd_count = draw_list->CmdBuffer.Size;
-    if (cmd_count > 0 && draw_list->CmdBuffer.back().ElemCount == 0 && draw_list->CmdBuffer.back().UserCallback == NULL)
+    if (cmd_count > 0 && draw_list->CmdBuffer.back().ElemCount == 0 && draw_list->CmdBuffer.back().QuadCount == 0 && draw_list->CmdBuffer.back().UserCallback == NULL)
         cmd_count--;
-    bool node_open = TreeNode(draw_list, "%s: '%s' %d vtx, %d indices, %d cmds", label, draw_list->_OwnerName ? draw_list->_OwnerName : "", draw_list->VtxBuffer.Size, draw_list->IdxBuffer.Size, cmd_count);
+    bool node_open;
+    if (draw_list->QuadBuffer.Size > 0)
+        node_open = TreeNode(draw_list, "%s: '%s' %d vtx, %d indices, %d quads, %d cmds", label, draw_list->_OwnerName ? draw_list->_OwnerName : "", draw_list->VtxBuffer.Size, draw_list->IdxBuffer.Size, draw_list->QuadBuffer.Size, cmd_count);
+    else
+        node_open = TreeNode(draw_list, "%s: '%s' %d vtx, %d indices, %d cmds", label, draw_list->_OwnerName ? draw_list->_OwnerName : "", draw_list->VtxBuffer.Size, draw_list->IdxBuffer.Size, cmd_count);
     if (draw_list == GetWindowDrawList())
     {
         SameLine();
@@ -16941,6 +17378,8 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
 
     if (window && !window->WasActive)
         TextDisabled("Warning: owning Window is inactive. This DrawList is not being rendered!");
+    if (const ImDrawListRetainedData* retained = draw_list->_Retained)
+        BulletText("Retained: reused %d/%d draw calls, journal %d entries", retained->LastFrameDrawCallsReused, retained->LastFrameDrawCalls, retained->Entries.Size);
 
     for (const ImDrawCmd* pcmd = draw_list->CmdBuffer.Data; pcmd < draw_list->CmdBuffer.Data + cmd_count; pcmd++)
     {
@@ -16953,8 +17392,12 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
         char texid_desc[30];
         FormatTextureRefForDebugDisplay(texid_desc, IM_ARRAYSIZE(texid_desc), pcmd->TexRef);
         char buf[300];
-        ImFormatString(buf, IM_ARRAYSIZE(buf), "DrawCmd:%5d tris, Tex %s, ClipRect (%4.0f,%4.0f)-(%4.0f,%4.0f)",
-            pcmd->ElemCount / 3, texid_desc, pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z, pcmd->ClipRect.w);
+        if (pcmd->QuadCount > 0)
+            ImFormatString(buf, IM_ARRAYSIZE(buf), "DrawCmd:%5d tris +%5d quads, Tex %s, ClipRect (%4.0f,%4.0f)-(%4.0f,%4.0f)",
+                pcmd->ElemCount / 3, pcmd->QuadCount, texid_desc, pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z, pcmd->ClipRect.w);
+        else
+            ImFormatString(buf, IM_ARRAYSIZE(buf), "DrawCmd:%5d tris, Tex %s, ClipRect (%4.0f,%4.0f)-(%4.0f,%4.0f)",
+                pcmd->ElemCount / 3, texid_desc, pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z, pcmd->ClipRect.w);
         bool pcmd_node_open = TreeNode((void*)(pcmd - draw_list->CmdBuffer.begin()), "%s", buf);
         if (IsItemHovered() && (cfg->ShowDrawCmdMesh || cfg->ShowDrawCmdBoundingBoxes) && fg_draw_list)
             DebugNodeDrawCmdShowMeshAndBoundingBox(fg_draw_list, draw_list, pcmd, cfg->ShowDrawCmdMesh, cfg->ShowDrawCmdBoundingBoxes);
@@ -16973,6 +17416,10 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
                 triangle[n] = vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n].pos;
             total_area += ImTriangleArea(triangle[0], triangle[1], triangle[2]);
         }
+        for (unsigned int quad_n = pcmd->QuadOffset; quad_n < pcmd->QuadOffset + pcmd->QuadCount; quad_n++)
+            total_area += ImAbs(draw_list->QuadBuffer[quad_n].Size.x * draw_list->QuadBuffer[quad_n].Size.y);
+        if (pcmd->QuadCount > 0)
+            BulletText("Quads: QuadCount: %d, QuadOffset: +%d", pcmd->QuadCount, pcmd->QuadOffset);
 
         // Display vertex information summary. Hover to get all triangles drawn in wire-frame
         ImFormatString(buf, IM_ARRAYSIZE(buf), "Mesh: ElemCount: %d, VtxOffset: +%d, IdxOffset: +%d, Area: ~%0.f px", pcmd->ElemCount, pcmd->VtxOffset, pcmd->IdxOffset, total_area);
@@ -17031,6 +17478,14 @@ void ImGui::DebugNodeDrawCmdShowMeshAndBoundingBox(ImDrawList* out_draw_list, co
         if (show_mesh)
             out_draw_list->AddPolyline(triangle, 3, IM_COL32(255, 255, 0, 255), ImDrawFlags_Closed, 1.0f); // In yellow: mesh triangles
     }
+    for (unsigned int quad_n = draw_cmd->QuadOffset, quad_end = draw_cmd->QuadOffset + draw_cmd->QuadCount; quad_n < quad_end; quad_n++)
+    {
+        const ImDrawQuad quad = draw_list->QuadBuffer[quad_n]; // Copy as ->AddRect() may invalidate pointers if out_draw_list==draw_list
+        vtxs_rect.Add(quad.Pos);
+        vtxs_rect.Add(quad.Pos + quad.Size);
+        if (show_mesh)
+            out_draw_list->AddRect(quad.Pos, quad.Pos + quad.Size, IM_COL32(255, 255, 0, 255)); // In yellow: instanced quads
+    }
     // Draw bounding boxes
     if (show_aabb)
     {
@@ -17178,7 +17633,7 @@ void ImGui::DebugNodeFont(ImFont* font)
         if (baked->ContainerFont != font)
             continue;
         PushID(baked_n);
-        if (TreeNode("Glyphs", "Baked at { %.2fpx, d.%.2f }: %d glyphs%s", baked->Size, baked->RasterizerDensity, baked->Glyphs.Size, (baked->LastUsedFrame < atlas->Builder->FrameCount - 1) ? " *Unused*" : ""))
+        if (TreeNode("Glyphs", "Baked at { %.2fpx, d.%.2f }: %d glyphs%s", baked->Size, baked->RasterizerDensity, baked->Glyphs.Size - baked->GlyphsFreeList.Size, (baked->LastUsedFrame < atlas->Builder->FrameCount - 1) ? " *Unused*" : ""))
         {
             if (SmallButton("Load all"))
                 for (unsigned int base = 0; base <= IM_UNICODE_CODEPOINT_MAX; base++)
@@ -48,7 +48,7 @@ Index of this file:
 // [SECTION] Misc data structures (ImGuiInputTextCallbackData, ImGuiSizeCallbackData, ImGuiPayload)
 // [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, Math Operators, ImColor)
 // [SECTION] Multi-Select API flags and structures (ImGuiMultiSelectFlags, ImGuiMultiSelectIO, ImGuiSelectionRequest, ImGuiSelectionBasicStorage, ImGuiSelectionExternalStorage)
-// [SECTION] Drawing API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawFlags, ImDrawListFlags, ImDrawList, ImDrawData)
+// [SECTION] Drawing API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawFlags, ImDrawListFlags, ImDrawList, ImDrawData, ImDrawDamageTracker, ImDrawDataMerger)
 // [SECTION] Texture API (ImTextureFormat, ImTextureStatus, ImTextureRect, ImTextureData)
 // [SECTION] Font API (ImFontConfig, ImFontGlyph, ImFontGlyphRangesBuilder, ImFontAtlasFlags, ImFontAtlas, ImFontBaked, ImFont)
 // [SECTION] Viewports (ImGuiViewportFlags, ImGuiViewport)
@@ -167,13 +167,18 @@ typedef unsigned long long  ImU64;  // 64-bit unsigned integer
 struct ImDrawChannel;               // Temporary storage to output draw commands out of order, used by ImDrawListSplitter and ImDrawList::ChannelsSplit()
 struct ImDrawCmd;                   // A single draw command within a parent ImDrawList (generally maps to 1 GPU draw call, unless it is a callback)
 struct ImDrawData;                  // All draw command lists required to render the frame + pos/size coordinates to use for the projection matrix.
+struct ImDrawDamageTracker;         // Helper to compute which regions of the screen changed between two successive ImDrawData, to allow partial redraws.
+struct ImDrawDataMerger;            // Helper to concatenate all draw lists of a ImDrawData and merge draw commands across them, to reduce draw calls.
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
 struct ImDrawListSplitter;          // Helper to split a draw list into different layers which can be drawn into out of order, then flattened back.
+struct ImDrawListRetainedData;      // [Internal] Journal used to reuse unchanged draw list contents from one frame to the next (see imgui_internal.h)
+struct ImDrawQuad;                  // A single axis-aligned textured quad instance (pos + size + uv rect + col = 36 bytes), used when ImDrawListFlags_InstancedQuads is set.
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
 struct ImFontAtlasBuilder;          // Opaque storage for building a ImFontAtlas
+struct ImFontAtlasGlyphCache;       // Opaque storage for persistent glyph cache (see io.FontCacheFilename)
 struct ImFontAtlasRect;             // Output of ImFontAtlas::GetCustomRect() when using custom rectangles.
 struct ImFontBaked;                 // Baked data for a ImFont at a given size.
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
@@ -1715,6 +1720,9 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if io.ConfigNavMoveSetMousePos is set).
     ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
     ImGuiBackendFlags_RendererHasTextures   = 1 << 4,   // Backend Renderer supports ImTextureData requests to create/update/destroy textures. This enables incremental texture updates and texture reloads. See https://github.com/ocornut/imgui/blob/master/docs/BACKENDS.md for instructions on how to upgrade your custom backend.
+    ImGuiBackendFlags_RendererHasTexAlpha8  = 1 << 5,   // Backend Renderer supports ImTextureData with Format == ImTextureFormat_Alpha8 (sampled as white + alpha). This allows setting 'io.Fonts->TexDesiredFormat = ImTextureFormat_Alpha8' to use 1/4 of the texture memory and upload bandwidth.
+    ImGuiBackendFlags_RendererHasInstancedQuads = 1 << 6, // Backend Renderer supports ImDrawCmd::QuadCount/QuadOffset (instanced ImDrawQuad records). This enables ImDrawListFlags_InstancedQuads: glyphs and filled rectangles are output as ImDrawQuad instead of 4 vertices + 6 indices.
+    ImGuiBackendFlags_RendererHasDistanceFields = 1 << 7, // Backend Renderer supports ImTextureData with UseDistanceField == true (alpha channel sampled as a signed distance field). This allows using ImFontAtlasFlags_DistanceField.
 };
 
 // Enumeration for PushStyleColor() / PopStyleColor()
@@ -2380,6 +2388,7 @@ struct ImGuiIO
     float       DeltaTime;                      // = 1.0f/60.0f     // Time elapsed since last frame, in seconds. May change every frame.
     float       IniSavingRate;                  // = 5.0f           // Minimum time between saving positions/sizes to .ini file, in seconds.
     const char* IniFilename;                    // = "imgui.ini"    // Path to .ini file (important: default "imgui.ini" is relative to current working dir!). Set NULL to disable automatic .ini loading/saving or if you want to manually call LoadIniSettingsXXX() / SaveIniSettingsXXX() functions.
+    const char* FontCacheFilename;              // = NULL           // Path to a glyph cache file for io.Fonts. When set, rasterized glyphs are saved to this file and reused by the next sessions instead of being rasterized again. Loaded on the first NewFrame(), saved at the same rate as .ini settings.
     const char* LogFilename;                    // = "imgui_log.txt"// Path to .log file (default parameter to ImGui::LogToFile when no file is specified).
     void*       UserData;                       // = NULL           // Store your own data.
 
@@ -2409,6 +2418,7 @@ struct ImGuiIO
     bool        ConfigWindowsMoveFromTitleBarOnly;  // = false      // Enable allowing to move windows only when clicking on their title bar. Does not apply to windows without a title bar.
     bool        ConfigWindowsCopyContentsWithCtrlC; // = false      // [EXPERIMENTAL] CTRL+C copy the contents of focused window into the clipboard. Experimental because: (1) has known issues with nested Begin/End pairs (2) text output quality varies (3) text output is in submission order rather than spatial order.
     bool        ConfigScrollbarScrollByPage;    // = true           // Enable scrolling page by page when clicking outside the scrollbar grab. When disabled, always scroll to clicked location. When enabled, Shift+Click scrolls to clicked location.
+    bool        ConfigTextSizeCache;            // = false          // [EXPERIMENTAL] Cache CalcTextSize() results, keyed on a hash of the text, font and wrap width. Saves measuring the same labels every frame. Hit/miss counts are displayed in Metrics.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // Timer (in seconds) to free transient windows/tables memory buffers when unused. Set to -1.0f to disable.
 
     // Inputs Behaviors
@@ -3091,7 +3101,7 @@ struct ImGuiSelectionExternalStorage
 };
 
 //-----------------------------------------------------------------------------
-// [SECTION] Drawing API (ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawListFlags, ImDrawList, ImDrawData)
+// [SECTION] Drawing API (ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawListFlags, ImDrawList, ImDrawData, ImDrawDamageTracker, ImDrawDataMerger)
 // Hold a series of drawing commands. The user provides a renderer for ImDrawData which essentially contains an array of ImDrawList.
 //-----------------------------------------------------------------------------
 
@@ -3129,6 +3139,8 @@ typedef void (*ImDrawCallback)(const ImDrawList* parent_list, const ImDrawCmd* c
 //   this fields allow us to render meshes larger than 64K vertices while keeping 16-bit indices.
 //   Backends made for <1.71. will typically ignore the VtxOffset fields.
 // - The ClipRect/TexRef/VtxOffset fields must be contiguous as we memcmp() them together (this is asserted for).
+// - QuadOffset/QuadCount: When 'io.BackendFlags & ImGuiBackendFlags_RendererHasInstancedQuads' is enabled, a command may also
+//   render QuadCount instanced ImDrawQuad from the ImDrawList's QuadBuffer[]. Those are always drawn AFTER the ElemCount indices of the same command.
 struct ImDrawCmd
 {
     ImVec4          ClipRect;           // 4*4  // Clipping rectangle (x1, y1, x2, y2). Subtract ImDrawData->DisplayPos to get clipping rectangle in "viewport" coordinates
@@ -3136,6 +3148,8 @@ struct ImDrawCmd
     unsigned int    VtxOffset;          // 4    // Start offset in vertex buffer. ImGuiBackendFlags_RendererHasVtxOffset: always 0, otherwise may be >0 to support meshes larger than 64K vertices with 16-bit indices.
     unsigned int    IdxOffset;          // 4    // Start offset in index buffer.
     unsigned int    ElemCount;          // 4    // Number of indices (multiple of 3) to be rendered as triangles. Vertices are stored in the callee ImDrawList's vtx_buffer[] array, indices in idx_buffer[].
+    unsigned int    QuadOffset;         // 4    // Start offset in quad buffer. Only meaningful when QuadCount > 0.
+    unsigned int    QuadCount;          // 4    // Number of ImDrawQuad to be rendered after the triangles. Always 0 unless ImDrawListFlags_InstancedQuads is set.
     ImDrawCallback  UserCallback;       // 4-8  // If != NULL, call the function instead of rendering the vertices. clip_rect and texture_id will be set normally.
     void*           UserCallbackData;   // 4-8  // Callback user data (when UserCallback != NULL). If called AddCallback() with size == 0, this is a copy of the AddCallback() argument. If called AddCallback() with size > 0, this is pointing to a buffer where data is stored.
     int             UserCallbackDataSize;  // 4 // Size of callback user data when using storage, otherwise 0.
@@ -3164,6 +3178,18 @@ struct ImDrawVert
 IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT;
 #endif
 
+// Instanced quad layout (used when ImDrawListFlags_InstancedQuads is set)
+// An axis-aligned rectangle with a texture coordinates rectangle and a single color, expanded to 4 vertices by the renderer (e.g. in a vertex shader with instancing).
+// Equivalent to PrimRectUV(Pos, Pos + Size, UvMin, UvMax, Col): 36 bytes instead of 4 ImDrawVert + 6 ImDrawIdx (92 bytes with 16-bit indices).
+struct ImDrawQuad
+{
+    ImVec2  Pos;                        // Upper-left corner
+    ImVec2  Size;
+    ImVec2  UvMin;                      // Texture coordinates of upper-left corner
+    ImVec2  UvMax;                      // Texture coordinates of lower-right corner
+    ImU32   Col;
+};
+
 // [Internal] For use by ImDrawList
 struct ImDrawCmdHeader
 {
@@ -3225,6 +3251,7 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering (NOT point/nearest filtering).
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
     ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_InstancedQuads          = 1 << 4,  // Output glyphs, images and non-rounded filled rectangles as ImDrawQuad records into QuadBuffer[]. Set when 'ImGuiBackendFlags_RendererHasInstancedQuads' is enabled. Clear it temporarily if you need to post-process vertices (e.g. ShadeVertsXXX functions).
 };
 
 // Draw command list
@@ -3242,6 +3269,7 @@ struct ImDrawList
     ImVector<ImDrawCmd>     CmdBuffer;          // Draw commands. Typically 1 command = 1 GPU draw call, unless the command is a callback.
     ImVector<ImDrawIdx>     IdxBuffer;          // Index buffer. Each command consume ImDrawCmd::ElemCount of those
     ImVector<ImDrawVert>    VtxBuffer;          // Vertex buffer.
+    ImVector<ImDrawQuad>    QuadBuffer;         // Quad instance buffer. Each command consume ImDrawCmd::QuadCount of those. Empty unless ImDrawListFlags_InstancedQuads is set.
     ImDrawListFlags         Flags;              // Flags, you may poke into these to adjust anti-aliasing settings per-primitive.
 
     // [Internal, used while building lists]
@@ -3249,6 +3277,7 @@ struct ImDrawList
     ImDrawListSharedData*   _Data;              // Pointer to shared draw data (you can use ImGui::GetDrawListSharedData() to get the one from current ImGui context)
     ImDrawVert*             _VtxWritePtr;       // [Internal] point within VtxBuffer.Data after each add command (to avoid using the ImVector<> operators too much)
     ImDrawIdx*              _IdxWritePtr;       // [Internal] point within IdxBuffer.Data after each add command (to avoid using the ImVector<> operators too much)
+    ImDrawQuad*             _QuadWritePtr;      // [Internal] point within QuadBuffer.Data after each add command
     ImVector<ImVec2>        _Path;              // [Internal] current path building
     ImDrawCmdHeader         _CmdHeader;         // [Internal] template of active commands. Fields should match those of CmdBuffer.back().
     ImDrawListSplitter      _Splitter;          // [Internal] for channels api (note: prefer using your own persistent instance of ImDrawListSplitter!)
@@ -3256,6 +3285,7 @@ struct ImDrawList
     ImVector<ImTextureRef>  _TextureStack;      // [Internal]
     ImVector<ImU8>          _CallbacksDataBuf;  // [Internal]
     float                   _FringeScale;       // [Internal] anti-alias fringe is scaled by this value, this helps to keep things sharp while zooming at vertex buffer content
+    ImDrawListRetainedData* _Retained;          // [Internal] NULL unless retained mode is enabled, see _SetRetained()
     const char*             _OwnerName;         // Pointer to owner window's name for debugging
 
     // If you want to create ImDrawList instances, pass them ImGui::GetDrawListSharedData().
@@ -3365,6 +3395,13 @@ struct ImDrawList
     inline    void  PrimWriteIdx(ImDrawIdx idx)                                     { *_IdxWritePtr = idx; _IdxWritePtr++; }
     inline    void  PrimVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)         { PrimWriteIdx((ImDrawIdx)_VtxCurrentIdx); PrimWriteVtx(pos, uv, col); } // Write vertex with unique index
 
+    // Advanced: Instanced quads allocations (only when ImDrawListFlags_InstancedQuads is set)
+    // - Axis-aligned rectangles are written as a single ImDrawQuad record. They need to be reserved via PrimReserveQuads() beforehand.
+    // - Quads are rendered after the triangles of the same command, so PrimReserve() following quads will start a new command.
+    IMGUI_API void  PrimReserveQuads(int quad_count);
+    IMGUI_API void  PrimUnreserveQuads(int quad_count);
+    inline    void  PrimWriteQuad(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a, const ImVec2& uv_c, ImU32 col) { _QuadWritePtr->Pos = a; _QuadWritePtr->Size = ImVec2(c.x - a.x, c.y - a.y); _QuadWritePtr->UvMin = uv_a; _QuadWritePtr->UvMax = uv_c; _QuadWritePtr->Col = col; _QuadWritePtr++; }
+
     // Obsolete names
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     inline    void  PushTextureID(ImTextureRef tex_ref) { PushTexture(tex_ref); }   // RENAMED in 1.92.x
@@ -3386,6 +3423,11 @@ struct ImDrawList
     IMGUI_API void  _OnChangedTexture();
     IMGUI_API void  _OnChangedVtxOffset();
     IMGUI_API void  _SetTexture(ImTextureRef tex_ref);
+    IMGUI_API void  _SetRetained(bool retained);
+    IMGUI_API bool  _RetainedBeginDrawCall(int kind, const void* args, size_t args_size, const void* data = NULL, size_t data_size = 0);
+    IMGUI_API bool  _RetainedOnStateChange();
+    IMGUI_API void  _RetainedOnUntrackedWrite(int vtx_start = -1);
+    IMGUI_API void  _RetainedEndFrame();
     IMGUI_API int   _CalcCircleAutoSegmentCount(float radius) const;
     IMGUI_API void  _PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step);
     IMGUI_API void  _PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments);
@@ -3400,6 +3442,7 @@ struct ImDrawData
     int                 CmdListsCount;      // == CmdLists.Size. (OBSOLETE: exists for legacy reasons). Number of ImDrawList* to render.
     int                 TotalIdxCount;      // For convenience, sum of all ImDrawList's IdxBuffer.Size
     int                 TotalVtxCount;      // For convenience, sum of all ImDrawList's VtxBuffer.Size
+    int                 TotalQuadCount;     // For convenience, sum of all ImDrawList's QuadBuffer.Size
     ImVector<ImDrawList*> CmdLists;         // Array of ImDrawList* to render. The ImDrawLists are owned by ImGuiContext and only pointed to from here.
     ImVec2              DisplayPos;         // Top-left position of the viewport to render (== top-left of the orthogonal projection matrix to use) (== GetMainViewport()->Pos for the main viewport, == (0.0) in most single-viewport applications)
     ImVec2              DisplaySize;        // Size of the viewport to render (== GetMainViewport()->Size for the main viewport, == io.DisplaySize in most single-viewport applications)
@@ -3415,6 +3458,66 @@ struct ImDrawData
     IMGUI_API void  ScaleClipRects(const ImVec2& fb_scale); // Helper to scale the ClipRect field of each ImDrawCmd. Use if your final output buffer is at a different scale than Dear ImGui expects, or if there is a difference between your window resolution and framebuffer resolution.
 };
 
+// Helper to track which regions of the screen changed between successive frames, so a renderer may only redraw those (partial redraw).
+// - Call Update() once per presented frame, after Render(). Each ImDrawCmd is hashed (clip rect, texture, vertices and indices) and
+//   commands which appeared or disappeared since the previous Update() mark their bounding box as damaged. A command's position within
+//   its draw list is part of its hash, so a command drawn in a different order (e.g. above another one instead of below) is damaged too.
+// - Regions are in the same coordinates as ImDrawCmd::ClipRect (DisplayPos/DisplaySize space), not overlapping each other.
+// - Your renderer needs to only clear + redraw inside those regions, and your swap chain needs to preserve previous contents.
+//   With swap chains cycling through multiple buffers (e.g. EGL_EXT_buffer_age), use GetDamageForBufferAge().
+// - Any user callback other than ImDrawCallback_ResetRenderState marks the whole display as damaged (we don't know what it draws).
+// - Commands using a ImTextureData are damaged when its contents are created or updated. Textures only known by their ImTextureID can't be
+//   tracked: call Clear() after changing their contents.
+#define IM_DRAW_DAMAGE_HISTORY      4   // Number of frames of damage we keep, for GetDamageForBufferAge()
+#define IM_DRAW_DAMAGE_MAX_RECTS    8   // Above this number of regions, merge all of them into their bounding box
+struct ImDrawDamageEntry
+{
+    ImU64               Hash;               // Hash of command contents + draw list order + position within draw list (64-bit: a collision would leave stale pixels)
+    ImVec4              Rect;               // Bounding box of command vertices, clipped by ClipRect
+};
+struct ImDrawDamageTracker
+{
+    bool                FullDamage;         // Whole display changed: first frame, display size/scale changed, user callbacks or too much damage
+    ImVector<ImVec4>    DamageRects;        // Regions which changed since previous Update(). Empty if nothing changed. == single display rect when FullDamage.
+    int                 UpdateCount;        // Number of calls to Update() since last Clear()
+
+    // [Internal]
+    ImVector<ImDrawDamageEntry> _Entries;
+    ImVector<ImDrawDamageEntry> _PrevEntries;
+    ImVector<ImVec4>    _History[IM_DRAW_DAMAGE_HISTORY]; // Damage of last frames, [0] = most recent
+    ImGuiStorage        _TexUpdateCounts;   // ImTextureData* (hashed) -> number of frames its contents changed, for textures of last ImDrawData::Textures[]
+    ImVec2              _DisplayPos;
+    ImVec2              _DisplaySize;
+    ImVec2              _FramebufferScale;
+
+    ImDrawDamageTracker()   { Clear(); }
+    IMGUI_API void  Clear();                                            // Forget previous frames: next Update() will report full damage.
+    IMGUI_API bool  Update(const ImDrawData* draw_data);                // Compute damage compared to previous call. Return true if anything changed.
+    IMGUI_API bool  GetDamageForBufferAge(int buffer_age, ImVector<ImVec4>* out_rects) const; // Regions to redraw into a buffer presented 'buffer_age' frames ago (1 = previous frame). Return false if everything needs to be redrawn (unknown age, or older than our history).
+};
+
+// Helper to concatenate the vertex/index/quad buffers of all draw lists of a ImDrawData into as few ImDrawList as possible,
+// merging consecutive draw commands across lists when they use the same texture and don't rely on scissoring to clip their geometry.
+// - Call after ImGui::Render() and before your renderer: ImDrawData::CmdLists[] will point to draw lists owned by this object, valid until next Merge().
+// - Order of draw commands is preserved. Draw lists with user callbacks are left untouched.
+// - Call ImDrawDamageTracker::Update() before this, as it identifies commands by their draw list index.
+// - With 16-bit indices, a new output draw list is started every 64K vertices.
+// - Call ClearFreeMemory() before destroying the Dear ImGui context, which our draw lists are registered to.
+struct ImDrawDataMerger
+{
+    int                 DrawCallsBefore;    // Number of draw calls (non-empty batches of triangles or quads) in last ImDrawData given to Merge()
+    int                 DrawCallsAfter;     // Number of draw calls after merging
+
+    // [Internal]
+    ImVector<ImDrawList*> _Lists;           // Output draw lists, reused from frame to frame
+    ImVector<ImDrawList*> _CmdLists;        // New contents of ImDrawData::CmdLists[]
+
+    ImDrawDataMerger()  { DrawCallsBefore = DrawCallsAfter = 0; }
+    ~ImDrawDataMerger() { ClearFreeMemory(); }
+    IMGUI_API void  Merge(ImDrawData* draw_data);
+    IMGUI_API void  ClearFreeMemory();
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Texture API (ImTextureFormat, ImTextureStatus, ImTextureRect, ImTextureData)
 //-----------------------------------------------------------------------------
@@ -3477,6 +3580,7 @@ struct ImTextureData
     int                 UnusedFrames;           // w    r   // In order to facilitate handling Status==WantDestroy in some backend: this is a count successive frames where the texture was not used. Always >0 when Status==WantDestroy.
     unsigned short      RefCount;               // w    r   // Number of contexts using this texture. Used during backend shutdown.
     bool                UseColors;              // w    r   // Tell whether our texture data is known to use colors (rather than just white + alpha).
+    bool                UseDistanceField;       // w    r   // Alpha channel stores a signed distance field (0.5 on edges) rather than coverage. Only set on atlases created with ImFontAtlasFlags_DistanceField.
     bool                WantDestroyNextFrame;   // rw   -   // [Internal] Queued to set ImTextureStatus_WantDestroy next frame. May still be used in the current frame.
 
     // Functions
@@ -3537,6 +3641,7 @@ struct ImFontConfig
     ImFont*         DstFont;                // Target font (as we merging fonts, multiple ImFontConfig may target the same font)
     const ImFontLoader* FontLoader;         // Custom font backend for this source (default source is the one stored in ImFontAtlas)
     void*           FontLoaderData;         // Font loader opaque storage (per font config)
+    ImGuiID         FontDataHash;           // Hash of FontData, computed when first needed by the glyph cache
 
     IMGUI_API ImFontConfig();
 };
@@ -3553,6 +3658,7 @@ struct ImFontGlyph
     float           X0, Y0, X1, Y1;     // Glyph corners. Offsets from current cursor/layout position.
     float           U0, V0, U1, V1;     // Texture coordinates for the current value of ImFontAtlas->TexRef. Cached equivalent of calling GetCustomRect() with PackId.
     int             PackId;             // [Internal] ImFontAtlasRectId value (FIXME: Cold data, could be moved elsewhere?)
+    int             LastUsedFrame;      // [Internal] Last frame this glyph was rendered. Least recently used glyphs are evicted first (see ImFontAtlas::TexMemoryBudget).
 
     ImFontGlyph()   { memset(this, 0, sizeof(*this)); PackId = -1; }
 };
@@ -3597,6 +3703,7 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
     ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory, allow support for point/nearest filtering). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_DistanceField      = 1 << 3,   // Bake glyphs as signed distance fields, once per font at its reference size (ImFontConfig::SizePixels), and scale them at render time. Requires ImGuiBackendFlags_RendererHasDistanceFields. Set before adding fonts.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -3714,6 +3821,7 @@ struct ImFontAtlas
     int                         TexMinHeight;       // Minimum desired texture height. Must be a power of two. Default to 128.
     int                         TexMaxWidth;        // Maximum desired texture width. Must be a power of two. Default to 8192.
     int                         TexMaxHeight;       // Maximum desired texture height. Must be a power of two. Default to 8192.
+    int                         TexMemoryBudget;    // Texture memory budget in bytes. Default to 0 (none). Instead of growing the texture past it, glyphs not rendered for a few frames are evicted in least recently used order, and loaded again when needed. Texture still grows if every glyph is in use.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
 
     // Output
@@ -3741,6 +3849,7 @@ struct ImFontAtlas
     int                         FontNextUniqueID;   // Next value to be stored in ImFont->FontID
     ImVector<ImDrawListSharedData*> DrawListSharedDatas; // List of users for this atlas. Typically one per Dear ImGui context.
     ImFontAtlasBuilder*         Builder;            // Opaque interface to our data that doesn't need to be public and may be discarded when rebuilding.
+    ImFontAtlasGlyphCache*      GlyphCache;         // Persistent glyph cache, NULL unless enabled (see io.FontCacheFilename). Survives rebuilding.
     const ImFontLoader*         FontLoader;         // Font loader opaque interface (default to use FreeType when IMGUI_ENABLE_FREETYPE is defined, otherwise default to use stb_truetype). Use SetFontLoader() to change this at runtime.
     const char*                 FontLoaderName;     // Font loader name (for display e.g. in About box) == FontLoader->Name
     void*                       FontLoaderData;     // Font backend opaque storage
@@ -3787,6 +3896,8 @@ struct ImFontBaked
     unsigned int                LoadNoFallback:1;      // 0  //     // Disable loading fallback in lower-level calls.
     unsigned int                LoadNoRenderOnLayout:1;// 0  //     // Enable a two-steps mode where CalcTextSize() calls will load AdvanceX *without* rendering/packing glyphs. Only advantagous if you know that the glyph is unlikely to actually be rendered, otherwise it is slower because we'd do one query on the first CalcTextSize and one query on the first Draw.
     int                         LastUsedFrame;         // 4  //     // Record of that time this was bounds
+    int                         GlyphsUvGeneration;    // 4  //     // Changed when glyphs are moved or evicted in atlas texture (unique within atlas). Hashed by retained draw lists, which may hold vertices using old UV.
+    ImVector<ImU16>             GlyphsFreeList;     // 12-16 //     // Indices of evicted glyphs in Glyphs[], reused by the next loaded glyphs.
     ImGuiID                     BakedId;            // 4     //     // Unique ID for this baked storage
     ImFont*                     ContainerFont;      // 4-8   // in  // Parent font
     void*                       FontLoaderDatas;    // 4-8   //     // Font loader opaque storage (per baked font * sources): single contiguous buffer allocated by imgui, passed to loader.
@@ -3798,6 +3909,8 @@ struct ImFontBaked
     IMGUI_API ImFontGlyph*      FindGlyphNoFallback(ImWchar c);     // Return NULL if glyph doesn't exist
     IMGUI_API float             GetCharAdvance(ImWchar c);
     IMGUI_API bool              IsGlyphLoaded(ImWchar c);
+    IMGUI_API void              LoadGlyphs(const ImWchar* codepoints, int codepoints_count);  // Load missing glyphs in one batch: rasterized in parallel if platform_io.Platform_ParallelForFn is set, then packed with a single texture update.
+    IMGUI_API void              LoadGlyphsFromText(const char* text, const char* text_end = NULL); // Same for all characters of a text (e.g. a table of localized strings). Text functions already do this on their first missing glyph.
 };
 
 // Font flags
@@ -3955,6 +4068,11 @@ struct ImGuiPlatformIO
     // [Experimental] Configure decimal point e.g. '.' or ',' useful for some languages (e.g. German), generally pulled from *localeconv()->decimal_point
     ImWchar     Platform_LocaleDecimalPoint;     // '.'
 
+    // Optional: Run jobs on worker threads: call job_fn(job_data, job_n) for each job_n in [0, jobs_count) and return once all calls have returned.
+    // Used to rasterize batches of missing glyphs in parallel (see ImFontBaked::LoadGlyphs()). Jobs don't access the ImGui context, but allocate memory with the functions given to SetAllocatorFunctions(), which need to be thread-safe.
+    void        (*Platform_ParallelForFn)(ImGuiContext* ctx, void (*job_fn)(void* job_data, int job_n), void* job_data, int jobs_count);
+    void*       Platform_ParallelForUserData;
+
     //------------------------------------------------------------------
     // Input - Interface with Renderer Backend
     //------------------------------------------------------------------
@@ -11,6 +11,8 @@ Index of this file:
 // [SECTION] ImTriangulator, ImDrawList concave polygon fill
 // [SECTION] ImDrawListSplitter
 // [SECTION] ImDrawData
+// [SECTION] ImDrawDamageTracker
+// [SECTION] ImDrawDataMerger
 // [SECTION] Helpers ShadeVertsXXX functions
 // [SECTION] ImFontConfig
 // [SECTION] ImFontAtlas, ImFontAtlasBuilder
@@ -137,8 +139,8 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+#define STBTT_malloc(x,u)   ((u) ? ((ImFontGlyphBitmap*)(u))->AllocFunc(x, ((ImFontGlyphBitmap*)(u))->AllocUserData) : IM_ALLOC(x))   // Non-NULL userdata when called from ImGui_ImplStbTrueType_FontBakedRasterizeGlyph()
+#define STBTT_free(x,u)     ((u) ? ((ImFontGlyphBitmap*)(u))->FreeFunc(x, ((ImFontGlyphBitmap*)(u))->AllocUserData) : IM_FREE(x))
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -437,6 +439,71 @@ void ImDrawList::_SetDrawListSharedData(ImDrawListSharedData* data)
         _Data->DrawLists.push_back(this);
 }
 
+// Draw call identifiers for _RetainedBeginDrawCall()
+enum ImDrawListRetainedCall_
+{
+    ImDrawListRetainedCall_Polyline,
+    ImDrawListRetainedCall_ConvexPolyFilled,
+    ImDrawListRetainedCall_ConcavePolyFilled,
+    ImDrawListRetainedCall_RectFilled,
+    ImDrawListRetainedCall_RectFilledMultiColor,
+    ImDrawListRetainedCall_Text,
+    ImDrawListRetainedCall_Image,
+    ImDrawListRetainedCall_ImageQuad,
+    ImDrawListRetainedCall_Callback,
+};
+
+// Retained mode: save/restore output state, see _RetainedBeginDrawCall()
+static void ImDrawList_RetainedSaveState(const ImDrawList* draw_list, ImDrawListRetainedEntry* entry)
+{
+    entry->CmdCount = draw_list->CmdBuffer.Size;
+    entry->IdxCount = draw_list->IdxBuffer.Size;
+    entry->VtxCount = draw_list->VtxBuffer.Size;
+    entry->QuadCount = draw_list->QuadBuffer.Size;
+    entry->CallbacksDataCount = draw_list->_CallbacksDataBuf.Size;
+    entry->VtxCurrentIdx = draw_list->_VtxCurrentIdx;
+    entry->LastCmd = draw_list->CmdBuffer.back();
+    entry->PrevCmd = (draw_list->CmdBuffer.Size > 1) ? draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 2] : ImDrawCmd();
+}
+
+// While replaying, buffers hold last frame final output and we only move their sizes forward (capacity can't have shrunk since).
+// CmdBuffer.back() may still be appended to by following draw calls: we show it as it was at this point, and backup its final value.
+static void ImDrawList_RetainedReplayMoveTo(ImDrawList* draw_list, const ImDrawListRetainedEntry* entry)
+{
+    ImDrawListRetainedData* retained = draw_list->_Retained;
+    IM_ASSERT_PARANOID(entry->CmdCount <= draw_list->CmdBuffer.Capacity && entry->VtxCount <= draw_list->VtxBuffer.Capacity);
+    if (retained->ReplayBackCmdIdx >= 0 && retained->ReplayBackCmdIdx != entry->CmdCount - 1)
+    {
+        draw_list->CmdBuffer.Data[retained->ReplayBackCmdIdx] = retained->ReplayBackCmd;
+        retained->ReplayBackCmdIdx = -1;
+    }
+    draw_list->CmdBuffer.Size = entry->CmdCount;
+    draw_list->IdxBuffer.Size = entry->IdxCount;
+    draw_list->VtxBuffer.Size = entry->VtxCount;
+    draw_list->QuadBuffer.Size = entry->QuadCount;
+    draw_list->_CallbacksDataBuf.Size = entry->CallbacksDataCount;
+    draw_list->_VtxWritePtr = draw_list->VtxBuffer.Data + draw_list->VtxBuffer.Size;
+    draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
+    draw_list->_QuadWritePtr = draw_list->QuadBuffer.Data + draw_list->QuadBuffer.Size;
+    draw_list->_VtxCurrentIdx = entry->VtxCurrentIdx;
+    draw_list->_CmdHeader.VtxOffset = entry->LastCmd.VtxOffset;
+    if (retained->ReplayBackCmdIdx < 0)
+    {
+        retained->ReplayBackCmdIdx = draw_list->CmdBuffer.Size - 1;
+        retained->ReplayBackCmd = draw_list->CmdBuffer.Data[retained->ReplayBackCmdIdx];
+    }
+    draw_list->CmdBuffer.Data[retained->ReplayBackCmdIdx] = entry->LastCmd;
+}
+
+// Stop replaying at this entry: output which followed will be regenerated, or was final.
+static void ImDrawList_RetainedLoadState(ImDrawList* draw_list, const ImDrawListRetainedEntry* entry)
+{
+    ImDrawList_RetainedReplayMoveTo(draw_list, entry);
+    if (draw_list->CmdBuffer.Size > 1)
+        draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 2] = entry->PrevCmd; // May have been appended to later, after a _OnChangedClipRect()/_OnChangedTexture() merge popped CmdBuffer.back()
+    draw_list->_Retained->ReplayBackCmdIdx = -1;
+}
+
 // Initialize before use in a new frame. We always have a command ready in the buffer.
 // In the majority of cases, you would want to call PushClipRect() and PushTexture() after this.
 void ImDrawList::_ResetForNewFrame()
@@ -448,21 +515,49 @@ void ImDrawList::_ResetForNewFrame()
     if (_Splitter._Count > 1)
         _Splitter.Merge(this);
 
-    CmdBuffer.resize(0);
-    IdxBuffer.resize(0);
-    VtxBuffer.resize(0);
+    // In retained mode, keep last frame output if it was completed: draw calls matching the journal will reuse it.
+    ImDrawListRetainedData* retained = _Retained;
+    const bool replay = (retained != NULL && retained->State == ImDrawListRetainedState_Ended && retained->Entries.Size > 0);
+    if (!replay)
+    {
+        CmdBuffer.resize(0);
+        IdxBuffer.resize(0);
+        VtxBuffer.resize(0);
+        QuadBuffer.resize(0);
+        _CallbacksDataBuf.resize(0);
+    }
     Flags = _Data->InitialFlags;
     memset(&_CmdHeader, 0, sizeof(_CmdHeader));
     _VtxCurrentIdx = 0;
     _VtxWritePtr = NULL;
     _IdxWritePtr = NULL;
+    _QuadWritePtr = NULL;
     _ClipRectStack.resize(0);
     _TextureStack.resize(0);
-    _CallbacksDataBuf.resize(0);
     _Path.resize(0);
     _Splitter.Clear();
-    CmdBuffer.push_back(ImDrawCmd());
+    if (replay)
+    {
+        retained->ReplayBackCmdIdx = -1;
+        ImDrawList_RetainedReplayMoveTo(this, &retained->Entries[0]);
+    }
+    else
+        CmdBuffer.push_back(ImDrawCmd());
     _FringeScale = _Data->InitialFringeScale;
+
+    if (retained != NULL)
+    {
+        retained->State = replay ? ImDrawListRetainedState_Replaying : ImDrawListRetainedState_Recording;
+        retained->Cursor = 0;
+        retained->Hash = 0;
+        retained->InDrawCall = false;
+        retained->DrawCalls = retained->DrawCallsReused = 0;
+        if (!replay)
+        {
+            retained->Entries.resize(0);
+            retained->EndedWithFrame = false;
+        }
+    }
 }
 
 void ImDrawList::_ClearFreeMemory()
@@ -470,15 +565,18 @@ void ImDrawList::_ClearFreeMemory()
     CmdBuffer.clear();
     IdxBuffer.clear();
     VtxBuffer.clear();
+    QuadBuffer.clear();
     Flags = ImDrawListFlags_None;
     _VtxCurrentIdx = 0;
     _VtxWritePtr = NULL;
     _IdxWritePtr = NULL;
+    _QuadWritePtr = NULL;
     _ClipRectStack.clear();
     _TextureStack.clear();
     _CallbacksDataBuf.clear();
     _Path.clear();
     _Splitter.ClearFreeMemory();
+    _SetRetained(false);
 }
 
 // Note: For multi-threaded rendering, consider using `imgui_threaded_rendering` from https://github.com/ocornut/imgui_club
@@ -488,17 +586,22 @@ ImDrawList* ImDrawList::CloneOutput() const
     dst->CmdBuffer = CmdBuffer;
     dst->IdxBuffer = IdxBuffer;
     dst->VtxBuffer = VtxBuffer;
+    dst->QuadBuffer = QuadBuffer;
     dst->Flags = Flags;
     return dst;
 }
 
 void ImDrawList::AddDrawCmd()
 {
+    if (_Retained != NULL && _RetainedOnStateChange())
+        return;
+
     ImDrawCmd draw_cmd;
     draw_cmd.ClipRect = _CmdHeader.ClipRect;    // Same as calling ImDrawCmd_HeaderCopy()
     draw_cmd.TexRef = _CmdHeader.TexRef;
     draw_cmd.VtxOffset = _CmdHeader.VtxOffset;
     draw_cmd.IdxOffset = IdxBuffer.Size;
+    draw_cmd.QuadOffset = QuadBuffer.Size;
 
     IM_ASSERT(draw_cmd.ClipRect.x <= draw_cmd.ClipRect.z && draw_cmd.ClipRect.y <= draw_cmd.ClipRect.w);
     CmdBuffer.push_back(draw_cmd);
@@ -511,7 +614,7 @@ void ImDrawList::_PopUnusedDrawCmd()
     while (CmdBuffer.Size > 0)
     {
         ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
-        if (curr_cmd->ElemCount != 0 || curr_cmd->UserCallback != NULL)
+        if (curr_cmd->ElemCount != 0 || curr_cmd->QuadCount != 0 || curr_cmd->UserCallback != NULL)
             return;// break;
         CmdBuffer.pop_back();
     }
@@ -519,11 +622,18 @@ void ImDrawList::_PopUnusedDrawCmd()
 
 void ImDrawList::AddCallback(ImDrawCallback callback, void* userdata, size_t userdata_size)
 {
+    if (_Retained != NULL)
+    {
+        struct { ImU64 Callback; ImU64 UserData; ImU64 UserDataSize; } args = { (ImU64)(intptr_t)callback, (ImU64)(intptr_t)(userdata_size == 0 ? userdata : NULL), (ImU64)userdata_size };
+        if (_RetainedBeginDrawCall(ImDrawListRetainedCall_Callback, &args, sizeof(args), userdata, userdata_size))
+            return;
+    }
+
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     IM_ASSERT(callback != NULL);
     IM_ASSERT(curr_cmd->UserCallback == NULL);
-    if (curr_cmd->ElemCount != 0)
+    if (curr_cmd->ElemCount != 0 || curr_cmd->QuadCount != 0)
     {
         AddDrawCmd();
         curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
@@ -550,6 +660,8 @@ void ImDrawList::AddCallback(ImDrawCallback callback, void* userdata, size_t use
     }
 
     AddDrawCmd(); // Force a new command after us (see comment below)
+    if (_Retained != NULL)
+        _Retained->InDrawCall = false;
 }
 
 // Compare ClipRect, TexRef and VtxOffset with a single memcmp()
@@ -557,6 +669,7 @@ void ImDrawList::AddCallback(ImDrawCallback callback, void* userdata, size_t use
 #define ImDrawCmd_HeaderCompare(CMD_LHS, CMD_RHS)       (memcmp(CMD_LHS, CMD_RHS, ImDrawCmd_HeaderSize))    // Compare ClipRect, TexRef, VtxOffset
 #define ImDrawCmd_HeaderCopy(CMD_DST, CMD_SRC)          (memcpy(CMD_DST, CMD_SRC, ImDrawCmd_HeaderSize))    // Copy ClipRect, TexRef, VtxOffset
 #define ImDrawCmd_AreSequentialIdxOffset(CMD_0, CMD_1)  (CMD_0->IdxOffset + CMD_0->ElemCount == CMD_1->IdxOffset)
+#define ImDrawCmd_CanAppendQuads(CMD_0, CMD_1)          (CMD_0->QuadCount == 0 || (CMD_1->ElemCount == 0 && (CMD_1->QuadCount == 0 || CMD_0->QuadOffset + CMD_0->QuadCount == CMD_1->QuadOffset))) // Quads are drawn after triangles: CMD_1 triangles can't be merged after CMD_0 quads
 
 // Try to merge two last draw commands
 void ImDrawList::_TryMergeDrawCmds()
@@ -564,9 +677,12 @@ void ImDrawList::_TryMergeDrawCmds()
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     ImDrawCmd* prev_cmd = curr_cmd - 1;
-    if (ImDrawCmd_HeaderCompare(curr_cmd, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && curr_cmd->UserCallback == NULL && prev_cmd->UserCallback == NULL)
+    if (ImDrawCmd_HeaderCompare(curr_cmd, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && ImDrawCmd_CanAppendQuads(prev_cmd, curr_cmd) && curr_cmd->UserCallback == NULL && prev_cmd->UserCallback == NULL)
     {
         prev_cmd->ElemCount += curr_cmd->ElemCount;
+        if (prev_cmd->QuadCount == 0)
+            prev_cmd->QuadOffset = curr_cmd->QuadOffset;
+        prev_cmd->QuadCount += curr_cmd->QuadCount;
         CmdBuffer.pop_back();
     }
 }
@@ -575,10 +691,13 @@ void ImDrawList::_TryMergeDrawCmds()
 // The cost of figuring out if a new command has to be added or if we can merge is paid in those Update** functions only.
 void ImDrawList::_OnChangedClipRect()
 {
+    if (_Retained != NULL && _RetainedOnStateChange())
+        return;
+
     // If current command is used with different settings we need to add a new command
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
-    if (curr_cmd->ElemCount != 0 && memcmp(&curr_cmd->ClipRect, &_CmdHeader.ClipRect, sizeof(ImVec4)) != 0)
+    if ((curr_cmd->ElemCount != 0 || curr_cmd->QuadCount != 0) && memcmp(&curr_cmd->ClipRect, &_CmdHeader.ClipRect, sizeof(ImVec4)) != 0)
     {
         AddDrawCmd();
         return;
@@ -587,7 +706,7 @@ void ImDrawList::_OnChangedClipRect()
 
     // Try to merge with previous command if it matches, else use current command
     ImDrawCmd* prev_cmd = curr_cmd - 1;
-    if (curr_cmd->ElemCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && curr_cmd->QuadCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
     {
         CmdBuffer.pop_back();
         return;
@@ -597,10 +716,13 @@ void ImDrawList::_OnChangedClipRect()
 
 void ImDrawList::_OnChangedTexture()
 {
+    if (_Retained != NULL && _RetainedOnStateChange())
+        return;
+
     // If current command is used with different settings we need to add a new command
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
-    if (curr_cmd->ElemCount != 0 && curr_cmd->TexRef != _CmdHeader.TexRef)
+    if ((curr_cmd->ElemCount != 0 || curr_cmd->QuadCount != 0) && curr_cmd->TexRef != _CmdHeader.TexRef)
     {
         AddDrawCmd();
         return;
@@ -612,7 +734,7 @@ void ImDrawList::_OnChangedTexture()
 
     // Try to merge with previous command if it matches, else use current command
     ImDrawCmd* prev_cmd = curr_cmd - 1;
-    if (curr_cmd->ElemCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && curr_cmd->QuadCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
     {
         CmdBuffer.pop_back();
         return;
@@ -627,7 +749,7 @@ void ImDrawList::_OnChangedVtxOffset()
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     //IM_ASSERT(curr_cmd->VtxOffset != _CmdHeader.VtxOffset); // See #3349
-    if (curr_cmd->ElemCount != 0)
+    if (curr_cmd->ElemCount != 0 || curr_cmd->QuadCount != 0)
     {
         AddDrawCmd();
         return;
@@ -636,6 +758,195 @@ void ImDrawList::_OnChangedVtxOffset()
     curr_cmd->VtxOffset = _CmdHeader.VtxOffset;
 }
 
+// Retained mode is enabled by ImGuiWindowRefreshFlags_RetainDrawList, but may be used on any draw list which is reset every frame.
+// - Each draw call (AddPolyline(), AddConvexPolyFilled(), AddConcavePolyFilled(), AddRectFilled(), AddText(), AddImage() etc.)
+//   hashes its parameters along with the current command header and calls _RetainedBeginDrawCall().
+// - As long as the running hash matches the one recorded during last frame, the draw call is skipped and buffers are resized to
+//   where last frame left them after it. On the first mismatch we restore the output state recorded before that draw call and
+//   continue as usual from there, recording a new journal.
+// - Changing clip rect or texture doesn't touch the buffers while replaying: the next draw call hash includes them.
+// - Buffer writes which don't come from a draw call (direct PrimReserve() calls, ChannelsSplit(), ShadeVertsTransformPos()) stop
+//   replaying and close the journal: only draw calls submitted before them may be reused on the next frame.
+// - Direct modifications of CmdBuffer[], IdxBuffer[] or VtxBuffer[] contents can't be detected and are not supported.
+void ImDrawList::_SetRetained(bool retained)
+{
+    if (retained && _Retained == NULL)
+    {
+        _Retained = IM_NEW(ImDrawListRetainedData)();
+    }
+    else if (!retained && _Retained != NULL)
+    {
+        IM_DELETE(_Retained);
+        _Retained = NULL;
+    }
+}
+
+// Hash 8 bytes at a time (MurmurHash3 x64 mixing): ImHashData() processes one byte per iteration, which would cost more than
+// generating the vertices of most draw calls.
+static ImU64 ImDrawList_RetainedHash(const void* data, size_t data_size, ImU64 hash)
+{
+    const ImU64 c1 = 0x87C37B91114253D5ULL;
+    const ImU64 c2 = 0x4CF5AD432745937FULL;
+    const unsigned char* p = (const unsigned char*)data;
+    for (; data_size >= 8; data_size -= 8, p += 8)
+    {
+        ImU64 k;
+        memcpy(&k, p, 8);
+        k *= c1;
+        k = (k << 31) | (k >> 33);
+        k *= c2;
+        hash ^= k;
+        hash = (hash << 27) | (hash >> 37);
+        hash = hash * 5 + 0x52DCE729;
+    }
+    if (data_size > 0)
+    {
+        ImU64 k = 0;
+        memcpy(&k, p, data_size);
+        k *= c1;
+        k = (k << 31) | (k >> 33);
+        k *= c2;
+        hash ^= k ^ (ImU64)data_size;
+        hash = (hash << 27) | (hash >> 37);
+        hash = hash * 5 + 0x52DCE729;
+    }
+    return hash;
+}
+
+static void ImDrawList_RetainedStopReplay(ImDrawList* draw_list)
+{
+    ImDrawListRetainedData* retained = draw_list->_Retained;
+    IM_ASSERT(retained->State == ImDrawListRetainedState_Replaying);
+    ImDrawList_RetainedLoadState(draw_list, &retained->Entries[retained->Cursor]);
+    retained->Entries.resize(retained->Cursor);
+    retained->State = ImDrawListRetainedState_Recording;
+    retained->EndedWithFrame = false;
+
+    // Clip rect and texture changes were not applied to buffers while replaying
+    draw_list->_OnChangedClipRect();
+    draw_list->_OnChangedTexture();
+}
+
+// Return true if the draw call can be skipped. Otherwise caller needs to clear _Retained->InDrawCall when done.
+bool ImDrawList::_RetainedBeginDrawCall(int kind, const void* args, size_t args_size, const void* data, size_t data_size)
+{
+    ImDrawListRetainedData* retained = _Retained;
+    IM_ASSERT(retained->InDrawCall == false);
+    retained->InDrawCall = true;
+    retained->DrawCalls++;
+    if (retained->State == ImDrawListRetainedState_Ended)
+        retained->Entries.resize(0); // Drawing after the frame ended (e.g. RenderDimmedBackgrounds()): last frame output won't match our journal.
+    if (retained->State != ImDrawListRetainedState_Recording && retained->State != ImDrawListRetainedState_Replaying)
+        return false;
+
+    // Hash command header (texture identified by its unique id too, as a ImTextureData address may be reused) + parameters
+    struct { ImVec4 ClipRect; ImU64 TexData; ImU64 TexID; int TexUniqueID; int Kind; ImDrawListFlags Flags; float FringeScale; } header;
+    IM_STATIC_ASSERT(sizeof(ImTextureID) <= sizeof(ImU64));
+    memset(&header, 0, sizeof(header)); // Clear padding
+    header.ClipRect = _CmdHeader.ClipRect;
+    header.TexData = (ImU64)(intptr_t)_CmdHeader.TexRef._TexData;
+    memcpy(&header.TexID, &_CmdHeader.TexRef._TexID, sizeof(ImTextureID));
+    header.TexUniqueID = _CmdHeader.TexRef._TexData ? _CmdHeader.TexRef._TexData->UniqueID : 0;
+    header.Kind = kind;
+    header.Flags = Flags;
+    header.FringeScale = _FringeScale;
+    ImU64 hash = ImDrawList_RetainedHash(&header, sizeof(header), retained->Hash);
+    hash = ImDrawList_RetainedHash(args, args_size, hash);
+    if (data_size > 0)
+        hash = ImDrawList_RetainedHash(data, data_size, hash);
+    retained->Hash = hash;
+
+    if (retained->State == ImDrawListRetainedState_Replaying)
+    {
+        const int n = retained->Cursor;
+        if (n + 1 < retained->Entries.Size && retained->Entries[n].Hash == hash)
+        {
+            ImDrawList_RetainedReplayMoveTo(this, &retained->Entries[n + 1]);
+            retained->Cursor++;
+            retained->DrawCallsReused++;
+            retained->InDrawCall = false;
+            return true;
+        }
+        ImDrawList_RetainedStopReplay(this);
+    }
+
+    retained->Entries.resize(retained->Entries.Size + 1);
+    ImDrawListRetainedEntry* entry = &retained->Entries.back();
+    entry->Hash = hash;
+    ImDrawList_RetainedSaveState(this, entry);
+    retained->Cursor++;
+    return false;
+}
+
+// Called before changing the command header of CmdBuffer.back() or adding a command. Return true if buffers must be left untouched.
+bool ImDrawList::_RetainedOnStateChange()
+{
+    ImDrawListRetainedData* retained = _Retained;
+    if (retained->State == ImDrawListRetainedState_Replaying)
+        return true;
+    if (retained->State == ImDrawListRetainedState_Ended)
+        retained->Entries.resize(0);
+    return false;
+}
+
+// Called before writing to buffers outside of a draw call.
+// When 'vtx_start' is specified, vertices from this index onward are being modified: draw calls which output them can't be reused either.
+void ImDrawList::_RetainedOnUntrackedWrite(int vtx_start)
+{
+    ImDrawListRetainedData* retained = _Retained;
+    if (retained->InDrawCall && vtx_start < 0)
+        return;
+    if (retained->State == ImDrawListRetainedState_Ended)
+    {
+        retained->Entries.resize(0);
+        return;
+    }
+    if (retained->State == ImDrawListRetainedState_Replaying)
+        ImDrawList_RetainedStopReplay(this);
+    if (retained->State == ImDrawListRetainedState_Recording)
+    {
+        // Close journal with current state
+        retained->Entries.resize(retained->Entries.Size + 1);
+        ImDrawListRetainedEntry* entry = &retained->Entries.back();
+        entry->Hash = 0;
+        ImDrawList_RetainedSaveState(this, entry);
+        retained->State = ImDrawListRetainedState_Closed;
+    }
+    if (vtx_start >= 0)
+        for (int n = 0; n < retained->Entries.Size; n++)
+            if (retained->Entries[n].VtxCount > vtx_start)
+            {
+                retained->Entries.resize(n); // Entry n-1 becomes the last entry: the draw call which output 'vtx_start' won't be reused.
+                break;
+            }
+}
+
+// Called once the draw list is complete for the frame (before _PopUnusedDrawCmd() and adding to a ImDrawData).
+void ImDrawList::_RetainedEndFrame()
+{
+    ImDrawListRetainedData* retained = _Retained;
+    if (retained->State == ImDrawListRetainedState_Ended)
+        return;
+    if (retained->State == ImDrawListRetainedState_Replaying)
+    {
+        if (retained->EndedWithFrame && retained->Cursor + 1 == retained->Entries.Size)
+            ImDrawList_RetainedLoadState(this, &retained->Entries[retained->Cursor]); // All draw calls reused
+        else
+            ImDrawList_RetainedStopReplay(this);
+    }
+    if (retained->State == ImDrawListRetainedState_Recording)
+    {
+        retained->Entries.resize(retained->Entries.Size + 1);
+        ImDrawListRetainedEntry* entry = &retained->Entries.back();
+        entry->Hash = 0;
+        ImDrawList_RetainedSaveState(this, entry);
+        retained->EndedWithFrame = true;
+    }
+    retained->State = ImDrawListRetainedState_Ended;
+    retained->LastFrameDrawCalls = retained->DrawCalls;
+    retained->LastFrameDrawCallsReused = retained->DrawCallsReused;
+}
+
 int ImDrawList::_CalcCircleAutoSegmentCount(float radius) const
 {
     // Automatic segment count
@@ -709,18 +1020,26 @@ void ImDrawList::_SetTexture(ImTextureRef tex_ref)
 // submit the intermediate results. PrimUnreserve() can be used to release unused allocations.
 void ImDrawList::PrimReserve(int idx_count, int vtx_count)
 {
+    if (_Retained != NULL)
+        _RetainedOnUntrackedWrite();
+
     // Large mesh support (when enabled)
     IM_ASSERT_PARANOID(idx_count >= 0 && vtx_count >= 0);
     if (sizeof(ImDrawIdx) == 2 && (_VtxCurrentIdx + vtx_count >= (1 << 16)) && (Flags & ImDrawListFlags_AllowVtxOffset))
     {
         // FIXME: In theory we should be testing that vtx_count <64k here.
-        // In practice, RenderText() relies on reserving ahead for a worst case scenario so it is currently useful for us
-        // to not make that check until we rework the text functions to handle clipping and large horizontal lines better.
+        // RenderText() now reserves in chunks of IM_DRAWLIST_TEXT_CHUNK_SIZE glyphs, but very large paths still reserve ahead in one call.
         _CmdHeader.VtxOffset = VtxBuffer.Size;
         _OnChangedVtxOffset();
     }
 
     ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    if (draw_cmd->QuadCount != 0)
+    {
+        // Quads are rendered after triangles of a same command: need a new command to preserve ordering.
+        AddDrawCmd();
+        draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    }
     draw_cmd->ElemCount += idx_count;
 
     int vtx_buffer_old_size = VtxBuffer.Size;
@@ -743,17 +1062,153 @@ void ImDrawList::PrimUnreserve(int idx_count, int vtx_count)
     IdxBuffer.shrink(IdxBuffer.Size - idx_count);
 }
 
+// Reserve space for a number of ImDrawQuad instances. Requires ImDrawListFlags_InstancedQuads.
+// Same rules as PrimReserve(): finish writing with PrimWriteQuad() before reserving again.
+void ImDrawList::PrimReserveQuads(int quad_count)
+{
+    if (_Retained != NULL)
+        _RetainedOnUntrackedWrite();
+
+    IM_ASSERT_PARANOID(quad_count >= 0);
+    IM_ASSERT_PARANOID(Flags & ImDrawListFlags_InstancedQuads);
+    ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    if (draw_cmd->QuadCount == 0)
+        draw_cmd->QuadOffset = QuadBuffer.Size;
+    else if (draw_cmd->QuadOffset + draw_cmd->QuadCount != (unsigned int)QuadBuffer.Size)
+    {
+        // Not contiguous, e.g. after switching channels with ImDrawListSplitter (all channels share the same QuadBuffer)
+        AddDrawCmd();
+        draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    }
+    draw_cmd->QuadCount += quad_count;
+
+    int quad_buffer_old_size = QuadBuffer.Size;
+    QuadBuffer.resize(quad_buffer_old_size + quad_count);
+    _QuadWritePtr = QuadBuffer.Data + quad_buffer_old_size;
+}
+
+// Release the number of reserved quads from the end of the last reservation made with PrimReserveQuads().
+void ImDrawList::PrimUnreserveQuads(int quad_count)
+{
+    IM_ASSERT_PARANOID(quad_count >= 0);
+
+    ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    draw_cmd->QuadCount -= quad_count;
+    QuadBuffer.shrink(QuadBuffer.Size - quad_count);
+}
+
+// SIMD helpers to write axis-aligned rectangles, used by PrimRect(), PrimRectUV() and ImFont::RenderText().
+// - Each vertex pos+uv pair is written with a single 16 bytes store (requires the default ImDrawVert layout).
+// - Indices of consecutive rectangles follow the same pattern: ImDrawList_WriteRectIndices() writes them in batches from a precomputed table.
+#if defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)
+#define IMGUI_ENABLE_SIMD_DRAWLIST      // Tessellation math
+#if !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+#define IMGUI_ENABLE_SIMD_RECTS         // Vertex writes
+#endif
+#endif
+
+#ifdef IMGUI_ENABLE_SIMD_RECTS
+IM_STATIC_ASSERT(sizeof(ImDrawVert) == 20 && offsetof(ImDrawVert, uv) == 8 && offsetof(ImDrawVert, col) == 16);
+IM_STATIC_ASSERT(offsetof(ImDrawQuad, Size) == 8 && offsetof(ImDrawQuad, UvMax) == 24 && offsetof(ImDrawQuad, Col) == 32);
+
+// 'pos' = (x1, y1, x2, y2), 'uv' = (u1, v1, u2, v2). Outputs 4 vertices in PrimRectUV() order: (x1,y1) (x2,y1) (x2,y2) (x1,y2).
+#ifdef IMGUI_ENABLE_SSE
+typedef __m128 ImDrawListSimdRect;
+static inline ImDrawListSimdRect ImDrawList_SimdRectSet(float x1, float y1, float x2, float y2) { return _mm_setr_ps(x1, y1, x2, y2); }
+static inline void ImDrawList_WriteRectVtx(ImDrawVert* vtx, __m128 pos, __m128 uv, ImU32 col)
+{
+    float* dst = (float*)(void*)vtx;
+    _mm_storeu_ps(dst + 0,  _mm_movelh_ps(pos, uv));                            // x1 y1 u1 v1
+    _mm_storeu_ps(dst + 5,  _mm_shuffle_ps(pos, uv, _MM_SHUFFLE(1, 2, 1, 2)));   // x2 y1 u2 v1
+    _mm_storeu_ps(dst + 10, _mm_movehl_ps(uv, pos));                            // x2 y2 u2 v2
+    _mm_storeu_ps(dst + 15, _mm_shuffle_ps(pos, uv, _MM_SHUFFLE(3, 0, 3, 0)));   // x1 y2 u1 v2
+    vtx[0].col = vtx[1].col = vtx[2].col = vtx[3].col = col;
+}
+static inline void ImDrawList_WriteRectQuad(ImDrawQuad* quad, __m128 pos, __m128 uv, ImU32 col)
+{
+    _mm_storeu_ps(&quad->Pos.x, _mm_sub_ps(pos, _mm_movelh_ps(_mm_setzero_ps(), pos))); // x1 y1 (x2-x1) (y2-y1)
+    _mm_storeu_ps(&quad->UvMin.x, uv);
+    quad->Col = col;
+}
+#else
+typedef float32x4_t ImDrawListSimdRect;
+static inline ImDrawListSimdRect ImDrawList_SimdRectSet(float x1, float y1, float x2, float y2) { const float v[4] = { x1, y1, x2, y2 }; return vld1q_f32(v); }
+static inline void ImDrawList_WriteRectVtx(ImDrawVert* vtx, float32x4_t pos, float32x4_t uv, ImU32 col)
+{
+    float* dst = (float*)(void*)vtx;
+    const float32x2_t p_a = vget_low_f32(pos), p_c = vget_high_f32(pos), uv_a = vget_low_f32(uv), uv_c = vget_high_f32(uv);
+    vst1q_f32(dst + 0,  vcombine_f32(p_a, uv_a));                                                   // x1 y1 u1 v1
+    vst1q_f32(dst + 5,  vcombine_f32(vrev64_f32(vext_f32(p_a, p_c, 1)), vrev64_f32(vext_f32(uv_a, uv_c, 1)))); // x2 y1 u2 v1
+    vst1q_f32(dst + 10, vcombine_f32(p_c, uv_c));                                                   // x2 y2 u2 v2
+    vst1q_f32(dst + 15, vcombine_f32(vrev64_f32(vext_f32(p_c, p_a, 1)), vrev64_f32(vext_f32(uv_c, uv_a, 1)))); // x1 y2 u1 v2
+    vtx[0].col = vtx[1].col = vtx[2].col = vtx[3].col = col;
+}
+static inline void ImDrawList_WriteRectQuad(ImDrawQuad* quad, float32x4_t pos, float32x4_t uv, ImU32 col)
+{
+    vst1q_f32(&quad->Pos.x, vsubq_f32(pos, vcombine_f32(vdup_n_f32(0.0f), vget_low_f32(pos)))); // x1 y1 (x2-x1) (y2-y1)
+    vst1q_f32(&quad->UvMin.x, uv);
+    quad->Col = col;
+}
+#endif
+#endif // #ifdef IMGUI_ENABLE_SIMD_RECTS
+
+// Write indices for 'rect_count' consecutive rectangles whose vertices start at 'vtx_idx': (0,1,2, 0,2,3), (4,5,6, 4,6,7)...
+static void ImDrawList_WriteRectIndices(ImDrawIdx* idx_write, unsigned int vtx_idx, int rect_count)
+{
+#ifdef IMGUI_ENABLE_SIMD_RECTS
+    // 4 rectangles = 24 indices = 48 bytes (16-bit indices) or 96 bytes (32-bit indices) per iteration
+    static const ImDrawIdx pattern[24] = { 0,1,2,0,2,3, 4,5,6,4,6,7, 8,9,10,8,10,11, 12,13,14,12,14,15 };
+    for (; rect_count >= 4; rect_count -= 4, vtx_idx += 16, idx_write += 24)
+    {
+        if (sizeof(ImDrawIdx) == 2)
+        {
+#ifdef IMGUI_ENABLE_SSE
+            const __m128i base = _mm_set1_epi16((short)vtx_idx);
+            for (int n = 0; n < 3; n++)
+                _mm_storeu_si128((__m128i*)(void*)(idx_write + n * 8), _mm_add_epi16(base, _mm_loadu_si128((const __m128i*)(const void*)(pattern + n * 8))));
+#else
+            const uint16x8_t base = vdupq_n_u16((uint16_t)vtx_idx);
+            for (int n = 0; n < 3; n++)
+                vst1q_u16((uint16_t*)(void*)(idx_write + n * 8), vaddq_u16(base, vld1q_u16((const uint16_t*)(const void*)(pattern + n * 8))));
+#endif
+        }
+        else
+        {
+#ifdef IMGUI_ENABLE_SSE
+            const __m128i base = _mm_set1_epi32((int)vtx_idx);
+            for (int n = 0; n < 6; n++)
+                _mm_storeu_si128((__m128i*)(void*)(idx_write + n * 4), _mm_add_epi32(base, _mm_loadu_si128((const __m128i*)(const void*)(pattern + n * 4))));
+#else
+            const uint32x4_t base = vdupq_n_u32((uint32_t)vtx_idx);
+            for (int n = 0; n < 6; n++)
+                vst1q_u32((uint32_t*)(void*)(idx_write + n * 4), vaddq_u32(base, vld1q_u32((const uint32_t*)(const void*)(pattern + n * 4))));
+#endif
+        }
+    }
+#endif
+    for (; rect_count > 0; rect_count--, vtx_idx += 4, idx_write += 6)
+    {
+        idx_write[0] = (ImDrawIdx)(vtx_idx); idx_write[1] = (ImDrawIdx)(vtx_idx + 1); idx_write[2] = (ImDrawIdx)(vtx_idx + 2);
+        idx_write[3] = (ImDrawIdx)(vtx_idx); idx_write[4] = (ImDrawIdx)(vtx_idx + 2); idx_write[5] = (ImDrawIdx)(vtx_idx + 3);
+    }
+}
+
 // Fully unrolled with inline call to keep our debug builds decently fast.
 void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
 {
-    ImVec2 b(c.x, a.y), d(a.x, c.y), uv(_Data->TexUvWhitePixel);
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
+#ifdef IMGUI_ENABLE_SIMD_RECTS
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    ImDrawList_WriteRectVtx(_VtxWritePtr, ImDrawList_SimdRectSet(a.x, a.y, c.x, c.y), ImDrawList_SimdRectSet(uv.x, uv.y, uv.x, uv.y), col);
+#else
+    ImVec2 b(c.x, a.y), d(a.x, c.y), uv(_Data->TexUvWhitePixel);
     _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
     _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
     _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
     _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
+#endif
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
@@ -761,14 +1216,18 @@ void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
 
 void ImDrawList::PrimRectUV(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a, const ImVec2& uv_c, ImU32 col)
 {
-    ImVec2 b(c.x, a.y), d(a.x, c.y), uv_b(uv_c.x, uv_a.y), uv_d(uv_a.x, uv_c.y);
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
+#ifdef IMGUI_ENABLE_SIMD_RECTS
+    ImDrawList_WriteRectVtx(_VtxWritePtr, ImDrawList_SimdRectSet(a.x, a.y, c.x, c.y), ImDrawList_SimdRectSet(uv_a.x, uv_a.y, uv_c.x, uv_c.y), col);
+#else
+    ImVec2 b(c.x, a.y), d(a.x, c.y), uv_b(uv_c.x, uv_a.y), uv_d(uv_a.x, uv_c.y);
     _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv_a; _VtxWritePtr[0].col = col;
     _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv_b; _VtxWritePtr[1].col = col;
     _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv_c; _VtxWritePtr[2].col = col;
     _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv_d; _VtxWritePtr[3].col = col;
+#endif
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
@@ -795,12 +1254,196 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
+// Tessellation helpers for AddPolyline() and AddConvexPolyFilled(), processing 4 points at a time with SSE2/NEON.
+// They perform the same operations as the scalar code, so output is identical (except on 32-bit ARM, which lacks vector division: refined estimates are used).
+#ifdef IMGUI_ENABLE_SIMD_DRAWLIST
+#ifdef IMGUI_ENABLE_SSE
+typedef __m128 ImDrawListSimdFloat4;
+static inline void ImDrawList_SimdLoadVec2x4(const ImVec2* p, __m128* out_x, __m128* out_y)
+{
+    const __m128 a = _mm_loadu_ps(&p[0].x), b = _mm_loadu_ps(&p[2].x);
+    *out_x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    *out_y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+}
+static inline void ImDrawList_SimdStoreVec2x4(ImVec2* p, size_t stride_bytes, __m128 x, __m128 y) // Write 4 ImVec2 'stride_bytes' apart
+{
+    const __m128 lo = _mm_unpacklo_ps(x, y), hi = _mm_unpackhi_ps(x, y);
+    char* dst = (char*)(void*)p;
+    _mm_storel_pi((__m64*)(void*)(dst), lo);
+    _mm_storeh_pi((__m64*)(void*)(dst + stride_bytes), lo);
+    _mm_storel_pi((__m64*)(void*)(dst + stride_bytes * 2), hi);
+    _mm_storeh_pi((__m64*)(void*)(dst + stride_bytes * 3), hi);
+}
+static inline __m128 ImDrawList_SimdSelect(__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+#define IM_SIMD4_SET1(V)        _mm_set1_ps(V)
+#define IM_SIMD4_ADD(A, B)      _mm_add_ps(A, B)
+#define IM_SIMD4_SUB(A, B)      _mm_sub_ps(A, B)
+#define IM_SIMD4_MUL(A, B)      _mm_mul_ps(A, B)
+#define IM_SIMD4_NEG(A)         _mm_xor_ps(A, _mm_set1_ps(-0.0f))
+#define IM_SIMD4_MIN(A, B)      _mm_min_ps(A, B)
+#define IM_SIMD4_RCP(A)         _mm_div_ps(_mm_set1_ps(1.0f), A)
+#define IM_SIMD4_RSQRT(A)       _mm_rsqrt_ps(A)  // Same as ImRsqrt() with SSE
+#define IM_SIMD4_SELECT_GT(A, B, V_TRUE, V_FALSE) ImDrawList_SimdSelect(_mm_cmpgt_ps(A, B), V_TRUE, V_FALSE)
+#else
+typedef float32x4_t ImDrawListSimdFloat4;
+static inline void ImDrawList_SimdLoadVec2x4(const ImVec2* p, float32x4_t* out_x, float32x4_t* out_y)
+{
+    const float32x4x2_t v = vld2q_f32(&p[0].x);
+    *out_x = v.val[0];
+    *out_y = v.val[1];
+}
+static inline void ImDrawList_SimdStoreVec2x4(ImVec2* p, size_t stride_bytes, float32x4_t x, float32x4_t y) // Write 4 ImVec2 'stride_bytes' apart
+{
+    const float32x4x2_t v = vzipq_f32(x, y);
+    char* dst = (char*)(void*)p;
+    vst1_f32((float*)(void*)(dst), vget_low_f32(v.val[0]));
+    vst1_f32((float*)(void*)(dst + stride_bytes), vget_high_f32(v.val[0]));
+    vst1_f32((float*)(void*)(dst + stride_bytes * 2), vget_low_f32(v.val[1]));
+    vst1_f32((float*)(void*)(dst + stride_bytes * 3), vget_high_f32(v.val[1]));
+}
+#if defined(__aarch64__) || defined(_M_ARM64)
+static inline float32x4_t ImDrawList_SimdRcp(float32x4_t a) { return vdivq_f32(vdupq_n_f32(1.0f), a); }
+static inline float32x4_t ImDrawList_SimdRsqrt(float32x4_t a) { return vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(a)); } // Same as ImRsqrt() without SSE
+#else
+static inline float32x4_t ImDrawList_SimdRcp(float32x4_t a) { float32x4_t r = vrecpeq_f32(a); r = vmulq_f32(r, vrecpsq_f32(a, r)); return vmulq_f32(r, vrecpsq_f32(a, r)); }
+static inline float32x4_t ImDrawList_SimdRsqrt(float32x4_t a) { float32x4_t r = vrsqrteq_f32(a); r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(a, r), r)); return vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(a, r), r)); }
+#endif
+#define IM_SIMD4_SET1(V)        vdupq_n_f32(V)
+#define IM_SIMD4_ADD(A, B)      vaddq_f32(A, B)
+#define IM_SIMD4_SUB(A, B)      vsubq_f32(A, B)
+#define IM_SIMD4_MUL(A, B)      vmulq_f32(A, B)
+#define IM_SIMD4_NEG(A)         vnegq_f32(A)
+#define IM_SIMD4_MIN(A, B)      vminq_f32(A, B)
+#define IM_SIMD4_RCP(A)         ImDrawList_SimdRcp(A)
+#define IM_SIMD4_RSQRT(A)       ImDrawList_SimdRsqrt(A)
+#define IM_SIMD4_SELECT_GT(A, B, V_TRUE, V_FALSE) vbslq_f32(vcgtq_f32(A, B), V_TRUE, V_FALSE)
+#endif
+#endif // #ifdef IMGUI_ENABLE_SIMD_DRAWLIST
+
+// Compute normals of segments points[i] -> points[i + 1] for i in [0, count). Requires points[count] to be readable.
+static void ImDrawList_ComputeSegmentNormals(const ImVec2* points, ImVec2* normals, int count)
+{
+    int i = 0;
+#ifdef IMGUI_ENABLE_SIMD_DRAWLIST
+    const ImDrawListSimdFloat4 zero = IM_SIMD4_SET1(0.0f);
+    for (; i + 4 <= count; i += 4)
+    {
+        ImDrawListSimdFloat4 x0, y0, x1, y1;
+        ImDrawList_SimdLoadVec2x4(&points[i], &x0, &y0);
+        ImDrawList_SimdLoadVec2x4(&points[i + 1], &x1, &y1);
+        ImDrawListSimdFloat4 dx = IM_SIMD4_SUB(x1, x0);
+        ImDrawListSimdFloat4 dy = IM_SIMD4_SUB(y1, y0);
+        const ImDrawListSimdFloat4 d2 = IM_SIMD4_ADD(IM_SIMD4_MUL(dx, dx), IM_SIMD4_MUL(dy, dy));
+        const ImDrawListSimdFloat4 inv_len = IM_SIMD4_RSQRT(d2);
+        dx = IM_SIMD4_SELECT_GT(d2, zero, IM_SIMD4_MUL(dx, inv_len), dx); // IM_NORMALIZE2F_OVER_ZERO()
+        dy = IM_SIMD4_SELECT_GT(d2, zero, IM_SIMD4_MUL(dy, inv_len), dy);
+        ImDrawList_SimdStoreVec2x4(&normals[i], sizeof(ImVec2), dy, IM_SIMD4_NEG(dx));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        float dx = points[i + 1].x - points[i].x;
+        float dy = points[i + 1].y - points[i].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        normals[i].x = dy;
+        normals[i].y = -dx;
+    }
+}
+
+// Vertices emitted for each point of an anti-aliased path: the point offset along its normal multiplied by 'Scale' (0.0f: the point itself)
+struct ImDrawListEdgeVertex
+{
+    float   Scale;
+    ImVec2  Uv;
+    ImU32   Col;
+};
+
+static inline void ImDrawList_WriteEdgeVertex(ImDrawVert* vtx_write, const ImVec2& p, float dm_x, float dm_y, const ImDrawListEdgeVertex* edge_vtx, int edge_vtx_count)
+{
+    for (int n = 0; n < edge_vtx_count; n++)
+    {
+        if (edge_vtx[n].Scale == 0.0f)
+            vtx_write[n].pos = p;
+        else
+            vtx_write[n].pos = ImVec2(p.x + dm_x * edge_vtx[n].Scale, p.y + dm_y * edge_vtx[n].Scale);
+        vtx_write[n].uv = edge_vtx[n].Uv;
+        vtx_write[n].col = edge_vtx[n].Col;
+    }
+}
+
+static inline void ImDrawList_WriteEdgeVerticesAveraged(ImDrawVert* vtx_write, const ImVec2& p, const ImVec2& n0, const ImVec2& n1, const ImDrawListEdgeVertex* edge_vtx, int edge_vtx_count)
+{
+    float dm_x = (n0.x + n1.x) * 0.5f;
+    float dm_y = (n0.y + n1.y) * 0.5f;
+    IM_FIXNORMAL2F(dm_x, dm_y);
+    ImDrawList_WriteEdgeVertex(vtx_write, p, dm_x, dm_y, edge_vtx, edge_vtx_count);
+}
+
+// Write 'edge_vtx_count' vertices for each of points[i] with i in [i_begin, i_end), to vtx_write[i * edge_vtx_count + n].
+// Points are offset along the average normal of their two adjacent segments ('normals[i - 1]' and 'normals[i]', wrapping around for i == 0).
+static void ImDrawList_WriteEdgeVertices(ImDrawVert* vtx_write, const ImVec2* points, const ImVec2* normals, int points_count, int i_begin, int i_end, const ImDrawListEdgeVertex* edge_vtx, int edge_vtx_count)
+{
+    int i = i_begin;
+#ifdef IMGUI_ENABLE_SIMD_DRAWLIST
+    if (i == 0 && i < i_end)
+    {
+        ImDrawList_WriteEdgeVerticesAveraged(vtx_write, points[0], normals[points_count - 1], normals[0], edge_vtx, edge_vtx_count);
+        i++;
+    }
+    const ImDrawListSimdFloat4 half = IM_SIMD4_SET1(0.5f);
+    const ImDrawListSimdFloat4 min_d2 = IM_SIMD4_SET1(0.000001f);
+    const ImDrawListSimdFloat4 max_inv_len2 = IM_SIMD4_SET1(IM_FIXNORMAL2F_MAX_INVLEN2);
+    const size_t vtx_stride = sizeof(ImDrawVert) * edge_vtx_count;
+    for (; i + 4 <= i_end; i += 4)
+    {
+        ImDrawListSimdFloat4 n0_x, n0_y, n1_x, n1_y, p_x, p_y;
+        ImDrawList_SimdLoadVec2x4(&normals[i - 1], &n0_x, &n0_y);
+        ImDrawList_SimdLoadVec2x4(&normals[i], &n1_x, &n1_y);
+        ImDrawList_SimdLoadVec2x4(&points[i], &p_x, &p_y);
+        ImDrawListSimdFloat4 dm_x = IM_SIMD4_MUL(IM_SIMD4_ADD(n0_x, n1_x), half);
+        ImDrawListSimdFloat4 dm_y = IM_SIMD4_MUL(IM_SIMD4_ADD(n0_y, n1_y), half);
+        const ImDrawListSimdFloat4 d2 = IM_SIMD4_ADD(IM_SIMD4_MUL(dm_x, dm_x), IM_SIMD4_MUL(dm_y, dm_y));
+        const ImDrawListSimdFloat4 inv_len2 = IM_SIMD4_MIN(IM_SIMD4_RCP(d2), max_inv_len2);
+        dm_x = IM_SIMD4_SELECT_GT(d2, min_d2, IM_SIMD4_MUL(dm_x, inv_len2), dm_x); // IM_FIXNORMAL2F()
+        dm_y = IM_SIMD4_SELECT_GT(d2, min_d2, IM_SIMD4_MUL(dm_y, inv_len2), dm_y);
+        ImDrawVert* vtx = vtx_write + i * edge_vtx_count;
+        for (int n = 0; n < edge_vtx_count; n++)
+        {
+            if (edge_vtx[n].Scale == 0.0f)
+            {
+                ImDrawList_SimdStoreVec2x4(&vtx[n].pos, vtx_stride, p_x, p_y);
+            }
+            else
+            {
+                const ImDrawListSimdFloat4 scale = IM_SIMD4_SET1(edge_vtx[n].Scale);
+                ImDrawList_SimdStoreVec2x4(&vtx[n].pos, vtx_stride, IM_SIMD4_ADD(p_x, IM_SIMD4_MUL(dm_x, scale)), IM_SIMD4_ADD(p_y, IM_SIMD4_MUL(dm_y, scale)));
+            }
+            const ImVec2 uv = edge_vtx[n].Uv;
+            const ImU32 col = edge_vtx[n].Col;
+            for (int k = 0; k < 4; k++)
+            {
+                vtx[k * edge_vtx_count + n].uv = uv;
+                vtx[k * edge_vtx_count + n].col = col;
+            }
+        }
+    }
+#endif
+    for (; i < i_end; i++)
+        ImDrawList_WriteEdgeVerticesAveraged(vtx_write + i * edge_vtx_count, points[i], normals[(i == 0) ? points_count - 1 : i - 1], normals[i], edge_vtx, edge_vtx_count);
+}
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
 {
     if (points_count < 2 || (col & IM_COL32_A_MASK) == 0)
         return;
+    if (_Retained != NULL)
+    {
+        struct { ImU32 Col; ImDrawFlags Flags; float Thickness; } args = { col, flags, thickness };
+        if (_RetainedBeginDrawCall(ImDrawListRetainedCall_Polyline, &args, sizeof(args), points, points_count * sizeof(ImVec2)))
+            return;
+    }
 
     const bool closed = (flags & ImDrawFlags_Closed) != 0;
     const ImVec2 opaque_uv = _Data->TexUvWhitePixel;
@@ -830,26 +1473,28 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         const int vtx_count = use_texture ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
         PrimReserve(idx_count, vtx_count);
 
-        // Temporary buffer
-        // The first <points_count> items are normals at each line point, then after that there are either 2 or 4 temp points for each line point
-        _Data->TempBuffer.reserve_discard(points_count * ((use_texture || !thick_line) ? 3 : 5));
+        // Temporary buffer: normals at each line point
+        _Data->TempBuffer.reserve_discard(points_count);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
-        ImVec2* temp_points = temp_normals + points_count;
 
         // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
+        ImDrawList_ComputeSegmentNormals(points, temp_normals, points_count - 1);
+        if (closed)
         {
-            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
+            float dx = points[0].x - points[points_count - 1].x;
+            float dy = points[0].y - points[points_count - 1].y;
             IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
+            temp_normals[points_count - 1].x = dy;
+            temp_normals[points_count - 1].y = -dx;
         }
-        if (!closed)
+        else
+        {
             temp_normals[points_count - 1] = temp_normals[points_count - 2];
+        }
 
-        // If we are drawing a one-pixel-wide line without a texture, or a textured line of any width, we only need 2 or 3 vertices per point
+        // Describe the vertices emitted for each point on the line
+        ImDrawListEdgeVertex edge_vtx[4];
+        int edge_vtx_count;
         if (use_texture || !thick_line)
         {
             // [PATH 1] Texture-based lines (thick or non-thick)
@@ -861,60 +1506,6 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             // - In the non texture-based paths, we would allow AA_SIZE to potentially be != 1.0f with a patch (e.g. fringe_scale patch to
             //   allow scaling geometry while preserving one-screen-pixel AA fringe).
             const float half_draw_size = use_texture ? ((thickness * 0.5f) + 1) : AA_SIZE;
-
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
-            if (!closed)
-            {
-                temp_points[0] = points[0] + temp_normals[0] * half_draw_size;
-                temp_points[1] = points[0] - temp_normals[0] * half_draw_size;
-                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * half_draw_size;
-                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
-            }
-
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
-            {
-                const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
-                const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
-                dm_y *= half_draw_size;
-
-                // Add temporary vertices for the outer edges
-                ImVec2* out_vtx = &temp_points[i2 * 2];
-                out_vtx[0].x = points[i2].x + dm_x;
-                out_vtx[0].y = points[i2].y + dm_y;
-                out_vtx[1].x = points[i2].x - dm_x;
-                out_vtx[1].y = points[i2].y - dm_y;
-
-                if (use_texture)
-                {
-                    // Add indices for two triangles
-                    _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 1); // Right tri
-                    _IdxWritePtr[3] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[4] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Left tri
-                    _IdxWritePtr += 6;
-                }
-                else
-                {
-                    // Add indexes for four triangles
-                    _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 2); // Right tri 1
-                    _IdxWritePtr[3] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Right tri 2
-                    _IdxWritePtr[6] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8] = (ImDrawIdx)(idx1 + 0); // Left tri 1
-                    _IdxWritePtr[9] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1); // Left tri 2
-                    _IdxWritePtr += 12;
-                }
-
-                idx1 = idx2;
-            }
-
-            // Add vertices for each point on the line
             if (use_texture)
             {
                 // If we're using textures we only need to emit the left/right edge vertices
@@ -927,76 +1518,61 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                     tex_uvs.z = tex_uvs.z + (tex_uvs_1.z - tex_uvs.z) * fractional_thickness;
                     tex_uvs.w = tex_uvs.w + (tex_uvs_1.w - tex_uvs.w) * fractional_thickness;
                 }*/
-                ImVec2 tex_uv0(tex_uvs.x, tex_uvs.y);
-                ImVec2 tex_uv1(tex_uvs.z, tex_uvs.w);
-                for (int i = 0; i < points_count; i++)
-                {
-                    _VtxWritePtr[0].pos = temp_points[i * 2 + 0]; _VtxWritePtr[0].uv = tex_uv0; _VtxWritePtr[0].col = col; // Left-side outer edge
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 1]; _VtxWritePtr[1].uv = tex_uv1; _VtxWritePtr[1].col = col; // Right-side outer edge
-                    _VtxWritePtr += 2;
-                }
+                edge_vtx[0] = { half_draw_size, ImVec2(tex_uvs.x, tex_uvs.y), col };    // Left-side outer edge
+                edge_vtx[1] = { -half_draw_size, ImVec2(tex_uvs.z, tex_uvs.w), col };   // Right-side outer edge
+                edge_vtx_count = 2;
             }
             else
             {
                 // If we're not using a texture, we need the center vertex as well
-                for (int i = 0; i < points_count; i++)
-                {
-                    _VtxWritePtr[0].pos = points[i];              _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;       // Center of line
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 0]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col_trans; // Left-side outer edge
-                    _VtxWritePtr[2].pos = temp_points[i * 2 + 1]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col_trans; // Right-side outer edge
-                    _VtxWritePtr += 3;
-                }
+                edge_vtx[0] = { 0.0f, opaque_uv, col };                     // Center of line
+                edge_vtx[1] = { half_draw_size, opaque_uv, col_trans };     // Left-side outer edge
+                edge_vtx[2] = { -half_draw_size, opaque_uv, col_trans };    // Right-side outer edge
+                edge_vtx_count = 3;
             }
         }
         else
         {
             // [PATH 2] Non texture-based lines (thick): we need to draw the solid line core and thus require four vertices per point
             const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
+            edge_vtx[0] = { half_inner_thickness + AA_SIZE, opaque_uv, col_trans };
+            edge_vtx[1] = { half_inner_thickness, opaque_uv, col };
+            edge_vtx[2] = { -half_inner_thickness, opaque_uv, col };
+            edge_vtx[3] = { -(half_inner_thickness + AA_SIZE), opaque_uv, col_trans };
+            edge_vtx_count = 4;
+        }
+
+        // Add vertices for each point on the line, offsetting it by the average of its segment normals
+        // If line is not closed, the first point needs to be generated differently as there are no normals to blend (the last one uses its copied normal)
+        if (!closed)
+            ImDrawList_WriteEdgeVertex(_VtxWritePtr, points[0], temp_normals[0].x, temp_normals[0].y, edge_vtx, edge_vtx_count);
+        ImDrawList_WriteEdgeVertices(_VtxWritePtr, points, temp_normals, points_count, closed ? 0 : 1, points_count, edge_vtx, edge_vtx_count);
+        _VtxWritePtr += vtx_count;
 
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
-            if (!closed)
+        // Generate the indices to form a number of triangles for each line segment
+        unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
+        for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+        {
+            const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + edge_vtx_count); // Vertex index for end of segment
+            if (use_texture)
             {
-                const int points_last = points_count - 1;
-                temp_points[0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
-                temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
-                temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 0] = points[points_last] + temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 1] = points[points_last] + temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 2] = points[points_last] - temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
+                // Add indices for two triangles
+                _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 1); // Right tri
+                _IdxWritePtr[3] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[4] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Left tri
+                _IdxWritePtr += 6;
             }
-
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            else if (!thick_line)
+            {
+                // Add indexes for four triangles
+                _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 2); // Right tri 1
+                _IdxWritePtr[3] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Right tri 2
+                _IdxWritePtr[6] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8] = (ImDrawIdx)(idx1 + 0); // Left tri 1
+                _IdxWritePtr[9] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1); // Left tri 2
+                _IdxWritePtr += 12;
+            }
+            else
             {
-                const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
-                const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
-                float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
-                float dm_in_x = dm_x * half_inner_thickness;
-                float dm_in_y = dm_y * half_inner_thickness;
-
-                // Add temporary vertices
-                ImVec2* out_vtx = &temp_points[i2 * 4];
-                out_vtx[0].x = points[i2].x + dm_out_x;
-                out_vtx[0].y = points[i2].y + dm_out_y;
-                out_vtx[1].x = points[i2].x + dm_in_x;
-                out_vtx[1].y = points[i2].y + dm_in_y;
-                out_vtx[2].x = points[i2].x - dm_in_x;
-                out_vtx[2].y = points[i2].y - dm_in_y;
-                out_vtx[3].x = points[i2].x - dm_out_x;
-                out_vtx[3].y = points[i2].y - dm_out_y;
-
-                // Add indexes
+                // Add indexes for six triangles
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
                 _IdxWritePtr[3]  = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2 + 1);
                 _IdxWritePtr[6]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8]  = (ImDrawIdx)(idx1 + 0);
@@ -1004,19 +1580,8 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 _IdxWritePtr[12] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[13] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[14] = (ImDrawIdx)(idx1 + 3);
                 _IdxWritePtr[15] = (ImDrawIdx)(idx1 + 3); _IdxWritePtr[16] = (ImDrawIdx)(idx2 + 3); _IdxWritePtr[17] = (ImDrawIdx)(idx2 + 2);
                 _IdxWritePtr += 18;
-
-                idx1 = idx2;
-            }
-
-            // Add vertices
-            for (int i = 0; i < points_count; i++)
-            {
-                _VtxWritePtr[0].pos = temp_points[i * 4 + 0]; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col_trans;
-                _VtxWritePtr[1].pos = temp_points[i * 4 + 1]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-                _VtxWritePtr[2].pos = temp_points[i * 4 + 2]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-                _VtxWritePtr[3].pos = temp_points[i * 4 + 3]; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col_trans;
-                _VtxWritePtr += 4;
             }
+            idx1 = idx2;
         }
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
@@ -1051,6 +1616,9 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             _VtxCurrentIdx += 4;
         }
     }
+
+    if (_Retained != NULL)
+        _Retained->InDrawCall = false;
 }
 
 // - We intentionally avoid using ImVec2 and its math operators here to reduce cost to a minimum for debug/non-inlined builds.
@@ -1059,6 +1627,8 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
 {
     if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
         return;
+    if (_Retained != NULL && _RetainedBeginDrawCall(ImDrawListRetainedCall_ConvexPolyFilled, &col, sizeof(col), points, points_count * sizeof(ImVec2)))
+        return;
 
     const ImVec2 uv = _Data->TexUvWhitePixel;
 
@@ -1080,41 +1650,30 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             _IdxWritePtr += 3;
         }
 
+        // Add indexes for fringes
+        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        {
+            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
+            _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
+            _IdxWritePtr += 6;
+        }
+
         // Compute normals
         _Data->TempBuffer.reserve_discard(points_count);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        ImDrawList_ComputeSegmentNormals(points, temp_normals, points_count - 1);
         {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
+            float dx = points[0].x - points[points_count - 1].x;
+            float dy = points[0].y - points[points_count - 1].y;
             IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
+            temp_normals[points_count - 1].x = dy;
+            temp_normals[points_count - 1].y = -dx;
         }
 
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
-
-            // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
-            _VtxWritePtr += 2;
-
-            // Add indexes for fringes
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
-            _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
-            _IdxWritePtr += 6;
-        }
+        // Average normals and add vertices
+        const ImDrawListEdgeVertex edge_vtx[2] = { { -AA_SIZE * 0.5f, uv, col }, { AA_SIZE * 0.5f, uv, col_trans } }; // Inner, Outer
+        ImDrawList_WriteEdgeVertices(_VtxWritePtr, points, temp_normals, points_count, 0, points_count, edge_vtx, 2);
+        _VtxWritePtr += vtx_count;
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
     else
@@ -1135,6 +1694,9 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         }
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
+
+    if (_Retained != NULL)
+        _Retained->InDrawCall = false;
 }
 
 void ImDrawList::_PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step)
@@ -1503,8 +2065,24 @@ void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 c
         return;
     if (rounding < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
     {
-        PrimReserve(6, 4);
-        PrimRect(p_min, p_max, col);
+        if (_Retained != NULL)
+        {
+            struct { ImVec2 PMin, PMax; ImU32 Col; } args = { p_min, p_max, col };
+            if (_RetainedBeginDrawCall(ImDrawListRetainedCall_RectFilled, &args, sizeof(args)))
+                return;
+        }
+        if (Flags & ImDrawListFlags_InstancedQuads)
+        {
+            PrimReserveQuads(1);
+            PrimWriteQuad(p_min, p_max, _Data->TexUvWhitePixel, _Data->TexUvWhitePixel, col);
+        }
+        else
+        {
+            PrimReserve(6, 4);
+            PrimRect(p_min, p_max, col);
+        }
+        if (_Retained != NULL)
+            _Retained->InDrawCall = false;
     }
     else
     {
@@ -1518,6 +2096,12 @@ void ImDrawList::AddRectFilledMultiColor(const ImVec2& p_min, const ImVec2& p_ma
 {
     if (((col_upr_left | col_upr_right | col_bot_right | col_bot_left) & IM_COL32_A_MASK) == 0)
         return;
+    if (_Retained != NULL)
+    {
+        struct { ImVec2 PMin, PMax; ImU32 Cols[4]; } args = { p_min, p_max, { col_upr_left, col_upr_right, col_bot_right, col_bot_left } };
+        if (_RetainedBeginDrawCall(ImDrawListRetainedCall_RectFilledMultiColor, &args, sizeof(args)))
+            return;
+    }
 
     const ImVec2 uv = _Data->TexUvWhitePixel;
     PrimReserve(6, 4);
@@ -1527,6 +2111,8 @@ void ImDrawList::AddRectFilledMultiColor(const ImVec2& p_min, const ImVec2& p_ma
     PrimWriteVtx(ImVec2(p_max.x, p_min.y), uv, col_upr_right);
     PrimWriteVtx(p_max, uv, col_bot_right);
     PrimWriteVtx(ImVec2(p_min.x, p_max.y), uv, col_bot_left);
+    if (_Retained != NULL)
+        _Retained->InDrawCall = false;
 }
 
 void ImDrawList::AddQuad(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness)
@@ -1713,6 +2299,22 @@ void ImDrawList::AddText(ImFont* font, float font_size, const ImVec2& pos, ImU32
         font = _Data->Font;
     if (font_size == 0.0f)
         font_size = _Data->FontSize;
+    if (_Retained != NULL)
+    {
+        if (text_end == NULL)
+            text_end = text_begin + ImStrlen(text_begin);
+        // Glyphs moved or evicted in font atlas texture have new UV: only text using the same baked font is invalidated.
+        // Also hash the baked density: the same font size may be rasterized at another density (e.g. after changing FramebufferScale).
+        ImFontBaked* baked = font->GetFontBaked(font_size);
+        struct { ImFont* Font; float FontSize; float WrapWidth; ImVec2 Pos; ImU32 Col; int HasFineClip; ImVec4 FineClip; float RasterizerDensity; int GlyphsUvGeneration; } args = { font, font_size, wrap_width, pos, col, cpu_fine_clip_rect != NULL, cpu_fine_clip_rect ? *cpu_fine_clip_rect : ImVec4(), baked->RasterizerDensity, baked->GlyphsUvGeneration };
+        if (_RetainedBeginDrawCall(ImDrawListRetainedCall_Text, &args, sizeof(args), text_begin, (size_t)(text_end - text_begin)))
+        {
+            // Reused vertices still display this baked font and its glyphs: mark glyphs as used so they are not evicted
+            if (font->ContainerAtlas->TexMemoryBudget > 0)
+                ImFontAtlasBakedMarkGlyphsUsed(baked, text_begin, text_end);
+            return;
+        }
+    }
 
     ImVec4 clip_rect = _CmdHeader.ClipRect;
     if (cpu_fine_clip_rect)
@@ -1723,6 +2325,8 @@ void ImDrawList::AddText(ImFont* font, float font_size, const ImVec2& pos, ImU32
         clip_rect.w = ImMin(clip_rect.w, cpu_fine_clip_rect->w);
     }
     font->RenderText(this, font_size, pos, col, clip_rect, text_begin, text_end, wrap_width, (cpu_fine_clip_rect != NULL) ? ImDrawTextFlags_CpuFineClip : ImDrawTextFlags_None);
+    if (_Retained != NULL)
+        _Retained->InDrawCall = false;
 }
 
 void ImDrawList::AddText(const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end)
@@ -1734,22 +2338,47 @@ void ImDrawList::AddImage(ImTextureRef tex_ref, const ImVec2& p_min, const ImVec
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (_Retained != NULL)
+    {
+        struct { ImU64 TexData; ImU64 TexID; ImVec2 PMin, PMax, UvMin, UvMax; ImU32 Col; int TexUniqueID; } args = { (ImU64)(intptr_t)tex_ref._TexData, 0, p_min, p_max, uv_min, uv_max, col, tex_ref._TexData ? tex_ref._TexData->UniqueID : 0 };
+        memcpy(&args.TexID, &tex_ref._TexID, sizeof(ImTextureID));
+        if (_RetainedBeginDrawCall(ImDrawListRetainedCall_Image, &args, sizeof(args)))
+            return;
+    }
 
     const bool push_texture_id = tex_ref != _CmdHeader.TexRef;
     if (push_texture_id)
         PushTexture(tex_ref);
 
-    PrimReserve(6, 4);
-    PrimRectUV(p_min, p_max, uv_min, uv_max, col);
+    if (Flags & ImDrawListFlags_InstancedQuads)
+    {
+        PrimReserveQuads(1);
+        PrimWriteQuad(p_min, p_max, uv_min, uv_max, col);
+    }
+    else
+    {
+        PrimReserve(6, 4);
+        PrimRectUV(p_min, p_max, uv_min, uv_max, col);
+    }
 
     if (push_texture_id)
         PopTexture();
+
+    if (_Retained != NULL)
+        _Retained->InDrawCall = false;
 }
 
 void ImDrawList::AddImageQuad(ImTextureRef tex_ref, const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, const ImVec2& uv1, const ImVec2& uv2, const ImVec2& uv3, const ImVec2& uv4, ImU32 col)
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if (_Retained != NULL)
+    {
+        struct { ImU64 TexData; ImU64 TexID; ImVec2 P[4], Uv[4]; ImU32 Col; int TexUniqueID; } args = { (ImU64)(intptr_t)tex_ref._TexData, 0, { p1, p2, p3, p4 }, { uv1, uv2, uv3, uv4 }, col, tex_ref._TexData ? tex_ref._TexData->UniqueID : 0 };
+        memcpy(&args.TexID, &tex_ref._TexID, sizeof(ImTextureID));
+        if (_RetainedBeginDrawCall(ImDrawListRetainedCall_ImageQuad, &args, sizeof(args)))
+            return;
+    }
 
     const bool push_texture_id = tex_ref != _CmdHeader.TexRef;
     if (push_texture_id)
@@ -1760,6 +2389,9 @@ void ImDrawList::AddImageQuad(ImTextureRef tex_ref, const ImVec2& p1, const ImVe
 
     if (push_texture_id)
         PopTexture();
+
+    if (_Retained != NULL)
+        _Retained->InDrawCall = false;
 }
 
 void ImDrawList::AddImageRounded(ImTextureRef tex_ref, const ImVec2& p_min, const ImVec2& p_max, const ImVec2& uv_min, const ImVec2& uv_max, ImU32 col, float rounding, ImDrawFlags flags)
@@ -1793,12 +2425,573 @@ void ImDrawList::AddImageRounded(ImTextureRef tex_ref, const ImVec2& p_min, cons
 //-----------------------------------------------------------------------------
 // Triangulate concave polygons. Based on "Triangulation by Ear Clipping" paper, O(N^2) complexity.
 // Reference: https://www.geometrictools.com/Documentation/TriangulationByEarClipping.pdf
+// Polygons with IM_TRIANGULATOR_MONOTONE_MIN_POINTS points or more are decomposed into monotone pieces instead, O(N log N) complexity.
 // Provided as a convenience for user but not used by main library.
 //-----------------------------------------------------------------------------
+// - ImTriangulatorMonotone [Internal]
 // - ImTriangulator [Internal]
 // - AddConcavePolyFilled()
 //-----------------------------------------------------------------------------
 
+// Ear clipping is faster on small polygons, until its quadratic cost catches up (measured with misc/benchmarks/imgui_bench_draw.cpp)
+#ifndef IM_TRIANGULATOR_MONOTONE_MIN_POINTS
+#define IM_TRIANGULATOR_MONOTONE_MIN_POINTS     64
+#endif
+
+//-----------------------------------------------------------------------------
+// ImTriangulatorMonotone [Internal]
+//-----------------------------------------------------------------------------
+// Triangulate large concave polygons in O(N log N), used by ImTriangulator above IM_TRIANGULATOR_MONOTONE_MIN_POINTS points:
+// - Sweep vertices from top to bottom and insert diagonals at split/merge vertices to partition the polygon into y-monotone pieces.
+//   Edges crossed by the sweep line are kept in a treap ordered along X, with their 'helper' vertex.
+// - Walk the pieces from the resulting planar graph, and triangulate each of them in linear time.
+// Reference: "Computational Geometry: Algorithms and Applications", chapter 3 (de Berg et al.)
+// Self-intersecting or degenerate polygons may break the invariants of the sweep: this is detected and reported so caller can fall back to ear clipping.
+//-----------------------------------------------------------------------------
+
+enum ImTriangulatorVertexType
+{
+    ImTriangulatorVertexType_Regular,
+    ImTriangulatorVertexType_Start,
+    ImTriangulatorVertexType_End,
+    ImTriangulatorVertexType_Split,
+    ImTriangulatorVertexType_Merge
+};
+
+struct ImTriangulatorSweepVertex
+{
+    ImVec2                  Pos;
+    int                     Index;
+};
+
+// Edge 'i' goes from vertex 'i' to vertex 'i + 1'. Only edges with the polygon interior on their right are inserted in the sweep status.
+struct ImTriangulatorSweepEdge
+{
+    int                     Left, Right, Parent;    // Treap links (-1 when none)
+    ImU32                   Priority;
+    int                     Helper;                 // Lowest vertex above the sweep line which sees this edge horizontally, -1 when not in the sweep status
+};
+
+struct ImTriangulatorMonotone
+{
+    static int  EstimateScratchBufferSize(int points_count);
+    bool        Triangulate(const ImVec2* points, int points_count, void* scratch_buffer, unsigned int* out_triangles);
+
+    // Internal functions
+    bool        IsAbove(int a, int b) const     { return _Rank[a] < _Rank[b]; }
+    float       GetEdgeX(int edge, const ImVec2& sweep_pos) const;
+    bool        IsEdgeLeftOf(int edge_a, int edge_b, const ImVec2& sweep_pos) const;
+    void        RotateUp(int edge);
+    bool        InsertEdge(int edge, int helper);
+    bool        RemoveEdge(int edge);
+    int         FindEdgeLeftOf(const ImVec2& pos) const;
+    bool        AddDiagonal(int a, int b);
+    bool        AddDiagonalIfHelperIsMerge(int edge, int vtx);
+    bool        BuildDiagonals();
+    int         GetNextHalfEdge(int half_edge) const;
+    bool        TriangulatePieces();
+    bool        TriangulateMonotonePiece(const int* piece, int piece_size);
+    unsigned int* AddTriangle(unsigned int* out, int a, int b, int c) const;
+
+    // Internal members
+    int                         _PointsCount = 0;
+    int                         _DiagonalsCount = 0;
+    int                         _TrianglesCount = 0;
+    int                         _Root = -1;
+    ImVec2*                     _Pos = NULL;            // points_count: positions, reordered counter-clockwise (in a Y-up frame) and without repeated points
+    int*                        _Rank = NULL;           // points_count: position in sweep order
+    ImU8*                       _Types = NULL;          // points_count: ImTriangulatorVertexType
+    ImTriangulatorSweepVertex*  _Sweep = NULL;          // points_count
+    ImTriangulatorSweepEdge*    _Edges = NULL;          // points_count
+    int*                        _Indices = NULL;        // points_count: index in source points
+    int*                        _HalfEdgeOrigin = NULL; // (points_count + diagonals) * 2. Half edges '2 * i' follow the polygon, '2 * i + 1' are their twins.
+    int*                        _VtxHalfEdges = NULL;   // (points_count + diagonals) * 2: outgoing half edges of each vertex, sorted counter-clockwise
+    int*                        _VtxHalfEdgesOffset = NULL; // points_count + 1
+    ImU8*                       _HalfEdgeVisited = NULL;// (points_count + diagonals) * 2
+    int*                        _Piece = NULL;          // (points_count + diagonals) * 2: vertices of the piece being triangulated, then sorted + stack
+    unsigned int*               _Triangles = NULL;
+    bool                        _Reversed = false;
+};
+
+int ImTriangulatorMonotone::EstimateScratchBufferSize(int points_count)
+{
+    const int half_edges_max = points_count * 4; // Up to 'points_count' diagonals
+    return (sizeof(ImVec2) + sizeof(int) * 3 + sizeof(ImU8) + sizeof(ImTriangulatorSweepVertex) + sizeof(ImTriangulatorSweepEdge)) * points_count
+        + (sizeof(int) * 2 + sizeof(ImU8) + sizeof(int) * 3) * half_edges_max + 64;
+}
+
+static int IMGUI_CDECL ImTriangulatorSweepVertex_Compare(const void* lhs, const void* rhs)
+{
+    // Top to bottom, then left to right
+    const ImTriangulatorSweepVertex* a = (const ImTriangulatorSweepVertex*)lhs;
+    const ImTriangulatorSweepVertex* b = (const ImTriangulatorSweepVertex*)rhs;
+    if (a->Pos.y != b->Pos.y)
+        return (a->Pos.y > b->Pos.y) ? -1 : +1;
+    if (a->Pos.x != b->Pos.x)
+        return (a->Pos.x < b->Pos.x) ? -1 : +1;
+    return a->Index - b->Index;
+}
+
+float ImTriangulatorMonotone::GetEdgeX(int edge, const ImVec2& sweep_pos) const
+{
+    const ImVec2& a = _Pos[edge];
+    const ImVec2& b = _Pos[(edge + 1 == _PointsCount) ? 0 : edge + 1];
+    if (a.y == b.y)
+        return ImClamp(sweep_pos.x, ImMin(a.x, b.x), ImMax(a.x, b.x));
+    return a.x + (sweep_pos.y - a.y) * (b.x - a.x) / (b.y - a.y);
+}
+
+bool ImTriangulatorMonotone::IsEdgeLeftOf(int edge_a, int edge_b, const ImVec2& sweep_pos) const
+{
+    const float xa = GetEdgeX(edge_a, sweep_pos);
+    const float xb = GetEdgeX(edge_b, sweep_pos);
+    if (xa != xb)
+        return xa < xb;
+    // Edges meeting on the sweep line: compare them just below it
+    const ImVec2 da = _Pos[(edge_a + 1 == _PointsCount) ? 0 : edge_a + 1] - _Pos[edge_a];
+    const ImVec2 db = _Pos[(edge_b + 1 == _PointsCount) ? 0 : edge_b + 1] - _Pos[edge_b];
+    return da.x * ImFabs(db.y) < db.x * ImFabs(da.y);
+}
+
+void ImTriangulatorMonotone::RotateUp(int edge)
+{
+    ImTriangulatorSweepEdge* e = &_Edges[edge];
+    const int parent = e->Parent;
+    ImTriangulatorSweepEdge* p = &_Edges[parent];
+    if (p->Left == edge)
+    {
+        p->Left = e->Right;
+        if (e->Right != -1)
+            _Edges[e->Right].Parent = parent;
+        e->Right = parent;
+    }
+    else
+    {
+        p->Right = e->Left;
+        if (e->Left != -1)
+            _Edges[e->Left].Parent = parent;
+        e->Left = parent;
+    }
+    e->Parent = p->Parent;
+    p->Parent = edge;
+    if (e->Parent == -1)
+        _Root = edge;
+    else if (_Edges[e->Parent].Left == parent)
+        _Edges[e->Parent].Left = edge;
+    else
+        _Edges[e->Parent].Right = edge;
+}
+
+bool ImTriangulatorMonotone::InsertEdge(int edge, int helper)
+{
+    ImTriangulatorSweepEdge* e = &_Edges[edge];
+    if (e->Helper != -1)
+        return false;
+    e->Left = e->Right = e->Parent = -1;
+    e->Helper = helper;
+    const ImVec2& sweep_pos = _Pos[helper];
+    for (int node = _Root; node != -1; )
+    {
+        e->Parent = node;
+        node = IsEdgeLeftOf(edge, node, sweep_pos) ? _Edges[node].Left : _Edges[node].Right;
+    }
+    if (e->Parent == -1)
+        _Root = edge;
+    else if (IsEdgeLeftOf(edge, e->Parent, sweep_pos))
+        _Edges[e->Parent].Left = edge;
+    else
+        _Edges[e->Parent].Right = edge;
+    while (e->Parent != -1 && _Edges[e->Parent].Priority < e->Priority)
+        RotateUp(edge);
+    return true;
+}
+
+bool ImTriangulatorMonotone::RemoveEdge(int edge)
+{
+    ImTriangulatorSweepEdge* e = &_Edges[edge];
+    if (e->Helper == -1)
+        return false;
+    e->Helper = -1;
+    while (e->Left != -1 && e->Right != -1)
+        RotateUp(_Edges[e->Left].Priority > _Edges[e->Right].Priority ? e->Left : e->Right);
+    const int child = (e->Left != -1) ? e->Left : e->Right;
+    if (child != -1)
+        _Edges[child].Parent = e->Parent;
+    if (e->Parent == -1)
+        _Root = child;
+    else if (_Edges[e->Parent].Left == edge)
+        _Edges[e->Parent].Left = child;
+    else
+        _Edges[e->Parent].Right = child;
+    return true;
+}
+
+// Return the edge immediately left of 'pos' on the sweep line, or -1
+int ImTriangulatorMonotone::FindEdgeLeftOf(const ImVec2& pos) const
+{
+    int result = -1;
+    for (int node = _Root; node != -1; )
+    {
+        if (GetEdgeX(node, pos) < pos.x)
+        {
+            result = node;
+            node = _Edges[node].Right;
+        }
+        else
+        {
+            node = _Edges[node].Left;
+        }
+    }
+    return result;
+}
+
+bool ImTriangulatorMonotone::AddDiagonal(int a, int b)
+{
+    if (_DiagonalsCount >= _PointsCount || a == b)
+        return false;
+    const int half_edge = (_PointsCount + _DiagonalsCount++) * 2;
+    _HalfEdgeOrigin[half_edge + 0] = a;
+    _HalfEdgeOrigin[half_edge + 1] = b;
+    return true;
+}
+
+bool ImTriangulatorMonotone::AddDiagonalIfHelperIsMerge(int edge, int vtx)
+{
+    const int helper = _Edges[edge].Helper;
+    return helper != -1 && (_Types[helper] != ImTriangulatorVertexType_Merge || AddDiagonal(vtx, helper));
+}
+
+bool ImTriangulatorMonotone::BuildDiagonals()
+{
+    const int points_count = _PointsCount;
+    for (int i = 0; i < points_count; i++)
+    {
+        const int i_prev = (i == 0) ? points_count - 1 : i - 1;
+        const int i_next = (i + 1 == points_count) ? 0 : i + 1;
+        const ImVec2& p0 = _Pos[i_prev];
+        const ImVec2& p1 = _Pos[i];
+        const ImVec2& p2 = _Pos[i_next];
+        const bool convex = ((p1.x - p0.x) * (p2.y - p1.y) - (p1.y - p0.y) * (p2.x - p1.x)) >= 0.0f;
+        if (IsAbove(i, i_prev) && IsAbove(i, i_next))
+            _Types[i] = (ImU8)(convex ? ImTriangulatorVertexType_Start : ImTriangulatorVertexType_Split);
+        else if (IsAbove(i_prev, i) && IsAbove(i_next, i))
+            _Types[i] = (ImU8)(convex ? ImTriangulatorVertexType_End : ImTriangulatorVertexType_Merge);
+        else
+            _Types[i] = ImTriangulatorVertexType_Regular;
+    }
+
+    for (int sweep_n = 0; sweep_n < points_count; sweep_n++)
+    {
+        const int i = _Sweep[sweep_n].Index;
+        const int i_prev = (i == 0) ? points_count - 1 : i - 1;
+        const ImVec2& pos = _Pos[i];
+        int edge_left;
+        switch (_Types[i])
+        {
+        case ImTriangulatorVertexType_Start:
+            if (!InsertEdge(i, i))
+                return false;
+            break;
+        case ImTriangulatorVertexType_End:
+            if (!AddDiagonalIfHelperIsMerge(i_prev, i) || !RemoveEdge(i_prev))
+                return false;
+            break;
+        case ImTriangulatorVertexType_Split:
+            if ((edge_left = FindEdgeLeftOf(pos)) == -1 || !AddDiagonal(i, _Edges[edge_left].Helper))
+                return false;
+            _Edges[edge_left].Helper = i;
+            if (!InsertEdge(i, i))
+                return false;
+            break;
+        case ImTriangulatorVertexType_Merge:
+            if (!AddDiagonalIfHelperIsMerge(i_prev, i) || !RemoveEdge(i_prev))
+                return false;
+            if ((edge_left = FindEdgeLeftOf(pos)) == -1 || !AddDiagonalIfHelperIsMerge(edge_left, i))
+                return false;
+            _Edges[edge_left].Helper = i;
+            break;
+        default:
+            if (IsAbove(i_prev, i))
+            {
+                // Interior is on the right of the vertex
+                if (!AddDiagonalIfHelperIsMerge(i_prev, i) || !RemoveEdge(i_prev) || !InsertEdge(i, i))
+                    return false;
+            }
+            else
+            {
+                if ((edge_left = FindEdgeLeftOf(pos)) == -1 || !AddDiagonalIfHelperIsMerge(edge_left, i))
+                    return false;
+                _Edges[edge_left].Helper = i;
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+// Next half edge around the piece on the left of 'half_edge': the outgoing half edge at its destination which comes clockwise after its twin.
+int ImTriangulatorMonotone::GetNextHalfEdge(int half_edge) const
+{
+    const int twin = half_edge ^ 1;
+    const int vtx = _HalfEdgeOrigin[twin];
+    const int* list = _VtxHalfEdges + _VtxHalfEdgesOffset[vtx];
+    const int list_size = _VtxHalfEdgesOffset[vtx + 1] - _VtxHalfEdgesOffset[vtx];
+    for (int n = 0; n < list_size; n++)
+        if (list[n] == twin)
+            return list[(n == 0) ? list_size - 1 : n - 1];
+    return -1;
+}
+
+static inline int ImTriangulatorMonotone_GetHalfPlane(const ImVec2& d) { return (d.y > 0.0f || (d.y == 0.0f && d.x > 0.0f)) ? 0 : 1; }
+
+bool ImTriangulatorMonotone::TriangulatePieces()
+{
+    // Build outgoing half edges lists for each vertex, sorted by angle (most vertices have 2, a few more have 3 or 4)
+    const int points_count = _PointsCount;
+    const int half_edges_count = (points_count + _DiagonalsCount) * 2;
+    for (int i = 0; i < points_count; i++)
+    {
+        _HalfEdgeOrigin[i * 2 + 0] = i;
+        _HalfEdgeOrigin[i * 2 + 1] = (i + 1 == points_count) ? 0 : i + 1;
+    }
+    for (int half_edge = 0; half_edge < half_edges_count; half_edge++)
+        _HalfEdgeVisited[half_edge] = 0;
+    memset(_VtxHalfEdgesOffset, 0, sizeof(int) * (points_count + 1));
+    for (int half_edge = 0; half_edge < half_edges_count; half_edge++)
+        _VtxHalfEdgesOffset[_HalfEdgeOrigin[half_edge] + 1]++;
+    for (int i = 0; i < points_count; i++)
+        _VtxHalfEdgesOffset[i + 1] += _VtxHalfEdgesOffset[i];
+    for (int half_edge = 0; half_edge < half_edges_count; half_edge++)
+        _VtxHalfEdges[_VtxHalfEdgesOffset[_HalfEdgeOrigin[half_edge]]++] = half_edge;
+    for (int i = points_count; i > 0; i--)
+        _VtxHalfEdgesOffset[i] = _VtxHalfEdgesOffset[i - 1];
+    _VtxHalfEdgesOffset[0] = 0;
+    for (int vtx = 0; vtx < points_count; vtx++)
+    {
+        int* list = _VtxHalfEdges + _VtxHalfEdgesOffset[vtx];
+        const int list_size = _VtxHalfEdgesOffset[vtx + 1] - _VtxHalfEdgesOffset[vtx];
+        for (int n = 1; n < list_size; n++)
+        {
+            const int half_edge = list[n];
+            const ImVec2 d = _Pos[_HalfEdgeOrigin[half_edge ^ 1]] - _Pos[vtx];
+            const int d_half = ImTriangulatorMonotone_GetHalfPlane(d);
+            int m = n;
+            for (; m > 0; m--)
+            {
+                const ImVec2 d_prev = _Pos[_HalfEdgeOrigin[list[m - 1] ^ 1]] - _Pos[vtx];
+                const int d_prev_half = ImTriangulatorMonotone_GetHalfPlane(d_prev);
+                if (d_prev_half < d_half || (d_prev_half == d_half && d_prev.x * d.y - d_prev.y * d.x >= 0.0f))
+                    break;
+                list[m] = list[m - 1];
+            }
+            list[m] = half_edge;
+        }
+    }
+
+    // Walk each piece starting from one of its half edges. Twins of polygon edges are outside.
+    for (int half_edge = 0; half_edge < half_edges_count; half_edge++)
+    {
+        if (_HalfEdgeVisited[half_edge] || (half_edge < points_count * 2 && (half_edge & 1)))
+            continue;
+        int piece_size = 0;
+        int it = half_edge;
+        do
+        {
+            if (it < 0 || _HalfEdgeVisited[it] || (it < points_count * 2 && (it & 1)) || piece_size == half_edges_count)
+                return false;
+            _HalfEdgeVisited[it] = 1;
+            _Piece[piece_size++] = _HalfEdgeOrigin[it];
+            it = GetNextHalfEdge(it);
+        }
+        while (it != half_edge);
+        if (!TriangulateMonotonePiece(_Piece, piece_size))
+            return false;
+    }
+    return _TrianglesCount == points_count - 2;
+}
+
+// Output a triangle with the same winding as the input polygon. 'b' and 'c' may be stored as ~index when on the right chain of the piece:
+// when 'c' is on the right chain and 'b' is above it, (a, b, c) is clockwise in a Y-up frame. Otherwise it is counter-clockwise.
+unsigned int* ImTriangulatorMonotone::AddTriangle(unsigned int* out, int a, int b, int c) const
+{
+    const bool swap = (c < 0) != _Reversed;
+    b = (b < 0) ? ~b : b;
+    c = (c < 0) ? ~c : c;
+    out[0] = (unsigned int)a;
+    out[1] = (unsigned int)(swap ? c : b);
+    out[2] = (unsigned int)(swap ? b : c);
+    return out + 3;
+}
+
+// Triangulate a y-monotone piece given in counter-clockwise order, in linear time.
+bool ImTriangulatorMonotone::TriangulateMonotonePiece(const int* piece, int piece_size)
+{
+    if (piece_size < 3 || _TrianglesCount + piece_size - 2 > _PointsCount - 2)
+        return false;
+
+    // Merge left chain (counter-clockwise from top) and right chain (clockwise from top) in sweep order. Right chain vertices are stored as ~index.
+    int top = 0, bottom = 0;
+    for (int n = 1; n < piece_size; n++)
+    {
+        if (IsAbove(piece[n], piece[top]))
+            top = n;
+        if (IsAbove(piece[bottom], piece[n]))
+            bottom = n;
+    }
+    int* sorted = _Piece + piece_size;
+    int* stack = sorted + piece_size;
+    sorted[0] = piece[top];
+    int left = (top + 1 == piece_size) ? 0 : top + 1;
+    int right = (top == 0) ? piece_size - 1 : top - 1;
+    int left_remaining = (bottom - top + piece_size) % piece_size; // Including bottom
+    int right_remaining = piece_size - 1 - left_remaining;
+    for (int n = 1; n < piece_size; n++)
+    {
+        int vtx;
+        if (right_remaining == 0 || (left_remaining > 0 && IsAbove(piece[left], piece[right])))
+        {
+            vtx = piece[left];
+            sorted[n] = vtx;
+            left = (left + 1 == piece_size) ? 0 : left + 1;
+            left_remaining--;
+        }
+        else
+        {
+            vtx = piece[right];
+            sorted[n] = ~vtx;
+            right = (right == 0) ? piece_size - 1 : right - 1;
+            right_remaining--;
+        }
+        const int vtx_prev = (sorted[n - 1] < 0) ? ~sorted[n - 1] : sorted[n - 1];
+        if (!IsAbove(vtx_prev, vtx))
+            return false; // Not monotone
+    }
+    if (sorted[piece_size - 1] != piece[bottom])
+        return false;
+
+    unsigned int* out = _Triangles + _TrianglesCount * 3;
+    int stack_size = 0;
+    stack[stack_size++] = sorted[0];
+    stack[stack_size++] = sorted[1];
+    for (int n = 2; n < piece_size - 1; n++)
+    {
+        const int u = sorted[n];
+        const int u_vtx = (u < 0) ? ~u : u;
+        if ((u < 0) != (stack[stack_size - 1] < 0))
+        {
+            // Opposite chains: fan from u to the whole stack
+            for (int k = 0; k < stack_size - 1; k++)
+                out = AddTriangle(out, u_vtx, stack[k], stack[k + 1]);
+            stack[0] = stack[stack_size - 1];
+            stack[1] = u;
+            stack_size = 2;
+        }
+        else
+        {
+            // Same chain: cut off triangles while the diagonal from u is inside
+            int last = stack[--stack_size];
+            while (stack_size > 0)
+            {
+                const int s = (stack[stack_size - 1] < 0) ? ~stack[stack_size - 1] : stack[stack_size - 1];
+                const int l = (last < 0) ? ~last : last;
+                const ImVec2 d_last = _Pos[l] - _Pos[s];
+                const ImVec2 d_u = _Pos[u_vtx] - _Pos[s];
+                const float cross = d_last.x * d_u.y - d_last.y * d_u.x;
+                if ((u < 0) ? (cross >= 0.0f) : (cross <= 0.0f))
+                    break;
+                out = (u < 0) ? AddTriangle(out, u_vtx, l, s) : AddTriangle(out, u_vtx, s, l);
+                last = stack[--stack_size];
+            }
+            stack[stack_size++] = last;
+            stack[stack_size++] = u;
+        }
+    }
+
+    // Last vertex: fan to the remaining stack
+    const int u_vtx = (sorted[piece_size - 1] < 0) ? ~sorted[piece_size - 1] : sorted[piece_size - 1];
+    for (int k = 0; k < stack_size - 1; k++)
+        out = AddTriangle(out, u_vtx, stack[k], stack[k + 1]);
+    const int triangles_count = (int)(out - _Triangles) / 3 - _TrianglesCount;
+    _TrianglesCount += triangles_count;
+    return triangles_count == piece_size - 2;
+}
+
+// Write 'points_count - 2' triangles (indices into 'points') to 'out_triangles'. Return false if the polygon couldn't be partitioned.
+bool ImTriangulatorMonotone::Triangulate(const ImVec2* points, int points_count, void* scratch_buffer, unsigned int* out_triangles)
+{
+    IM_ASSERT(points_count >= 3);
+    const int half_edges_max = points_count * 4;
+    _Triangles = out_triangles;
+    _Pos = (ImVec2*)scratch_buffer;
+    _Sweep = (ImTriangulatorSweepVertex*)(_Pos + points_count);
+    _Edges = (ImTriangulatorSweepEdge*)(_Sweep + points_count);
+    _Indices = (int*)(_Edges + points_count);
+    _Rank = _Indices + points_count;
+    _VtxHalfEdgesOffset = _Rank + points_count;
+    _HalfEdgeOrigin = _VtxHalfEdgesOffset + points_count + 1;
+    _VtxHalfEdges = _HalfEdgeOrigin + half_edges_max;
+    _Piece = _VtxHalfEdges + half_edges_max;            // 3 x half_edges_max
+    _Types = (ImU8*)(_Piece + half_edges_max * 3);
+    _HalfEdgeVisited = _Types + points_count;
+
+    // Work on a counter-clockwise polygon, without repeated points
+    float area2 = 0.0f;
+    for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        area2 += points[i0].x * points[i1].y - points[i1].x * points[i0].y;
+    _Reversed = (area2 < 0.0f);
+    int count = 0;
+    for (int n = 0; n < points_count; n++)
+    {
+        const int src = _Reversed ? points_count - 1 - n : n;
+        if (count > 0 && points[src].x == _Pos[count - 1].x && points[src].y == _Pos[count - 1].y)
+            continue;
+        _Pos[count] = points[src];
+        _Indices[count++] = src;
+    }
+    while (count > 1 && _Pos[count - 1].x == _Pos[0].x && _Pos[count - 1].y == _Pos[0].y)
+        count--;
+    if (count < 3)
+        return false;
+    _PointsCount = count;
+    _DiagonalsCount = _TrianglesCount = 0;
+    _Root = -1;
+    for (int i = 0; i < count; i++)
+    {
+        _Sweep[i].Pos = _Pos[i];
+        _Sweep[i].Index = i;
+        _Edges[i].Priority = (ImU32)i * 2654435761u; // Pseudo-random but deterministic
+        _Edges[i].Helper = -1;
+    }
+    ImQsort(_Sweep, (size_t)count, sizeof(ImTriangulatorSweepVertex), ImTriangulatorSweepVertex_Compare);
+    for (int n = 0; n < count; n++)
+        _Rank[_Sweep[n].Index] = n;
+
+    if (!BuildDiagonals() || !TriangulatePieces())
+        return false;
+    unsigned int* out = _Triangles;
+    for (unsigned int* out_end = out + _TrianglesCount * 3; out < out_end; out++)
+        *out = (unsigned int)_Indices[*out];
+
+    // Repeated points get a degenerate triangle each, to output the same number of triangles as ear clipping
+    const int step = _Reversed ? -1 : +1;
+    for (int n = 0; n < count; n++)
+    {
+        const int next = _Indices[(n + 1 < count) ? n + 1 : 0];
+        const int src_end = (n + 1 < count) ? next : (_Reversed ? -1 : points_count);
+        for (int dup = _Indices[n] + step; dup != src_end; dup += step)
+        {
+            out[0] = (unsigned int)_Indices[n]; out[1] = (unsigned int)dup; out[2] = (unsigned int)next;
+            out += 3;
+        }
+    }
+    IM_ASSERT(out == _Triangles + (points_count - 2) * 3);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// ImTriangulator [Internal]
+//-----------------------------------------------------------------------------
+
 enum ImTriangulatorNodeType
 {
     ImTriangulatorNodeType_Convex,
@@ -1829,7 +3022,7 @@ struct ImTriangulatorNodeSpan
 struct ImTriangulator
 {
     static int EstimateTriangleCount(int points_count)      { return (points_count < 3) ? 0 : points_count - 2; }
-    static int EstimateScratchBufferSize(int points_count)  { return sizeof(ImTriangulatorNode) * points_count + sizeof(ImTriangulatorNode*) * points_count * 2; }
+    static int EstimateScratchBufferSize(int points_count);
 
     void    Init(const ImVec2* points, int points_count, void* scratch_buffer);
     void    GetNextTriangle(unsigned int out_triangle[3]);     // Return relative indexes for next triangle
@@ -1844,11 +3037,20 @@ struct ImTriangulator
 
     // Internal members
     int                     _TrianglesLeft = 0;
+    unsigned int*           _Triangles = NULL;  // Output of ImTriangulatorMonotone, when used
     ImTriangulatorNode*     _Nodes = NULL;
     ImTriangulatorNodeSpan  _Ears;
     ImTriangulatorNodeSpan  _Reflexes;
 };
 
+int ImTriangulator::EstimateScratchBufferSize(int points_count)
+{
+    int size = sizeof(ImTriangulatorNode) * points_count + sizeof(ImTriangulatorNode*) * points_count * 2;
+    if (points_count >= IM_TRIANGULATOR_MONOTONE_MIN_POINTS)
+        size = ImMax(size, (int)sizeof(unsigned int) * 3 * EstimateTriangleCount(points_count) + ImTriangulatorMonotone::EstimateScratchBufferSize(points_count));
+    return size;
+}
+
 // Distribute storage for nodes, ears and reflexes.
 // FIXME-OPT: if everything is convex, we could report it to caller and let it switch to an convex renderer
 // (this would require first building reflexes to bail to convex if empty, without even building nodes)
@@ -1856,6 +3058,19 @@ void ImTriangulator::Init(const ImVec2* points, int points_count, void* scratch_
 {
     IM_ASSERT(scratch_buffer != NULL && points_count >= 3);
     _TrianglesLeft = EstimateTriangleCount(points_count);
+    _Triangles = NULL;
+
+    // Large polygons: triangulate everything upfront, falling back to ear clipping if the polygon is degenerate
+    if (points_count >= IM_TRIANGULATOR_MONOTONE_MIN_POINTS)
+    {
+        unsigned int* triangles = (unsigned int*)scratch_buffer;
+        ImTriangulatorMonotone monotone;
+        if (monotone.Triangulate(points, points_count, triangles + _TrianglesLeft * 3, triangles))
+        {
+            _Triangles = triangles;
+            return;
+        }
+    }
     _Nodes         = (ImTriangulatorNode*)scratch_buffer;                          // points_count x Node
     _Ears.Data     = (ImTriangulatorNode**)(_Nodes + points_count);                // points_count x Node*
     _Reflexes.Data = (ImTriangulatorNode**)(_Nodes + points_count) + points_count; // points_count x Node*
@@ -1906,6 +3121,16 @@ void ImTriangulator::BuildEars()
 
 void ImTriangulator::GetNextTriangle(unsigned int out_triangle[3])
 {
+    if (_Triangles != NULL)
+    {
+        out_triangle[0] = _Triangles[0];
+        out_triangle[1] = _Triangles[1];
+        out_triangle[2] = _Triangles[2];
+        _Triangles += 3;
+        _TrianglesLeft--;
+        return;
+    }
+
     if (_Ears.Size == 0)
     {
         FlipNodeList();
@@ -2013,6 +3238,8 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
 {
     if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
         return;
+    if (_Retained != NULL && _RetainedBeginDrawCall(ImDrawListRetainedCall_ConcavePolyFilled, &col, sizeof(col), points, points_count * sizeof(ImVec2)))
+        return;
 
     const ImVec2 uv = _Data->TexUvWhitePixel;
     ImTriangulator triangulator;
@@ -2097,6 +3324,9 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
         }
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
+
+    if (_Retained != NULL)
+        _Retained->InDrawCall = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -2121,8 +3351,9 @@ void ImDrawListSplitter::ClearFreeMemory()
 
 void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
 {
-    IM_UNUSED(draw_list);
     IM_ASSERT(_Current == 0 && _Count <= 1 && "Nested channel splitting is not supported. Please use separate instances of ImDrawListSplitter.");
+    if (draw_list->_Retained != NULL)
+        draw_list->_RetainedOnUntrackedWrite(); // Channels swap buffers around: stop replaying and close journal
     int old_channels_count = _Channels.Size;
     if (old_channels_count < channels_count)
     {
@@ -2166,7 +3397,7 @@ void ImDrawListSplitter::Merge(ImDrawList* draw_list)
     for (int i = 1; i < _Count; i++)
     {
         ImDrawChannel& ch = _Channels[i];
-        if (ch._CmdBuffer.Size > 0 && ch._CmdBuffer.back().ElemCount == 0 && ch._CmdBuffer.back().UserCallback == NULL) // Equivalent of PopUnusedDrawCmd()
+        if (ch._CmdBuffer.Size > 0 && ch._CmdBuffer.back().ElemCount == 0 && ch._CmdBuffer.back().QuadCount == 0 && ch._CmdBuffer.back().UserCallback == NULL) // Equivalent of PopUnusedDrawCmd()
             ch._CmdBuffer.pop_back();
 
         if (ch._CmdBuffer.Size > 0 && last_cmd != NULL)
@@ -2174,9 +3405,12 @@ void ImDrawListSplitter::Merge(ImDrawList* draw_list)
             // Do not include ImDrawCmd_AreSequentialIdxOffset() in the compare as we rebuild IdxOffset values ourselves.
             // Manipulating IdxOffset (e.g. by reordering draw commands like done by RenderDimmedBackgroundBehindWindow()) is not supported within a splitter.
             ImDrawCmd* next_cmd = &ch._CmdBuffer[0];
-            if (ImDrawCmd_HeaderCompare(last_cmd, next_cmd) == 0 && last_cmd->UserCallback == NULL && next_cmd->UserCallback == NULL)
+            if (ImDrawCmd_HeaderCompare(last_cmd, next_cmd) == 0 && ImDrawCmd_CanAppendQuads(last_cmd, next_cmd) && last_cmd->UserCallback == NULL && next_cmd->UserCallback == NULL)
             {
                 // Merge previous channel last draw command with current channel first draw command if matching.
+                if (last_cmd->QuadCount == 0)
+                    last_cmd->QuadOffset = next_cmd->QuadOffset;
+                last_cmd->QuadCount += next_cmd->QuadCount;
                 last_cmd->ElemCount += next_cmd->ElemCount;
                 idx_offset += next_cmd->ElemCount;
                 ch._CmdBuffer.erase(ch._CmdBuffer.Data); // FIXME-OPT: Improve for multiple merges.
@@ -2212,7 +3446,7 @@ void ImDrawListSplitter::Merge(ImDrawList* draw_list)
 
     // If current command is used with different settings we need to add a new command
     ImDrawCmd* curr_cmd = &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
-    if (curr_cmd->ElemCount == 0)
+    if (curr_cmd->ElemCount == 0 && curr_cmd->QuadCount == 0)
         ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader); // Copy ClipRect, TexRef, VtxOffset
     else if (ImDrawCmd_HeaderCompare(curr_cmd, &draw_list->_CmdHeader) != 0)
         draw_list->AddDrawCmd();
@@ -2238,7 +3472,7 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
     ImDrawCmd* curr_cmd = (draw_list->CmdBuffer.Size == 0) ? NULL : &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
     if (curr_cmd == NULL)
         draw_list->AddDrawCmd();
-    else if (curr_cmd->ElemCount == 0)
+    else if (curr_cmd->ElemCount == 0 && curr_cmd->QuadCount == 0)
         ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader); // Copy ClipRect, TexRef, VtxOffset
     else if (ImDrawCmd_HeaderCompare(curr_cmd, &draw_list->_CmdHeader) != 0)
         draw_list->AddDrawCmd();
@@ -2251,7 +3485,7 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
 void ImDrawData::Clear()
 {
     Valid = false;
-    CmdListsCount = TotalIdxCount = TotalVtxCount = 0;
+    CmdListsCount = TotalIdxCount = TotalVtxCount = TotalQuadCount = 0;
     CmdLists.resize(0); // The ImDrawList are NOT owned by ImDrawData but e.g. by ImGuiContext, so we don't clear them.
     DisplayPos = DisplaySize = FramebufferScale = ImVec2(0.0f, 0.0f);
     OwnerViewport = NULL;
@@ -2264,13 +3498,14 @@ void ImGui::AddDrawListToDrawDataEx(ImDrawData* draw_data, ImVector<ImDrawList*>
 {
     if (draw_list->CmdBuffer.Size == 0)
         return;
-    if (draw_list->CmdBuffer.Size == 1 && draw_list->CmdBuffer[0].ElemCount == 0 && draw_list->CmdBuffer[0].UserCallback == NULL)
+    if (draw_list->CmdBuffer.Size == 1 && draw_list->CmdBuffer[0].ElemCount == 0 && draw_list->CmdBuffer[0].QuadCount == 0 && draw_list->CmdBuffer[0].UserCallback == NULL)
         return;
 
     // Draw list sanity check. Detect mismatch between PrimReserve() calls and incrementing _VtxCurrentIdx, _VtxWritePtr etc.
     // May trigger for you if you are using PrimXXX functions incorrectly.
     IM_ASSERT(draw_list->VtxBuffer.Size == 0 || draw_list->_VtxWritePtr == draw_list->VtxBuffer.Data + draw_list->VtxBuffer.Size);
     IM_ASSERT(draw_list->IdxBuffer.Size == 0 || draw_list->_IdxWritePtr == draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size);
+    IM_ASSERT(draw_list->QuadBuffer.Size == 0 || draw_list->_QuadWritePtr == draw_list->QuadBuffer.Data + draw_list->QuadBuffer.Size);
     if (!(draw_list->Flags & ImDrawListFlags_AllowVtxOffset))
         IM_ASSERT((int)draw_list->_VtxCurrentIdx == draw_list->VtxBuffer.Size);
 
@@ -2303,6 +3538,7 @@ void ImGui::AddDrawListToDrawDataEx(ImDrawData* draw_data, ImVector<ImDrawList*>
     draw_data->CmdListsCount++;
     draw_data->TotalVtxCount += draw_list->VtxBuffer.Size;
     draw_data->TotalIdxCount += draw_list->IdxBuffer.Size;
+    draw_data->TotalQuadCount += draw_list->QuadBuffer.Size;
 }
 
 void ImDrawData::AddDrawList(ImDrawList* draw_list)
@@ -2341,34 +3577,388 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
 }
 
 //-----------------------------------------------------------------------------
-// [SECTION] Helpers ShadeVertsXXX functions
+// [SECTION] ImDrawDamageTracker
 //-----------------------------------------------------------------------------
 
-// Generic linear color gradient, write to RGB fields, leave A untouched.
-void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1)
+static int IMGUI_CDECL ImDrawDamageEntry_CompareByHash(const void* lhs, const void* rhs)
 {
-    ImVec2 gradient_extent = gradient_p1 - gradient_p0;
-    float gradient_inv_length2 = 1.0f / ImLengthSqr(gradient_extent);
-    ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
-    ImDrawVert* vert_end = draw_list->VtxBuffer.Data + vert_end_idx;
-    const int col0_r = (int)(col0 >> IM_COL32_R_SHIFT) & 0xFF;
-    const int col0_g = (int)(col0 >> IM_COL32_G_SHIFT) & 0xFF;
-    const int col0_b = (int)(col0 >> IM_COL32_B_SHIFT) & 0xFF;
-    const int col_delta_r = ((int)(col1 >> IM_COL32_R_SHIFT) & 0xFF) - col0_r;
-    const int col_delta_g = ((int)(col1 >> IM_COL32_G_SHIFT) & 0xFF) - col0_g;
-    const int col_delta_b = ((int)(col1 >> IM_COL32_B_SHIFT) & 0xFF) - col0_b;
-    for (ImDrawVert* vert = vert_start; vert < vert_end; vert++)
-    {
-        float d = ImDot(vert->pos - gradient_p0, gradient_extent);
-        float t = ImClamp(d * gradient_inv_length2, 0.0f, 1.0f);
-        int r = (int)(col0_r + col_delta_r * t);
-        int g = (int)(col0_g + col_delta_g * t);
-        int b = (int)(col0_b + col_delta_b * t);
-        vert->col = (r << IM_COL32_R_SHIFT) | (g << IM_COL32_G_SHIFT) | (b << IM_COL32_B_SHIFT) | (vert->col & IM_COL32_A_MASK);
-    }
+    const ImU64 a = ((const ImDrawDamageEntry*)lhs)->Hash;
+    const ImU64 b = ((const ImDrawDamageEntry*)rhs)->Hash;
+    return (a < b) ? -1 : (a > b) ? +1 : 0;
 }
 
-// Distribute UV over (a, b) rectangle
+// Add a rectangle to a list of non-overlapping rectangles, merging it with every rectangle it touches.
+static void ImDrawDamage_AddRect(ImVector<ImVec4>* rects, ImVec4 r)
+{
+    if (r.x >= r.z || r.y >= r.w)
+        return;
+    for (int n = 0; n < rects->Size; )
+    {
+        const ImVec4 o = (*rects)[n];
+        if (o.x > r.z || r.x > o.z || o.y > r.w || r.y > o.w)
+        {
+            n++;
+            continue;
+        }
+        r = ImVec4(ImMin(r.x, o.x), ImMin(r.y, o.y), ImMax(r.z, o.z), ImMax(r.w, o.w));
+        rects->erase_unsorted(rects->Data + n);
+        n = 0; // Merged rectangle is larger and may now touch rectangles we already checked
+    }
+    rects->push_back(r);
+
+    // Too many regions: merge them all. A bit of overdraw is cheaper than many draw passes.
+    if (rects->Size > IM_DRAW_DAMAGE_MAX_RECTS)
+    {
+        ImVec4 bb = (*rects)[0];
+        for (const ImVec4& o : *rects)
+            bb = ImVec4(ImMin(bb.x, o.x), ImMin(bb.y, o.y), ImMax(bb.z, o.z), ImMax(bb.w, o.w));
+        rects->resize(1);
+        (*rects)[0] = bb;
+    }
+}
+
+void ImDrawDamageTracker::Clear()
+{
+    FullDamage = false;
+    DamageRects.resize(0);
+    UpdateCount = 0;
+    _Entries.resize(0);
+    _PrevEntries.resize(0);
+    for (ImVector<ImVec4>& history : _History)
+        history.resize(0);
+    _TexUpdateCounts.Clear();
+    _DisplayPos = _DisplaySize = _FramebufferScale = ImVec2(0.0f, 0.0f);
+}
+
+bool ImDrawDamageTracker::Update(const ImDrawData* draw_data)
+{
+    const ImVec4 display_rect(draw_data->DisplayPos.x, draw_data->DisplayPos.y, draw_data->DisplayPos.x + draw_data->DisplaySize.x, draw_data->DisplayPos.y + draw_data->DisplaySize.y);
+    bool full_damage = (UpdateCount == 0 || draw_data->DisplayPos != _DisplayPos || draw_data->DisplaySize != _DisplaySize || draw_data->FramebufferScale != _FramebufferScale);
+
+    // Count texture contents changes (backend hasn't processed them yet), so that commands are damaged even when their vertices didn't change
+    if (draw_data->Textures != NULL)
+    {
+        ImGuiStorage tex_update_counts;
+        for (ImTextureData* tex : *draw_data->Textures)
+        {
+            const ImGuiID tex_key = ImHashData(&tex, sizeof(tex));
+            int count = _TexUpdateCounts.GetInt(tex_key, 0);
+            if (tex->Status == ImTextureStatus_WantCreate || tex->Status == ImTextureStatus_WantUpdates)
+                count++;
+            tex_update_counts.SetInt(tex_key, count);
+        }
+        _TexUpdateCounts.Data.swap(tex_update_counts.Data);
+    }
+
+    // Hash each command: draw list order and position within its draw list (so z-order changes are detected), clip rect, texture,
+    // vertices and indices relative to the first vertex used. Hashing relative indices means a command is unaffected by changes of
+    // what precedes it in the buffers. Uses the same 64-bit hash as retained draw lists.
+    _Entries.resize(0);
+    for (int draw_list_n = 0; draw_list_n < draw_data->CmdLists.Size; draw_list_n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[draw_list_n];
+        for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+        {
+            const ImDrawCmd& cmd = draw_list->CmdBuffer[cmd_n];
+            if (cmd.UserCallback != NULL)
+            {
+                if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                    full_damage = true;
+                continue;
+            }
+            if (cmd.ElemCount == 0 && cmd.QuadCount == 0)
+                continue;
+
+            ImU64 hash = ImDrawList_RetainedHash(&cmd.ClipRect, sizeof(cmd.ClipRect), ((ImU64)draw_list_n << 32) | (ImU64)cmd_n);
+            if (ImTextureData* tex = cmd.TexRef._TexData)
+            {
+                const int tex_state[2] = { tex->UniqueID, _TexUpdateCounts.GetInt(ImHashData(&tex, sizeof(tex)), 0) };
+                hash = ImDrawList_RetainedHash(tex_state, sizeof(tex_state), hash);
+            }
+            else
+                hash = ImDrawList_RetainedHash(&cmd.TexRef._TexID, sizeof(cmd.TexRef._TexID), hash);
+
+            // Bounding box of vertices, with 1 unit of margin to account for rasterization rounding
+            ImVec4 rect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+            if (cmd.ElemCount > 0)
+            {
+                const ImDrawIdx* idx_begin = draw_list->IdxBuffer.Data + cmd.IdxOffset;
+                const ImDrawIdx* idx_end = idx_begin + cmd.ElemCount;
+                unsigned int idx_min = (unsigned int)*idx_begin, idx_max = idx_min;
+                for (const ImDrawIdx* idx = idx_begin; idx < idx_end; idx++)
+                {
+                    idx_min = ImMin(idx_min, (unsigned int)*idx);
+                    idx_max = ImMax(idx_max, (unsigned int)*idx);
+                }
+                const ImDrawVert* vtx_begin = draw_list->VtxBuffer.Data + cmd.VtxOffset + idx_min;
+                const ImDrawVert* vtx_end = draw_list->VtxBuffer.Data + cmd.VtxOffset + idx_max + 1;
+                hash = ImDrawList_RetainedHash(vtx_begin, (size_t)(vtx_end - vtx_begin) * sizeof(ImDrawVert), hash);
+                for (const ImDrawIdx* idx = idx_begin; idx < idx_end; idx++)
+                    hash = (hash ^ (ImU64)(*idx - idx_min)) * 0x100000001B3ULL; // FNV-1a 64-bit step
+                for (const ImDrawVert* vtx = vtx_begin; vtx < vtx_end; vtx++)
+                    rect = ImVec4(ImMin(rect.x, vtx->pos.x), ImMin(rect.y, vtx->pos.y), ImMax(rect.z, vtx->pos.x), ImMax(rect.w, vtx->pos.y));
+            }
+            if (cmd.QuadCount > 0)
+            {
+                const ImDrawQuad* quad_begin = draw_list->QuadBuffer.Data + cmd.QuadOffset;
+                const ImDrawQuad* quad_end = quad_begin + cmd.QuadCount;
+                hash = ImDrawList_RetainedHash(quad_begin, (size_t)cmd.QuadCount * sizeof(ImDrawQuad), hash);
+                for (const ImDrawQuad* quad = quad_begin; quad < quad_end; quad++)
+                {
+                    const ImVec2 p0 = quad->Pos, p1 = quad->Pos + quad->Size;
+                    rect = ImVec4(ImMin(rect.x, ImMin(p0.x, p1.x)), ImMin(rect.y, ImMin(p0.y, p1.y)), ImMax(rect.z, ImMax(p0.x, p1.x)), ImMax(rect.w, ImMax(p0.y, p1.y)));
+                }
+            }
+            rect = ImVec4(ImMax(rect.x - 1.0f, cmd.ClipRect.x), ImMax(rect.y - 1.0f, cmd.ClipRect.y), ImMin(rect.z + 1.0f, cmd.ClipRect.z), ImMin(rect.w + 1.0f, cmd.ClipRect.w));
+            rect = ImVec4(ImMax(rect.x, display_rect.x), ImMax(rect.y, display_rect.y), ImMin(rect.z, display_rect.z), ImMin(rect.w, display_rect.w));
+            if (rect.x >= rect.z || rect.y >= rect.w)
+                continue;
+
+            ImDrawDamageEntry entry;
+            entry.Hash = hash;
+            entry.Rect = rect;
+            _Entries.push_back(entry);
+        }
+    }
+    ImQsort(_Entries.Data, (size_t)_Entries.Size, sizeof(ImDrawDamageEntry), ImDrawDamageEntry_CompareByHash);
+
+    // Commands present in only one of the two frames are damaged: where they are now, or where they used to be.
+    DamageRects.resize(0);
+    if (!full_damage)
+    {
+        int curr_n = 0, prev_n = 0;
+        while (curr_n < _Entries.Size || prev_n < _PrevEntries.Size)
+        {
+            if (prev_n == _PrevEntries.Size || (curr_n < _Entries.Size && _Entries[curr_n].Hash < _PrevEntries[prev_n].Hash))
+                ImDrawDamage_AddRect(&DamageRects, _Entries[curr_n++].Rect);
+            else if (curr_n == _Entries.Size || _PrevEntries[prev_n].Hash < _Entries[curr_n].Hash)
+                ImDrawDamage_AddRect(&DamageRects, _PrevEntries[prev_n++].Rect);
+            else
+            {
+                curr_n++; // Unchanged
+                prev_n++;
+            }
+        }
+    }
+    else
+    {
+        DamageRects.push_back(display_rect);
+    }
+    FullDamage = full_damage;
+    _PrevEntries.swap(_Entries);
+
+    // Record history for GetDamageForBufferAge()
+    for (int n = IM_DRAW_DAMAGE_HISTORY - 1; n > 0; n--)
+        _History[n].swap(_History[n - 1]);
+    _History[0].resize(DamageRects.Size);
+    if (DamageRects.Size > 0)
+        memcpy(_History[0].Data, DamageRects.Data, (size_t)DamageRects.Size * sizeof(ImVec4));
+
+    _DisplayPos = draw_data->DisplayPos;
+    _DisplaySize = draw_data->DisplaySize;
+    _FramebufferScale = draw_data->FramebufferScale;
+    UpdateCount++;
+    return DamageRects.Size > 0;
+}
+
+bool ImDrawDamageTracker::GetDamageForBufferAge(int buffer_age, ImVector<ImVec4>* out_rects) const
+{
+    out_rects->resize(0);
+    if (buffer_age <= 0 || buffer_age > IM_DRAW_DAMAGE_HISTORY || buffer_age > UpdateCount)
+    {
+        out_rects->push_back(ImVec4(_DisplayPos.x, _DisplayPos.y, _DisplayPos.x + _DisplaySize.x, _DisplayPos.y + _DisplaySize.y));
+        return false;
+    }
+    for (int n = 0; n < buffer_age; n++)
+        for (const ImVec4& r : _History[n])
+            ImDrawDamage_AddRect(out_rects, r);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImDrawDataMerger
+//-----------------------------------------------------------------------------
+
+static int ImDrawDataMerger_CountDrawCalls(const ImDrawList* draw_list)
+{
+    int count = 0;
+    for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        if (cmd.UserCallback == NULL)
+            count += (cmd.ElemCount > 0 ? 1 : 0) + (cmd.QuadCount > 0 ? 1 : 0);
+    return count;
+}
+
+void ImDrawDataMerger::ClearFreeMemory()
+{
+    for (ImDrawList* draw_list : _Lists)
+        IM_DELETE(draw_list);
+    _Lists.clear();
+    _CmdLists.clear();
+}
+
+void ImDrawDataMerger::Merge(ImDrawData* draw_data)
+{
+    DrawCallsBefore = 0;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+        DrawCallsBefore += ImDrawDataMerger_CountDrawCalls(draw_list);
+    DrawCallsAfter = DrawCallsBefore;
+    if (draw_data->CmdLists.Size <= 1)
+        return;
+
+    // Geometry entirely inside of its clip rectangle doesn't need scissoring, so such commands can share a larger clip rectangle.
+    // Keep one framebuffer pixel of margin, as renderers truncate clip rectangles to integer scissor coordinates.
+    const ImVec2 margin(1.0f / ImMax(draw_data->FramebufferScale.x, 1.0f), 1.0f / ImMax(draw_data->FramebufferScale.y, 1.0f));
+    const unsigned int max_vtx_count = (sizeof(ImDrawIdx) == 2) ? (1 << 16) : ~0u;
+
+    _CmdLists.resize(0);
+    int used_lists = 0;
+    ImDrawList* dst = NULL;
+    bool dst_last_cmd_unclipped = false;    // Geometry of last command of 'dst' doesn't need its clip rectangle
+    for (ImDrawList* src : draw_data->CmdLists)
+    {
+        // Leave lists with user callbacks untouched (callbacks may expect to receive their own draw list),
+        // as well as large lists relying on ImDrawCmd::VtxOffset.
+        bool pass_through = (unsigned int)src->VtxBuffer.Size > max_vtx_count;
+        for (const ImDrawCmd& cmd : src->CmdBuffer)
+            if (cmd.UserCallback != NULL && cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                pass_through = true;
+        if (pass_through)
+        {
+            _CmdLists.push_back(src);
+            dst = NULL;
+            continue;
+        }
+
+        // Start a new output list when needed
+        if (dst == NULL || (unsigned int)(dst->VtxBuffer.Size + src->VtxBuffer.Size) > max_vtx_count)
+        {
+            if (used_lists == _Lists.Size)
+            {
+                _Lists.push_back(IM_NEW(ImDrawList)(src->_Data));
+                _Lists.back()->_OwnerName = "##Merged";
+            }
+            dst = _Lists[used_lists++];
+            dst->CmdBuffer.resize(0);
+            dst->IdxBuffer.resize(0);
+            dst->VtxBuffer.resize(0);
+            dst->QuadBuffer.resize(0);
+            dst->Flags = src->Flags;
+            dst_last_cmd_unclipped = false;
+            _CmdLists.push_back(dst);
+        }
+
+        // Append vertices and quads as-is
+        const unsigned int vtx_base = (unsigned int)dst->VtxBuffer.Size;
+        const unsigned int quad_base = (unsigned int)dst->QuadBuffer.Size;
+        dst->VtxBuffer.resize(dst->VtxBuffer.Size + src->VtxBuffer.Size);
+        if (src->VtxBuffer.Size > 0)
+            memcpy(dst->VtxBuffer.Data + vtx_base, src->VtxBuffer.Data, (size_t)src->VtxBuffer.Size * sizeof(ImDrawVert));
+        dst->QuadBuffer.resize(dst->QuadBuffer.Size + src->QuadBuffer.Size);
+        if (src->QuadBuffer.Size > 0)
+            memcpy(dst->QuadBuffer.Data + quad_base, src->QuadBuffer.Data, (size_t)src->QuadBuffer.Size * sizeof(ImDrawQuad));
+
+        // Append commands, rebasing indices to the start of the output list
+        dst->IdxBuffer.reserve(dst->IdxBuffer.Size + src->IdxBuffer.Size);
+        for (const ImDrawCmd& src_cmd : src->CmdBuffer)
+        {
+            if (src_cmd.UserCallback == NULL && src_cmd.ElemCount == 0 && src_cmd.QuadCount == 0)
+                continue;
+
+            ImDrawCmd cmd = src_cmd;
+            cmd.VtxOffset = 0;
+            cmd.IdxOffset = (unsigned int)dst->IdxBuffer.Size;
+            cmd.QuadOffset = quad_base + src_cmd.QuadOffset;
+            if (cmd.UserCallback != NULL)
+            {
+                dst->CmdBuffer.push_back(cmd);
+                dst_last_cmd_unclipped = false;
+                continue;
+            }
+
+            // Copy indices and compute bounding box of geometry
+            ImVec4 bb(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+            const unsigned int idx_rebase = vtx_base + src_cmd.VtxOffset;
+            const ImDrawVert* vtx_buffer = dst->VtxBuffer.Data + idx_rebase;
+            const ImDrawIdx* idx_read = src->IdxBuffer.Data + src_cmd.IdxOffset;
+            dst->IdxBuffer.resize(dst->IdxBuffer.Size + (int)src_cmd.ElemCount);
+            ImDrawIdx* idx_write = dst->IdxBuffer.Data + cmd.IdxOffset;
+            for (unsigned int n = 0; n < src_cmd.ElemCount; n++)
+            {
+                const ImVec2 pos = vtx_buffer[idx_read[n]].pos;
+                bb = ImVec4(ImMin(bb.x, pos.x), ImMin(bb.y, pos.y), ImMax(bb.z, pos.x), ImMax(bb.w, pos.y));
+                idx_write[n] = (ImDrawIdx)(idx_read[n] + idx_rebase);
+            }
+            for (const ImDrawQuad* quad = dst->QuadBuffer.Data + cmd.QuadOffset; quad < dst->QuadBuffer.Data + cmd.QuadOffset + cmd.QuadCount; quad++)
+            {
+                const ImVec2 p0 = quad->Pos, p1 = quad->Pos + quad->Size;
+                bb = ImVec4(ImMin(bb.x, ImMin(p0.x, p1.x)), ImMin(bb.y, ImMin(p0.y, p1.y)), ImMax(bb.z, ImMax(p0.x, p1.x)), ImMax(bb.w, ImMax(p0.y, p1.y)));
+            }
+            const ImVec4& clip = cmd.ClipRect;
+            const bool unclipped = (bb.x >= clip.x + margin.x && bb.y >= clip.y + margin.y && bb.z <= clip.z - margin.x && bb.w <= clip.w - margin.y);
+
+            // Try merging with previous command
+            ImDrawCmd* prev_cmd = dst->CmdBuffer.Size > 0 ? &dst->CmdBuffer.back() : NULL;
+            if (prev_cmd != NULL && prev_cmd->UserCallback == NULL && memcmp(&prev_cmd->TexRef, &cmd.TexRef, sizeof(ImTextureRef)) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, (&cmd)) && ImDrawCmd_CanAppendQuads(prev_cmd, (&cmd)))
+            {
+                const bool same_clip = (prev_cmd->ClipRect == cmd.ClipRect);
+                if (same_clip || (dst_last_cmd_unclipped && unclipped))
+                {
+                    if (!same_clip)
+                        prev_cmd->ClipRect = ImVec4(ImMin(prev_cmd->ClipRect.x, clip.x), ImMin(prev_cmd->ClipRect.y, clip.y), ImMax(prev_cmd->ClipRect.z, clip.z), ImMax(prev_cmd->ClipRect.w, clip.w));
+                    if (prev_cmd->QuadCount == 0)
+                        prev_cmd->QuadOffset = cmd.QuadOffset;
+                    prev_cmd->ElemCount += cmd.ElemCount;
+                    prev_cmd->QuadCount += cmd.QuadCount;
+                    dst_last_cmd_unclipped = dst_last_cmd_unclipped && unclipped;
+                    continue;
+                }
+            }
+            dst->CmdBuffer.push_back(cmd);
+            dst_last_cmd_unclipped = unclipped;
+        }
+    }
+
+    // Output lists need at least one command
+    for (ImDrawList* draw_list : _CmdLists)
+        if (draw_list->CmdBuffer.Size == 0)
+            draw_list->AddDrawCmd();
+
+    draw_data->CmdLists.swap(_CmdLists);
+    draw_data->CmdListsCount = draw_data->CmdLists.Size;
+    DrawCallsAfter = 0;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+        DrawCallsAfter += ImDrawDataMerger_CountDrawCalls(draw_list);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Helpers ShadeVertsXXX functions
+//-----------------------------------------------------------------------------
+
+// Generic linear color gradient, write to RGB fields, leave A untouched.
+void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1)
+{
+    ImVec2 gradient_extent = gradient_p1 - gradient_p0;
+    float gradient_inv_length2 = 1.0f / ImLengthSqr(gradient_extent);
+    ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
+    ImDrawVert* vert_end = draw_list->VtxBuffer.Data + vert_end_idx;
+    const int col0_r = (int)(col0 >> IM_COL32_R_SHIFT) & 0xFF;
+    const int col0_g = (int)(col0 >> IM_COL32_G_SHIFT) & 0xFF;
+    const int col0_b = (int)(col0 >> IM_COL32_B_SHIFT) & 0xFF;
+    const int col_delta_r = ((int)(col1 >> IM_COL32_R_SHIFT) & 0xFF) - col0_r;
+    const int col_delta_g = ((int)(col1 >> IM_COL32_G_SHIFT) & 0xFF) - col0_g;
+    const int col_delta_b = ((int)(col1 >> IM_COL32_B_SHIFT) & 0xFF) - col0_b;
+    for (ImDrawVert* vert = vert_start; vert < vert_end; vert++)
+    {
+        float d = ImDot(vert->pos - gradient_p0, gradient_extent);
+        float t = ImClamp(d * gradient_inv_length2, 0.0f, 1.0f);
+        int r = (int)(col0_r + col_delta_r * t);
+        int g = (int)(col0_g + col_delta_g * t);
+        int b = (int)(col0_b + col_delta_b * t);
+        vert->col = (r << IM_COL32_R_SHIFT) | (g << IM_COL32_G_SHIFT) | (b << IM_COL32_B_SHIFT) | (vert->col & IM_COL32_A_MASK);
+    }
+}
+
+// Distribute UV over (a, b) rectangle
 void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp)
 {
     const ImVec2 size = b - a;
@@ -2395,6 +3985,8 @@ void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int ve
 
 void ImGui::ShadeVertsTransformPos(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& pivot_in, float cos_a, float sin_a, const ImVec2& pivot_out)
 {
+    if (draw_list->_Retained != NULL)
+        draw_list->_RetainedOnUntrackedWrite(vert_start_idx); // Not idempotent: vertices can't be reused as-is next frame
     ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
     ImDrawVert* vert_end = draw_list->VtxBuffer.Data + vert_end_idx;
     for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
@@ -2539,7 +4131,10 @@ void ImTextureData::DestroyPixels()
 // - ImFontAtlasBuildDiscardBakes()
 // - ImFontAtlasBuildDiscardFontBakedGlyph()
 // - ImFontAtlasBuildDiscardFontBaked()
+// - ImFontAtlasWrapLinesFind()
+// - ImFontAtlasWrapLinesAdd()
 // - ImFontAtlasBuildDiscardFontBakes()
+// - ImFontAtlasBuildEvictGlyphs()
 //-----------------------------------------------------------------------------
 // - ImFontAtlasAddDrawListSharedData()
 // - ImFontAtlasRemoveDrawListSharedData()
@@ -2548,24 +4143,39 @@ void ImTextureData::DestroyPixels()
 //-----------------------------------------------------------------------------
 // - ImFontAtlasBuildSetTexture()
 // - ImFontAtlasBuildAddTexture()
+// - ImFontAtlasBuildUpdateGlyphsUV()
 // - ImFontAtlasBuildMakeSpace()
 // - ImFontAtlasBuildRepackTexture()
+// - ImFontAtlasTextureExtend()
 // - ImFontAtlasBuildGrowTexture()
 // - ImFontAtlasBuildRepackOrGrowTexture()
 // - ImFontAtlasBuildGetTextureSizeEstimate()
 // - ImFontAtlasBuildCompactTexture()
+// - ImFontAtlasTextureShrinkToBudget()
 // - ImFontAtlasBuildInit()
 // - ImFontAtlasBuildDestroy()
 //-----------------------------------------------------------------------------
 // - ImFontAtlasPackInit()
+// - ImFontAtlasPackFindShelf()
+// - ImFontAtlasPackAllocSpace()
+// - ImFontAtlasPackFreeSpace()
 // - ImFontAtlasPackAllocRectEntry()
 // - ImFontAtlasPackReuseRectEntry()
+// - ImFontAtlasPackGcRects()
 // - ImFontAtlasPackDiscardRect()
 // - ImFontAtlasPackAddRect()
+// - ImFontAtlasPackDefragStep()
 // - ImFontAtlasPackGetRect()
 //-----------------------------------------------------------------------------
+// - ImFontAtlasGlyphCacheLoadFromDisk()
+// - ImFontAtlasGlyphCacheSaveToDisk()
+// - ImFontAtlasGlyphCacheLoadGlyph()
+// - ImFontAtlasGlyphCacheAddGlyph()
+//-----------------------------------------------------------------------------
 // - ImFontBaked_BuildGrowIndex()
 // - ImFontBaked_BuildLoadGlyph()
+// - ImFontAtlasBakedLoadGlyphs()
+// - ImFontBaked_BuildLoadGlyphsForText()
 // - ImFontBaked_BuildLoadGlyphAdvanceX()
 // - ImFontAtlasDebugLogTextureRequests()
 //-----------------------------------------------------------------------------
@@ -2626,6 +4236,7 @@ static const ImVec2 FONT_ATLAS_DEFAULT_TEX_CURSOR_DATA[ImGuiMouseCursor_COUNT][3
 
 #define IM_FONTGLYPH_INDEX_UNUSED           ((ImU16)-1) // 0xFFFF
 #define IM_FONTGLYPH_INDEX_NOT_FOUND        ((ImU16)-2) // 0xFFFE
+#define IM_FONTBAKED_INDEX_ASCII_SIZE       128         // Initial index size of a baked font: text loops index ASCII characters without range checks
 
 ImFontAtlas::ImFontAtlas()
 {
@@ -2651,6 +4262,7 @@ ImFontAtlas::~ImFontAtlas()
     ClearTexData();
     TexList.clear_delete();
     TexData = NULL;
+    ImFontAtlasGlyphCacheDestroy(this);
 }
 
 void ImFontAtlas::Clear()
@@ -2752,6 +4364,10 @@ void ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool rendere
     if (atlas->TexIsBuilt && atlas->Builder->PreloadedAllGlyphsRanges)
         IM_ASSERT_USER_ERROR(atlas->RendererHasTextures == false, "Called ImFontAtlas::Build() before ImGuiBackendFlags_RendererHasTextures got set! With new backends: you don't need to call Build().");
 
+    // Toggling ImFontAtlasFlags_DistanceField invalidates every glyph: rebuild from sources.
+    if (atlas->RendererHasTextures && atlas->TexData->UseDistanceField != ((atlas->Flags & ImFontAtlasFlags_DistanceField) != 0))
+        ImFontAtlasBuildClear(atlas);
+
     // Clear BakedCurrent cache, this is important because it ensure the uncached path gets taken once.
     // We also rely on ImFontBaked* pointers never crossing frames.
     ImFontAtlasBuilder* builder = atlas->Builder;
@@ -2833,6 +4449,13 @@ void ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool rendere
             tex_n--;
         }
     }
+
+    // Shrink texture back within memory budget when possible, otherwise reclaim space left by discarded glyphs, a few glyphs at a time
+    if (atlas->RendererHasTextures)
+    {
+        ImFontAtlasTextureShrinkToBudget(atlas);
+        ImFontAtlasPackDefragStep(atlas);
+    }
 }
 
 void ImFontAtlasTextureBlockConvert(const unsigned char* src_pixels, ImTextureFormat src_fmt, int src_pitch, unsigned char* dst_pixels, ImTextureFormat dst_fmt, int dst_pitch, int w, int h)
@@ -2874,8 +4497,8 @@ void ImFontAtlasTextureBlockConvert(const unsigned char* src_pixels, ImTextureFo
 // Post-process hooks may eventually be added here.
 void ImFontAtlasTextureBlockPostProcess(ImFontAtlasPostProcessData* data)
 {
-    // Multiply operator (legacy)
-    if (data->FontSrc->RasterizerMultiply != 1.0f)
+    // Multiply operator (legacy). Not applied to distance fields, where it would move glyph edges.
+    if (data->FontSrc->RasterizerMultiply != 1.0f && !(data->FontAtlas->Flags & ImFontAtlasFlags_DistanceField))
         ImFontAtlasTextureBlockPostProcessMultiply(data, data->FontSrc->RasterizerMultiply);
 }
 
@@ -3262,6 +4885,7 @@ ImFontAtlasRectId ImFontAtlas::AddCustomRect(int width, int height, ImFontAtlasR
     ImFontAtlasRectId r_id = ImFontAtlasPackAddRect(this, width, height);
     if (r_id == ImFontAtlasRectId_Invalid)
         return ImFontAtlasRectId_Invalid;
+    Builder->RectsIndex[ImFontAtlasRectId_GetIndex(r_id)].IsCustom = 1;
     if (out_r != NULL)
         GetCustomRect(r_id, out_r);
 
@@ -3308,6 +4932,7 @@ ImFontAtlasRectId ImFontAtlas::AddCustomRectFontGlyphForSize(ImFont* font, float
     ImFontAtlasRectId r_id = ImFontAtlasPackAddRect(this, width, height);
     if (r_id == ImFontAtlasRectId_Invalid)
         return ImFontAtlasRectId_Invalid;
+    Builder->RectsIndex[ImFontAtlasRectId_GetIndex(r_id)].IsCustom = 1;
     ImTextureRect* r = ImFontAtlasPackGetRect(this, r_id);
     if (RendererHasTextures)
         ImFontAtlasTextureBlockQueueUpload(this, TexData, r->x, r->y, r->w, r->h);
@@ -3434,13 +5059,15 @@ void ImFontAtlasBuildLegacyPreloadAllGlyphRanges(ImFontAtlas* atlas)
             baked->FindGlyph(font->FallbackChar);
         if (font->EllipsisChar != 0)
             baked->FindGlyph(font->EllipsisChar);
+        ImVector<ImWchar> codepoints;
         for (ImFontConfig* src : font->Sources)
         {
             const ImWchar* ranges = src->GlyphRanges ? src->GlyphRanges : atlas->GetGlyphRangesDefault();
             for (; ranges[0]; ranges += 2)
                 for (unsigned int c = ranges[0]; c <= ranges[1] && c <= IM_UNICODE_CODEPOINT_MAX; c++) //-V560
-                    baked->FindGlyph((ImWchar)c);
+                    codepoints.push_back((ImWchar)c);
         }
+        ImFontAtlasBakedLoadGlyphs(atlas, baked, codepoints.Data, codepoints.Size);
     }
 }
 
@@ -3758,6 +5385,14 @@ void ImFontAtlasBuildSetupFontSpecialGlyphs(ImFontAtlas* atlas, ImFont* font, Im
     }
 }
 
+// Contexts may have cached text sizes keyed on ImFontBaked pointers (see io.ConfigTextSizeCache)
+static void ImFontAtlasTextSizeCachesClear(ImFontAtlas* atlas)
+{
+    for (ImDrawListSharedData* shared_data : atlas->DrawListSharedDatas)
+        if (ImGuiContext* ctx = shared_data->Context)
+            ctx->TextSizeCache.Clear();
+}
+
 void ImFontAtlasBakedDiscardFontGlyph(ImFontAtlas* atlas, ImFont* font, ImFontBaked* baked, ImFontGlyph* glyph)
 {
     if (glyph->PackId != ImFontAtlasRectId_Invalid)
@@ -3771,6 +5406,8 @@ void ImFontAtlasBakedDiscardFontGlyph(ImFontAtlas* atlas, ImFont* font, ImFontBa
     IM_UNUSED(font);
     baked->IndexLookup[c] = IM_FONTGLYPH_INDEX_UNUSED;
     baked->IndexAdvanceX[c] = baked->FallbackAdvanceX;
+    baked->GlyphsUvGeneration = ++atlas->Builder->GlyphsUvGenerationNext;
+    ImFontAtlasTextSizeCachesClear(atlas);
 }
 
 ImFontBaked* ImFontAtlasBakedAdd(ImFontAtlas* atlas, ImFont* font, float font_size, float font_rasterizer_density, ImGuiID baked_id)
@@ -3782,6 +5419,9 @@ ImFontBaked* ImFontAtlasBakedAdd(ImFontAtlas* atlas, ImFont* font, float font_si
     baked->BakedId = baked_id;
     baked->ContainerFont = font;
     baked->LastUsedFrame = atlas->Builder->FrameCount;
+    baked->GlyphsUvGeneration = ++atlas->Builder->GlyphsUvGenerationNext; // A previous baked with same BakedId may have had its glyphs elsewhere
+    baked->IndexAdvanceX.resize(IM_FONTBAKED_INDEX_ASCII_SIZE, -1.0f);
+    baked->IndexLookup.resize(IM_FONTBAKED_INDEX_ASCII_SIZE, IM_FONTGLYPH_INDEX_UNUSED);
 
     // Initialize backend data
     size_t loader_data_size = 0;
@@ -3833,6 +5473,54 @@ ImFontBaked* ImFontAtlasBakedGetClosestMatch(ImFontAtlas* atlas, ImFont* font, f
     return NULL;
 }
 
+static bool ImFontWrapLinesEntry_Matches(const ImFontWrapLinesEntry& entry, ImFontBaked* baked, float size, float wrap_width, ImDrawTextFlags flags, const char* text, const char* text_end)
+{
+    const int text_len = (int)(text_end - text);
+    if (entry.Baked != baked || entry.Text.Size != text_len || entry.Size != size || entry.WrapWidth != wrap_width || entry.Flags != (flags & ImDrawTextFlags_WrapKeepBlanks))
+        return false;
+    return memcmp(entry.Text.Data, text, (size_t)text_len) == 0;
+}
+
+// Find line breaks recorded for this text during the current frame
+static ImFontWrapLinesEntry* ImFontAtlasWrapLinesFind(ImFontAtlas* atlas, ImFontBaked* baked, float size, float wrap_width, ImDrawTextFlags flags, const char* text, const char* text_end)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    for (ImFontWrapLinesEntry& entry : builder->WrapLines)
+        if (entry.FrameCount == builder->FrameCount && ImFontWrapLinesEntry_Matches(entry, baked, size, wrap_width, flags, text, text_end))
+            return &entry;
+    return NULL;
+}
+
+// Store line ends recorded in builder->WrapLinesTemp. Texts measured every frame keep their entry.
+static void ImFontAtlasWrapLinesAdd(ImFontAtlas* atlas, ImFontBaked* baked, float size, float wrap_width, ImDrawTextFlags flags, const char* text, const char* text_end)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImFontWrapLinesEntry* entry = NULL;
+    for (ImFontWrapLinesEntry& it : builder->WrapLines)
+        if (ImFontWrapLinesEntry_Matches(it, baked, size, wrap_width, flags, text, text_end))
+            entry = &it;
+    if (entry == NULL)
+    {
+        entry = &builder->WrapLines[builder->WrapLinesNext];
+        builder->WrapLinesNext = (builder->WrapLinesNext + 1) % IM_ARRAYSIZE(builder->WrapLines);
+        entry->Baked = baked;
+        entry->Size = size;
+        entry->WrapWidth = wrap_width;
+        entry->Flags = flags & ImDrawTextFlags_WrapKeepBlanks;
+        entry->Text.resize((int)(text_end - text));
+        memcpy(entry->Text.Data, text, (size_t)(text_end - text));
+    }
+    entry->FrameCount = builder->FrameCount;
+    entry->LineEnds.swap(builder->WrapLinesTemp);
+}
+
+static void ImFontAtlasWrapLinesDiscardBaked(ImFontAtlas* atlas, ImFontBaked* baked)
+{
+    for (ImFontWrapLinesEntry& entry : atlas->Builder->WrapLines)
+        if (entry.Baked == baked)
+            entry.Baked = NULL;
+}
+
 void ImFontAtlasBakedDiscard(ImFontAtlas* atlas, ImFont* font, ImFontBaked* baked)
 {
     ImFontAtlasBuilder* builder = atlas->Builder;
@@ -3857,6 +5545,8 @@ void ImFontAtlasBakedDiscard(ImFontAtlas* atlas, ImFont* font, ImFontBaked* bake
     }
     builder->BakedMap.SetVoidPtr(baked->BakedId, NULL);
     builder->BakedDiscardedCount++;
+    ImFontAtlasWrapLinesDiscardBaked(atlas, baked);
+    ImFontAtlasTextSizeCachesClear(atlas);
     baked->ClearOutputData();
     baked->WantDestroy = true;
     font->LastBaked = NULL;
@@ -3892,6 +5582,85 @@ void ImFontAtlasBuildDiscardBakes(ImFontAtlas* atlas, int unused_frames)
     }
 }
 
+struct ImFontAtlasEvictCandidate
+{
+    int     LastUsedFrame;
+    int     BakedIdx;
+    int     GlyphIdx;
+};
+
+static int IMGUI_CDECL ImFontAtlasEvictCandidateCompare(const void* lhs, const void* rhs)
+{
+    const ImFontAtlasEvictCandidate* a = (const ImFontAtlasEvictCandidate*)lhs;
+    const ImFontAtlasEvictCandidate* b = (const ImFontAtlasEvictCandidate*)rhs;
+    if (a->LastUsedFrame != b->LastUsedFrame)
+        return (a->LastUsedFrame < b->LastUsedFrame) ? -1 : +1;
+    if (a->BakedIdx != b->BakedIdx)
+        return (a->BakedIdx < b->BakedIdx) ? -1 : +1;
+    return (a->GlyphIdx < b->GlyphIdx) ? -1 : (a->GlyphIdx > b->GlyphIdx) ? +1 : 0;
+}
+
+// Evict glyphs not rendered during the last 'unused_frames' frames, least recently used first, until 'max_surface' pixels are freed.
+// Evict nothing if less than 'min_surface' pixels can be freed.
+// - Their space is immediately reusable by the packer. Their entry in baked->Glyphs[] is reused by the next loaded glyph.
+// - Their advance is kept in IndexAdvanceX[], so text measurements (and caches of them) don't change. They are loaded again when rendered.
+// - Fallback and ellipsis glyphs, glyphs added with AddCustomRectFontGlyph() and glyphs of fonts which can't load glyphs are never evicted.
+int ImFontAtlasBuildEvictGlyphs(ImFontAtlas* atlas, int min_surface, int max_surface, int unused_frames)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    if (!atlas->RendererHasTextures || atlas->Locked)
+        return 0;
+
+    const int pack_padding = atlas->TexGlyphPadding;
+    ImVector<ImFontAtlasEvictCandidate> candidates;
+    int candidates_surface = 0;
+    for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
+    {
+        ImFontBaked* baked = &builder->BakedPool[baked_n];
+        ImFont* font = baked->ContainerFont;
+        if (baked->WantDestroy || (font->Flags & (ImFontFlags_LockBakedSizes | ImFontFlags_NoLoadGlyphs)))
+            continue;
+        for (int glyph_n = 0; glyph_n < baked->Glyphs.Size; glyph_n++)
+        {
+            const ImFontGlyph& glyph = baked->Glyphs[glyph_n];
+            if (glyph.PackId == ImFontAtlasRectId_Invalid || glyph.LastUsedFrame + unused_frames > builder->FrameCount)
+                continue;
+            if (glyph_n == baked->FallbackGlyphIndex || glyph.Codepoint == font->EllipsisChar || builder->RectsIndex[ImFontAtlasRectId_GetIndex(glyph.PackId)].IsCustom)
+                continue;
+            ImFontAtlasEvictCandidate candidate = { glyph.LastUsedFrame, baked_n, glyph_n };
+            candidates.push_back(candidate);
+            ImTextureRect* r = ImFontAtlasPackGetRect(atlas, glyph.PackId);
+            candidates_surface += (r->w + pack_padding) * (r->h + pack_padding);
+        }
+    }
+    if (candidates.Size == 0 || candidates_surface < min_surface)
+        return 0;
+    ImQsort(candidates.Data, (size_t)candidates.Size, sizeof(ImFontAtlasEvictCandidate), ImFontAtlasEvictCandidateCompare);
+
+    int freed_surface = 0;
+    int evicted_count = 0;
+    for (const ImFontAtlasEvictCandidate& candidate : candidates)
+    {
+        if (freed_surface >= max_surface)
+            break;
+        ImFontBaked* baked = &builder->BakedPool[candidate.BakedIdx];
+        ImFontGlyph* glyph = &baked->Glyphs[candidate.GlyphIdx];
+        IM_ASSERT(baked->IndexLookup[glyph->Codepoint] == candidate.GlyphIdx);
+        ImTextureRect* r = ImFontAtlasPackGetRect(atlas, glyph->PackId);
+        freed_surface += (r->w + pack_padding) * (r->h + pack_padding);
+        baked->MetricsTotalSurface -= r->w * r->h;
+        ImFontAtlasPackDiscardRect(atlas, glyph->PackId);
+        baked->IndexLookup[glyph->Codepoint] = IM_FONTGLYPH_INDEX_UNUSED;
+        *glyph = ImFontGlyph();
+        baked->GlyphsFreeList.push_back((ImU16)candidate.GlyphIdx);
+        baked->GlyphsUvGeneration = ++builder->GlyphsUvGenerationNext; // Other glyphs may be packed in their space
+        evicted_count++;
+    }
+    builder->GlyphsEvictedCount += evicted_count;
+    IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: evicted %d glyphs (%d px) unused since frame %d\n", atlas->TexData->UniqueID, evicted_count, freed_surface, candidates[evicted_count - 1].LastUsedFrame);
+    return freed_surface;
+}
+
 // Those functions are designed to facilitate changing the underlying structures for ImFontAtlas to store an array of ImDrawListSharedData*
 void ImFontAtlasAddDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* data)
 {
@@ -3978,6 +5747,7 @@ ImTextureData* ImFontAtlasTextureAdd(ImFontAtlas* atlas, int w, int h)
     }
 
     new_tex->Create(atlas->TexDesiredFormat, w, h);
+    new_tex->UseDistanceField = (atlas->Flags & ImFontAtlasFlags_DistanceField) != 0;
     atlas->TexIsBuilt = false;
 
     ImFontAtlasBuildSetTexture(atlas, new_tex);
@@ -3997,6 +5767,31 @@ static void ImFontAtlasDebugWriteTexToDisk(ImTextureData* tex, const char* descr
 }
 #endif
 
+// Update UV of all glyphs, after rectangles were moved or texture was resized
+static void ImFontAtlasBuildUpdateGlyphsUV(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
+        for (ImFontGlyph& glyph : builder->BakedPool[baked_n].Glyphs)
+            if (glyph.PackId != ImFontAtlasRectId_Invalid)
+            {
+                ImTextureRect* r = ImFontAtlasPackGetRect(atlas, glyph.PackId);
+                glyph.U0 = (r->x) * atlas->TexUvScale.x;
+                glyph.V0 = (r->y) * atlas->TexUvScale.y;
+                glyph.U1 = (r->x + r->w) * atlas->TexUvScale.x;
+                glyph.V1 = (r->y + r->h) * atlas->TexUvScale.y;
+            }
+}
+
+static int IMGUI_CDECL ImFontAtlasRepackCompareByHeight(const void* lhs, const void* rhs)
+{
+    const ImVec2i* a = (const ImVec2i*)lhs;
+    const ImVec2i* b = (const ImVec2i*)rhs;
+    if (a->y != b->y)
+        return b->y - a->y;
+    return a->x - b->x;
+}
+
 void ImFontAtlasTextureRepack(ImFontAtlas* atlas, int w, int h)
 {
     ImFontAtlasBuilder* builder = atlas->Builder;
@@ -4011,22 +5806,35 @@ void ImFontAtlasTextureRepack(ImFontAtlas* atlas, int w, int h)
     //IMGUI_DEBUG_LOG_FONT("[font] - Old packed rects: %d, area %d px\n", builder->RectsPackedCount, builder->RectsPackedSurface);
     //ImFontAtlasDebugWriteTexToDisk(old_tex, "Before Pack");
 
+    // Save packer state, restored on failure
+    ImVector<ImFontAtlasPackShelf> old_shelves = builder->PackShelves;
+    ImVector<ImFontAtlasPackSlot> old_free_slots = builder->PackFreeSlots;
+    const int old_shelves_height = builder->PackShelvesHeight;
+    const int old_dirty_height = builder->PackDirtyHeight;
+    const ImVec2i old_packed(builder->RectsPackedCount, builder->RectsPackedSurface);
+    const ImVec2i old_discarded(builder->RectsDiscardedCount, builder->RectsDiscardedSurface);
+    const ImVec2i old_max_rect_bounds = builder->MaxRectBounds;
+
     // Repack, lose discarded rectangle, copy pixels
-    // FIXME-NEWATLAS: This is unstable because packing order is based on RectsIndex
-    // FIXME-NEWATLAS-V2: Repacking in batch would be beneficial to packing heuristic, and fix stability.
+    // - Rectangles are packed from tallest to shortest, which fills shelves with rectangles of similar heights.
+    // - Ties are sorted by index, so repacking the same set of rectangles gives the same result.
     // FIXME-NEWATLAS-TESTS: Test calling RepackTexture with size too small to fits existing rects.
     ImFontAtlasPackInit(atlas);
     ImVector<ImTextureRect> old_rects;
     ImVector<ImFontAtlasRectEntry> old_index = builder->RectsIndex;
     old_rects.swap(builder->Rects);
 
+    ImVector<ImVec2i> pack_order; // (index_idx, height)
+    pack_order.reserve(old_rects.Size - builder->RectsUnusedCount);
     for (ImFontAtlasRectEntry& index_entry : builder->RectsIndex)
+        if (index_entry.IsUsed)
+            pack_order.push_back(ImVec2i(builder->RectsIndex.index_from_ptr(&index_entry), old_rects[index_entry.TargetIndex].h));
+    ImQsort(pack_order.Data, (size_t)pack_order.Size, sizeof(ImVec2i), ImFontAtlasRepackCompareByHeight);
+
+    for (const ImVec2i& pack_item : pack_order)
     {
-        if (index_entry.IsUsed == false)
-            continue;
+        ImFontAtlasRectEntry& index_entry = builder->RectsIndex[pack_item.x];
         ImTextureRect& old_r = old_rects[index_entry.TargetIndex];
-        if (old_r.w == 0 && old_r.h == 0)
-            continue;
         ImFontAtlasRectId new_r_id = ImFontAtlasPackAddRect(atlas, old_r.w, old_r.h, &index_entry);
         if (new_r_id == ImFontAtlasRectId_Invalid)
         {
@@ -4036,29 +5844,29 @@ void ImFontAtlasTextureRepack(ImFontAtlas* atlas, int w, int h)
             new_tex->WantDestroyNextFrame = true;
             builder->Rects.swap(old_rects);
             builder->RectsIndex = old_index;
+            builder->PackShelves.swap(old_shelves);
+            builder->PackFreeSlots.swap(old_free_slots);
+            builder->PackShelvesHeight = old_shelves_height;
+            builder->PackDirtyHeight = old_dirty_height;
+            builder->RectsPackedCount = old_packed.x;
+            builder->RectsPackedSurface = old_packed.y;
+            builder->RectsDiscardedCount = old_discarded.x;
+            builder->RectsDiscardedSurface = old_discarded.y;
+            builder->MaxRectBounds = old_max_rect_bounds;
+            builder->LockDisableResize = false;
             ImFontAtlasBuildSetTexture(atlas, old_tex);
             ImFontAtlasTextureGrow(atlas, w, h); // Recurse
             return;
         }
-        IM_ASSERT(ImFontAtlasRectId_GetIndex(new_r_id) == builder->RectsIndex.index_from_ptr(&index_entry));
+        IM_ASSERT(ImFontAtlasRectId_GetIndex(new_r_id) == pack_item.x);
         ImTextureRect* new_r = ImFontAtlasPackGetRect(atlas, new_r_id);
         ImFontAtlasTextureBlockCopy(old_tex, old_r.x, old_r.y, new_tex, new_r->x, new_r->y, new_r->w, new_r->h);
     }
-    IM_ASSERT(old_rects.Size == builder->Rects.Size + builder->RectsDiscardedCount);
-    builder->RectsDiscardedCount = 0;
-    builder->RectsDiscardedSurface = 0;
+    IM_ASSERT(old_rects.Size == builder->Rects.Size + builder->RectsUnusedCount);
+    builder->RectsUnusedCount = 0;
 
     // Patch glyphs UV
-    for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
-        for (ImFontGlyph& glyph : builder->BakedPool[baked_n].Glyphs)
-            if (glyph.PackId != ImFontAtlasRectId_Invalid)
-            {
-                ImTextureRect* r = ImFontAtlasPackGetRect(atlas, glyph.PackId);
-                glyph.U0 = (r->x) * atlas->TexUvScale.x;
-                glyph.V0 = (r->y) * atlas->TexUvScale.y;
-                glyph.U1 = (r->x + r->w) * atlas->TexUvScale.x;
-                glyph.V1 = (r->y + r->h) * atlas->TexUvScale.y;
-            }
+    ImFontAtlasBuildUpdateGlyphsUV(atlas);
 
     // Update other cached UV
     ImFontAtlasBuildUpdateLinesTexData(atlas);
@@ -4069,10 +5877,43 @@ void ImFontAtlasTextureRepack(ImFontAtlas* atlas, int w, int h)
     //ImFontAtlasDebugWriteTexToDisk(new_tex, "After Pack");
 }
 
+// Create a larger texture, with existing rectangles staying at the same position.
+// This is a single copy of used pixels, much cheaper than repacking.
+static void ImFontAtlasTextureExtend(ImFontAtlas* atlas, int w, int h)
+{
+    ImTextureData* old_tex = atlas->TexData;
+    IM_ASSERT(w >= old_tex->Width && h >= old_tex->Height);
+    ImTextureData* new_tex = ImFontAtlasTextureAdd(atlas, w, h);
+    new_tex->UseColors = old_tex->UseColors;
+    IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: resize %dx%d => Texture #%03d: %dx%d\n", old_tex->UniqueID, old_tex->Width, old_tex->Height, new_tex->UniqueID, new_tex->Width, new_tex->Height);
+
+    // Copy pixels which may have been used since old texture was created
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    int copy_w = 0;
+    for (const ImFontAtlasPackShelf& shelf : builder->PackShelves)
+        copy_w = ImMax(copy_w, shelf.XDirty);
+    const int copy_h = ImMin(builder->PackDirtyHeight, old_tex->Height);
+    if (copy_w > 0 && copy_h > 0)
+    {
+        if (new_tex->Width == old_tex->Width)
+            memcpy(new_tex->Pixels, old_tex->Pixels, (size_t)old_tex->GetPitch() * copy_h); // Same pitch: copy all lines at once
+        else
+            ImFontAtlasTextureBlockCopy(old_tex, 0, 0, new_tex, 0, 0, copy_w, copy_h);
+    }
+    new_tex->UsedRect = old_tex->UsedRect;
+
+    ImFontAtlasBuildUpdateGlyphsUV(atlas);
+    ImFontAtlasBuildUpdateLinesTexData(atlas);
+    ImFontAtlasBuildUpdateBasicTexData(atlas);
+    ImFontAtlasUpdateDrawListsSharedData(atlas);
+}
+
+// Grow current texture, or grow from a given size (after failing to repack at that size)
 void ImFontAtlasTextureGrow(ImFontAtlas* atlas, int old_tex_w, int old_tex_h)
 {
     //ImFontAtlasDebugWriteTexToDisk(atlas->TexData, "Before Grow");
     ImFontAtlasBuilder* builder = atlas->Builder;
+    const bool grow_current_tex = (old_tex_w == -1 && old_tex_h == -1);
     if (old_tex_w == -1)
         old_tex_w = atlas->TexData->Width;
     if (old_tex_h == -1)
@@ -4084,7 +5925,7 @@ void ImFontAtlasTextureGrow(ImFontAtlas* atlas, int old_tex_w, int old_tex_h)
     IM_ASSERT(ImIsPowerOfTwo(atlas->TexMinWidth) && ImIsPowerOfTwo(atlas->TexMaxWidth) && ImIsPowerOfTwo(atlas->TexMinHeight) && ImIsPowerOfTwo(atlas->TexMaxHeight));
 
     // Grow texture so it follows roughly a square.
-    // - Grow height before width, as width imply more packing nodes.
+    // - Grow height before width.
     // - Caller should be taking account of RectsDiscardedSurface and may not need to grow.
     int new_tex_w = (old_tex_h <= old_tex_w) ? old_tex_w : old_tex_w * 2;
     int new_tex_h = (old_tex_h <= old_tex_w) ? old_tex_h * 2 : old_tex_h;
@@ -4098,21 +5939,43 @@ void ImFontAtlasTextureGrow(ImFontAtlas* atlas, int old_tex_w, int old_tex_h)
     if (new_tex_w == old_tex_w && new_tex_h == old_tex_h)
         return;
 
-    ImFontAtlasTextureRepack(atlas, new_tex_w, new_tex_h);
+    // Keep rectangles in place when growing current texture
+    if (grow_current_tex && new_tex_w >= old_tex_w && new_tex_h >= old_tex_h)
+        ImFontAtlasTextureExtend(atlas, new_tex_w, new_tex_h);
+    else
+        ImFontAtlasTextureRepack(atlas, new_tex_w, new_tex_h);
 }
 
-void ImFontAtlasTextureMakeSpace(ImFontAtlas* atlas)
+void ImFontAtlasTextureMakeSpace(ImFontAtlas* atlas, bool allow_evict)
 {
-    // Can some baked contents be ditched?
+    // Can some baked contents be ditched? Their space is immediately reused by the packer, caller will try again.
     //IMGUI_DEBUG_LOG_FONT("[font] ImFontAtlasBuildMakeSpace()\n");
     ImFontAtlasBuilder* builder = atlas->Builder;
+    const int packed_surface = builder->RectsPackedSurface;
     ImFontAtlasBuildDiscardBakes(atlas, 2);
+    if (builder->RectsPackedSurface < packed_surface)
+        return;
 
-    // Currently using a heuristic for repack without growing.
-    if (builder->RectsDiscardedSurface < builder->RectsPackedSurface * 0.20f)
-        ImFontAtlasTextureGrow(atlas);
-    else
-        ImFontAtlasTextureRepack(atlas, atlas->TexData->Width, atlas->TexData->Height);
+    // Repack when texture is mostly free but too fragmented to fit the new rectangle, otherwise grow texture (keeping rectangles in place).
+    // ImFontAtlasPackDefragStep() generally keeps fragmentation low enough for this repack to be rare.
+    ImTextureData* old_tex = atlas->TexData;
+    if (builder->RectsPackedSurface * 2 < old_tex->Width * old_tex->Height)
+    {
+        ImFontAtlasTextureRepack(atlas, old_tex->Width, old_tex->Height);
+        return;
+    }
+
+    // Stay within memory budget: evict least recently used glyphs rather than growing texture. When all glyphs are in use, grow anyway.
+    // Caller passes 'allow_evict = false' when space freed by a previous eviction was too scattered to fit its rectangle.
+    if (allow_evict && atlas->TexMemoryBudget > 0 && old_tex->GetSizeInBytes() * 2 > atlas->TexMemoryBudget)
+    {
+        if (ImFontAtlasBuildEvictGlyphs(atlas, 1, old_tex->Width * old_tex->Height / IM_FONTATLAS_EVICT_SURFACE_DIVISOR, IM_FONTATLAS_EVICT_UNUSED_FRAMES) > 0)
+            return;
+        IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: all glyphs in use, growing past memory budget.\n", old_tex->UniqueID);
+    }
+    ImFontAtlasTextureGrow(atlas);
+    if (atlas->TexData == old_tex && builder->RectsDiscardedCount > 0)
+        ImFontAtlasTextureRepack(atlas, old_tex->Width, old_tex->Height); // Already at maximum size
 }
 
 ImVec2i ImFontAtlasTextureGetSizeEstimate(ImFontAtlas* atlas)
@@ -4125,7 +5988,7 @@ ImVec2i ImFontAtlasTextureGetSizeEstimate(ImFontAtlas* atlas)
     ImFontAtlasBuilder* builder = atlas->Builder;
     min_w = ImMax(ImUpperPowerOfTwo(builder->MaxRectSize.x), min_w);
     min_h = ImMax(ImUpperPowerOfTwo(builder->MaxRectSize.y), min_h);
-    const int surface_approx = builder->RectsPackedSurface - builder->RectsDiscardedSurface; // Expected surface after repack
+    const int surface_approx = builder->RectsPackedSurface; // Expected surface after repack
     const int surface_sqrt = (int)sqrtf((float)surface_approx);
 
     int new_tex_w;
@@ -4179,8 +6042,40 @@ void ImFontAtlasTextureCompact(ImFontAtlas* atlas)
     ImFontAtlasTextureRepack(atlas, new_tex_size.x, new_tex_size.y);
 }
 
-// Start packing over current empty texture
-void ImFontAtlasBuildInit(ImFontAtlas* atlas)
+// Called once per frame by ImFontAtlasUpdateNewFrame(), after texture had to grow past ImFontAtlas::TexMemoryBudget because all its glyphs were in use.
+// Halve texture (reversing ImFontAtlasTextureGrow() steps) when evicting glyphs unused for a while leaves it at most a quarter used at the smaller size,
+// so that it doesn't need to grow again right away.
+void ImFontAtlasTextureShrinkToBudget(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImTextureData* old_tex = atlas->TexData;
+    if (atlas->TexMemoryBudget <= 0 || old_tex->GetSizeInBytes() <= atlas->TexMemoryBudget)
+        return;
+    if (builder->LockDisableResize || old_tex->Status == ImTextureStatus_WantDestroy || old_tex->Status == ImTextureStatus_Destroyed)
+        return;
+    if (builder->TexShrinkFailedFrame != 0 && builder->FrameCount - builder->TexShrinkFailedFrame < IM_FONTATLAS_SHRINK_UNUSED_FRAMES)
+        return; // Glyphs in use during last attempt need time to become unused: don't scan all glyphs every frame
+
+    const int pack_padding = atlas->TexGlyphPadding;
+    int new_tex_w = (old_tex->Height >= old_tex->Width) ? old_tex->Width : old_tex->Width / 2;
+    int new_tex_h = (old_tex->Height >= old_tex->Width) ? old_tex->Height / 2 : old_tex->Height;
+    new_tex_w = ImMax(new_tex_w, ImMax(ImUpperPowerOfTwo(atlas->TexMinWidth), ImUpperPowerOfTwo(builder->MaxRectSize.x + pack_padding)));
+    new_tex_h = ImMax(new_tex_h, ImMax(ImUpperPowerOfTwo(atlas->TexMinHeight), ImUpperPowerOfTwo(builder->MaxRectSize.y + pack_padding)));
+    if (new_tex_w * new_tex_h >= old_tex->Width * old_tex->Height)
+        return;
+
+    const int surface_to_free = builder->RectsPackedSurface - (new_tex_w * new_tex_h) / 4;
+    if (surface_to_free > 0 && ImFontAtlasBuildEvictGlyphs(atlas, surface_to_free, surface_to_free, IM_FONTATLAS_SHRINK_UNUSED_FRAMES) == 0)
+    {
+        builder->TexShrinkFailedFrame = builder->FrameCount;
+        return;
+    }
+    IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: shrinking to %dx%d to stay within memory budget.\n", old_tex->UniqueID, new_tex_w, new_tex_h);
+    ImFontAtlasTextureRepack(atlas, new_tex_w, new_tex_h);
+}
+
+// Start packing over current empty texture
+void ImFontAtlasBuildInit(ImFontAtlas* atlas)
 {
     // Select Backend
     // - Note that we do not reassign to atlas->FontLoader, since it is likely to point to static data which
@@ -4233,25 +6128,287 @@ void ImFontAtlasBuildDestroy(ImFontAtlas* atlas)
         atlas->FontLoader->LoaderShutdown(atlas);
         IM_ASSERT(atlas->FontLoaderData == NULL);
     }
+    ImFontAtlasTextSizeCachesClear(atlas); // ImFontBaked pointers are freed with the builder
     IM_DELETE(atlas->Builder);
     atlas->Builder = NULL;
 }
 
 void ImFontAtlasPackInit(ImFontAtlas * atlas)
 {
-    ImTextureData* tex = atlas->TexData;
     ImFontAtlasBuilder* builder = atlas->Builder;
-
-    // In theory we could decide to reduce the number of nodes, e.g. halve them, and waste a little texture space, but it doesn't seem worth it.
-    const int pack_node_count = tex->Width / 2;
-    builder->PackNodes.resize(pack_node_count);
-    IM_STATIC_ASSERT(sizeof(stbrp_context) <= sizeof(stbrp_context_opaque));
-    stbrp_init_target((stbrp_context*)(void*)&builder->PackContext, tex->Width, tex->Height, builder->PackNodes.Data, builder->PackNodes.Size);
+    builder->PackShelves.resize(0);
+    builder->PackFreeSlots.resize(0);
+    builder->PackShelvesHeight = builder->PackDirtyHeight = 0;
+    builder->PackDefragShelfIdx = -1;
+    builder->PackDefragFailedSurface = 0;
     builder->RectsPackedSurface = builder->RectsPackedCount = 0;
+    builder->RectsDiscardedSurface = builder->RectsDiscardedCount = 0;
     builder->MaxRectSize = ImVec2i(0, 0);
     builder->MaxRectBounds = ImVec2i(0, 0);
 }
 
+// Shelves cover [0, PackShelvesHeight) without gaps: binary search shelf containing 'y'
+static int ImFontAtlasPackFindShelf(ImFontAtlasBuilder* builder, int y)
+{
+    int lo = 0, hi = builder->PackShelves.Size - 1;
+    while (lo < hi)
+    {
+        int mid = (lo + hi + 1) >> 1;
+        if (builder->PackShelves[mid].Y <= y)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    IM_ASSERT(builder->PackShelves[lo].Y <= y && y < builder->PackShelves[lo].Y + builder->PackShelves[lo].H);
+    return lo;
+}
+
+static void ImFontAtlasPackInsertShelf(ImFontAtlasBuilder* builder, int shelf_idx, const ImFontAtlasPackShelf& shelf)
+{
+    builder->PackShelves.insert(builder->PackShelves.Data + shelf_idx, shelf);
+    for (ImFontAtlasPackSlot& slot : builder->PackFreeSlots)
+        if (slot.ShelfIdx >= shelf_idx)
+            slot.ShelfIdx++;
+    if (builder->PackDefragShelfIdx >= shelf_idx)
+        builder->PackDefragShelfIdx++;
+}
+
+static void ImFontAtlasPackEraseShelf(ImFontAtlasBuilder* builder, int shelf_idx)
+{
+    builder->PackShelves.erase(builder->PackShelves.Data + shelf_idx);
+    for (ImFontAtlasPackSlot& slot : builder->PackFreeSlots)
+    {
+        IM_ASSERT(slot.ShelfIdx != shelf_idx);
+        if (slot.ShelfIdx > shelf_idx)
+            slot.ShelfIdx--;
+    }
+    if (builder->PackDefragShelfIdx == shelf_idx)
+        builder->PackDefragShelfIdx = -1;
+    else if (builder->PackDefragShelfIdx > shelf_idx)
+        builder->PackDefragShelfIdx--;
+}
+
+static void ImFontAtlasPackRemoveSlot(ImFontAtlasBuilder* builder, int slot_idx)
+{
+    ImFontAtlasPackSlot* slot = &builder->PackFreeSlots[slot_idx];
+    builder->RectsDiscardedCount--;
+    builder->RectsDiscardedSurface -= slot->W * builder->PackShelves[slot->ShelfIdx].H;
+    *slot = builder->PackFreeSlots.back();
+    builder->PackFreeSlots.pop_back();
+}
+
+// Find and reserve space for a w*h rectangle (padding included) in current texture. Return false if there's no room.
+// - 'reuse_only' only considers space left by discarded rectangles and free space on the right of non-empty shelves (used by defragmentation).
+// - Space which was previously used is cleared, including the padding which other rectangles may sample on their right/bottom.
+static bool ImFontAtlasPackAllocSpace(ImFontAtlas* atlas, int w, int h, int exclude_shelf_idx, bool reuse_only, int* out_x, int* out_y)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImTextureData* tex = atlas->TexData;
+    if (w > tex->Width || h > tex->Height)
+        return false;
+    const int h_max = h + IM_FONTATLAS_PACK_SHELF_SLACK(h);
+
+    // Best fit in space of discarded rectangles, then at the end of a shelf (with little waste on height in both cases)
+    int best_slot_idx = -1, best_shelf_idx = -1, best_score = INT_MAX;
+    for (int slot_n = 0; slot_n < builder->PackFreeSlots.Size && best_score > 0; slot_n++)
+    {
+        const ImFontAtlasPackSlot& slot = builder->PackFreeSlots[slot_n];
+        const int shelf_h = builder->PackShelves[slot.ShelfIdx].H;
+        if (slot.W < w || shelf_h < h || shelf_h > h_max || slot.ShelfIdx == exclude_shelf_idx)
+            continue;
+        const int score = (shelf_h - h) * tex->Width + (slot.W - w);
+        if (score < best_score)
+            best_slot_idx = slot_n, best_score = score;
+    }
+    if (best_slot_idx == -1)
+        for (int shelf_n = 0; shelf_n < builder->PackShelves.Size && best_score > 0; shelf_n++)
+        {
+            const ImFontAtlasPackShelf& shelf = builder->PackShelves[shelf_n];
+            if (shelf.H < h || shelf.H > h_max || shelf.X + w > tex->Width || shelf_n == exclude_shelf_idx || (reuse_only && shelf.UsedSurface == 0))
+                continue;
+            if (shelf.H - h < best_score)
+                best_shelf_idx = shelf_n, best_score = shelf.H - h;
+        }
+
+    // Split an empty shelf, or add a new one
+    if (best_slot_idx == -1 && best_shelf_idx == -1 && !reuse_only)
+    {
+        for (int shelf_n = 0; shelf_n < builder->PackShelves.Size; shelf_n++)
+        {
+            const ImFontAtlasPackShelf& shelf = builder->PackShelves[shelf_n];
+            if (shelf.UsedSurface == 0 && shelf.H >= h && shelf_n != exclude_shelf_idx && (best_shelf_idx == -1 || shelf.H < builder->PackShelves[best_shelf_idx].H))
+                best_shelf_idx = shelf_n;
+        }
+        if (best_shelf_idx != -1 && builder->PackShelves[best_shelf_idx].H > h_max)
+        {
+            ImFontAtlasPackShelf* shelf = &builder->PackShelves[best_shelf_idx];
+            ImFontAtlasPackShelf remainder = *shelf;
+            remainder.Y += h;
+            remainder.H -= h;
+            shelf->H = h;
+            ImFontAtlasPackInsertShelf(builder, best_shelf_idx + 1, remainder);
+        }
+        else if (best_shelf_idx == -1 && builder->PackShelvesHeight + h <= tex->Height)
+        {
+            ImFontAtlasPackShelf shelf = { builder->PackShelvesHeight, h, 0, (builder->PackShelvesHeight < builder->PackDirtyHeight) ? tex->Width : 0, 0 };
+            builder->PackShelves.push_back(shelf);
+            builder->PackShelvesHeight += h;
+            builder->PackDirtyHeight = ImMax(builder->PackDirtyHeight, builder->PackShelvesHeight);
+            best_shelf_idx = builder->PackShelves.Size - 1;
+        }
+    }
+
+    // Last resort: accept wasting height
+    if (best_slot_idx == -1 && best_shelf_idx == -1)
+    {
+        best_score = INT_MAX;
+        for (int slot_n = 0; slot_n < builder->PackFreeSlots.Size; slot_n++)
+        {
+            const ImFontAtlasPackSlot& slot = builder->PackFreeSlots[slot_n];
+            const int shelf_h = builder->PackShelves[slot.ShelfIdx].H;
+            if (slot.W >= w && shelf_h >= h && slot.ShelfIdx != exclude_shelf_idx && shelf_h - h < best_score)
+                best_slot_idx = slot_n, best_score = shelf_h - h;
+        }
+        for (int shelf_n = 0; shelf_n < builder->PackShelves.Size; shelf_n++)
+        {
+            const ImFontAtlasPackShelf& shelf = builder->PackShelves[shelf_n];
+            if (shelf.H < h || shelf.X + w > tex->Width || shelf_n == exclude_shelf_idx || (reuse_only && shelf.UsedSurface == 0))
+                continue;
+            if (shelf.H - h < best_score)
+                best_slot_idx = -1, best_shelf_idx = shelf_n, best_score = shelf.H - h;
+        }
+        if (best_slot_idx == -1 && best_shelf_idx == -1)
+            return false;
+    }
+
+    // Reserve space
+    int x;
+    bool dirty;
+    if (best_slot_idx != -1)
+    {
+        ImFontAtlasPackSlot* slot = &builder->PackFreeSlots[best_slot_idx];
+        best_shelf_idx = slot->ShelfIdx;
+        x = slot->X;
+        dirty = true;
+        if (slot->W == w)
+        {
+            ImFontAtlasPackRemoveSlot(builder, best_slot_idx);
+        }
+        else
+        {
+            slot->X += w;
+            slot->W -= w;
+            builder->RectsDiscardedSurface -= w * builder->PackShelves[best_shelf_idx].H;
+        }
+    }
+    else
+    {
+        ImFontAtlasPackShelf* shelf = &builder->PackShelves[best_shelf_idx];
+        x = shelf->X;
+        dirty = x < shelf->XDirty;
+        shelf->X += w;
+        shelf->XDirty = ImMax(shelf->XDirty, shelf->X);
+    }
+    ImFontAtlasPackShelf* shelf = &builder->PackShelves[best_shelf_idx];
+    shelf->UsedSurface += w * h;
+    *out_x = x;
+    *out_y = shelf->Y;
+
+    if (dirty)
+    {
+        const int pack_padding = atlas->TexGlyphPadding;
+        const int x0 = ImMax(x - pack_padding, 0);
+        const int y0 = ImMax(shelf->Y - pack_padding, 0);
+        ImFontAtlasTextureBlockFill(tex, x0, y0, x + w - x0, shelf->Y + h - y0, IM_COL32_BLACK_TRANS);
+        ImFontAtlasTextureBlockQueueUpload(atlas, tex, x0, y0, x + w - x0, shelf->Y + h - y0);
+    }
+    return true;
+}
+
+// Give back space of a w*h rectangle (padding included)
+static void ImFontAtlasPackFreeSpace(ImFontAtlasBuilder* builder, int x, int y, int w, int h)
+{
+    int shelf_idx = ImFontAtlasPackFindShelf(builder, y);
+    ImFontAtlasPackShelf* shelf = &builder->PackShelves[shelf_idx];
+    shelf->UsedSurface -= w * h;
+    IM_ASSERT(shelf->UsedSurface >= 0 && x + w <= shelf->X);
+
+    if (shelf->UsedSurface == 0)
+    {
+        // Shelf is empty: drop its slots and merge with empty neighbors, so it may be reused for any height
+        for (int slot_n = 0; slot_n < builder->PackFreeSlots.Size; slot_n++)
+            if (builder->PackFreeSlots[slot_n].ShelfIdx == shelf_idx)
+                ImFontAtlasPackRemoveSlot(builder, slot_n--);
+        shelf->X = 0;
+        if (shelf_idx + 1 < builder->PackShelves.Size && builder->PackShelves[shelf_idx + 1].UsedSurface == 0)
+        {
+            shelf->H += builder->PackShelves[shelf_idx + 1].H;
+            shelf->XDirty = ImMax(shelf->XDirty, builder->PackShelves[shelf_idx + 1].XDirty);
+            ImFontAtlasPackEraseShelf(builder, shelf_idx + 1);
+        }
+        if (shelf_idx > 0 && builder->PackShelves[shelf_idx - 1].UsedSurface == 0)
+        {
+            ImFontAtlasPackShelf* prev_shelf = &builder->PackShelves[shelf_idx - 1];
+            prev_shelf->H += shelf->H;
+            prev_shelf->XDirty = ImMax(prev_shelf->XDirty, shelf->XDirty);
+            ImFontAtlasPackEraseShelf(builder, shelf_idx--);
+        }
+        if (shelf_idx == builder->PackShelves.Size - 1)
+        {
+            builder->PackShelvesHeight = builder->PackShelves[shelf_idx].Y;
+            ImFontAtlasPackEraseShelf(builder, shelf_idx);
+        }
+        return;
+    }
+
+    // Merge with adjacent free slots, or with free space at the end of the shelf
+    int left_slot_idx = -1, right_slot_idx = -1;
+    for (int slot_n = 0; slot_n < builder->PackFreeSlots.Size; slot_n++)
+    {
+        const ImFontAtlasPackSlot& slot = builder->PackFreeSlots[slot_n];
+        if (slot.ShelfIdx != shelf_idx)
+            continue;
+        if (slot.X + slot.W == x)
+            left_slot_idx = slot_n;
+        else if (slot.X == x + w)
+            right_slot_idx = slot_n;
+    }
+    if (x + w == shelf->X)
+    {
+        shelf->X = x;
+        if (left_slot_idx != -1)
+        {
+            shelf->X = builder->PackFreeSlots[left_slot_idx].X;
+            ImFontAtlasPackRemoveSlot(builder, left_slot_idx);
+        }
+        return;
+    }
+    if (left_slot_idx != -1 && right_slot_idx != -1)
+    {
+        w += builder->PackFreeSlots[right_slot_idx].W;
+        ImFontAtlasPackRemoveSlot(builder, right_slot_idx);
+        if (left_slot_idx == builder->PackFreeSlots.Size)
+            left_slot_idx = right_slot_idx; // Was moved by ImFontAtlasPackRemoveSlot()
+        right_slot_idx = -1;
+    }
+    if (left_slot_idx != -1)
+    {
+        builder->PackFreeSlots[left_slot_idx].W += w;
+    }
+    else if (right_slot_idx != -1)
+    {
+        builder->PackFreeSlots[right_slot_idx].X = x;
+        builder->PackFreeSlots[right_slot_idx].W += w;
+    }
+    else
+    {
+        ImFontAtlasPackSlot slot = { shelf_idx, x, w };
+        builder->PackFreeSlots.push_back(slot);
+        builder->RectsDiscardedCount++;
+    }
+    builder->RectsDiscardedSurface += w * shelf->H;
+}
+
 // This is essentially a free-list pattern, it may be nice to wrap it into a dedicated type.
 static ImFontAtlasRectId ImFontAtlasPackAllocRectEntry(ImFontAtlas* atlas, int rect_idx)
 {
@@ -4274,6 +6431,7 @@ static ImFontAtlasRectId ImFontAtlasPackAllocRectEntry(ImFontAtlas* atlas, int r
     }
     index_entry->TargetIndex = rect_idx;
     index_entry->IsUsed = 1;
+    index_entry->IsCustom = 0;
     return ImFontAtlasRectId_Make(index_idx, index_entry->Generation);
 }
 
@@ -4286,7 +6444,24 @@ static ImFontAtlasRectId ImFontAtlasPackReuseRectEntry(ImFontAtlas* atlas, ImFon
     return ImFontAtlasRectId_Make(index_idx, index_entry->Generation);
 }
 
-// This is expected to be called in batches and followed by a repack
+// Remove entries of discarded rectangles from Rects[]
+static void ImFontAtlasPackGcRects(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImVector<ImTextureRect> old_rects;
+    old_rects.swap(builder->Rects);
+    builder->Rects.reserve(old_rects.Size - builder->RectsUnusedCount);
+    for (ImFontAtlasRectEntry& index_entry : builder->RectsIndex)
+        if (index_entry.IsUsed)
+        {
+            builder->Rects.push_back(old_rects[index_entry.TargetIndex]);
+            index_entry.TargetIndex = builder->Rects.Size - 1;
+        }
+    IM_ASSERT(old_rects.Size == builder->Rects.Size + builder->RectsUnusedCount);
+    builder->RectsUnusedCount = 0;
+}
+
+// Space of discarded rectangle is immediately reusable by the packer.
 void ImFontAtlasPackDiscardRect(ImFontAtlas* atlas, ImFontAtlasRectId id)
 {
     IM_ASSERT(id != ImFontAtlasRectId_Invalid);
@@ -4307,8 +6482,10 @@ void ImFontAtlasPackDiscardRect(ImFontAtlas* atlas, ImFontAtlasRectId id)
 
     const int pack_padding = atlas->TexGlyphPadding;
     builder->RectsIndexFreeListStart = index_idx;
-    builder->RectsDiscardedCount++;
-    builder->RectsDiscardedSurface += (rect->w + pack_padding) * (rect->h + pack_padding);
+    builder->RectsUnusedCount++;
+    builder->RectsPackedCount--;
+    builder->RectsPackedSurface -= (rect->w + pack_padding) * (rect->h + pack_padding);
+    ImFontAtlasPackFreeSpace(builder, rect->x, rect->y, rect->w + pack_padding, rect->h + pack_padding);
     rect->w = rect->h = 0; // Clear rectangle so it won't be packed again
 }
 
@@ -4326,17 +6503,17 @@ ImFontAtlasRectId ImFontAtlasPackAddRect(ImFontAtlas* atlas, int w, int h, ImFon
 
     // Pack
     ImTextureRect r = { 0, 0, (unsigned short)w, (unsigned short)h };
+    bool evicted = false;
     for (int attempts_remaining = 3; attempts_remaining >= 0; attempts_remaining--)
     {
         // Try packing
-        stbrp_rect pack_r = {};
-        pack_r.w = w + pack_padding;
-        pack_r.h = h + pack_padding;
-        stbrp_pack_rects((stbrp_context*)(void*)&builder->PackContext, &pack_r, 1);
-        r.x = (unsigned short)pack_r.x;
-        r.y = (unsigned short)pack_r.y;
-        if (pack_r.was_packed)
+        int pack_x, pack_y;
+        if (ImFontAtlasPackAllocSpace(atlas, w + pack_padding, h + pack_padding, -1, false, &pack_x, &pack_y))
+        {
+            r.x = (unsigned short)pack_x;
+            r.y = (unsigned short)pack_y;
             break;
+        }
 
         // If we ran out of attempts, return fallback
         if (attempts_remaining == 0 || builder->LockDisableResize)
@@ -4346,7 +6523,14 @@ ImFontAtlasRectId ImFontAtlasPackAddRect(ImFontAtlas* atlas, int w, int h, ImFon
         }
 
         // Resize or repack atlas! (this should be a rare event)
-        ImFontAtlasTextureMakeSpace(atlas);
+        // Space freed by evicting glyphs (see ImFontAtlas::TexMemoryBudget) may be too scattered for this rectangle: try it once, then grow.
+        const int evicted_count = builder->GlyphsEvictedCount;
+        ImFontAtlasTextureMakeSpace(atlas, !evicted);
+        if (builder->GlyphsEvictedCount != evicted_count)
+        {
+            evicted = true;
+            attempts_remaining++; // Don't count toward attempts, so that texture can still grow if this didn't help
+        }
     }
 
     builder->MaxRectBounds.x = ImMax(builder->MaxRectBounds.x, r.x + r.w + pack_padding);
@@ -4354,11 +6538,110 @@ ImFontAtlasRectId ImFontAtlasPackAddRect(ImFontAtlas* atlas, int w, int h, ImFon
     builder->RectsPackedCount++;
     builder->RectsPackedSurface += (w + pack_padding) * (h + pack_padding);
 
-    builder->Rects.push_back(r);
     if (overwrite_entry != NULL)
+    {
+        builder->Rects.push_back(r);
         return ImFontAtlasPackReuseRectEntry(atlas, overwrite_entry); // Write into an existing entry instead of adding one (used during repack)
-    else
-        return ImFontAtlasPackAllocRectEntry(atlas, builder->Rects.Size - 1);
+    }
+    if (builder->RectsUnusedCount >= 64 && builder->RectsUnusedCount >= builder->Rects.Size / 2)
+        ImFontAtlasPackGcRects(atlas);
+    builder->Rects.push_back(r);
+    return ImFontAtlasPackAllocRectEntry(atlas, builder->Rects.Size - 1);
+}
+
+// Incremental defragmentation, called once per frame by ImFontAtlasUpdateNewFrame().
+// When enough space was left by discarded rectangles, move glyphs out of the least used shelf into that space, a few per frame.
+// Once emptied, the shelf can be reused for rectangles of any height. This is what allows the texture to rarely grow or be repacked.
+// Moving a glyph changes its UV. This runs before any text is submitted for the frame, only retained draw lists may refer to old UV (they hash ImFontBaked::GlyphsUvGeneration).
+void ImFontAtlasPackDefragStep(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImTextureData* tex = atlas->TexData;
+    if (builder->RectsDiscardedSurface < IM_FONTATLAS_DEFRAG_SURFACE_PER_FRAME / 4 || builder->RectsDiscardedSurface * 4 < builder->RectsPackedSurface)
+    {
+        builder->PackDefragShelfIdx = -1;
+        return;
+    }
+    if (builder->LockDisableResize || tex->Status == ImTextureStatus_WantDestroy || tex->Status == ImTextureStatus_Destroyed)
+        return;
+    if (builder->PackDefragShelfIdx == -1 && builder->PackDefragFailedSurface == builder->RectsDiscardedSurface)
+        return; // Nothing changed since last failure
+
+    // Select shelf: least used one among those containing only glyphs (custom rectangles, including AddCustomRectFontGlyph() ones, may have their UV stored by user code)
+    if (builder->PackDefragShelfIdx == -1)
+    {
+        ImVector<int> shelves_glyphs_surface;
+        shelves_glyphs_surface.resize(builder->PackShelves.Size, 0);
+        const int pack_padding = atlas->TexGlyphPadding;
+        for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
+            for (ImFontGlyph& glyph : builder->BakedPool[baked_n].Glyphs)
+                if (glyph.PackId != ImFontAtlasRectId_Invalid && !builder->RectsIndex[ImFontAtlasRectId_GetIndex(glyph.PackId)].IsCustom)
+                {
+                    ImTextureRect* r = ImFontAtlasPackGetRect(atlas, glyph.PackId);
+                    shelves_glyphs_surface[ImFontAtlasPackFindShelf(builder, r->y)] += (r->w + pack_padding) * (r->h + pack_padding);
+                }
+        float best_fill = 0.5f;
+        for (int shelf_n = 0; shelf_n < builder->PackShelves.Size; shelf_n++)
+        {
+            const ImFontAtlasPackShelf& shelf = builder->PackShelves[shelf_n];
+            if (shelf.UsedSurface == 0 || shelves_glyphs_surface[shelf_n] != shelf.UsedSurface)
+                continue;
+            const float fill = (float)shelf.UsedSurface / (float)(shelf.X * shelf.H);
+            if (fill < best_fill)
+                builder->PackDefragShelfIdx = shelf_n, best_fill = fill;
+        }
+        if (builder->PackDefragShelfIdx == -1)
+        {
+            builder->PackDefragFailedSurface = builder->RectsDiscardedSurface;
+            return;
+        }
+        IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: defragment shelf y=%d h=%d, %d%% used\n", tex->UniqueID, builder->PackShelves[builder->PackDefragShelfIdx].Y, builder->PackShelves[builder->PackDefragShelfIdx].H, (int)(best_fill * 100));
+    }
+
+    // Move glyphs to other shelves, within budget
+    const int pack_padding = atlas->TexGlyphPadding;
+    int moved_surface = 0;
+    for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
+        for (ImFontGlyph& glyph : builder->BakedPool[baked_n].Glyphs)
+        {
+            if (glyph.PackId == ImFontAtlasRectId_Invalid || builder->RectsIndex[ImFontAtlasRectId_GetIndex(glyph.PackId)].IsCustom)
+                continue;
+            const ImFontAtlasPackShelf& shelf = builder->PackShelves[builder->PackDefragShelfIdx];
+            ImTextureRect* r = ImFontAtlasPackGetRect(atlas, glyph.PackId);
+            if (r->y != shelf.Y)
+                continue;
+            int new_x, new_y;
+            if (!ImFontAtlasPackAllocSpace(atlas, r->w + pack_padding, r->h + pack_padding, builder->PackDefragShelfIdx, true, &new_x, &new_y))
+            {
+                builder->PackDefragShelfIdx = -1;
+                builder->PackDefragFailedSurface = builder->RectsDiscardedSurface;
+                return;
+            }
+            ImFontAtlasTextureBlockCopy(tex, r->x, r->y, tex, new_x, new_y, r->w, r->h);
+            ImFontAtlasTextureBlockQueueUpload(atlas, tex, new_x, new_y, r->w, r->h);
+            ImFontAtlasPackFreeSpace(builder, r->x, r->y, r->w + pack_padding, r->h + pack_padding);
+            r->x = (unsigned short)new_x;
+            r->y = (unsigned short)new_y;
+            glyph.U0 = (r->x) * atlas->TexUvScale.x;
+            glyph.V0 = (r->y) * atlas->TexUvScale.y;
+            glyph.U1 = (r->x + r->w) * atlas->TexUvScale.x;
+            glyph.V1 = (r->y + r->h) * atlas->TexUvScale.y;
+            builder->BakedPool[baked_n].GlyphsUvGeneration = ++builder->GlyphsUvGenerationNext;
+            builder->RectsMovedCount++;
+
+            // Stop when shelf is empty (it was merged or removed) or out of budget
+            moved_surface += (r->w + pack_padding) * (r->h + pack_padding);
+            if (builder->PackDefragShelfIdx == -1 || builder->PackShelves[builder->PackDefragShelfIdx].UsedSurface == 0)
+            {
+                builder->PackDefragShelfIdx = -1;
+                return;
+            }
+            if (moved_surface >= IM_FONTATLAS_DEFRAG_SURFACE_PER_FRAME)
+                return;
+        }
+
+    // All glyphs moved but shelf is not empty: a custom rectangle was added in the meanwhile
+    builder->PackDefragShelfIdx = -1;
 }
 
 // Generally for non-user facing functions: assert on invalid ID.
@@ -4392,6 +6675,313 @@ ImTextureRect* ImFontAtlasPackGetRectSafe(ImFontAtlas* atlas, ImFontAtlasRectId
     return &builder->Rects[index_entry->TargetIndex];
 }
 
+// Persistent glyph cache (see io.FontCacheFilename)
+// We store the output of font loaders rather than texture pages: the dynamic atlas packs glyphs on demand,
+// so a glyph loaded from the cache is packed again, but rasterization and post-processing are skipped.
+struct ImFontAtlasGlyphCacheFileHeader
+{
+    char    Magic[4];       // "IMGC"
+    int     Version;        // IMGUI_VERSION_NUM
+    int     EntrySize;      // sizeof(ImFontAtlasGlyphCacheEntry)
+    int     EntriesCount;
+    int     PixelsSize;
+    ImGuiID DataHash;       // Hash of entries and pixels
+};
+
+// Hash everything which may affect the loader output for a given source. Return 0 when the source can't be cached.
+static ImGuiID ImFontAtlasGlyphCacheGetSrcKey(ImFontAtlas* atlas, ImFont* font, ImFontConfig* src)
+{
+    const ImFontLoader* loader = src->FontLoader ? src->FontLoader : atlas->FontLoader;
+    if (src->FontData == NULL || src->FontDataSize <= 0 || loader == NULL || loader->Name == NULL)
+        return 0;
+    if (src->FontDataHash == 0)
+        src->FontDataHash = ImHashData(src->FontData, (size_t)src->FontDataSize);
+
+    struct
+    {
+        ImGuiID         FontDataHash;
+        int             FontDataSize;
+        ImU32           FontNo;
+        ImGuiID         LoaderNameHash;
+        unsigned int    LoaderFlags[2];
+        int             Oversample[2];
+        int             PixelSnap[2];
+        float           GlyphOffset[2];
+        float           RasterizerMultiply;
+        float           RasterizerDensity;
+        float           SizePixels;
+        float           RefSizePixels;
+        int             AtlasFlags;
+    } key;
+    memset(&key, 0, sizeof(key)); // Hashed as a block: don't leave uninitialized padding
+    key.FontDataHash = src->FontDataHash;
+    key.FontDataSize = src->FontDataSize;
+    key.FontNo = src->FontNo;
+    key.LoaderNameHash = ImHashStr(loader->Name);
+    key.LoaderFlags[0] = src->FontLoaderFlags;
+    key.LoaderFlags[1] = atlas->FontLoaderFlags;
+    key.Oversample[0] = src->OversampleH;
+    key.Oversample[1] = src->OversampleV;
+    key.PixelSnap[0] = src->PixelSnapH;
+    key.PixelSnap[1] = src->PixelSnapV;
+    key.GlyphOffset[0] = src->GlyphOffset.x;
+    key.GlyphOffset[1] = src->GlyphOffset.y;
+    key.RasterizerMultiply = src->RasterizerMultiply;
+    key.RasterizerDensity = src->RasterizerDensity;
+    key.SizePixels = src->SizePixels;
+    key.RefSizePixels = font->Sources[0]->SizePixels; // Scales GlyphOffset
+    key.AtlasFlags = atlas->Flags & ImFontAtlasFlags_DistanceField;
+    ImGuiID hash = ImHashData(&key, sizeof(key));
+    return hash ? hash : 1;
+}
+
+static ImGuiID ImFontAtlasGlyphCacheGetEntryKey(ImGuiID src_key, float size, float rasterizer_density, ImU32 codepoint)
+{
+    struct { float Size; float RasterizerDensity; ImU32 Codepoint; } key = { size, rasterizer_density, codepoint };
+    return ImHashData(&key, sizeof(key), src_key);
+}
+
+static void ImFontAtlasGlyphCacheBuildMap(ImFontAtlasGlyphCache* cache)
+{
+    cache->Map.Clear();
+    cache->Map.Data.reserve(cache->Entries.Size);
+    for (int entry_n = 0; entry_n < cache->Entries.Size; entry_n++)
+    {
+        const ImFontAtlasGlyphCacheEntry* entry = &cache->Entries[entry_n];
+        cache->Map.Data.push_back(ImGuiStoragePair(ImFontAtlasGlyphCacheGetEntryKey(entry->SrcKey, entry->Size, entry->RasterizerDensity, entry->Codepoint), entry_n + 1));
+    }
+    cache->Map.BuildSortByKey();
+}
+
+bool ImFontAtlasGlyphCacheLoadFromDisk(ImFontAtlas* atlas, const char* filename)
+{
+    if (atlas->GlyphCache == NULL)
+        atlas->GlyphCache = IM_NEW(ImFontAtlasGlyphCache)();
+    ImFontAtlasGlyphCache* cache = atlas->GlyphCache;
+    cache->Entries.clear();
+    cache->Pixels.clear();
+    cache->Map.Clear();
+
+    size_t file_size = 0;
+    char* file_data = (char*)ImFileLoadToMemory(filename, "rb", &file_size);
+    if (file_data == NULL)
+        return false;
+
+    // Validate everything: a mismatching or corrupted file is discarded and glyphs will be rasterized again
+    ImFontAtlasGlyphCacheFileHeader header;
+    bool ret = file_size >= sizeof(header);
+    if (ret)
+    {
+        memcpy(&header, file_data, sizeof(header));
+        ret = memcmp(header.Magic, "IMGC", 4) == 0 && header.Version == IMGUI_VERSION_NUM && header.EntrySize == (int)sizeof(ImFontAtlasGlyphCacheEntry)
+            && header.EntriesCount >= 0 && header.PixelsSize >= 0
+            && (ImU64)file_size == sizeof(header) + (ImU64)header.EntriesCount * sizeof(ImFontAtlasGlyphCacheEntry) + (ImU64)header.PixelsSize;
+    }
+    if (ret)
+        ret = ImHashData(file_data + sizeof(header), file_size - sizeof(header)) == header.DataHash;
+    if (ret)
+    {
+        cache->Entries.resize(header.EntriesCount);
+        cache->Pixels.resize(header.PixelsSize);
+        if (header.EntriesCount > 0)
+            memcpy(cache->Entries.Data, file_data + sizeof(header), header.EntriesCount * sizeof(ImFontAtlasGlyphCacheEntry));
+        if (header.PixelsSize > 0)
+            memcpy(cache->Pixels.Data, file_data + sizeof(header) + header.EntriesCount * sizeof(ImFontAtlasGlyphCacheEntry), (size_t)header.PixelsSize);
+        for (ImFontAtlasGlyphCacheEntry& entry : cache->Entries)
+        {
+            if (entry.Format != ImTextureFormat_Alpha8 && entry.Format != ImTextureFormat_RGBA32)
+                ret = false;
+            else if ((entry.PixelsOffset & 3) != 0 || (ImU64)entry.PixelsOffset + (ImU64)entry.Width * entry.Height * ImTextureDataGetFormatBytesPerPixel((ImTextureFormat)entry.Format) > (ImU64)header.PixelsSize)
+                ret = false;
+            if (entry.UnusedSessions < 255)
+                entry.UnusedSessions++;
+        }
+    }
+    IM_FREE(file_data);
+    if (!ret)
+    {
+        cache->Entries.clear();
+        cache->Pixels.clear();
+        return false;
+    }
+    ImFontAtlasGlyphCacheBuildMap(cache);
+    cache->Dirty = false;
+    return true;
+}
+
+bool ImFontAtlasGlyphCacheSaveToDisk(ImFontAtlas* atlas, const char* filename)
+{
+    ImFontAtlasGlyphCache* cache = atlas->GlyphCache;
+    if (cache == NULL)
+        return false;
+
+    // Drop entries which haven't been used for a while, and compact pixels accordingly
+    ImVector<ImFontAtlasGlyphCacheEntry> new_entries;
+    ImVector<unsigned char> new_pixels;
+    new_entries.reserve(cache->Entries.Size);
+    new_pixels.reserve(cache->Pixels.Size);
+    for (const ImFontAtlasGlyphCacheEntry& entry : cache->Entries)
+    {
+        if (entry.UnusedSessions >= IM_FONTATLAS_GLYPH_CACHE_MAX_UNUSED_SESSIONS)
+            continue;
+        const int pixels_size = entry.Width * entry.Height * ImTextureDataGetFormatBytesPerPixel((ImTextureFormat)entry.Format);
+        new_entries.push_back(entry);
+        new_entries.back().PixelsOffset = (ImU32)new_pixels.Size;
+        new_pixels.resize(IM_MEMALIGN(new_pixels.Size + pixels_size, 4));
+        memcpy(new_pixels.Data + new_entries.back().PixelsOffset, cache->Pixels.Data + entry.PixelsOffset, (size_t)pixels_size);
+    }
+    if (new_entries.Size != cache->Entries.Size)
+    {
+        cache->Entries.swap(new_entries);
+        cache->Pixels.swap(new_pixels);
+        ImFontAtlasGlyphCacheBuildMap(cache);
+    }
+
+    // Write to a temporary file then replace the previous one, so an interrupted save doesn't leave a truncated cache behind.
+    // (with custom file functions we have no way to rename, so we write directly)
+#ifndef IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS
+    ImGuiTextBuffer temp_filename;
+    temp_filename.appendf("%s.tmp", filename);
+    ImFileHandle f = ImFileOpen(temp_filename.c_str(), "wb");
+#else
+    ImFileHandle f = ImFileOpen(filename, "wb");
+#endif
+    if (!f)
+        return false;
+    ImFontAtlasGlyphCacheFileHeader header;
+    memcpy(header.Magic, "IMGC", 4);
+    header.Version = IMGUI_VERSION_NUM;
+    header.EntrySize = (int)sizeof(ImFontAtlasGlyphCacheEntry);
+    header.EntriesCount = cache->Entries.Size;
+    header.PixelsSize = cache->Pixels.Size;
+    header.DataHash = ImHashData(cache->Entries.Data, cache->Entries.size_in_bytes());
+    header.DataHash = ImHashData(cache->Pixels.Data, cache->Pixels.size_in_bytes(), header.DataHash); // == hash of the file data following the header
+    bool ret = ImFileWrite(&header, sizeof(header), 1, f) == 1;
+    if (ret && cache->Entries.Size > 0)
+        ret = ImFileWrite(cache->Entries.Data, sizeof(ImFontAtlasGlyphCacheEntry), (ImU64)cache->Entries.Size, f) == (ImU64)cache->Entries.Size;
+    if (ret && cache->Pixels.Size > 0)
+        ret = ImFileWrite(cache->Pixels.Data, 1, (ImU64)cache->Pixels.Size, f) == (ImU64)cache->Pixels.Size;
+    ret = ImFileClose(f) && ret; // Buffered data may fail to be written when closing (e.g. disk full)
+#ifndef IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS
+    ret = ret && ImFileRename(temp_filename.c_str(), filename); // On failure, previous file is left untouched
+    if (!ret)
+        ImFileRemove(temp_filename.c_str());
+#endif
+    if (ret)
+        cache->Dirty = false; // Otherwise keep it dirty so next save tries again
+    return ret;
+}
+
+void ImFontAtlasGlyphCacheDestroy(ImFontAtlas* atlas)
+{
+    IM_DELETE(atlas->GlyphCache);
+    atlas->GlyphCache = NULL;
+}
+
+static ImFontAtlasGlyphCacheEntry* ImFontAtlasGlyphCacheFindEntry(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, ImWchar codepoint)
+{
+    ImFontAtlasGlyphCache* cache = atlas->GlyphCache;
+    const ImGuiID src_key = ImFontAtlasGlyphCacheGetSrcKey(atlas, baked->ContainerFont, src);
+    if (src_key == 0)
+        return NULL;
+    const int entry_idx = cache->Map.GetInt(ImFontAtlasGlyphCacheGetEntryKey(src_key, baked->Size, baked->RasterizerDensity, codepoint), 0) - 1;
+    if (entry_idx < 0)
+        return NULL;
+    ImFontAtlasGlyphCacheEntry* entry = &cache->Entries[entry_idx];
+    if (entry->SrcKey != src_key || entry->Size != baked->Size || entry->RasterizerDensity != baked->RasterizerDensity || entry->Codepoint != codepoint)
+        return NULL; // Hash collision
+    return entry;
+}
+
+// Pack and copy glyph from cache, without calling the font loader.
+bool ImFontAtlasGlyphCacheLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, ImWchar codepoint, ImFontGlyph* out_glyph, float* out_advance_x)
+{
+    ImFontAtlasGlyphCache* cache = atlas->GlyphCache;
+    ImFontAtlasGlyphCacheEntry* entry = ImFontAtlasGlyphCacheFindEntry(atlas, src, baked, codepoint);
+    if (entry == NULL)
+        return false;
+
+    // Load metrics only mode
+    if (out_advance_x != NULL)
+    {
+        IM_ASSERT(out_glyph == NULL);
+        *out_advance_x = entry->AdvanceX;
+        return true;
+    }
+
+    out_glyph->Codepoint = codepoint;
+    out_glyph->AdvanceX = entry->AdvanceX;
+    out_glyph->X0 = entry->X0;
+    out_glyph->Y0 = entry->Y0;
+    out_glyph->X1 = entry->X1;
+    out_glyph->Y1 = entry->Y1;
+    out_glyph->Colored = entry->Colored;
+    if (entry->Width > 0 && entry->Height > 0)
+    {
+        ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, entry->Width, entry->Height);
+        if (pack_id == ImFontAtlasRectId_Invalid)
+            return false;
+        ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
+        ImTextureData* tex = atlas->TexData;
+        const ImTextureFormat src_fmt = (ImTextureFormat)entry->Format;
+        ImFontAtlasTextureBlockConvert(cache->Pixels.Data + entry->PixelsOffset, src_fmt, entry->Width * ImTextureDataGetFormatBytesPerPixel(src_fmt), (unsigned char*)tex->GetPixelsAt(r->x, r->y), tex->Format, tex->GetPitch(), r->w, r->h);
+        ImFontAtlasTextureBlockQueueUpload(atlas, tex, r->x, r->y, r->w, r->h);
+        out_glyph->Visible = true;
+        out_glyph->PackId = pack_id;
+    }
+    if (entry->UnusedSessions != 0)
+    {
+        entry->UnusedSessions = 0;
+        cache->Dirty = true;
+    }
+    cache->HitsCount++;
+    return true;
+}
+
+// Store a glyph output by a font loader, reading its pixels back from the texture.
+void ImFontAtlasGlyphCacheAddGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, ImWchar codepoint, const ImFontGlyph* glyph)
+{
+    ImFontAtlasGlyphCache* cache = atlas->GlyphCache;
+    const ImGuiID src_key = ImFontAtlasGlyphCacheGetSrcKey(atlas, baked->ContainerFont, src);
+    if (src_key == 0)
+        return;
+    const ImGuiID entry_key = ImFontAtlasGlyphCacheGetEntryKey(src_key, baked->Size, baked->RasterizerDensity, codepoint);
+    if (cache->Map.GetInt(entry_key, 0) != 0)
+        return;
+    ImTextureRect* r = (glyph->PackId != ImFontAtlasRectId_Invalid) ? ImFontAtlasPackGetRect(atlas, glyph->PackId) : NULL;
+
+    ImFontAtlasGlyphCacheEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.SrcKey = src_key;
+    entry.Size = baked->Size;
+    entry.RasterizerDensity = baked->RasterizerDensity;
+    entry.Codepoint = codepoint;
+    entry.AdvanceX = glyph->AdvanceX;
+    entry.X0 = glyph->X0;
+    entry.Y0 = glyph->Y0;
+    entry.X1 = glyph->X1;
+    entry.Y1 = glyph->Y1;
+    entry.Colored = (ImU8)glyph->Colored;
+    entry.Format = ImTextureFormat_Alpha8;
+    if (r != NULL)
+    {
+        // Keep colors only when they are in the texture
+        ImTextureData* tex = atlas->TexData;
+        const ImTextureFormat dst_fmt = (glyph->Colored && tex->Format == ImTextureFormat_RGBA32) ? ImTextureFormat_RGBA32 : ImTextureFormat_Alpha8;
+        const int dst_pitch = r->w * ImTextureDataGetFormatBytesPerPixel(dst_fmt);
+        entry.Width = r->w;
+        entry.Height = r->h;
+        entry.Format = (ImU8)dst_fmt;
+        entry.PixelsOffset = (ImU32)cache->Pixels.Size;
+        cache->Pixels.resize(IM_MEMALIGN(cache->Pixels.Size + dst_pitch * r->h, 4));
+        ImFontAtlasTextureBlockConvert((const unsigned char*)tex->GetPixelsAt(r->x, r->y), tex->Format, tex->GetPitch(), cache->Pixels.Data + entry.PixelsOffset, dst_fmt, dst_pitch, r->w, r->h);
+    }
+    cache->Map.SetInt(entry_key, cache->Entries.Size + 1);
+    cache->Entries.push_back(entry);
+    cache->MissesCount++;
+    cache->Dirty = true;
+}
+
 // Important! This assume by ImFontConfig::GlyphExcludeRanges[] is a SMALL ARRAY (e.g. <10 entries)
 // Use "Input Glyphs Overlap Detection Tool" to display a list of glyphs provided by multiple sources in order to set this array up.
 static bool ImFontAtlasBuildAcceptCodepointForSource(ImFontConfig* src, ImWchar codepoint)
@@ -4455,8 +7045,12 @@ static ImFontGlyph* ImFontBaked_BuildLoadGlyph(ImFontBaked* baked, ImWchar codep
             if (only_load_advance_x == NULL)
             {
                 ImFontGlyph glyph_buf;
-                if (loader->FontBakedLoadGlyph(atlas, src, baked, loader_user_data_p, codepoint, &glyph_buf, NULL))
+                const bool from_cache = atlas->GlyphCache != NULL && ImFontAtlasGlyphCacheLoadGlyph(atlas, src, baked, codepoint, &glyph_buf, NULL);
+                if (from_cache || loader->FontBakedLoadGlyph(atlas, src, baked, loader_user_data_p, codepoint, &glyph_buf, NULL))
                 {
+                    if (!from_cache && atlas->GlyphCache != NULL)
+                        ImFontAtlasGlyphCacheAddGlyph(atlas, src, baked, codepoint, &glyph_buf);
+
                     // FIXME: Add hooks for e.g. #7962
                     glyph_buf.Codepoint = src_codepoint;
                     glyph_buf.SourceIdx = src_n;
@@ -4466,7 +7060,8 @@ static ImFontGlyph* ImFontBaked_BuildLoadGlyph(ImFontBaked* baked, ImWchar codep
             else
             {
                 // Special mode but only loading glyphs metrics. Will rasterize and pack later.
-                if (loader->FontBakedLoadGlyph(atlas, src, baked, loader_user_data_p, codepoint, NULL, only_load_advance_x))
+                if ((atlas->GlyphCache != NULL && ImFontAtlasGlyphCacheLoadGlyph(atlas, src, baked, codepoint, NULL, only_load_advance_x))
+                    || loader->FontBakedLoadGlyph(atlas, src, baked, loader_user_data_p, codepoint, NULL, only_load_advance_x))
                 {
                     ImFontAtlasBakedAddFontGlyphAdvancedX(atlas, baked, src, codepoint, *only_load_advance_x);
                     return NULL;
@@ -4490,6 +7085,193 @@ static ImFontGlyph* ImFontBaked_BuildLoadGlyph(ImFontBaked* baked, ImWchar codep
     return NULL;
 }
 
+ImFontGlyphBitmap::ImFontGlyphBitmap()
+{
+    memset(this, 0, sizeof(*this));
+    ImGui::GetAllocatorFunctions(&AllocFunc, &FreeFunc, &AllocUserData);
+    Format = ImTextureFormat_Alpha8;
+}
+
+// Rasterize one glyph of ImFontAtlasBuilder::GlyphJobs[]. May run on any thread: only reads from atlas/font/baked.
+static void ImFontAtlasBakedLoadGlyphsJob(void* job_data, int job_n)
+{
+    ImFontBaked* baked = (ImFontBaked*)job_data;
+    ImFont* font = baked->ContainerFont;
+    ImFontAtlas* atlas = font->ContainerAtlas;
+    ImFontAtlasGlyphJob* job = &atlas->Builder->GlyphJobs.Data[job_n];
+    IM_ASSERT(job->WantRasterize && job->SourceIdx == -1);
+
+    char* loader_user_data_p = (char*)baked->FontLoaderDatas;
+    for (int src_n = 0; src_n < font->Sources.Size; src_n++)
+    {
+        ImFontConfig* src = font->Sources[src_n];
+        const ImFontLoader* loader = src->FontLoader ? src->FontLoader : atlas->FontLoader;
+        if (!src->GlyphExcludeRanges || ImFontAtlasBuildAcceptCodepointForSource(src, job->Codepoint))
+        {
+            if (loader->FontBakedRasterizeGlyph == NULL)
+                return; // Will be loaded by ImFontBaked_BuildLoadGlyph()
+            if (loader->FontBakedRasterizeGlyph(atlas, src, baked, loader_user_data_p, job->Codepoint, &job->Glyph, &job->Bitmap))
+            {
+                job->SourceIdx = src_n;
+                return;
+            }
+        }
+        loader_user_data_p += loader->FontBakedSrcLoaderDataSize;
+    }
+}
+
+// Load a batch of glyphs:
+// - Rasterize them, in parallel if platform_io.Platform_ParallelForFn is set.
+// - Pack them and copy their pixels, then queue a single texture update.
+// - Glyphs which can't be rasterized this way (loader without FontBakedRasterizeGlyph, glyph cache, special glyphs, not found) go through ImFontBaked_BuildLoadGlyph().
+void ImFontAtlasBakedLoadGlyphs(ImFontAtlas* atlas, ImFontBaked* baked, const ImWchar* codepoints, int codepoints_count)
+{
+    ImFont* font = baked->ContainerFont;
+    if (atlas->Locked || (font->Flags & ImFontFlags_NoLoadGlyphs))
+        return;
+
+    // Gather missing glyphs, skipping duplicates
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImVector<ImFontAtlasGlyphJob>& jobs = builder->GlyphJobs;
+    if (builder->GlyphJobsCodepointsMask.Storage.Size == 0)
+        builder->GlyphJobsCodepointsMask.Create(IM_UNICODE_CODEPOINT_MAX + 1);
+    jobs.resize(0);
+    int rasterize_count = 0;
+    for (int n = 0; n < codepoints_count; n++)
+    {
+        const ImWchar src_codepoint = codepoints[n];
+        if ((int)src_codepoint < baked->IndexLookup.Size && baked->IndexLookup.Data[src_codepoint] != IM_FONTGLYPH_INDEX_UNUSED)
+            continue;
+        if (builder->GlyphJobsCodepointsMask.TestBit(src_codepoint))
+            continue;
+        builder->GlyphJobsCodepointsMask.SetBit(src_codepoint);
+
+        ImFontAtlasGlyphJob job;
+        job.SrcCodepoint = job.Codepoint = src_codepoint;
+        ImFontAtlas_FontHookRemapCodepoint(atlas, font, &job.Codepoint);
+        job.SourceIdx = -1;
+        job.WantRasterize = !(job.Codepoint == font->EllipsisChar && font->EllipsisAutoBake);
+        if (job.WantRasterize && atlas->GlyphCache != NULL)
+            for (ImFontConfig* src : font->Sources)
+                if (ImFontAtlasGlyphCacheFindEntry(atlas, src, baked, job.Codepoint) != NULL)
+                    job.WantRasterize = false;
+        jobs.push_back(job);
+        rasterize_count += job.WantRasterize ? 1 : 0;
+    }
+    for (ImFontAtlasGlyphJob& job : jobs)
+        builder->GlyphJobsCodepointsMask.ClearBit(job.SrcCodepoint);
+
+    // Rasterize
+    if (rasterize_count > 0)
+    {
+        // Move glyphs to rasterize first
+        if (rasterize_count < jobs.Size)
+            for (int n = 0, dst_n = 0; n < jobs.Size; n++)
+                if (jobs[n].WantRasterize)
+                    ImSwap(jobs[n], jobs[dst_n++]);
+
+        ImGuiContext* ctx = atlas->OwnerContext;
+        if (ctx != NULL && ctx->PlatformIO.Platform_ParallelForFn != NULL && rasterize_count > 1)
+            ctx->PlatformIO.Platform_ParallelForFn(ctx, ImFontAtlasBakedLoadGlyphsJob, baked, rasterize_count);
+        else
+            for (int n = 0; n < rasterize_count; n++)
+                ImFontAtlasBakedLoadGlyphsJob(baked, n);
+
+        // Pack all glyphs first, as packing may grow/repack the texture
+        for (int n = 0; n < rasterize_count; n++)
+        {
+            ImFontAtlasGlyphJob& job = jobs[n];
+            if (job.SourceIdx == -1 || job.Bitmap.Pixels == NULL)
+                continue;
+            job.Glyph.PackId = ImFontAtlasPackAddRect(atlas, job.Bitmap.Width, job.Bitmap.Height);
+            if (job.Glyph.PackId == ImFontAtlasRectId_Invalid)
+            {
+                // Out of texture memory: leave it to ImFontBaked_BuildLoadGlyph() which will report it
+                job.Bitmap.FreeFunc(job.Bitmap.Pixels, job.Bitmap.AllocUserData);
+                job.Bitmap.Pixels = NULL;
+                job.SourceIdx = -1;
+            }
+        }
+
+        // Copy pixels and register glyphs
+        ImTextureData* tex = atlas->TexData;
+        int upload_x0 = INT_MAX, upload_y0 = INT_MAX, upload_x1 = 0, upload_y1 = 0;
+        for (int n = 0; n < rasterize_count; n++)
+        {
+            ImFontAtlasGlyphJob& job = jobs[n];
+            if (job.SourceIdx == -1)
+                continue;
+            ImFontConfig* src = font->Sources[job.SourceIdx];
+            if (job.Bitmap.Pixels != NULL)
+            {
+                ImTextureRect* r = ImFontAtlasPackGetRect(atlas, job.Glyph.PackId);
+                IM_ASSERT(r->x + r->w <= tex->Width && r->y + r->h <= tex->Height);
+                ImFontAtlasTextureBlockConvert(job.Bitmap.Pixels, job.Bitmap.Format, job.Bitmap.Width * ImTextureDataGetFormatBytesPerPixel(job.Bitmap.Format), (unsigned char*)tex->GetPixelsAt(r->x, r->y), tex->Format, tex->GetPitch(), r->w, r->h);
+                ImFontAtlasPostProcessData pp_data = { atlas, font, src, baked, &job.Glyph, tex->GetPixelsAt(r->x, r->y), tex->Format, tex->GetPitch(), r->w, r->h };
+                ImFontAtlasTextureBlockPostProcess(&pp_data);
+                upload_x0 = ImMin(upload_x0, (int)r->x);
+                upload_y0 = ImMin(upload_y0, (int)r->y);
+                upload_x1 = ImMax(upload_x1, (int)(r->x + r->w));
+                upload_y1 = ImMax(upload_y1, (int)(r->y + r->h));
+                job.Bitmap.FreeFunc(job.Bitmap.Pixels, job.Bitmap.AllocUserData);
+                job.Bitmap.Pixels = NULL;
+            }
+            if (atlas->GlyphCache != NULL)
+                ImFontAtlasGlyphCacheAddGlyph(atlas, src, baked, job.Codepoint, &job.Glyph);
+            job.Glyph.Codepoint = job.SrcCodepoint;
+            job.Glyph.SourceIdx = job.SourceIdx;
+            ImFontAtlasBakedAddFontGlyph(atlas, baked, src, &job.Glyph);
+        }
+        if (upload_x1 > upload_x0)
+            ImFontAtlasTextureBlockQueueUpload(atlas, tex, upload_x0, upload_y0, upload_x1 - upload_x0, upload_y1 - upload_y0);
+    }
+
+    // Load remaining glyphs one by one
+    for (int n = 0; n < jobs.Size; n++)
+        if (jobs[n].SourceIdx == -1)
+            ImFontBaked_BuildLoadGlyph(baked, jobs[n].SrcCodepoint, NULL);
+}
+
+// Load codepoint 'c' along with other missing glyphs of the text following it, so text functions load a new paragraph in one batch.
+static void ImFontBaked_BuildLoadGlyphsForText(ImFontBaked* baked, unsigned int c, const char* text, const char* text_end)
+{
+    ImFont* font = baked->ContainerFont;
+    ImFontAtlas* atlas = font->ContainerAtlas;
+    if (atlas->Locked || (font->Flags & ImFontFlags_NoLoadGlyphs))
+        return;
+    if (c < (unsigned int)baked->IndexLookup.Size && baked->IndexLookup.Data[c] != IM_FONTGLYPH_INDEX_UNUSED)
+        return;
+
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImVector<ImWchar>& codepoints = builder->GlyphJobsCodepoints;
+    ImBitVector& mask = builder->GlyphJobsCodepointsMask;
+    if (mask.Storage.Size == 0)
+        mask.Create(IM_UNICODE_CODEPOINT_MAX + 1);
+    codepoints.resize(0);
+    codepoints.push_back((ImWchar)c);
+    mask.SetBit(c);
+    if (text_end - text > IM_FONTBAKED_LOAD_GLYPHS_FROM_TEXT_MAX * 16) // Don't scan megabytes of text for a missing glyph
+        text_end = text + IM_FONTBAKED_LOAD_GLYPHS_FROM_TEXT_MAX * 16;
+    for (const char* s = text; s < text_end && codepoints.Size < IM_FONTBAKED_LOAD_GLYPHS_FROM_TEXT_MAX; )
+    {
+        unsigned int text_c = (unsigned int)*s;
+        if (text_c < 0x80)
+            s += 1;
+        else
+            s += ImTextCharFromUtf8(&text_c, s, text_end);
+        if (text_c < 32 || (text_c < (unsigned int)baked->IndexLookup.Size && baked->IndexLookup.Data[text_c] != IM_FONTGLYPH_INDEX_UNUSED) || mask.TestBit(text_c))
+            continue;
+        codepoints.push_back((ImWchar)text_c);
+        mask.SetBit(text_c);
+    }
+    for (ImWchar codepoint : codepoints)
+        mask.ClearBit(codepoint);
+
+    // Nothing to batch: let caller load glyph the usual way
+    if (codepoints.Size > 1)
+        ImFontAtlasBakedLoadGlyphs(atlas, baked, codepoints.Data, codepoints.Size);
+}
+
 static float ImFontBaked_BuildLoadGlyphAdvanceX(ImFontBaked* baked, ImWchar codepoint)
 {
     if (baked->Size >= IMGUI_FONT_SIZE_THRESHOLD_FOR_LOADADVANCEXONLYMODE || baked->LoadNoRenderOnLayout)
@@ -4508,10 +7290,22 @@ static float ImFontBaked_BuildLoadGlyphAdvanceX(ImFontBaked* baked, ImWchar code
 
 // The point of this indirection is to not be inlined in debug mode in order to not bloat inner loop.b
 IM_MSVC_RUNTIME_CHECKS_OFF
-static float BuildLoadGlyphGetAdvanceOrFallback(ImFontBaked* baked, unsigned int codepoint)
+static float BuildLoadGlyphGetAdvanceOrFallback(ImFontBaked* baked, unsigned int codepoint, const char* text, const char* text_end)
 {
+    if (baked->Size < IMGUI_FONT_SIZE_THRESHOLD_FOR_LOADADVANCEXONLYMODE && !baked->LoadNoRenderOnLayout)
+    {
+        ImFontBaked_BuildLoadGlyphsForText(baked, codepoint, text, text_end);
+        if (codepoint < (unsigned int)baked->IndexAdvanceX.Size && baked->IndexAdvanceX.Data[codepoint] >= 0.0f)
+            return baked->IndexAdvanceX.Data[codepoint];
+    }
     return ImFontBaked_BuildLoadGlyphAdvanceX(baked, (ImWchar)codepoint);
 }
+
+static ImFontGlyph* BuildLoadGlyphFindOrFallback(ImFontBaked* baked, unsigned int codepoint, const char* text, const char* text_end)
+{
+    ImFontBaked_BuildLoadGlyphsForText(baked, codepoint, text, text_end);
+    return baked->FindGlyph((ImWchar)codepoint);
+}
 IM_MSVC_RUNTIME_CHECKS_RESTORE
 
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
@@ -4579,6 +7373,7 @@ static bool ImGui_ImplStbTrueType_FontSrcInit(ImFontAtlas* atlas, ImFontConfig*
         IM_ASSERT_USER_ERROR(0, "stbtt_InitFont(): failed to parse FontData. It is correct and complete? Check FontDataSize.");
         return false;
     }
+    bd_font_data->FontInfo.userdata = NULL; // Our STBTT_malloc() uses this
     src->FontLoaderData = bd_font_data;
 
     const float ref_size = src->DstFont->Sources[0]->SizePixels;
@@ -4632,7 +7427,8 @@ static bool ImGui_ImplStbTrueType_FontBakedInit(ImFontAtlas* atlas, ImFontConfig
     return true;
 }
 
-static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void*, ImWchar codepoint, ImFontGlyph* out_glyph, float* out_advance_x)
+// Rasterize without touching the atlas: this may run on worker threads (see ImFontAtlasBakedLoadGlyphs()).
+static bool ImGui_ImplStbTrueType_FontBakedRasterizeGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void*, ImWchar codepoint, ImFontGlyph* out_glyph, ImFontGlyphBitmap* out_bitmap)
 {
     // Search for first font which has the glyph
     ImGui_ImplStbTrueType_FontSrcData* bd_font_data = (ImGui_ImplStbTrueType_FontSrcData*)src->FontLoaderData;
@@ -4641,9 +7437,17 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
     if (glyph_index == 0)
         return false;
 
+    // Our own copy of font info, so temporary allocations made by stb_truetype go through 'out_bitmap' allocators (see STBTT_malloc)
+    stbtt_fontinfo font_info = bd_font_data->FontInfo;
+    font_info.userdata = out_bitmap;
+
     // Fonts unit to pixels
+    // (distance fields are scaled at render time, oversampling them wouldn't help)
+    const bool is_distance_field = (atlas->Flags & ImFontAtlasFlags_DistanceField) != 0;
     int oversample_h, oversample_v;
     ImFontAtlasBuildGetOversampleFactors(src, baked, &oversample_h, &oversample_v);
+    if (is_distance_field)
+        oversample_h = oversample_v = 1;
     const float scale_for_layout = bd_font_data->ScaleFactor * baked->Size;
     const float rasterizer_density = src->RasterizerDensity * baked->RasterizerDensity;
     const float scale_for_raster_x = bd_font_data->ScaleFactor * baked->Size * rasterizer_density * oversample_h;
@@ -4652,75 +7456,111 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
     // Obtain size and advance
     int x0, y0, x1, y1;
     int advance, lsb;
-    stbtt_GetGlyphBitmapBoxSubpixel(&bd_font_data->FontInfo, glyph_index, scale_for_raster_x, scale_for_raster_y, 0, 0, &x0, &y0, &x1, &y1);
-    stbtt_GetGlyphHMetrics(&bd_font_data->FontInfo, glyph_index, &advance, &lsb);
-
-    // Load metrics only mode
-    if (out_advance_x != NULL)
-    {
-        IM_ASSERT(out_glyph == NULL);
-        *out_advance_x = advance * scale_for_layout;
-        return true;
-    }
+    stbtt_GetGlyphBitmapBoxSubpixel(&font_info, glyph_index, scale_for_raster_x, scale_for_raster_y, 0, 0, &x0, &y0, &x1, &y1);
+    stbtt_GetGlyphHMetrics(&font_info, glyph_index, &advance, &lsb);
 
     // Prepare glyph
     out_glyph->Codepoint = codepoint;
     out_glyph->AdvanceX = advance * scale_for_layout;
+    out_bitmap->Pixels = NULL;
+    out_bitmap->Width = out_bitmap->Height = 0;
+    out_bitmap->Format = ImTextureFormat_Alpha8;
 
-    // Pack and retrieve position inside texture atlas
+    // Render
     // (generally based on stbtt_PackFontRangesRenderIntoRects)
     const bool is_visible = (x0 != x1 && y0 != y1);
-    if (is_visible)
-    {
-        const int w = (x1 - x0 + oversample_h - 1);
-        const int h = (y1 - y0 + oversample_v - 1);
-        ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, w, h);
-        if (pack_id == ImFontAtlasRectId_Invalid)
-        {
-            // Pathological out of memory case (TexMaxWidth/TexMaxHeight set too small?)
-            IM_ASSERT(pack_id != ImFontAtlasRectId_Invalid && "Out of texture memory.");
+    if (!is_visible)
+        return true;
+    int w, h;
+    unsigned char* bitmap_pixels;
+    float sub_x = 0.0f, sub_y = 0.0f;
+    if (is_distance_field)
+    {
+        // Distance field: stb_truetype allocates the bitmap, padded by the field spread. 128 is on the edge, 0 and 255 are 'spread' pixels away.
+        const int spread = IM_FONTATLAS_DISTANCE_FIELD_SPREAD;
+        unsigned char* sdf_pixels = stbtt_GetGlyphSDF(&font_info, scale_for_raster_x, glyph_index, spread, 128, 128.0f / spread, &w, &h, &x0, &y0);
+        if (sdf_pixels == NULL)
             return false;
-        }
-        ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
+        bitmap_pixels = (unsigned char*)out_bitmap->AllocFunc((size_t)(w * h), out_bitmap->AllocUserData);
+        memcpy(bitmap_pixels, sdf_pixels, (size_t)(w * h));
+        stbtt_FreeSDF(sdf_pixels, font_info.userdata);
+    }
+    else
+    {
+        w = (x1 - x0 + oversample_h - 1);
+        h = (y1 - y0 + oversample_v - 1);
+        stbtt_GetGlyphBitmapBox(&font_info, glyph_index, scale_for_raster_x, scale_for_raster_y, &x0, &y0, &x1, &y1);
+        bitmap_pixels = (unsigned char*)out_bitmap->AllocFunc((size_t)(w * h), out_bitmap->AllocUserData);
+        memset(bitmap_pixels, 0, (size_t)(w * h));
+
+        // Render with oversampling
+        // (those functions conveniently assert if pixels are not cleared, which is another safety layer)
+        stbtt_MakeGlyphBitmapSubpixelPrefilter(&font_info, bitmap_pixels, w, h, w,
+            scale_for_raster_x, scale_for_raster_y, 0, 0, oversample_h, oversample_v, &sub_x, &sub_y, glyph_index);
+    }
+
+    const float ref_size = baked->ContainerFont->Sources[0]->SizePixels;
+    const float offsets_scale = (ref_size != 0.0f) ? (baked->Size / ref_size) : 1.0f;
+    float font_off_x = (src->GlyphOffset.x * offsets_scale);
+    float font_off_y = (src->GlyphOffset.y * offsets_scale);
+    if (src->PixelSnapH) // Snap scaled offset. This is to mitigate backward compatibility issues for GlyphOffset, but a better design would be welcome.
+        font_off_x = IM_ROUND(font_off_x);
+    if (src->PixelSnapV)
+        font_off_y = IM_ROUND(font_off_y);
+    font_off_x += sub_x;
+    font_off_y += sub_y + IM_ROUND(baked->Ascent);
+    float recip_h = 1.0f / (oversample_h * rasterizer_density);
+    float recip_v = 1.0f / (oversample_v * rasterizer_density);
+
+    // Register glyph
+    // glyph.X0, glyph.Y0 are drawing coordinates from base text position, and accounting for oversampling.
+    out_glyph->X0 = x0 * recip_h + font_off_x;
+    out_glyph->Y0 = y0 * recip_v + font_off_y;
+    out_glyph->X1 = (x0 + w) * recip_h + font_off_x;
+    out_glyph->Y1 = (y0 + h) * recip_v + font_off_y;
+    out_glyph->Visible = true;
+    out_bitmap->Pixels = bitmap_pixels;
+    out_bitmap->Width = w;
+    out_bitmap->Height = h;
+    return true;
+}
 
-        // Render
-        stbtt_GetGlyphBitmapBox(&bd_font_data->FontInfo, glyph_index, scale_for_raster_x, scale_for_raster_y, &x0, &y0, &x1, &y1);
-        ImFontAtlasBuilder* builder = atlas->Builder;
-        builder->TempBuffer.resize(w * h * 1);
-        unsigned char* bitmap_pixels = builder->TempBuffer.Data;
-        memset(bitmap_pixels, 0, w * h * 1);
+static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loader_data_for_baked_src, ImWchar codepoint, ImFontGlyph* out_glyph, float* out_advance_x)
+{
+    // Load metrics only mode
+    if (out_advance_x != NULL)
+    {
+        IM_ASSERT(out_glyph == NULL);
+        ImGui_ImplStbTrueType_FontSrcData* bd_font_data = (ImGui_ImplStbTrueType_FontSrcData*)src->FontLoaderData;
+        IM_ASSERT(bd_font_data);
+        int glyph_index = stbtt_FindGlyphIndex(&bd_font_data->FontInfo, (int)codepoint);
+        if (glyph_index == 0)
+            return false;
+        int advance, lsb;
+        stbtt_GetGlyphHMetrics(&bd_font_data->FontInfo, glyph_index, &advance, &lsb);
+        *out_advance_x = advance * bd_font_data->ScaleFactor * baked->Size;
+        return true;
+    }
 
-        // Render with oversampling
-        // (those functions conveniently assert if pixels are not cleared, which is another safety layer)
-        float sub_x, sub_y;
-        stbtt_MakeGlyphBitmapSubpixelPrefilter(&bd_font_data->FontInfo, bitmap_pixels, w, h, w,
-            scale_for_raster_x, scale_for_raster_y, 0, 0, oversample_h, oversample_v, &sub_x, &sub_y, glyph_index);
+    ImFontGlyphBitmap bitmap;
+    if (!ImGui_ImplStbTrueType_FontBakedRasterizeGlyph(atlas, src, baked, loader_data_for_baked_src, codepoint, out_glyph, &bitmap))
+        return false;
+    if (bitmap.Pixels == NULL)
+        return true;
 
-        const float ref_size = baked->ContainerFont->Sources[0]->SizePixels;
-        const float offsets_scale = (ref_size != 0.0f) ? (baked->Size / ref_size) : 1.0f;
-        float font_off_x = (src->GlyphOffset.x * offsets_scale);
-        float font_off_y = (src->GlyphOffset.y * offsets_scale);
-        if (src->PixelSnapH) // Snap scaled offset. This is to mitigate backward compatibility issues for GlyphOffset, but a better design would be welcome.
-            font_off_x = IM_ROUND(font_off_x);
-        if (src->PixelSnapV)
-            font_off_y = IM_ROUND(font_off_y);
-        font_off_x += sub_x;
-        font_off_y += sub_y + IM_ROUND(baked->Ascent);
-        float recip_h = 1.0f / (oversample_h * rasterizer_density);
-        float recip_v = 1.0f / (oversample_v * rasterizer_density);
-
-        // Register glyph
-        // r->x r->y are coordinates inside texture (in pixels)
-        // glyph.X0, glyph.Y0 are drawing coordinates from base text position, and accounting for oversampling.
-        out_glyph->X0 = x0 * recip_h + font_off_x;
-        out_glyph->Y0 = y0 * recip_v + font_off_y;
-        out_glyph->X1 = (x0 + (int)r->w) * recip_h + font_off_x;
-        out_glyph->Y1 = (y0 + (int)r->h) * recip_v + font_off_y;
-        out_glyph->Visible = true;
-        out_glyph->PackId = pack_id;
-        ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, r, bitmap_pixels, ImTextureFormat_Alpha8, w);
+    // Pack and retrieve position inside texture atlas
+    ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, bitmap.Width, bitmap.Height);
+    if (pack_id == ImFontAtlasRectId_Invalid)
+    {
+        // Pathological out of memory case (TexMaxWidth/TexMaxHeight set too small?)
+        IM_ASSERT(pack_id != ImFontAtlasRectId_Invalid && "Out of texture memory.");
+        bitmap.FreeFunc(bitmap.Pixels, bitmap.AllocUserData);
+        return false;
     }
-
+    ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
+    out_glyph->PackId = pack_id;
+    ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, r, bitmap.Pixels, bitmap.Format, bitmap.Width);
+    bitmap.FreeFunc(bitmap.Pixels, bitmap.AllocUserData);
     return true;
 }
 
@@ -4734,6 +7574,7 @@ const ImFontLoader* ImFontAtlasGetFontLoaderForStbTruetype()
     loader.FontBakedInit = ImGui_ImplStbTrueType_FontBakedInit;
     loader.FontBakedDestroy = NULL;
     loader.FontBakedLoadGlyph = ImGui_ImplStbTrueType_FontBakedLoadGlyph;
+    loader.FontBakedRasterizeGlyph = ImGui_ImplStbTrueType_FontBakedRasterizeGlyph;
     return &loader;
 }
 
@@ -5025,6 +7866,11 @@ void ImFontGlyphRangesBuilder::AddText(const char* text, const char* text_end)
 {
     while (text_end ? (text < text_end) : *text)
     {
+        if ((unsigned char)*text < 0x80) // ASCII: no decoding needed
+        {
+            AddChar((ImWchar)*text++);
+            continue;
+        }
         unsigned int c = 0;
         int c_len = ImTextCharFromUtf8(&c, text, text_end);
         text += c_len;
@@ -5069,6 +7915,7 @@ void ImFontBaked::ClearOutputData()
 {
     FallbackAdvanceX = 0.0f;
     Glyphs.clear();
+    GlyphsFreeList.clear();
     IndexAdvanceX.clear();
     IndexLookup.clear();
     FallbackGlyphIndex = -1;
@@ -5116,10 +7963,22 @@ bool ImFont::IsGlyphRangeUnused(unsigned int c_begin, unsigned int c_last)
 // - 'src' is not necessarily == 'this->Sources' because multiple source fonts+configs can be used to build one target font.
 ImFontGlyph* ImFontAtlasBakedAddFontGlyph(ImFontAtlas* atlas, ImFontBaked* baked, ImFontConfig* src, const ImFontGlyph* in_glyph)
 {
-    int glyph_idx = baked->Glyphs.Size;
-    baked->Glyphs.push_back(*in_glyph);
+    // Reuse entry of an evicted glyph
+    int glyph_idx;
+    if (baked->GlyphsFreeList.Size > 0)
+    {
+        glyph_idx = baked->GlyphsFreeList.back();
+        baked->GlyphsFreeList.pop_back();
+        baked->Glyphs[glyph_idx] = *in_glyph;
+    }
+    else
+    {
+        glyph_idx = baked->Glyphs.Size;
+        baked->Glyphs.push_back(*in_glyph);
+    }
     ImFontGlyph* glyph = &baked->Glyphs[glyph_idx];
     IM_ASSERT(baked->Glyphs.Size < 0xFFFE); // IndexLookup[] hold 16-bit values and -1/-2 are reserved.
+    glyph->LastUsedFrame = atlas->Builder->FrameCount;
 
     // Set UV from packed rectangle
     if (glyph->PackId != ImFontAtlasRectId_Invalid)
@@ -5157,8 +8016,11 @@ ImFontGlyph* ImFontAtlasBakedAddFontGlyph(ImFontAtlas* atlas, ImFontBaked* baked
         atlas->TexPixelsUseColors = atlas->TexData->UseColors = true;
 
     // Update lookup tables
+    // (an evicted glyph kept its advance, which is also set when loading advances alone with LoadNoRenderOnLayout)
     const int codepoint = glyph->Codepoint;
     ImFontBaked_BuildGrowIndex(baked, codepoint + 1);
+    if (baked->IndexLookup[codepoint] == IM_FONTGLYPH_INDEX_UNUSED && baked->IndexAdvanceX[codepoint] >= 0.0f && !baked->LoadNoRenderOnLayout)
+        atlas->Builder->GlyphsReloadedCount++;
     baked->IndexAdvanceX[codepoint] = glyph->AdvanceX;
     baked->IndexLookup[codepoint] = (ImU16)glyph_idx;
     const int page_n = codepoint / 8192;
@@ -5207,6 +8069,7 @@ void ImFont::AddRemapChar(ImWchar from_codepoint, ImWchar to_codepoint)
 }
 
 // Find glyph, load if necessary, return fallback if missing
+// Glyph is marked as used during current frame (LastUsedFrame is that of the baked font, set by ImFont::GetFontBaked()), so it won't be evicted.
 ImFontGlyph* ImFontBaked::FindGlyph(ImWchar c)
 {
     if (c < (size_t)IndexLookup.Size) IM_LIKELY
@@ -5215,7 +8078,10 @@ ImFontGlyph* ImFontBaked::FindGlyph(ImWchar c)
         if (i == IM_FONTGLYPH_INDEX_NOT_FOUND)
             return &Glyphs.Data[FallbackGlyphIndex];
         if (i != IM_FONTGLYPH_INDEX_UNUSED)
+        {
+            Glyphs.Data[i].LastUsedFrame = LastUsedFrame;
             return &Glyphs.Data[i];
+        }
     }
     ImFontGlyph* glyph = ImFontBaked_BuildLoadGlyph(this, c, NULL);
     return glyph ? glyph : &Glyphs.Data[FallbackGlyphIndex];
@@ -5230,7 +8096,10 @@ ImFontGlyph* ImFontBaked::FindGlyphNoFallback(ImWchar c)
         if (i == IM_FONTGLYPH_INDEX_NOT_FOUND)
             return NULL;
         if (i != IM_FONTGLYPH_INDEX_UNUSED)
+        {
+            Glyphs.Data[i].LastUsedFrame = LastUsedFrame;
             return &Glyphs.Data[i];
+        }
     }
     LoadNoFallback = true; // This is actually a rare call, not done in hot-loop, so we prioritize not adding extra cruft to ImFontBaked_BuildLoadGlyph() call sites.
     ImFontGlyph* glyph = ImFontBaked_BuildLoadGlyph(this, c, NULL);
@@ -5251,6 +8120,50 @@ bool ImFontBaked::IsGlyphLoaded(ImWchar c)
     return false;
 }
 
+void ImFontBaked::LoadGlyphs(const ImWchar* codepoints, int codepoints_count)
+{
+    ImFontAtlasBakedLoadGlyphs(ContainerFont->ContainerAtlas, this, codepoints, codepoints_count);
+}
+
+void ImFontBaked::LoadGlyphsFromText(const char* text, const char* text_end)
+{
+    if (text_end == NULL)
+        text_end = text + ImStrlen(text);
+    ImVector<ImWchar> codepoints; // Duplicates are skipped by ImFontAtlasBakedLoadGlyphs()
+    for (const char* s = text; s < text_end; )
+    {
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+            s += 1;
+        else
+            s += ImTextCharFromUtf8(&c, s, text_end);
+        if (c >= 32 && !(c < (unsigned int)IndexLookup.Size && IndexLookup.Data[c] != IM_FONTGLYPH_INDEX_UNUSED))
+            codepoints.push_back((ImWchar)c);
+    }
+    LoadGlyphs(codepoints.Data, codepoints.Size);
+}
+
+// Mark loaded glyphs of a text as used during current frame, without rendering it (see ImFontAtlas::TexMemoryBudget)
+// Used for text drawn by reusing last frame vertices (ImGuiWindowRefreshFlags_RetainDrawList).
+void ImFontAtlasBakedMarkGlyphsUsed(ImFontBaked* baked, const char* text, const char* text_end)
+{
+    const int frame_count = baked->LastUsedFrame; // == current frame, set by ImFont::GetFontBaked()
+    for (const char* s = text; s < text_end; )
+    {
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+            s += 1;
+        else
+            s += ImTextCharFromUtf8(&c, s, text_end);
+        if (c < (unsigned int)baked->IndexLookup.Size)
+        {
+            const int i = (int)baked->IndexLookup.Data[c];
+            if (i != IM_FONTGLYPH_INDEX_UNUSED && i != IM_FONTGLYPH_INDEX_NOT_FOUND)
+                baked->Glyphs.Data[i].LastUsedFrame = frame_count;
+        }
+    }
+}
+
 // This is not fast query
 bool ImFont::IsGlyphInFont(ImWchar c)
 {
@@ -5294,6 +8207,13 @@ ImFontBaked* ImFont::GetFontBaked(float size, float density)
 {
     ImFontBaked* baked = LastBaked;
 
+    // Distance field atlases bake a single size per font, which callers scale by 'size / baked->Size' like any other size mismatch.
+    if (ContainerAtlas->Flags & ImFontAtlasFlags_DistanceField)
+    {
+        size = (LegacySize > 0.0f) ? LegacySize : IM_FONTATLAS_DISTANCE_FIELD_DEFAULT_SIZE;
+        density = 1.0f;
+    }
+
     // Round font size
     // - ImGui::PushFont() will already round, but other paths calling GetFontBaked() directly also needs it (e.g. ImFontAtlasBuildPreloadAllGlyphRanges)
     size = ImGui::GetRoundedFontSize(size);
@@ -5359,10 +8279,143 @@ const char* ImTextCalcWordWrapNextLineStart(const char* text, const char* text_e
     return text;
 }
 
+// Return the end of the run of printable ASCII characters (0x20..0x7F) starting at 'text', testing 16 bytes at a time.
+// Text loops process such runs without UTF-8 decoding nor control characters checks, reading advances directly from the first
+// IM_FONTBAKED_INDEX_ASCII_SIZE entries of the baked font index. They may stop early (e.g. on a line break), so the run is only
+// searched up to 'max_len' bytes at a time: looking ahead further than that could cost more than processing the text.
+static inline const char* ImTextFindPrintableAsciiEnd(const char* text, const char* text_end, int max_len = 64)
+{
+    if (text_end - text > max_len)
+        text_end = text + max_len;
+#if defined(IMGUI_ENABLE_SSE)
+    // As signed bytes, all bytes of multi-byte UTF-8 sequences are negative: a single comparison finds them along with control characters.
+    const __m128i min_printable = _mm_set1_epi8(0x20);
+    while (text_end - text >= 16 && _mm_movemask_epi8(_mm_cmplt_epi8(_mm_loadu_si128((const __m128i*)(const void*)text), min_printable)) == 0)
+        text += 16;
+#elif defined(IMGUI_ENABLE_NEON)
+    const int8x16_t min_printable = vdupq_n_s8(0x20);
+    while (text_end - text >= 16)
+    {
+        const uint64x2_t mask = vreinterpretq_u64_u8(vcltq_s8(vld1q_s8((const int8_t*)(const void*)text), min_printable));
+        if ((vgetq_lane_u64(mask, 0) | vgetq_lane_u64(mask, 1)) != 0)
+            break;
+        text += 16;
+    }
+#endif
+    while (text < text_end && (signed char)*text >= 0x20)
+        text++;
+    return text;
+}
+
+// A candidate line break position, along with the caller's line width and output count at that position.
+struct ImFontWordWrapMark
+{
+    const char*     Pos;
+    float           X;          // Scaled line width, as accumulated by the caller
+    int             Written;    // Caller output position (e.g. bytes of vertices) when reaching 'Pos'
+};
+
+// Word-wrapping state machine, fed one character at a time. It holds the rules of ImFontCalcWordWrapPositionEx(), and lets
+// ImFont::RenderText() emit glyphs in the same pass that finds line breaks: when a line overflows, the caller rewinds its
+// output to the break position instead of having scanned the line ahead of rendering it.
+struct ImFontWordWrapper
+{
+    float               WrapWidth;      // Unscaled
+    float               LineWidth;
+    float               WordWidth;
+    float               BlankWidth;
+    bool                InsideWord;
+    bool                KeepBlanks;
+    const char*         LineStart;
+    ImFontWordWrapMark  FirstCharEnd;   // After the first character of the line. Pos == NULL before it.
+    ImFontWordWrapMark  WordEnd;
+    ImFontWordWrapMark  PrevWordEnd;    // Pos == NULL when there's no previous word on the line
+    ImFontWordWrapMark  Break;          // Output, when AddChar() returns true
+
+    void Begin(const char* text, float wrap_width, ImDrawTextFlags flags)
+    {
+        WrapWidth = wrap_width;
+        LineWidth = WordWidth = BlankWidth = 0.0f;
+        InsideWord = true;
+        KeepBlanks = (flags & ImDrawTextFlags_WrapKeepBlanks) != 0;
+        LineStart = text;
+        FirstCharEnd.Pos = PrevWordEnd.Pos = NULL;
+        WordEnd.Pos = text;
+        WordEnd.X = 0.0f;
+        WordEnd.Written = 0;
+    }
+
+    // Add character 'c' spanning [s, next_s) with unscaled advance 'char_width'. (x, written) are the caller values before it, (x_next, written_next) after it.
+    // Return true if the line overflows: it needs to be broken at 'Break' (which may be before 'c', or after it when 'c' is the first character of the line).
+    inline bool AddChar(unsigned int c, const char* s, const char* next_s, float char_width, float x, int written, float x_next, int written_next)
+    {
+        const bool is_blank = ImCharIsBlankW(c);
+        const bool is_break_after = (c == '.' || c == ',' || c == ';' || c == '!' || c == '?' || c == '\"' || c == 0x3001 || c == 0x3002);
+        return AddCharEx(is_blank, is_break_after, s, next_s, char_width, x, written, x_next, written_next);
+    }
+
+    // Faster classification of printable ASCII characters (0x20..0x7F) for AddCharEx(), which match AddChar() rules.
+    static inline bool IsBlankAscii(unsigned int c)         { return c == ' '; }
+    static inline bool IsBreakAfterAscii(unsigned int c)    { const ImU64 mask = (1ULL << '!') | (1ULL << '\"') | (1ULL << ',') | (1ULL << '.') | (1ULL << ';') | (1ULL << '?'); return c < 64 && ((mask >> c) & 1) != 0; }
+
+    // Same as AddChar() with the character class given by the caller: blank, or punctuation we allow wrapping after.
+    inline bool AddCharEx(bool is_blank, bool is_break_after, const char* s, const char* next_s, float char_width, float x, int written, float x_next, int written_next)
+    {
+        if (FirstCharEnd.Pos == NULL)
+            FirstCharEnd = { next_s, x_next, written_next };
+
+        if (is_blank)
+        {
+            if (InsideWord)
+            {
+                LineWidth += BlankWidth;
+                BlankWidth = 0.0f;
+                WordEnd = { s, x, written };
+            }
+            BlankWidth += char_width;
+            InsideWord = false;
+        }
+        else
+        {
+            WordWidth += char_width;
+            if (InsideWord)
+            {
+                WordEnd = { next_s, x_next, written_next };
+            }
+            else
+            {
+                PrevWordEnd = WordEnd;
+                LineWidth += WordWidth + BlankWidth;
+                if (KeepBlanks && LineWidth <= WrapWidth)
+                    PrevWordEnd = { s, x, written };
+                WordWidth = BlankWidth = 0.0f;
+            }
+
+            // Allow wrapping after punctuation.
+            InsideWord = !is_break_after;
+        }
+
+        // We ignore blank width at the end of the line (they can be skipped)
+        if (LineWidth + WordWidth <= WrapWidth)
+            return false;
+
+        // Words that cannot possibly fit within an entire line will be cut anywhere.
+        if (WordWidth < WrapWidth)
+            Break = PrevWordEnd.Pos ? PrevWordEnd : WordEnd;
+        else
+            Break = { s, x, written };
+
+        // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
+        if (Break.Pos == LineStart)
+            Break = FirstCharEnd;
+        return true;
+    }
+};
+
 // Simple word-wrapping for English, not full-featured. Please submit failing cases!
 // This will return the next location to wrap from. If no wrapping if necessary, this will fast-forward to e.g. text_end.
 // FIXME: Much possible improvements (don't cut things like "word !", "word!!!" but cut within "word,,,,", more sensible support for punctuations, support for Unicode punctuations, etc.)
-const char* ImFontCalcWordWrapPositionEx(ImFont* font, float size, const char* text, const char* text_end, float wrap_width, ImDrawTextFlags flags)
+const char* ImFontCalcWordWrapPositionEx(ImFont* font, float size, const char* text, const char* text_end, float wrap_width, ImDrawTextFlags flags, float* out_line_width)
 {
     // For references, possible wrap point marked with ^
     //  "aaa bbb, ccc,ddd. eee   fff. ggg!"
@@ -5379,19 +8432,39 @@ const char* ImFontCalcWordWrapPositionEx(ImFont* font, float size, const char* t
     ImFontBaked* baked = font->GetFontBaked(size);
     const float scale = size / baked->Size;
 
+    // We work with unscaled widths to avoid scaling every characters.
+    // The scaled 'line_width' is only accumulated for 'out_line_width', the same way ImFontCalcTextSizeEx() does.
+    ImFontWordWrapper wrapper;
+    wrapper.Begin(text, wrap_width / scale, flags);
     float line_width = 0.0f;
-    float word_width = 0.0f;
-    float blank_width = 0.0f;
-    wrap_width /= scale; // We work with unscaled widths to avoid scaling every characters
-
-    const char* word_end = text;
-    const char* prev_word_end = NULL;
-    bool inside_word = true;
 
     const char* s = text;
     IM_ASSERT(text_end != NULL);
+    const bool ascii_direct = (baked->IndexAdvanceX.Size >= IM_FONTBAKED_INDEX_ASCII_SIZE);
     while (s < text_end)
     {
+        // Fast path for runs of printable ASCII characters
+        if (ascii_direct && (signed char)*s >= 0x20)
+        {
+            for (const char* run_end = ImTextFindPrintableAsciiEnd(s, text_end); s < run_end; s++)
+            {
+                const unsigned int c = (unsigned char)*s;
+                float char_width = baked->IndexAdvanceX.Data[c];
+                if (char_width < 0.0f)
+                    char_width = BuildLoadGlyphGetAdvanceOrFallback(baked, c, s, text_end);
+                const float line_width_next = line_width + char_width * scale;
+                if (wrapper.AddCharEx(ImFontWordWrapper::IsBlankAscii(c), ImFontWordWrapper::IsBreakAfterAscii(c), s, s + 1, char_width, line_width, 0, line_width_next, 0))
+                {
+                    if (out_line_width)
+                        *out_line_width = wrapper.Break.X;
+                    return wrapper.Break.Pos;
+                }
+                line_width = line_width_next;
+            }
+            if (s == text_end)
+                break;
+        }
+
         unsigned int c = (unsigned int)*s;
         const char* next_s;
         if (c < 0x80)
@@ -5402,7 +8475,7 @@ const char* ImFontCalcWordWrapPositionEx(ImFont* font, float size, const char* t
         if (c < 32)
         {
             if (c == '\n')
-                return s; // Direct return, skip "Wrap_width is too small to fit anything" path.
+                break; // Stop on line feed, skip "Wrap_width is too small to fit anything" path.
             if (c == '\r')
             {
                 s = next_s;
@@ -5413,55 +8486,22 @@ const char* ImFontCalcWordWrapPositionEx(ImFont* font, float size, const char* t
         // Optimized inline version of 'float char_width = GetCharAdvance((ImWchar)c);'
         float char_width = (c < (unsigned int)baked->IndexAdvanceX.Size) ? baked->IndexAdvanceX.Data[c] : -1.0f;
         if (char_width < 0.0f)
-            char_width = BuildLoadGlyphGetAdvanceOrFallback(baked, c);
-
-        if (ImCharIsBlankW(c))
-        {
-            if (inside_word)
-            {
-                line_width += blank_width;
-                blank_width = 0.0f;
-                word_end = s;
-            }
-            blank_width += char_width;
-            inside_word = false;
-        }
-        else
-        {
-            word_width += char_width;
-            if (inside_word)
-            {
-                word_end = next_s;
-            }
-            else
-            {
-                prev_word_end = word_end;
-                line_width += word_width + blank_width;
-                if ((flags & ImDrawTextFlags_WrapKeepBlanks) && line_width <= wrap_width)
-                    prev_word_end = s;
-                word_width = blank_width = 0.0f;
-            }
-
-            // Allow wrapping after punctuation.
-            inside_word = (c != '.' && c != ',' && c != ';' && c != '!' && c != '?' && c != '\"' && c != 0x3001 && c != 0x3002);
-        }
+            char_width = BuildLoadGlyphGetAdvanceOrFallback(baked, c, s, text_end);
 
-        // We ignore blank width at the end of the line (they can be skipped)
-        if (line_width + word_width > wrap_width)
+        const float line_width_next = line_width + char_width * scale;
+        if (wrapper.AddChar(c, s, next_s, char_width, line_width, 0, line_width_next, 0))
         {
-            // Words that cannot possibly fit within an entire line will be cut anywhere.
-            if (word_width < wrap_width)
-                s = prev_word_end ? prev_word_end : word_end;
-            break;
+            // +1 char may not be a character start point in UTF-8 but it's ok because caller loops use (text >= word_wrap_eol).
+            if (out_line_width)
+                *out_line_width = wrapper.Break.X;
+            return wrapper.Break.Pos;
         }
-
+        line_width = line_width_next;
         s = next_s;
     }
 
-    // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
-    // +1 may not be a character start point in UTF-8 but it's ok because caller loops use (text >= word_wrap_eol).
-    if (s == text && text < text_end)
-        return s + ImTextCountUtf8BytesFromChar(s, text_end);
+    if (out_line_width)
+        *out_line_width = line_width;
     return s;
 }
 
@@ -5486,6 +8526,15 @@ ImVec2 ImFontCalcTextSizeEx(ImFont* font, float size, float max_width, float wra
 
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
+    const bool ascii_direct = (baked->IndexAdvanceX.Size >= IM_FONTBAKED_INDEX_ASCII_SIZE); // Except while PushPasswordFont() has swapped the index out
+
+    // When measuring a whole wrapped text, record its line breaks for ImFont::RenderText() to reuse
+    ImVector<int>* wrap_lines = NULL;
+    if (word_wrap_enabled && text_end_display == text_end && max_width == FLT_MAX && (flags & ImDrawTextFlags_StopOnNewLine) == 0 && font->ContainerAtlas->Builder != NULL)
+    {
+        wrap_lines = &font->ContainerAtlas->Builder->WrapLinesTemp;
+        wrap_lines->resize(0);
+    }
 
     const char* s = text_begin;
     while (s < text_end_display)
@@ -5493,9 +8542,21 @@ ImVec2 ImFontCalcTextSizeEx(ImFont* font, float size, float max_width, float wra
         // Word-wrapping
         if (word_wrap_enabled)
         {
-            // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
+            // Calculate how far we can render. The wrapping function also measures the line, so unless it needs to be cut short we skip straight to its end.
             if (!word_wrap_eol)
-                word_wrap_eol = ImFontCalcWordWrapPositionEx(font, size, s, text_end, wrap_width - line_width, flags);
+            {
+                float word_wrap_line_width;
+                word_wrap_eol = ImFontCalcWordWrapPositionEx(font, size, s, text_end, wrap_width - line_width, flags, &word_wrap_line_width);
+                if (wrap_lines != NULL)
+                    wrap_lines->push_back((int)(word_wrap_eol - text_begin));
+                if (word_wrap_eol <= text_end_display && max_width == FLT_MAX)
+                {
+                    IM_ASSERT(line_width == 0.0f);
+                    line_width = word_wrap_line_width;
+                    s = word_wrap_eol;
+                    continue;
+                }
+            }
 
             if (s >= word_wrap_eol)
             {
@@ -5511,6 +8572,27 @@ ImVec2 ImFontCalcTextSizeEx(ImFont* font, float size, float max_width, float wra
             }
         }
 
+        // Fast path for runs of printable ASCII characters
+        if (!word_wrap_enabled && ascii_direct && (signed char)*s >= 0x20)
+        {
+            const char* run_end = ImTextFindPrintableAsciiEnd(s, text_end_display);
+            for (; s < run_end; s++)
+            {
+                const unsigned int c = (unsigned char)*s;
+                float char_width = baked->IndexAdvanceX.Data[c];
+                if (char_width < 0.0f)
+                    char_width = BuildLoadGlyphGetAdvanceOrFallback(baked, c, s, text_end);
+                char_width *= scale;
+                if (line_width + char_width >= max_width)
+                    break;
+                line_width += char_width;
+            }
+            if (s < run_end)
+                break;
+            if (s == text_end_display)
+                break;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -5534,7 +8616,7 @@ ImVec2 ImFontCalcTextSizeEx(ImFont* font, float size, float max_width, float wra
         // Optimized inline version of 'float char_width = GetCharAdvance((ImWchar)c);'
         float char_width = (c < (unsigned int)baked->IndexAdvanceX.Size) ? baked->IndexAdvanceX.Data[c] : -1.0f;
         if (char_width < 0.0f)
-            char_width = BuildLoadGlyphGetAdvanceOrFallback(baked, c);
+            char_width = BuildLoadGlyphGetAdvanceOrFallback(baked, c, s, text_end);
         char_width *= scale;
 
         if (line_width + char_width >= max_width)
@@ -5558,6 +8640,9 @@ ImVec2 ImFontCalcTextSizeEx(ImFont* font, float size, float max_width, float wra
     if (out_remaining != NULL)
         *out_remaining = s;
 
+    if (wrap_lines != NULL && wrap_lines->Size > 0)
+        ImFontAtlasWrapLinesAdd(font->ContainerAtlas, baked, size, wrap_width, flags, text_begin, text_end);
+
     return text_size;
 }
 
@@ -5601,8 +8686,62 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
         if (y1 >= y2)
             return;
     }
-    draw_list->PrimReserve(6, 4);
-    draw_list->PrimRectUV(ImVec2(x1, y1), ImVec2(x2, y2), ImVec2(u1, v1), ImVec2(u2, v2), col);
+    if (draw_list->Flags & ImDrawListFlags_InstancedQuads)
+    {
+        draw_list->PrimReserveQuads(1);
+        draw_list->PrimWriteQuad(ImVec2(x1, y1), ImVec2(x2, y2), ImVec2(u1, v1), ImVec2(u2, v2), col);
+    }
+    else
+    {
+        draw_list->PrimReserve(6, 4);
+        draw_list->PrimRectUV(ImVec2(x1, y1), ImVec2(x2, y2), ImVec2(u1, v1), ImVec2(u2, v2), col);
+    }
+}
+
+// Commit glyphs written in a chunk reserved by ImFont::RenderText() and give back unused vertices (clipped ones, blanks) ~ this is essentially a PrimUnreserve() action.
+// Returns false if a glyph load changed the texture while writing the chunk: it is then entirely given back and needs to be written again.
+static bool ImFont_RenderTextCommitChunk(ImDrawList* draw_list, int cmd_count, ImDrawVert* vtx_write, ImDrawQuad* quad_write)
+{
+    // Edge case: calling RenderText() with unloaded glyphs triggering texture change. It doesn't happen via ImGui:: calls because CalcTextSize() is always used.
+    const bool texture_changed = (cmd_count != draw_list->CmdBuffer.Size); //-V547
+    if (texture_changed)
+    {
+        IM_ASSERT(draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount == 0 && draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].QuadCount == 0);
+        draw_list->CmdBuffer.pop_back();
+        vtx_write = draw_list->_VtxWritePtr;
+        if (quad_write != NULL)
+            quad_write = draw_list->_QuadWritePtr;
+    }
+
+    ImDrawCmd* draw_cmd = &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
+    if (quad_write != NULL)
+    {
+        const int quad_buffer_size = (int)(quad_write - draw_list->QuadBuffer.Data);
+        draw_cmd->QuadCount -= (draw_list->QuadBuffer.Size - quad_buffer_size);
+        draw_list->QuadBuffer.Size = quad_buffer_size;
+        draw_list->_QuadWritePtr = quad_write;
+    }
+    else
+    {
+        const int rect_count = (int)(vtx_write - draw_list->_VtxWritePtr) / 4;
+        ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+        ImDrawList_WriteRectIndices(idx_write, draw_list->_VtxCurrentIdx, rect_count);
+        idx_write += rect_count * 6;
+        const int idx_buffer_size = (int)(idx_write - draw_list->IdxBuffer.Data);
+        draw_cmd->ElemCount -= (draw_list->IdxBuffer.Size - idx_buffer_size);
+        draw_list->VtxBuffer.Size = (int)(vtx_write - draw_list->VtxBuffer.Data); // Same as calling shrink()
+        draw_list->IdxBuffer.Size = idx_buffer_size;
+        draw_list->_VtxWritePtr = vtx_write;
+        draw_list->_IdxWritePtr = idx_write;
+        draw_list->_VtxCurrentIdx += rect_count * 4;
+    }
+
+    if (texture_changed)
+    {
+        draw_list->AddDrawCmd();
+        //IMGUI_DEBUG_LOG("RenderText: cancel and retry to missing glyphs.\n"); // [DEBUG]
+    }
+    return !texture_changed;
 }
 
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
@@ -5610,7 +8749,6 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
 void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, ImDrawTextFlags flags)
 {
     // Align to be pixel perfect
-begin:
     float x = IM_TRUNC(pos.x);
     float y = IM_TRUNC(pos.y);
     if (y > clip_rect.w)
@@ -5624,67 +8762,116 @@ begin:
 
     const float scale = size / baked->Size;
     const float origin_x = x;
+    const int frame_count = baked->LastUsedFrame; // == current frame, for marking rendered glyphs (see ImFontAtlas::TexMemoryBudget)
     const bool word_wrap_enabled = (wrap_width > 0.0f);
+    const bool ascii_direct = (baked->IndexLookup.Size >= IM_FONTBAKED_INDEX_ASCII_SIZE); // Except while PushPasswordFont() has swapped the index out
+
+    // Reuse line breaks if the text was just measured by ImFontCalcTextSizeEx() (e.g. ImGui::TextWrapped())
+    const ImFontWrapLinesEntry* wrap_lines = word_wrap_enabled ? ImFontAtlasWrapLinesFind(ContainerAtlas, baked, size, wrap_width, flags, text_begin, text_end) : NULL;
+    int wrap_lines_n = 0;
 
     // Fast-forward to first visible line
     const char* s = text_begin;
     if (y + line_height < clip_rect.y)
         while (y + line_height < clip_rect.y && s < text_end)
         {
-            const char* line_end = (const char*)ImMemchr(s, '\n', text_end - s);
-            if (word_wrap_enabled)
-            {
-                // FIXME-OPT: This is not optimal as do first do a search for \n before calling CalcWordWrapPosition().
-                // If the specs for CalcWordWrapPosition() were reworked to optionally return on \n we could combine both.
-                // However it is still better than nothing performing the fast-forward!
-                s = ImFontCalcWordWrapPositionEx(this, size, s, line_end ? line_end : text_end, wrap_width, flags);
-                s = ImTextCalcWordWrapNextLineStart(s, text_end, flags);
-            }
+            if (wrap_lines != NULL)
+                s = ImTextCalcWordWrapNextLineStart(text_begin + wrap_lines->LineEnds[wrap_lines_n++], text_end, flags);
+            else if (word_wrap_enabled)
+                s = ImTextCalcWordWrapNextLineStart(ImFontCalcWordWrapPositionEx(this, size, s, text_end, wrap_width, flags), text_end, flags); // Stops on \n
+            else if (const char* line_end = (const char*)ImMemchr(s, '\n', text_end - s))
+                s = line_end + 1;
             else
-            {
-                s = line_end ? line_end + 1 : text_end;
-            }
+                s = text_end;
             y += line_height;
         }
 
-    // For large text, scan for the last visible line in order to avoid over-reserving in the call to PrimReserve()
-    // Note that very large horizontal line will still be affected by the issue (e.g. a one megabyte string buffer without a newline will likely crash atm)
-    if (text_end - s > 10000 && !word_wrap_enabled)
-    {
-        const char* s_end = s;
-        float y_end = y;
-        while (y_end < clip_rect.w && s_end < text_end)
-        {
-            s_end = (const char*)ImMemchr(s_end, '\n', text_end - s_end);
-            s_end = s_end ? s_end + 1 : text_end;
-            y_end += line_height;
-        }
-        text_end = s_end;
-    }
     if (s == text_end)
         return;
 
-    // Reserve vertices for remaining worse case (over-reserving is useful and easily amortized)
-    const int vtx_count_max = (int)(text_end - s) * 4;
-    const int idx_count_max = (int)(text_end - s) * 6;
-    const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
-    draw_list->PrimReserve(idx_count_max, vtx_count_max);
-    ImDrawVert*  vtx_write = draw_list->_VtxWritePtr;
-    ImDrawIdx*   idx_write = draw_list->_IdxWritePtr;
-    unsigned int vtx_index = draw_list->_VtxCurrentIdx;
-    const int cmd_count = draw_list->CmdBuffer.Size;
+    // Reserve vertices (or quads) in chunks of at most IM_DRAWLIST_TEXT_CHUNK_SIZE glyphs, over-reserving within a chunk is useful and easily amortized.
+    // A chunk is filled from at most as many bytes of text as it has glyphs, which spares us checking for space left when writing a glyph.
+    // Glyphs outside of the clip rectangle are never written, so even for megabytes of text (with or without newlines) memory use stays bounded by what is visible.
+    const bool use_quads = (draw_list->Flags & ImDrawListFlags_InstancedQuads) != 0;
+    ImDrawVert*  vtx_write = NULL;
+    ImDrawQuad*  quad_write = NULL;
+    const char*  chunk_end = NULL;
+    int cmd_count = 0;
     const bool cpu_fine_clip = (flags & ImDrawTextFlags_CpuFineClip) != 0;
 
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
     const char* word_wrap_eol = NULL;
 
-    while (s < text_end)
+    // Where to write the current chunk again from, if a glyph load changes the texture while writing it.
+    const char* chunk_s = s;
+    float chunk_x = x;
+    float chunk_y = y;
+    const char* chunk_word_wrap_eol = NULL;
+    int chunk_wrap_lines_n = wrap_lines_n;
+
+    // Horizontal skip-ahead, on lines whose end is known: once a glyph is clipped, the rest of the line is skipped if we are past the right of
+    // the clip rectangle, and following glyphs are skipped using their advances only if we are left of it.
+    // This assumes that glyphs don't extend more than a line height before their origin or after their advance.
+    const float clip_x_skip_left = clip_rect.x - line_height;
+    const float clip_x_skip_right = clip_rect.z + line_height;
+
+    // Without recorded line breaks, lines are wrapped while emitting glyphs: the wrapper tells when a line overflows,
+    // and we rewind the output to the break position (at most re-emitting the word that didn't fit).
+    // Output positions are tracked in bytes written since the line start to either the vertex or the quad buffer, which avoids a division per character.
+    // Such a line never spans two chunks: when a chunk ends in its middle, the line end is calculated upfront and the line is written again in the next chunk.
+    ImFontWordWrapper wrapper;
+    wrapper.Begin(s, wrap_width / scale, flags);
+    const bool word_wrap_single_pass = word_wrap_enabled && wrap_lines == NULL;
+    bool word_wrap_searching = false; // Wrapper is looking for the end of current line
+    const char* line_begin = s;
+    const char* line_quad_write = NULL;
+    const char* line_vtx_write = NULL;
+    int wrapper_written = 0;
+
+begin_chunk:
+    {
+        const int chunk_size = ImMin((int)(text_end - s), IM_DRAWLIST_TEXT_CHUNK_SIZE);
+        if (use_quads)
+        {
+            draw_list->PrimReserveQuads(chunk_size);
+            quad_write = draw_list->_QuadWritePtr;
+        }
+        else
+        {
+            draw_list->PrimReserve(chunk_size * 6, chunk_size * 4);
+            vtx_write = draw_list->_VtxWritePtr;
+        }
+        cmd_count = draw_list->CmdBuffer.Size;
+        chunk_end = s + chunk_size;
+        chunk_s = s;
+        chunk_x = x;
+        chunk_y = y;
+        chunk_word_wrap_eol = word_wrap_eol;
+        chunk_wrap_lines_n = wrap_lines_n;
+    }
+
+    while (s < chunk_end)
     {
         if (word_wrap_enabled)
         {
-            // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
+            // Calculate how far we can render
             if (!word_wrap_eol)
-                word_wrap_eol = ImFontCalcWordWrapPositionEx(this, size, s, text_end, wrap_width - (x - origin_x), flags);
+            {
+                if (word_wrap_single_pass)
+                {
+                    wrapper.Begin(s, wrap_width / scale, flags);
+                    word_wrap_eol = text_end; // Until the wrapper finds a break
+                    word_wrap_searching = true;
+                    line_begin = s;
+                    line_quad_write = (const char*)quad_write;
+                    line_vtx_write = (const char*)vtx_write;
+                    wrapper_written = 0;
+                }
+                else
+                {
+                    word_wrap_eol = text_begin + wrap_lines->LineEnds[wrap_lines_n++];
+                }
+            }
 
             if (s >= word_wrap_eol)
             {
@@ -5699,30 +8886,41 @@ begin:
         }
 
         // Decode and advance source
+        const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
-        if (c < 0x80)
+        ImFontGlyph* glyph;
+        if ((signed char)c >= 0x20 && ascii_direct)
+        {
+            // Printable ASCII: index glyph directly
             s += 1;
+            const unsigned int glyph_idx = baked->IndexLookup.Data[c];
+            glyph = (glyph_idx < IM_FONTGLYPH_INDEX_NOT_FOUND) ? &baked->Glyphs.Data[glyph_idx] : BuildLoadGlyphFindOrFallback(baked, c, prev_s, text_end);
+        }
         else
-            s += ImTextCharFromUtf8(&c, s, text_end);
-
-        if (c < 32)
         {
-            if (c == '\n')
+            if (c < 0x80)
+                s += 1;
+            else
+                s += ImTextCharFromUtf8(&c, s, text_end);
+
+            if (c < 32)
             {
-                x = origin_x;
-                y += line_height;
-                if (y > clip_rect.w)
-                    break; // break out of main loop
-                continue;
+                if (c == '\n')
+                {
+                    x = origin_x;
+                    y += line_height;
+                    if (y > clip_rect.w)
+                        break; // break out of main loop
+                    word_wrap_eol = NULL;
+                    continue;
+                }
+                if (c == '\r')
+                    continue;
             }
-            if (c == '\r')
-                continue;
+            const unsigned int glyph_idx = (c < (unsigned int)baked->IndexLookup.Size) ? baked->IndexLookup.Data[c] : IM_FONTGLYPH_INDEX_UNUSED;
+            glyph = (glyph_idx < IM_FONTGLYPH_INDEX_NOT_FOUND) ? &baked->Glyphs.Data[glyph_idx] : BuildLoadGlyphFindOrFallback(baked, c, prev_s, text_end);
         }
 
-        const ImFontGlyph* glyph = baked->FindGlyph((ImWchar)c);
-        //if (glyph == NULL)
-        //    continue;
-
         float char_width = glyph->AdvanceX * scale;
         if (glyph->Visible)
         {
@@ -5731,9 +8929,10 @@ begin:
             float x2 = x + glyph->X1 * scale;
             float y1 = y + glyph->Y0 * scale;
             float y2 = y + glyph->Y1 * scale;
-            if (x1 <= clip_rect.z && x2 >= clip_rect.x)
+            if (x1 <= clip_rect.z && x2 >= clip_rect.x && (!cpu_fine_clip || ImMax(y1, clip_rect.y) < ImMin(y2, clip_rect.w)))
             {
                 // Render a character
+                glyph->LastUsedFrame = frame_count;
                 float u1 = glyph->U0;
                 float v1 = glyph->V0;
                 float u2 = glyph->U1;
@@ -5762,54 +8961,131 @@ begin:
                         v2 = v1 + ((clip_rect.w - y1) / (y2 - y1)) * (v2 - v1);
                         y2 = clip_rect.w;
                     }
-                    if (y1 >= y2)
-                    {
-                        x += char_width;
-                        continue;
-                    }
                 }
 
                 // Support for untinted glyphs
                 ImU32 glyph_col = glyph->Colored ? col_untinted : col;
 
-                // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug builds. Inlined here:
+                // We are NOT calling PrimRectUV()/PrimWriteQuad() here because non-inlined causes too much overhead in a debug builds. Inlined here:
+                // (indices are all written after the loop, see ImDrawList_WriteRectIndices())
+#ifdef IMGUI_ENABLE_SIMD_RECTS
+                const ImDrawListSimdRect pos4 = ImDrawList_SimdRectSet(x1, y1, x2, y2);
+                const ImDrawListSimdRect uv4 = ImDrawList_SimdRectSet(u1, v1, u2, v2);
+                if (quad_write != NULL)
+                {
+                    ImDrawList_WriteRectQuad(quad_write, pos4, uv4, glyph_col);
+                    quad_write++;
+                }
+                else
+                {
+                    ImDrawList_WriteRectVtx(vtx_write, pos4, uv4, glyph_col);
+                    vtx_write += 4;
+                }
+#else
+                if (quad_write != NULL)
+                {
+                    quad_write->Pos.x = x1; quad_write->Pos.y = y1; quad_write->Size.x = x2 - x1; quad_write->Size.y = y2 - y1;
+                    quad_write->UvMin.x = u1; quad_write->UvMin.y = v1; quad_write->UvMax.x = u2; quad_write->UvMax.y = v2; quad_write->Col = glyph_col;
+                    quad_write++;
+                }
+                else
                 {
                     vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
                     vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
                     vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
                     vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
-                    idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
-                    idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
                     vtx_write += 4;
-                    vtx_index += 4;
-                    idx_write += 6;
                 }
+#endif
+            }
+            else if (!word_wrap_searching && x > clip_x_skip_right)
+            {
+                // Nothing else visible on this line
+                if (word_wrap_enabled)
+                    s = ImMax(s, word_wrap_eol);
+                else if (const char* line_end = (const char*)ImMemchr(s, '\n', text_end - s))
+                    s = line_end;
+                else
+                    s = text_end;
+                continue;
+            }
+            else if (!word_wrap_searching && x < clip_x_skip_left)
+            {
+                // Skip following glyphs left of the clip rectangle. Control characters and glyphs not loaded yet are left to the main loop.
+                x += char_width;
+                const char* line_end = word_wrap_enabled ? word_wrap_eol : text_end;
+                while (s < line_end)
+                {
+                    unsigned int skip_c = (unsigned int)*s;
+                    int skip_c_len = 1;
+                    if (skip_c < 32)
+                        break;
+                    if (skip_c >= 0x80)
+                        skip_c_len = ImTextCharFromUtf8(&skip_c, s, text_end);
+                    float skip_char_width = (skip_c < (unsigned int)baked->IndexAdvanceX.Size) ? baked->IndexAdvanceX.Data[skip_c] : -1.0f;
+                    if (skip_char_width < 0.0f)
+                        break;
+                    skip_char_width *= scale;
+                    if (x + skip_char_width >= clip_x_skip_left)
+                        break;
+                    x += skip_char_width;
+                    s += skip_c_len;
+                }
+                continue;
             }
         }
+        const float char_x = x;
         x += char_width;
+
+        if (word_wrap_searching)
+        {
+            const int written = (int)(((const char*)quad_write - line_quad_write) + ((const char*)vtx_write - line_vtx_write));
+            if (wrapper.AddChar(c, prev_s, s, glyph->AdvanceX, char_x - origin_x, wrapper_written, x - origin_x, written))
+            {
+                // Line overflows: take back glyphs past the break, they will be emitted again on next line.
+                wrapper_written = wrapper.Break.Written;
+                if (use_quads)
+                    quad_write = (ImDrawQuad*)(void*)(line_quad_write + wrapper_written);
+                else
+                    vtx_write = (ImDrawVert*)(void*)(line_vtx_write + wrapper_written);
+                s = word_wrap_eol = wrapper.Break.Pos;
+                word_wrap_searching = false;
+            }
+            else
+            {
+                wrapper_written = written;
+            }
+        }
     }
 
-    // Edge case: calling RenderText() with unloaded glyphs triggering texture change. It doesn't happen via ImGui:: calls because CalcTextSize() is always used.
-    if (cmd_count != draw_list->CmdBuffer.Size) //-V547
+    // Chunk is full: commit it and continue with next one
+    if (s < text_end && y <= clip_rect.w)
     {
-        IM_ASSERT(draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount == 0);
-        draw_list->CmdBuffer.pop_back();
-        draw_list->PrimUnreserve(idx_count_max, vtx_count_max);
-        draw_list->AddDrawCmd();
-        //IMGUI_DEBUG_LOG("RenderText: cancel and retry to missing glyphs.\n"); // [DEBUG]
-        //draw_list->AddRectFilled(pos, pos + ImVec2(10, 10), IM_COL32(255, 0, 0, 255)); // [DEBUG]
-        goto begin;
-        //RenderText(draw_list, size, pos, col, clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip); // FIXME-OPT: Would a 'goto begin' be better for code-gen?
-        //return;
+        if (word_wrap_searching)
+        {
+            word_wrap_eol = ImFontCalcWordWrapPositionEx(this, size, line_begin, text_end, wrap_width, flags);
+            word_wrap_searching = false;
+            s = line_begin;
+            x = origin_x;
+            vtx_write = (ImDrawVert*)(void*)line_vtx_write;
+            quad_write = (ImDrawQuad*)(void*)line_quad_write;
+        }
+        if (ImFont_RenderTextCommitChunk(draw_list, cmd_count, vtx_write, quad_write))
+            goto begin_chunk;
+    }
+    else if (ImFont_RenderTextCommitChunk(draw_list, cmd_count, vtx_write, quad_write))
+    {
+        return;
     }
 
-    // Give back unused vertices (clipped ones, blanks) ~ this is essentially a PrimUnreserve() action.
-    draw_list->VtxBuffer.Size = (int)(vtx_write - draw_list->VtxBuffer.Data); // Same as calling shrink()
-    draw_list->IdxBuffer.Size = (int)(idx_write - draw_list->IdxBuffer.Data);
-    draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
-    draw_list->_VtxWritePtr = vtx_write;
-    draw_list->_IdxWritePtr = idx_write;
-    draw_list->_VtxCurrentIdx = vtx_index;
+    // A glyph load changed the texture while writing current chunk, which was given back: write it again.
+    s = chunk_s;
+    x = chunk_x;
+    y = chunk_y;
+    word_wrap_eol = chunk_word_wrap_eol;
+    word_wrap_searching = false;
+    wrap_lines_n = chunk_wrap_lines_n;
+    goto begin_chunk;
 }
 
 //-----------------------------------------------------------------------------
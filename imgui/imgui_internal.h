@@ -72,6 +72,11 @@ Index of this file:
 #if defined(IMGUI_ENABLE_SSE4_2) && !defined(IMGUI_USE_LEGACY_CRC32_ADLER) && !defined(__EMSCRIPTEN__)
 #define IMGUI_ENABLE_SSE4_2_CRC
 #endif
+// Enable NEON intrinsics if available
+#if (defined __ARM_NEON || defined __ARM_NEON__ || defined _M_ARM64) && !defined(IMGUI_DISABLE_NEON)
+#define IMGUI_ENABLE_NEON
+#include <arm_neon.h>
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -137,6 +142,7 @@ Index of this file:
 struct ImBitVector;                 // Store 1-bit per value
 struct ImRect;                      // An axis-aligned rectangle (2 points)
 struct ImGuiTextIndex;              // Maintain a line index for a text buffer.
+struct ImGuiTextSizeCache;          // Cache CalcTextSize() results (when io.ConfigTextSizeCache is enabled)
 
 // ImDrawList/ImFontAtlas
 struct ImDrawDataBuilder;           // Helper to build a ImDrawData instance
@@ -362,6 +368,7 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 // - Helper: ImPool<>
 // - Helper: ImChunkStream<>
 // - Helper: ImGuiTextIndex
+// - Helper: ImGuiTextSizeCache
 // - Helper: ImGuiStorage
 //-----------------------------------------------------------------------------
 
@@ -439,7 +446,7 @@ enum ImDrawTextFlags_
     ImDrawTextFlags_StopOnNewLine       = 1 << 2,
 };
 IMGUI_API ImVec2        ImFontCalcTextSizeEx(ImFont* font, float size, float max_width, float wrap_width, const char* text_begin, const char* text_end_display, const char* text_end, const char** out_remaining, ImVec2* out_offset, ImDrawTextFlags flags);
-IMGUI_API const char*   ImFontCalcWordWrapPositionEx(ImFont* font, float size, const char* text, const char* text_end, float wrap_width, ImDrawTextFlags flags = 0);
+IMGUI_API const char*   ImFontCalcWordWrapPositionEx(ImFont* font, float size, const char* text, const char* text_end, float wrap_width, ImDrawTextFlags flags = 0, float* out_line_width = NULL); // 'out_line_width' receives the width of [text, returned position)
 IMGUI_API const char*   ImTextCalcWordWrapNextLineStart(const char* text, const char* text_end, ImDrawTextFlags flags = 0); // trim trailing space and find beginning of next line
 
 // Helpers: File System
@@ -459,6 +466,8 @@ IMGUI_API bool              ImFileClose(ImFileHandle file);
 IMGUI_API ImU64             ImFileGetSize(ImFileHandle file);
 IMGUI_API ImU64             ImFileRead(void* data, ImU64 size, ImU64 count, ImFileHandle file);
 IMGUI_API ImU64             ImFileWrite(const void* data, ImU64 size, ImU64 count, ImFileHandle file);
+IMGUI_API bool              ImFileRename(const char* old_filename, const char* new_filename); // Replace 'new_filename' if it exists
+IMGUI_API bool              ImFileRemove(const char* filename);
 #else
 #define IMGUI_DISABLE_TTY_FUNCTIONS // Can't use stdout, fflush if we are not using default file functions
 #endif
@@ -814,6 +823,41 @@ struct ImGuiTextIndex
     void            append(const char* base, int old_size, int new_size);
 };
 
+// Helper: ImGuiTextSizeCache
+// Cache CalcTextSize() results, when io.ConfigTextSizeCache is enabled.
+// - Keyed on a 64-bit hash of the text contents + length, font baked, font size and wrap width. The text itself isn't stored or compared.
+// - Open addressing hash table (power-of-two size, kept at most half full). Entries unused for a while are evicted when it needs room.
+// - Font atlases clear caches of their contexts when discarding baked data or glyphs (ImFontBaked pointers may then be reused).
+struct ImGuiTextSizeCacheEntry
+{
+    ImFontBaked*    FontBaked;
+    ImU64           TextHash;                               // 0 == empty slot
+    int             TextLen;
+    float           FontSize;
+    float           WrapWidth;
+    int             LastFrameUsed;
+    ImVec2          Size;                                   // Rounded result, as returned by CalcTextSize()
+};
+
+struct ImGuiTextSizeCache
+{
+    ImVector<ImGuiTextSizeCacheEntry> Entries;
+    int             EntriesCount = 0;
+    int             FrameHits = 0;                          // Lookups during the current frame
+    int             FrameMisses = 0;
+    int             LastFrameHits = 0;                      // Lookups during the previous frame (displayed in Metrics)
+    int             LastFrameMisses = 0;
+    int             EvictedCount = 0;                       // Total number of entries evicted for being unused
+
+    void            Clear()                                 { if (EntriesCount > 0) memset(Entries.Data, 0, (size_t)Entries.size_in_bytes()); EntriesCount = 0; }
+    void            ClearFreeMemory()                       { Entries.clear(); EntriesCount = 0; }
+    void            NewFrame()                              { LastFrameHits = FrameHits; LastFrameMisses = FrameMisses; FrameHits = FrameMisses = 0; }
+    static ImU64    HashText(const char* text, int text_len);
+    ImGuiTextSizeCacheEntry* Find(ImU64 text_hash, int text_len, ImFontBaked* baked, float font_size, float wrap_width);
+    void            Add(ImU64 text_hash, int text_len, ImFontBaked* baked, float font_size, float wrap_width, const ImVec2& size, int frame_count);
+    void            Rebuild(int frame_count);
+};
+
 // Helper: ImGuiStorage
 IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStoragePair* in_end, ImGuiID key);
 
@@ -846,6 +890,12 @@ IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStorag
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// ImDrawList: Maximum number of glyphs ImFont::RenderText() reserves vertices (or quads) for at once.
+// Must stay under 16384 so a chunk fits in 16-bit indices (4 vertices per glyph).
+#ifndef IM_DRAWLIST_TEXT_CHUNK_SIZE
+#define IM_DRAWLIST_TEXT_CHUNK_SIZE                             4096
+#endif
+
 // Data shared between all ImDrawList instances
 // Conceptually this could have been called e.g. ImDrawListSharedContext
 // Typically one ImGui context would create and maintain one of this.
@@ -877,6 +927,50 @@ struct IMGUI_API ImDrawListSharedData
     void SetCircleTessellationMaxError(float max_error);
 };
 
+// ImDrawList retained mode: journal of the draw calls submitted to a draw list during the previous frame.
+// Each entry stores a running hash of all draw calls up to that point, and the output state just before the draw call.
+// When the same sequence of draw calls is submitted again, we move the output state forward instead of regenerating vertices.
+// See ImDrawList::_SetRetained() and ImGuiWindowRefreshFlags_RetainDrawList.
+enum ImDrawListRetainedState
+{
+    ImDrawListRetainedState_Off,                // Not started (or previous frame didn't finish properly)
+    ImDrawListRetainedState_Recording,          // Generating output and adding one entry per draw call
+    ImDrawListRetainedState_Replaying,          // Submitted draw calls match the journal: output buffers still hold previous frame data, only sizes are moved forward
+    ImDrawListRetainedState_Closed,             // Generating output, journal stopped for the rest of the frame (e.g. after ChannelsSplit() or an untracked buffer write)
+    ImDrawListRetainedState_Ended,              // Frame done (added to ImDrawData). Any further write invalidates the journal.
+};
+
+struct ImDrawListRetainedEntry
+{
+    ImU64           Hash;                       // Hash of all draw calls up to and including this one. Unused for the last entry, which only stores the state where the journal ended.
+    int             CmdCount;                   // Output state before this draw call
+    int             IdxCount;
+    int             VtxCount;
+    int             QuadCount;
+    int             CallbacksDataCount;
+    unsigned int    VtxCurrentIdx;
+    ImDrawCmd       LastCmd;                    // Copy of CmdBuffer.back(), still being appended to
+    ImDrawCmd       PrevCmd;                    // Copy of CmdBuffer[CmdBuffer.Size - 2], which may be appended to again if CmdBuffer.back() is empty and gets merged
+};
+
+struct ImDrawListRetainedData
+{
+    ImVector<ImDrawListRetainedEntry> Entries;  // One entry per draw call, + one entry for the state where the journal ended
+    ImDrawListRetainedState State;
+    int             Cursor;                     // Index of next draw call
+    ImU64           Hash;                       // Running hash (64-bit: a collision would silently display last frame output)
+    bool            InDrawCall;                 // Set while a draw call which wasn't skipped is writing to buffers
+    bool            EndedWithFrame;             // Last entry was recorded by _RetainedEndFrame() (as opposed to journal being closed earlier)
+    int             ReplayBackCmdIdx;           // While replaying: index of CmdBuffer.back() in last frame output
+    ImDrawCmd       ReplayBackCmd;              // While replaying: final value of CmdBuffer.back() in last frame output
+    int             DrawCalls;                  // [Stats] Draw calls submitted during current frame
+    int             DrawCallsReused;            // [Stats] Draw calls skipped during current frame
+    int             LastFrameDrawCalls;         // [Stats] Same for last finished frame
+    int             LastFrameDrawCallsReused;   // [Stats]
+
+    ImDrawListRetainedData()                    { memset(this, 0, sizeof(*this)); State = ImDrawListRetainedState_Off; ReplayBackCmdIdx = -1; }
+};
+
 struct ImDrawDataBuilder
 {
     ImVector<ImDrawList*>*  Layers[2];      // Pointers to global layers for: regular, tooltip. LayersP[0] is owned by DrawData.
@@ -1279,6 +1373,7 @@ enum ImGuiWindowRefreshFlags_
     ImGuiWindowRefreshFlags_TryToAvoidRefresh   = 1 << 0,   // [EXPERIMENTAL] Try to keep existing contents, USER MUST NOT HONOR BEGIN() RETURNING FALSE AND NOT APPEND.
     ImGuiWindowRefreshFlags_RefreshOnHover      = 1 << 1,   // [EXPERIMENTAL] Always refresh on hover
     ImGuiWindowRefreshFlags_RefreshOnFocus      = 1 << 2,   // [EXPERIMENTAL] Always refresh on focus
+    ImGuiWindowRefreshFlags_RetainDrawList      = 1 << 3,   // [EXPERIMENTAL] Keep submitting contents, but reuse previous frame vertices for the leading draw calls which are unchanged. Stops at the first ChannelsSplit() (e.g. tables, columns).
     // Refresh policy/frequency, Load Balancing etc.
 };
 
@@ -2175,6 +2270,7 @@ struct ImGuiContext
     float                   FontRasterizerDensity;              // Current font density. Used by all calls to GetFontBaked().
     float                   CurrentDpiScale;                    // Current window/viewport DpiScale == CurrentViewport->DpiScale
     ImDrawListSharedData    DrawListSharedData;
+    ImGuiTextSizeCache      TextSizeCache;                      // CalcTextSize() results, when io.ConfigTextSizeCache is enabled.
     double                  Time;
     int                     FrameCount;
     int                     FrameCountEnded;
@@ -2468,6 +2564,8 @@ struct ImGuiContext
     // Settings
     bool                    SettingsLoaded;
     float                   SettingsDirtyTimer;                 // Save .ini Settings to memory when time reaches zero
+    bool                    FontCacheLoaded;
+    float                   FontCacheDirtyTimer;                // Save io.Fonts glyph cache to disk when time reaches zero
     ImGuiTextBuffer         SettingsIniData;                    // In memory .ini settings
     ImVector<ImGuiSettingsHandler>      SettingsHandlers;       // List of .ini settings handlers
     ImChunkStream<ImGuiWindowSettings>  SettingsWindows;        // ImGuiWindow .ini settings entries
@@ -3722,6 +3820,19 @@ namespace ImGui
 // [SECTION] ImFontLoader
 //-----------------------------------------------------------------------------
 
+// Output of ImFontLoader::FontBakedRasterizeGlyph().
+// As this may run on worker threads, memory needs to be allocated with AllocFunc/FreeFunc, not IM_ALLOC()/IM_FREE() which update context debug data.
+struct ImFontGlyphBitmap
+{
+    ImGuiMemAllocFunc   AllocFunc;      // In   // Allocators set with ImGui::SetAllocatorFunctions()
+    ImGuiMemFreeFunc    FreeFunc;       // In
+    void*               AllocUserData;  // In
+    unsigned char*      Pixels;         // Out  // Allocated with AllocFunc, freed by caller. NULL if glyph has no visible pixels.
+    int                 Width, Height;  // Out
+    ImTextureFormat     Format;         // Out
+    IMGUI_API ImFontGlyphBitmap();
+};
+
 // Hooks and storage for a given font backend.
 // This structure is likely to evolve as we add support for incremental atlas updates.
 // Conceptually this could be public, but API is still going to be evolve.
@@ -3737,6 +3848,10 @@ struct ImFontLoader
     void            (*FontBakedDestroy)(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loader_data_for_baked_src);
     bool            (*FontBakedLoadGlyph)(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loader_data_for_baked_src, ImWchar codepoint, ImFontGlyph* out_glyph, float* out_advance_x);
 
+    // Optional: rasterize a glyph into 'out_bitmap' without packing it or touching the atlas, so batches of glyphs may be rasterized in parallel (see ImFontBaked::LoadGlyphs()).
+    // May be called from any thread, concurrently for a same source. Output glyph X0/Y0/X1/Y1 match bitmap size. Loaders without it have glyphs of batches loaded one by one on the calling thread.
+    bool            (*FontBakedRasterizeGlyph)(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loader_data_for_baked_src, ImWchar codepoint, ImFontGlyph* out_glyph, ImFontGlyphBitmap* out_bitmap);
+
     // Size of backend data, Per Baked * Per Source. Buffers are managed by core to avoid excessive allocations.
     // FIXME: At this point the two other types of buffers may be managed by core to be consistent?
     size_t          FontBakedSrcLoaderDataSize;
@@ -3781,6 +3896,7 @@ struct ImFontAtlasRectEntry
     int                 TargetIndex : 20;   // When Used: ImFontAtlasRectId -> into Rects[]. When unused: index to next unused RectsIndex[] slot to consume free-list.
     unsigned int        Generation : 10;    // Increased each time the entry is reused for a new rectangle.
     unsigned int        IsUsed : 1;
+    unsigned int        IsCustom : 1;       // Added by AddCustomRect()/AddCustomRectFontGlyph(): identifier is held by user code, never evicted.
 };
 
 // Data available to potential texture post-processing functions
@@ -3800,29 +3916,118 @@ struct ImFontAtlasPostProcessData
     int                 Height;
 };
 
-// We avoid dragging imstb_rectpack.h into public header (partly because binding generators are having issues with it)
-#ifdef IMGUI_STB_NAMESPACE
-namespace IMGUI_STB_NAMESPACE { struct stbrp_node; }
-typedef IMGUI_STB_NAMESPACE::stbrp_node stbrp_node_im;
-#else
-struct stbrp_node;
-typedef stbrp_node stbrp_node_im;
-#endif
-struct stbrp_context_opaque { char data[80]; };
+// Shelf packer used by ImFontAtlasPackAddRect()
+// - Rectangles are packed left to right in horizontal shelves spanning the texture width, stacked from the top of the texture.
+//   Glyphs of a baked font have similar heights, so a shelf holds many of them with little waste.
+// - Space of discarded rectangles is kept as free slots and reused by new rectangles fitting in them. An empty shelf may be reused for any height.
+// - ImFontAtlasPackDefragStep() moves glyphs out of sparsely used shelves a few at a time, so that the texture rarely needs to grow or be repacked.
+#define IM_FONTATLAS_PACK_SHELF_SLACK(h)        ((h) / 2 + 2)   // Extra height tolerated when picking a shelf for a rectangle of height 'h'
+#define IM_FONTATLAS_DEFRAG_SURFACE_PER_FRAME   (128 * 128)     // Max surface moved by ImFontAtlasPackDefragStep() in a frame
+struct ImFontAtlasPackShelf
+{
+    int                 Y, H;           // Position and height, padding included
+    int                 X;              // Rectangles are packed up to this position, the rest of the shelf is free
+    int                 XDirty;         // Pixels on the left of this position may have been used since the texture was created
+    int                 UsedSurface;    // Surface of rectangles in the shelf, padding included
+};
+
+struct ImFontAtlasPackSlot
+{
+    int                 ShelfIdx;
+    int                 X, W;           // Free span left by discarded rectangles, on the left of the shelf's X
+};
+
+// Distance field atlases (ImFontAtlasFlags_DistanceField): glyphs are baked once at the font reference size.
+// The field covers SPREAD pixels on each side of glyph edges, which is also the padding added around each glyph.
+#define IM_FONTATLAS_DISTANCE_FIELD_SPREAD          4
+#define IM_FONTATLAS_DISTANCE_FIELD_DEFAULT_SIZE    32.0f   // Reference size for fonts added without a size
+
+// Line breaks of a word-wrapped text measured by ImFontCalcTextSizeEx(), reused by ImFont::RenderText() when the same text
+// is rendered with the same font, size and wrap width during the same frame (e.g. ImGui::TextWrapped() measures then renders).
+#define IM_FONTATLAS_WRAP_LINES_CACHE_SIZE  8
+struct ImFontWrapLinesEntry
+{
+    ImFontBaked*        Baked;          // NULL when unused
+    float               Size;
+    float               WrapWidth;
+    ImDrawTextFlags     Flags;          // Only ImDrawTextFlags_WrapKeepBlanks
+    int                 FrameCount;
+    ImVector<char>      Text;           // Copy of the text, compared on lookup
+    ImVector<int>       LineEnds;       // Offset of the end of each line from the start of the text (before the blanks skipped by ImTextCalcWordWrapNextLineStart())
+};
+
+// Persistent glyph cache (see io.FontCacheFilename)
+// Holds glyphs output by font loaders (metrics + post-processed pixels), so a later session can pack them again without rasterizing.
+// Entries are keyed by font data and every setting affecting the loader output, they are dropped after not being used for a few sessions.
+#define IM_FONTATLAS_GLYPH_CACHE_MAX_UNUSED_SESSIONS    8
+struct ImFontAtlasGlyphCacheEntry
+{
+    ImGuiID     SrcKey;             // Hash of font data, loader and source settings
+    float       Size;               // Baked size
+    float       RasterizerDensity;  // Baked density
+    ImU32       Codepoint;          // Codepoint passed to the loader (after remapping)
+    float       AdvanceX;           // Metrics as output by the loader (before ImFontAtlasBakedAddFontGlyph() adjustments)
+    float       X0, Y0, X1, Y1;
+    ImU16       Width, Height;      // Size of stored pixels, 0 when the glyph is not visible
+    ImU8        Format;             // ImTextureFormat of stored pixels
+    ImU8        Colored;
+    ImU8        UnusedSessions;     // Number of sessions since this entry was last used
+    ImU8        _Padding;
+    ImU32       PixelsOffset;       // Offset into ImFontAtlasGlyphCache::Pixels[]
+};
+
+struct ImFontAtlasGlyphCache
+{
+    ImVector<ImFontAtlasGlyphCacheEntry> Entries;
+    ImVector<unsigned char>     Pixels;
+    ImGuiStorage                Map;                // Entry key --> index into Entries[] + 1
+    bool                        Dirty;              // Entries were added or used since loading/saving
+    int                         HitsCount;          // Glyphs loaded from the cache (this session)
+    int                         MissesCount;        // Glyphs loaded by the font loader and added to the cache (this session)
+
+    ImFontAtlasGlyphCache()     { Dirty = false; HitsCount = MissesCount = 0; }
+};
+
+// Glyph loaded by ImFontAtlasBakedLoadGlyphs(): rasterized by any thread, then packed by the calling thread
+#define IM_FONTBAKED_LOAD_GLYPHS_FROM_TEXT_MAX  256     // Max glyphs collected at once from a text by text functions
+struct ImFontAtlasGlyphJob
+{
+    ImWchar             SrcCodepoint;   // Requested codepoint
+    ImWchar             Codepoint;      // Codepoint passed to the loader (after remapping)
+    bool                WantRasterize;  // false when the glyph needs to be loaded by the regular path (e.g. glyph cache, ellipsis)
+    int                 SourceIdx;      // Source which rasterized the glyph, -1 if none did
+    ImFontGlyph         Glyph;
+    ImFontGlyphBitmap   Bitmap;
+};
+
+// Glyph eviction (see ImFontAtlas::TexMemoryBudget)
+#define IM_FONTATLAS_EVICT_UNUSED_FRAMES        2               // Glyphs rendered during the last frames are never evicted
+#define IM_FONTATLAS_EVICT_SURFACE_DIVISOR      8               // Evict at least 1/8 of the texture surface at once, so that eviction stays rare
+#define IM_FONTATLAS_SHRINK_UNUSED_FRAMES       60              // Shrinking back within budget only evicts glyphs not rendered for a second, so it doesn't fight a working set larger than budget
 
 // Internal storage for incrementally packing and building a ImFontAtlas
 struct ImFontAtlasBuilder
 {
-    stbrp_context_opaque        PackContext;            // Actually 'stbrp_context' but we don't want to define this in the header file.
-    ImVector<stbrp_node_im>     PackNodes;
+    ImVector<ImFontAtlasPackShelf> PackShelves;         // Sorted by Y, without gaps
+    ImVector<ImFontAtlasPackSlot> PackFreeSlots;        // Space of discarded rectangles which can be reused
+    int                         PackShelvesHeight;      // Bottom of last shelf. New shelves are added there.
+    int                         PackDirtyHeight;        // Pixels above this position may have been used since the texture was created
+    int                         PackDefragShelfIdx;     // Shelf being emptied by ImFontAtlasPackDefragStep(), -1 if none
+    int                         PackDefragFailedSurface;// Value of RectsDiscardedSurface when ImFontAtlasPackDefragStep() last failed to empty a shelf
     ImVector<ImTextureRect>     Rects;
     ImVector<ImFontAtlasRectEntry> RectsIndex;          // ImFontAtlasRectId -> index into Rects[]
     ImVector<unsigned char>     TempBuffer;             // Misc scratch buffer
     int                         RectsIndexFreeListStart;// First unused entry
+    int                         RectsUnusedCount;       // Number of entries of discarded rectangles in Rects[], garbage collected by ImFontAtlasPackAddRect().
     int                         RectsPackedCount;       // Number of packed rectangles.
     int                         RectsPackedSurface;     // Number of packed pixels. Used when compacting to heuristically find the ideal texture size.
-    int                         RectsDiscardedCount;
-    int                         RectsDiscardedSurface;
+    int                         RectsDiscardedCount;    // Number of free slots.
+    int                         RectsDiscardedSurface;  // Number of pixels in free slots: space left by discarded rectangles, only reusable by rectangles fitting in it.
+    int                         RectsMovedCount;        // Number of rectangles moved by ImFontAtlasPackDefragStep().
+    int                         GlyphsEvictedCount;     // Number of glyphs evicted by ImFontAtlasBuildEvictGlyphs().
+    int                         GlyphsUvGenerationNext; // Source of ImFontBaked::GlyphsUvGeneration values
+    int                         GlyphsReloadedCount;    // Number of evicted glyphs loaded again.
+    int                         TexShrinkFailedFrame;   // Value of FrameCount when ImFontAtlasTextureShrinkToBudget() last failed to evict enough glyphs
     int                         FrameCount;             // Current frame count
     ImVec2i                     MaxRectSize;            // Largest rectangle to pack (de-facto used as a "minimum texture size")
     ImVec2i                     MaxRectBounds;          // Bottom-right most used pixels
@@ -3838,7 +4043,17 @@ struct ImFontAtlasBuilder
     ImFontAtlasRectId           PackIdMouseCursors;     // White pixel + mouse cursors. Also happen to be fallback in case of packing failure.
     ImFontAtlasRectId           PackIdLinesTexData;
 
-    ImFontAtlasBuilder()        { memset(this, 0, sizeof(*this)); FrameCount = -1; RectsIndexFreeListStart = -1; PackIdMouseCursors = PackIdLinesTexData = -1; }
+    // Batch glyph loading
+    ImVector<ImFontAtlasGlyphJob> GlyphJobs;
+    ImVector<ImWchar>           GlyphJobsCodepoints;    // Codepoints collected from a text
+    ImBitVector                 GlyphJobsCodepointsMask;// Same as a bit mask, to skip duplicates. Cleared after use.
+
+    // Line breaks of recently measured word-wrapped texts
+    ImFontWrapLinesEntry        WrapLines[IM_FONTATLAS_WRAP_LINES_CACHE_SIZE];
+    int                         WrapLinesNext;          // Next entry to overwrite
+    ImVector<int>               WrapLinesTemp;          // Line ends recorded while measuring
+
+    ImFontAtlasBuilder()        { memset(this, 0, sizeof(*this)); FrameCount = -1; RectsIndexFreeListStart = -1; PackDefragShelfIdx = -1; PackIdMouseCursors = PackIdLinesTexData = -1; }
 };
 
 IMGUI_API void              ImFontAtlasBuildInit(ImFontAtlas* atlas);
@@ -3850,16 +4065,18 @@ IMGUI_API void              ImFontAtlasBuildRenderBitmapFromString(ImFontAtlas*
 IMGUI_API void              ImFontAtlasBuildClear(ImFontAtlas* atlas); // Clear output and custom rects
 
 IMGUI_API ImTextureData*    ImFontAtlasTextureAdd(ImFontAtlas* atlas, int w, int h);
-IMGUI_API void              ImFontAtlasTextureMakeSpace(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasTextureMakeSpace(ImFontAtlas* atlas, bool allow_evict = true);
 IMGUI_API void              ImFontAtlasTextureRepack(ImFontAtlas* atlas, int w, int h);
 IMGUI_API void              ImFontAtlasTextureGrow(ImFontAtlas* atlas, int old_w = -1, int old_h = -1);
 IMGUI_API void              ImFontAtlasTextureCompact(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasTextureShrinkToBudget(ImFontAtlas* atlas);
 IMGUI_API ImVec2i           ImFontAtlasTextureGetSizeEstimate(ImFontAtlas* atlas);
 
 IMGUI_API void              ImFontAtlasBuildSetupFontSpecialGlyphs(ImFontAtlas* atlas, ImFont* font, ImFontConfig* src);
 IMGUI_API void              ImFontAtlasBuildLegacyPreloadAllGlyphRanges(ImFontAtlas* atlas); // Legacy
 IMGUI_API void              ImFontAtlasBuildGetOversampleFactors(ImFontConfig* src, ImFontBaked* baked, int* out_oversample_h, int* out_oversample_v);
 IMGUI_API void              ImFontAtlasBuildDiscardBakes(ImFontAtlas* atlas, int unused_frames);
+IMGUI_API int               ImFontAtlasBuildEvictGlyphs(ImFontAtlas* atlas, int min_surface, int max_surface, int unused_frames); // Evict least recently used glyphs until 'max_surface' pixels are freed, or none if less than 'min_surface' can be. Return freed surface.
 
 IMGUI_API bool              ImFontAtlasFontSourceInit(ImFontAtlas* atlas, ImFontConfig* src);
 IMGUI_API void              ImFontAtlasFontSourceAddToFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* src);
@@ -3876,13 +4093,22 @@ IMGUI_API void              ImFontAtlasBakedDiscard(ImFontAtlas* atlas, ImFont*
 IMGUI_API ImFontGlyph*      ImFontAtlasBakedAddFontGlyph(ImFontAtlas* atlas, ImFontBaked* baked, ImFontConfig* src, const ImFontGlyph* in_glyph);
 IMGUI_API void              ImFontAtlasBakedAddFontGlyphAdvancedX(ImFontAtlas* atlas, ImFontBaked* baked, ImFontConfig* src, ImWchar codepoint, float advance_x);
 IMGUI_API void              ImFontAtlasBakedDiscardFontGlyph(ImFontAtlas* atlas, ImFont* font, ImFontBaked* baked, ImFontGlyph* glyph);
+IMGUI_API void              ImFontAtlasBakedLoadGlyphs(ImFontAtlas* atlas, ImFontBaked* baked, const ImWchar* codepoints, int codepoints_count);
+IMGUI_API void              ImFontAtlasBakedMarkGlyphsUsed(ImFontBaked* baked, const char* text, const char* text_end);
 IMGUI_API void              ImFontAtlasBakedSetFontGlyphBitmap(ImFontAtlas* atlas, ImFontBaked* baked, ImFontConfig* src, ImFontGlyph* glyph, ImTextureRect* r, const unsigned char* src_pixels, ImTextureFormat src_fmt, int src_pitch);
 
+IMGUI_API bool              ImFontAtlasGlyphCacheLoadFromDisk(ImFontAtlas* atlas, const char* filename); // Enable glyph cache, with entries from a previous session if the file is valid
+IMGUI_API bool              ImFontAtlasGlyphCacheSaveToDisk(ImFontAtlas* atlas, const char* filename);
+IMGUI_API void              ImFontAtlasGlyphCacheDestroy(ImFontAtlas* atlas);
+IMGUI_API bool              ImFontAtlasGlyphCacheLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, ImWchar codepoint, ImFontGlyph* out_glyph, float* out_advance_x); // Same contract as ImFontLoader::FontBakedLoadGlyph()
+IMGUI_API void              ImFontAtlasGlyphCacheAddGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, ImWchar codepoint, const ImFontGlyph* glyph);
+
 IMGUI_API void              ImFontAtlasPackInit(ImFontAtlas* atlas);
 IMGUI_API ImFontAtlasRectId ImFontAtlasPackAddRect(ImFontAtlas* atlas, int w, int h, ImFontAtlasRectEntry* overwrite_entry = NULL);
 IMGUI_API ImTextureRect*    ImFontAtlasPackGetRect(ImFontAtlas* atlas, ImFontAtlasRectId id);
 IMGUI_API ImTextureRect*    ImFontAtlasPackGetRectSafe(ImFontAtlas* atlas, ImFontAtlasRectId id);
 IMGUI_API void              ImFontAtlasPackDiscardRect(ImFontAtlas* atlas, ImFontAtlasRectId id);
+IMGUI_API void              ImFontAtlasPackDefragStep(ImFontAtlas* atlas);
 
 IMGUI_API void              ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool renderer_has_textures);
 IMGUI_API void              ImFontAtlasAddDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* data);
@@ -3439,9 +3439,12 @@ void ImGui::TableAngledHeadersRowEx(ImGuiID row_id, float angle, float max_label
                     float clip_height = ImMin(label_size.y, column->ClipRect.Max.x - column->WorkMinX - line_off_curr_x);
                     ImRect clip_r(window->ClipRect.Min, window->ClipRect.Min + ImVec2(clip_width, clip_height));
                     int vtx_idx_begin = draw_list->_VtxCurrentIdx;
+                    ImDrawListFlags backup_flags = draw_list->Flags;
+                    draw_list->Flags &= ~ImDrawListFlags_InstancedQuads; // We need vertices to rotate them
                     PushStyleColor(ImGuiCol_Text, request->TextColor);
                     RenderTextEllipsis(draw_list, clip_r.Min, clip_r.Max, clip_r.Max.x, label_name, label_name_eol, &label_size);
                     PopStyleColor();
+                    draw_list->Flags = backup_flags;
                     int vtx_idx_end = draw_list->_VtxCurrentIdx;
 
                     // Up<>Down alignment
@@ -0,0 +1,551 @@
+// dear imgui
+// (imgui_bench_draw.cpp)
+// Command-line microbenchmarks for ImDrawList geometry generation.
+// No renderer is involved: each case fills a draw list in a loop and reports how many items per second it outputs.
+
+// Build, e.g: (see README.md)
+//   # g++ -O2 -I../.. imgui_bench_draw.cpp ../../imgui*.cpp -o imgui_bench_draw
+// Compare SIMD and scalar code paths by building a second time with -DIMGUI_DISABLE_SSE (x86) or -DIMGUI_DISABLE_NEON (ARM).
+
+// Usage:
+//   imgui_bench_draw [filter] [seconds_per_case]
+//   e.g. "imgui_bench_draw text" to only run cases whose name contains "text".
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#if defined(IMGUI_ENABLE_SSE)
+#define SIMD_NAME "sse"
+#elif defined(IMGUI_ENABLE_NEON)
+#define SIMD_NAME "neon"
+#else
+#define SIMD_NAME "scalar"
+#endif
+
+//-----------------------------------------------------------------------------
+// Helpers
+//-----------------------------------------------------------------------------
+
+static ImDrawList* g_DrawList = NULL;
+static ImFont*     g_Font = NULL;
+static float       g_FontSize = 16.0f;
+static ImVector<ImVec2> g_Points;
+static ImVector<ImVec2> g_ShapePoints;          // Concave shapes other than the star
+static int         g_ShapeParam = -1;
+static ImVector<char> g_LargeText;
+static float       g_LargeTextWidth = 0.0f;
+static ImVector<char> g_Labels;                 // Zero-separated
+static ImVector<int> g_LabelsOffsets;
+static ImVector<char> g_Utf8Text[2];            // English, mixed-script
+static ImVector<ImWchar> g_Utf8TextW[2];
+static ImVector<char> g_Utf8Out;
+static const char  g_Paragraph[] =
+    "The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs! 0123456789\n"
+    "Sphinx of black quartz, judge my vow: (a + b) * c = d / e; [x, y] {z} <w> 'q' \"r\" #s %t &u |v\n";
+static const char  g_ParagraphMixed[] =     // UTF-8: Latin-1, Greek, Cyrillic, CJK (the latter three use the fallback glyph of the default font)
+    "Gr\xC3\xB6\xC3\x9F" "e und \xC3\x9C" "bergr\xC3\xB6\xC3\x9F" "e: caf\xC3\xA9, na\xC3\xAFve, fa\xC3\xA7" "ade. 0123456789 (a + b) * c = d / e;\n"
+    "\xCE\x95\xCE\xBB\xCE\xBB\xCE\xB7\xCE\xBD\xCE\xB9\xCE\xBA\xCE\xAC \xD0\xA0\xD1\x83\xD1\x81\xD1\x81\xD0\xBA\xD0\xB8\xD0\xB9 \xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE6\x96\x87 The quick brown fox jumps over the lazy dog.\n";
+
+// Start a new frame for the draw list. 'quads' selects ImDrawListFlags_InstancedQuads.
+static void ResetDrawList(bool quads, ImDrawListFlags remove_flags = 0)
+{
+    g_DrawList->_ResetForNewFrame();
+    if (quads)
+        g_DrawList->Flags |= ImDrawListFlags_InstancedQuads;
+    g_DrawList->Flags &= ~remove_flags;
+    g_DrawList->PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(100000.0f, 100000.0f));
+    g_DrawList->PushTexture(ImGui::GetIO().Fonts->TexRef);
+}
+
+//-----------------------------------------------------------------------------
+// Cases. Each function outputs a batch and returns the number of items it produced.
+//-----------------------------------------------------------------------------
+
+static int BenchPrimRectUV(int quads)
+{
+    const int count = 10000;
+    ResetDrawList(quads);
+    if (quads)
+    {
+        g_DrawList->PrimReserveQuads(count);
+        for (int n = 0; n < count; n++)
+            g_DrawList->PrimWriteQuad(ImVec2((float)(n & 255), (float)(n >> 8)), ImVec2((float)(n & 255) + 8.0f, (float)(n >> 8) + 12.0f), ImVec2(0.0f, 0.0f), ImVec2(0.5f, 0.5f), IM_COL32_WHITE);
+    }
+    else
+    {
+        g_DrawList->PrimReserve(count * 6, count * 4);
+        for (int n = 0; n < count; n++)
+            g_DrawList->PrimRectUV(ImVec2((float)(n & 255), (float)(n >> 8)), ImVec2((float)(n & 255) + 8.0f, (float)(n >> 8) + 12.0f), ImVec2(0.0f, 0.0f), ImVec2(0.5f, 0.5f), IM_COL32_WHITE);
+    }
+    return count;
+}
+
+static int BenchAddRectFilled(int quads)
+{
+    const int count = 10000;
+    ResetDrawList(quads);
+    for (int n = 0; n < count; n++)
+        g_DrawList->AddRectFilled(ImVec2((float)(n & 255), (float)(n >> 8)), ImVec2((float)(n & 255) + 8.0f, (float)(n >> 8) + 12.0f), IM_COL32(n, 255, 255, 255));
+    return count;
+}
+
+static int BenchAddText(int quads)
+{
+    // Return number of glyphs (visible or not)
+    const int lines = 100;
+    ResetDrawList(quads);
+    for (int n = 0; n < lines; n++)
+        g_DrawList->AddText(g_Font, g_FontSize, ImVec2(0.0f, n * g_FontSize * 2.0f), IM_COL32_WHITE, g_Paragraph);
+    return lines * (int)(sizeof(g_Paragraph) - 1);
+}
+
+static int BenchAddTextMixed(int quads)
+{
+    // Return number of bytes
+    const int lines = 100;
+    ResetDrawList(quads);
+    for (int n = 0; n < lines; n++)
+        g_DrawList->AddText(g_Font, g_FontSize, ImVec2(0.0f, n * g_FontSize * 2.0f), IM_COL32_WHITE, g_ParagraphMixed);
+    return lines * (int)(sizeof(g_ParagraphMixed) - 1);
+}
+
+// Word-wrapped text. With 'measure', each paragraph is measured before being rendered, as ImGui::TextWrapped() does.
+static int BenchTextWrapped(int measure)
+{
+    // Use different wrap widths so that rendering alone doesn't find line breaks recorded by the other case
+    const int paragraphs = 20;
+    const float wrap_width = measure ? 300.0f : 301.0f;
+    ResetDrawList(false);
+    for (int n = 0; n < paragraphs; n++)
+    {
+        if (measure)
+            g_Font->CalcTextSizeA(g_FontSize, FLT_MAX, wrap_width, g_Paragraph);
+        g_DrawList->AddText(g_Font, g_FontSize, ImVec2(0.0f, n * g_FontSize * 10.0f), IM_COL32_WHITE, g_Paragraph, NULL, wrap_width);
+    }
+    return paragraphs * (int)(sizeof(g_Paragraph) - 1);
+}
+
+// One megabyte of text without newlines (e.g. a pasted command output) in a 1280x720 clip rectangle.
+// Unwrapped, it is scrolled horizontally to its middle. Word-wrapped, its beginning is visible.
+static int BenchTextLarge(int wrapped)
+{
+    if (g_LargeText.Size == 0)
+    {
+        const int paragraph_len = (int)(sizeof(g_Paragraph) - 1);
+        g_LargeText.resize(1024 * 1024);
+        for (int n = 0; n < g_LargeText.Size; n++)
+            g_LargeText[n] = (g_Paragraph[n % paragraph_len] == '\n') ? ' ' : g_Paragraph[n % paragraph_len];
+        g_LargeTextWidth = g_Font->CalcTextSizeA(g_FontSize, FLT_MAX, 0.0f, g_LargeText.begin(), g_LargeText.end()).x;
+    }
+    ResetDrawList(false);
+    g_DrawList->PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(1280.0f, 720.0f));
+    const char* text_begin = g_LargeText.Data;
+    const char* text_end = g_LargeText.Data + g_LargeText.Size;
+    if (wrapped)
+        g_DrawList->AddText(g_Font, g_FontSize, ImVec2(0.0f, 0.0f), IM_COL32_WHITE, text_begin, text_end, 1280.0f);
+    else
+        g_DrawList->AddText(g_Font, g_FontSize, ImVec2(-g_LargeTextWidth * 0.5f, 0.0f), IM_COL32_WHITE, text_begin, text_end);
+    g_DrawList->PopClipRect();
+    return g_LargeText.Size;
+}
+
+// Measure paragraphs, unwrapped or word-wrapped. Param: bit 0 = wrapped, bit 1 = mixed-script text (otherwise English).
+static int BenchCalcText(int param)
+{
+    const int paragraphs = 20;
+    const char* text = (param & 2) ? g_ParagraphMixed : g_Paragraph;
+    const int text_len = (param & 2) ? (int)(sizeof(g_ParagraphMixed) - 1) : (int)(sizeof(g_Paragraph) - 1);
+    const float wrap_width = (param & 1) ? 300.0f : 0.0f;
+    for (int n = 0; n < paragraphs; n++)
+        g_Font->CalcTextSizeA(g_FontSize, FLT_MAX, wrap_width, text, text + text_len);
+    return paragraphs * text_len;
+}
+
+// ImGui::CalcTextSize() on widget labels, as submitted every frame, with 'cached' selecting io.ConfigTextSizeCache.
+static int BenchCalcLabels(int cached)
+{
+    if (g_Labels.Size == 0)
+    {
+        const char* fmts[] = { "Item %d", "Enable option %d##opt", "Button %d", "%d: The quick brown fox jumps", "Settings###%d" };
+        for (int n = 0; n < 1000; n++)
+        {
+            char buf[64];
+            const int len = snprintf(buf, sizeof(buf), fmts[n % IM_ARRAYSIZE(fmts)], n);
+            g_LabelsOffsets.push_back(g_Labels.Size);
+            g_Labels.resize(g_Labels.Size + len + 1);
+            memcpy(g_Labels.Data + g_LabelsOffsets.back(), buf, (size_t)len + 1);
+        }
+    }
+    ImGuiIO& io = ImGui::GetIO();
+    io.ConfigTextSizeCache = (cached != 0);
+    for (int offset : g_LabelsOffsets)
+        ImGui::CalcTextSize(g_Labels.Data + offset, NULL, true);
+    io.ConfigTextSizeCache = false;
+    return g_LabelsOffsets.Size;
+}
+
+// ImGui::CalcTextSize() on word-wrapped paragraphs, as ImGui::TextWrapped() does, with 'cached' selecting io.ConfigTextSizeCache.
+static int BenchCalcWrapped(int cached)
+{
+    const int paragraphs = 20;
+    ImGuiIO& io = ImGui::GetIO();
+    io.ConfigTextSizeCache = (cached != 0);
+    for (int n = 0; n < paragraphs; n++)
+        ImGui::CalcTextSize(g_Paragraph, NULL, false, 300.0f + n);
+    io.ConfigTextSizeCache = false;
+    return paragraphs * (int)(sizeof(g_Paragraph) - 1);
+}
+
+// UTF-8 conversion of one megabyte of text (e.g. a large paste). Param: bit 0 = mixed-script text (otherwise English), bits 1-2 = operation.
+enum { BenchUtf8_Decode = 0 << 1, BenchUtf8_Count = 1 << 1, BenchUtf8_Encode = 2 << 1, BenchUtf8_CountBytes = 3 << 1 };
+static int BenchUtf8(int param)
+{
+    const int text_idx = param & 1;
+    ImVector<char>& text = g_Utf8Text[text_idx];
+    ImVector<ImWchar>& text_w = g_Utf8TextW[text_idx];
+    if (text.Size == 0)
+    {
+        const char* paragraph = text_idx ? g_ParagraphMixed : g_Paragraph;
+        const int paragraph_len = text_idx ? (int)(sizeof(g_ParagraphMixed) - 1) : (int)(sizeof(g_Paragraph) - 1);
+        text.resize(1024 * 1024 / paragraph_len * paragraph_len + 1);
+        for (int n = 0; n < text.Size - 1; n += paragraph_len)
+            memcpy(text.Data + n, paragraph, (size_t)paragraph_len);
+        text.back() = 0;
+        text_w.resize(text.Size);
+        text_w.resize(ImTextStrFromUtf8(text_w.Data, text_w.Size, text.Data, text.Data + text.Size - 1) + 1);
+        g_Utf8Out.resize(text.Size);
+    }
+    switch (param & ~1)
+    {
+    case BenchUtf8_Decode:      ImTextStrFromUtf8(text_w.Data, text_w.Size, text.Data, text.Data + text.Size - 1); break;
+    case BenchUtf8_Count:       ImTextCountCharsFromUtf8(text.Data, text.Data + text.Size - 1); break;
+    case BenchUtf8_Encode:      ImTextStrToUtf8(g_Utf8Out.Data, g_Utf8Out.Size, text_w.Data, text_w.Data + text_w.Size - 1); break;
+    case BenchUtf8_CountBytes:  ImTextCountUtf8BytesFromStr(text_w.Data, text_w.Data + text_w.Size - 1); break;
+    }
+    return text.Size - 1;
+}
+
+// A plot-like path: 'points_count' points over a 1000 pixels wide graph
+static const ImVec2* GetWavePoints(int points_count)
+{
+    if (g_Points.Size != points_count)
+    {
+        g_Points.resize(points_count);
+        for (int n = 0; n < points_count; n++)
+            g_Points[n] = ImVec2(10.0f + n * 1000.0f / points_count, 300.0f + 200.0f * ImSin(n * 0.05f) + 20.0f * ImSin(n * 0.31f));
+    }
+    return g_Points.Data;
+}
+
+// A circle, which is convex with clockwise winding in screen space
+static const ImVec2* GetCirclePoints(int points_count)
+{
+    if (g_Points.Size != points_count)
+    {
+        g_Points.resize(points_count);
+        for (int n = 0; n < points_count; n++)
+            g_Points[n] = ImVec2(500.0f + 400.0f * ImCos(n * IM_PI * 2.0f / points_count), 500.0f + 400.0f * ImSin(n * IM_PI * 2.0f / points_count));
+    }
+    return g_Points.Data;
+}
+
+// A star with 'points_count / 2' spikes and randomized radii: concave, clockwise winding in screen space
+static const ImVec2* GetStarPoints(int points_count)
+{
+    if (g_Points.Size != points_count)
+    {
+        g_Points.resize(points_count);
+        unsigned int seed = 0x12345678;
+        for (int n = 0; n < points_count; n++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            const float r = (n & 1) ? 100.0f + (seed >> 24) : 400.0f + (seed >> 25);
+            g_Points[n] = ImVec2(500.0f + r * ImCos(n * IM_PI * 2.0f / points_count), 500.0f + r * ImSin(n * IM_PI * 2.0f / points_count));
+        }
+    }
+    return g_Points.Data;
+}
+
+// Adversarial inputs for the triangulator. Param: bits 0-23 = points count, bits 24+ = shape.
+// - Comb: rectangular teeth above and below a band, i.e. many split and merge vertices, and long runs of vertices at the same Y.
+// - Sawtooth: teeth of random height with vertical sides, above and below a band.
+// - Spiral: a thick arm winding 4 turns: pieces are long and nested.
+// - Collinear: a staircase whose sides are subdivided into collinear points.
+enum { BenchShape_Star = 0 << 24, BenchShape_Comb = 1 << 24, BenchShape_Sawtooth = 2 << 24, BenchShape_Spiral = 3 << 24, BenchShape_Collinear = 4 << 24, BenchShape_Mask_ = 0xFF << 24 };
+
+// Add 'count' points on the segment from 'a' (included) to 'b' (excluded)
+static void AddSegmentPoints(ImVector<ImVec2>& points, const ImVec2& a, const ImVec2& b, int count)
+{
+    for (int n = 0; n < count; n++)
+        points.push_back(ImLerp(a, b, (float)n / count));
+}
+
+static const ImVec2* GetConcavePoints(int param)
+{
+    const int points_count = param & ~BenchShape_Mask_;
+    const int shape = param & BenchShape_Mask_;
+    if (shape == BenchShape_Star)
+        return GetStarPoints(points_count);
+    if (g_ShapeParam == param)
+        return g_ShapePoints.Data;
+
+    ImVector<ImVec2>& points = g_ShapePoints;
+    points.resize(0);
+    unsigned int seed = 0x12345678;
+    if (shape == BenchShape_Comb || shape == BenchShape_Sawtooth)
+    {
+        // Top side from left to right, bottom side from right to left, then left side gets the points which don't make a whole tooth
+        const bool comb = (shape == BenchShape_Comb);
+        const int teeth = (points_count - 4) / (comb ? 8 : 4);
+        const float w = 1000.0f / teeth;
+        for (int side = 0; side < 2; side++)
+        {
+            const float band_y = side ? 600.0f : 400.0f;
+            const float dir = side ? 1.0f : -1.0f;
+            points.push_back(ImVec2(side ? 1000.0f : 0.0f, band_y));
+            for (int k = 0; k < teeth; k++)
+            {
+                const float x0 = side ? 1000.0f - k * w : k * w;
+                const float x1 = side ? x0 - w : x0 + w;
+                seed = seed * 1664525u + 1013904223u;
+                if (comb)
+                {
+                    points.push_back(ImVec2(ImLerp(x0, x1, 0.25f), band_y));
+                    points.push_back(ImVec2(ImLerp(x0, x1, 0.25f), band_y + dir * 200.0f));
+                    points.push_back(ImVec2(ImLerp(x0, x1, 0.75f), band_y + dir * 200.0f));
+                    points.push_back(ImVec2(ImLerp(x0, x1, 0.75f), band_y));
+                }
+                else
+                {
+                    points.push_back(ImVec2(x1, band_y + dir * (20.0f + (seed >> 24) * 1.5f)));
+                    if (side == 0 || k + 1 < teeth)
+                        points.push_back(ImVec2(x1, band_y));
+                }
+            }
+            if (comb && side == 0)
+                points.push_back(ImVec2(1000.0f, band_y));
+        }
+        AddSegmentPoints(points, ImVec2(0.0f, 600.0f), ImVec2(0.0f, 400.0f), points_count - points.Size);
+    }
+    else if (shape == BenchShape_Spiral)
+    {
+        // Outer edge of the arm outward, then inner edge back toward the center
+        const int outer_count = points_count / 2;
+        const float turns = 4.0f;
+        for (int n = 0; n < points_count; n++)
+        {
+            const bool outer = n < outer_count;
+            const float t = outer ? (float)n / (outer_count - 1) : 1.0f - (float)(n - outer_count) / (points_count - outer_count - 1);
+            const float a = t * turns * IM_PI * 2.0f;
+            const float r = 60.0f + t * turns * 90.0f - (outer ? 0.0f : 45.0f);
+            points.push_back(ImVec2(500.0f + r * ImCos(a), 500.0f + r * ImSin(a)));
+        }
+    }
+    else if (shape == BenchShape_Collinear)
+    {
+        // 8 steps from top-right to bottom-left, every side subdivided evenly. Starts from a reflex corner halfway down the steps,
+        // so that the polygon is not star-shaped from its first point (a triangle fan from it doesn't work).
+        const int steps = 8;
+        ImVec2 corners[2 + steps * 2];
+        int corners_count = 0;
+        corners[corners_count++] = ImVec2(100.0f, 100.0f);
+        corners[corners_count++] = ImVec2(900.0f, 100.0f);
+        for (int k = 0; k < steps; k++)
+        {
+            corners[corners_count++] = ImVec2(900.0f - k * 100.0f, 200.0f + k * 100.0f);
+            corners[corners_count++] = ImVec2(800.0f - k * 100.0f, 200.0f + k * 100.0f);
+        }
+        for (int n = 0; n < corners_count; n++)
+        {
+            const int corner = (n + steps + 1) % corners_count;
+            AddSegmentPoints(points, corners[corner], corners[(corner + 1) % corners_count], points_count / corners_count + (n < points_count % corners_count ? 1 : 0));
+        }
+    }
+    IM_ASSERT(points.Size == points_count);
+
+    // Same winding as other shapes
+    float area = 0.0f;
+    for (int n = 0; n < points.Size; n++)
+        area += points[n].x * points[(n + 1) % points.Size].y - points[(n + 1) % points.Size].x * points[n].y;
+    if (area < 0.0f)
+        for (int n = 0; n < points.Size / 2; n++)
+            ImSwap(points[n], points[points.Size - 1 - n]);
+    g_ShapeParam = param;
+    return points.Data;
+}
+
+// Verify that AddConcavePolyFilled() outputs N-2 triangles which exactly cover the polygon: the sum of their unsigned areas is the polygon
+// area, which catches overlapping, missing or flipped triangles.
+static bool CheckConcaveFill(const char* name, int param)
+{
+    const int points_count = param & ~BenchShape_Mask_;
+    const ImVec2* points = GetConcavePoints(param);
+    ResetDrawList(false, ImDrawListFlags_AntiAliasedFill);
+    g_DrawList->AddConcavePolyFilled(points, points_count, IM_COL32_WHITE);
+
+    double polygon_area = 0.0;
+    for (int n = 0; n < points_count; n++)
+    {
+        const ImVec2& a = points[n];
+        const ImVec2& b = points[(n + 1) % points_count];
+        polygon_area += (double)a.x * b.y - (double)b.x * a.y;
+    }
+    polygon_area = ImAbs(polygon_area) * 0.5;
+
+    double triangles_area = 0.0;
+    bool ok = (g_DrawList->VtxBuffer.Size == points_count && g_DrawList->IdxBuffer.Size == (points_count - 2) * 3);
+    for (int n = 0; ok && n + 2 < g_DrawList->IdxBuffer.Size; n += 3)
+    {
+        const ImDrawIdx* idx = &g_DrawList->IdxBuffer[n];
+        ok = idx[0] < points_count && idx[1] < points_count && idx[2] < points_count;
+        if (!ok)
+            break;
+        const ImVec2 a = g_DrawList->VtxBuffer[idx[0]].pos, b = g_DrawList->VtxBuffer[idx[1]].pos, c = g_DrawList->VtxBuffer[idx[2]].pos;
+        triangles_area += ImAbs(((double)b.x - a.x) * ((double)c.y - a.y) - ((double)c.x - a.x) * ((double)b.y - a.y)) * 0.5;
+    }
+    ok = ok && ImAbs(triangles_area - polygon_area) <= polygon_area * 1e-6;
+    if (!ok)
+        printf("%-24s FAILED: %d vertices, %d indices, triangles area %.1f, polygon area %.1f\n", name, g_DrawList->VtxBuffer.Size, g_DrawList->IdxBuffer.Size, triangles_area, polygon_area);
+    return ok;
+}
+
+// Anti-aliased polylines, one path of 'points_count' points
+// (with 16-bit indices, paths over 64k vertices can't be rendered correctly but their cost is representative)
+static int BenchPolylineTex(int points_count)   { ResetDrawList(false); g_DrawList->AddPolyline(GetWavePoints(points_count), points_count, IM_COL32_WHITE, 0, 1.0f); return points_count; }
+static int BenchPolylineThin(int points_count)  { ResetDrawList(false, ImDrawListFlags_AntiAliasedLinesUseTex); g_DrawList->AddPolyline(GetWavePoints(points_count), points_count, IM_COL32_WHITE, 0, 1.0f); return points_count; }
+static int BenchPolylineThick(int points_count) { ResetDrawList(false); g_DrawList->AddPolyline(GetWavePoints(points_count), points_count, IM_COL32_WHITE, 0, 3.5f); return points_count; }
+static int BenchConvexFill(int points_count)    { ResetDrawList(false); g_DrawList->AddConvexPolyFilled(GetCirclePoints(points_count), points_count, IM_COL32_WHITE); return points_count; }
+static int BenchConcaveFill(int param)          { ResetDrawList(false); g_DrawList->AddConcavePolyFilled(GetConcavePoints(param), param & ~BenchShape_Mask_, IM_COL32_WHITE); return param & ~BenchShape_Mask_; }
+
+struct BenchCase
+{
+    const char* Name;
+    const char* Unit;
+    int         (*Func)(int param);
+    int         Param;
+};
+
+static const BenchCase g_Cases[] =
+{
+    { "primrectuv/vtx",             "quads",    BenchPrimRectUV,    0 },
+    { "primrectuv/quads",           "quads",    BenchPrimRectUV,    1 },
+    { "rectfilled/vtx",             "quads",    BenchAddRectFilled, 0 },
+    { "rectfilled/quads",           "quads",    BenchAddRectFilled, 1 },
+    { "text/vtx",                   "glyphs",   BenchAddText,       0 },
+    { "text/quads",                 "glyphs",   BenchAddText,       1 },
+    { "text/mixed/vtx",             "bytes",    BenchAddTextMixed,  0 },
+    { "textwrap/render",            "glyphs",   BenchTextWrapped,   0 },
+    { "textwrap/measure+render",    "glyphs",   BenchTextWrapped,   1 },
+    { "textlarge/1mb-line",         "bytes",    BenchTextLarge,     0 },
+    { "textlarge/1mb-line-wrapped", "bytes",    BenchTextLarge,     1 },
+    { "calctext/english",           "bytes",    BenchCalcText,      0 },
+    { "calctext/english-wrapped",   "bytes",    BenchCalcText,      1 },
+    { "calctext/mixed",             "bytes",    BenchCalcText,      2 },
+    { "calctext/mixed-wrapped",     "bytes",    BenchCalcText,      3 },
+    { "calctextsize/labels",        "labels",   BenchCalcLabels,    0 },
+    { "calctextsize/labels-cached", "labels",   BenchCalcLabels,    1 },
+    { "calctextsize/wrapped",       "glyphs",   BenchCalcWrapped,   0 },
+    { "calctextsize/wrapped-cached", "glyphs",  BenchCalcWrapped,   1 },
+    { "utf8/decode/english",        "bytes",    BenchUtf8,          BenchUtf8_Decode },
+    { "utf8/decode/mixed",          "bytes",    BenchUtf8,          BenchUtf8_Decode | 1 },
+    { "utf8/count/english",         "bytes",    BenchUtf8,          BenchUtf8_Count },
+    { "utf8/count/mixed",           "bytes",    BenchUtf8,          BenchUtf8_Count | 1 },
+    { "utf8/encode/english",        "bytes",    BenchUtf8,          BenchUtf8_Encode },
+    { "utf8/encode/mixed",          "bytes",    BenchUtf8,          BenchUtf8_Encode | 1 },
+    { "utf8/countbytes/english",    "bytes",    BenchUtf8,          BenchUtf8_CountBytes },
+    { "utf8/countbytes/mixed",      "bytes",    BenchUtf8,          BenchUtf8_CountBytes | 1 },
+    { "polyline/tex/10k",           "points",   BenchPolylineTex,   10000 },
+    { "polyline/tex/100k",          "points",   BenchPolylineTex,   100000 },
+    { "polyline/tex/1M",            "points",   BenchPolylineTex,   1000000 },
+    { "polyline/thin/10k",          "points",   BenchPolylineThin,  10000 },
+    { "polyline/thin/100k",         "points",   BenchPolylineThin,  100000 },
+    { "polyline/thin/1M",           "points",   BenchPolylineThin,  1000000 },
+    { "polyline/thick/10k",         "points",   BenchPolylineThick, 10000 },
+    { "polyline/thick/100k",        "points",   BenchPolylineThick, 100000 },
+    { "polyline/thick/1M",          "points",   BenchPolylineThick, 1000000 },
+    { "convexfill/10k",             "points",   BenchConvexFill,    10000 },
+    { "convexfill/100k",            "points",   BenchConvexFill,    100000 },
+    { "convexfill/1M",              "points",   BenchConvexFill,    1000000 },
+    { "concavefill/32",             "points",   BenchConcaveFill,   32 },
+    { "concavefill/64",             "points",   BenchConcaveFill,   64 },
+    { "concavefill/100",            "points",   BenchConcaveFill,   100 },
+    { "concavefill/1k",             "points",   BenchConcaveFill,   1000 },
+    { "concavefill/10k",            "points",   BenchConcaveFill,   10000 },
+    { "concavefill/comb/64",        "points",   BenchConcaveFill,   BenchShape_Comb | 64 },
+    { "concavefill/comb/1k",        "points",   BenchConcaveFill,   BenchShape_Comb | 1000 },
+    { "concavefill/comb/10k",       "points",   BenchConcaveFill,   BenchShape_Comb | 10000 },
+    { "concavefill/sawtooth/64",    "points",   BenchConcaveFill,   BenchShape_Sawtooth | 64 },
+    { "concavefill/sawtooth/1k",    "points",   BenchConcaveFill,   BenchShape_Sawtooth | 1000 },
+    { "concavefill/sawtooth/10k",   "points",   BenchConcaveFill,   BenchShape_Sawtooth | 10000 },
+    { "concavefill/spiral/64",      "points",   BenchConcaveFill,   BenchShape_Spiral | 64 },
+    { "concavefill/spiral/1k",      "points",   BenchConcaveFill,   BenchShape_Spiral | 1000 },
+    { "concavefill/spiral/10k",     "points",   BenchConcaveFill,   BenchShape_Spiral | 10000 },
+    { "concavefill/collinear/64",   "points",   BenchConcaveFill,   BenchShape_Collinear | 64 },
+    { "concavefill/collinear/1k",   "points",   BenchConcaveFill,   BenchShape_Collinear | 1000 },
+    { "concavefill/collinear/10k",  "points",   BenchConcaveFill,   BenchShape_Collinear | 10000 },
+};
+
+//-----------------------------------------------------------------------------
+// Main
+//-----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    const char* filter = (argc > 1) ? argv[1] : NULL;
+    const double seconds_per_case = (argc > 2) ? atof(argv[2]) : 1.0;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1920.0f, 1080.0f);
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasVtxOffset;
+    g_Font = io.Fonts->AddFontDefault();
+
+    // Glyphs are baked on first use: output all of them once before measuring
+    ImGui::NewFrame();
+    g_DrawList = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+    g_DrawList->_ResetForNewFrame();
+    g_DrawList->PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(100000.0f, 100000.0f));
+    g_DrawList->PushTexture(io.Fonts->TexRef);
+    g_DrawList->AddText(g_Font, g_FontSize, ImVec2(0.0f, 0.0f), IM_COL32_WHITE, g_Paragraph);
+    g_DrawList->AddText(g_Font, g_FontSize, ImVec2(0.0f, 0.0f), IM_COL32_WHITE, g_ParagraphMixed);
+
+    printf("imgui_bench_draw (%s, %d-bit indices)\n", SIMD_NAME, (int)sizeof(ImDrawIdx) * 8);
+    int failed_checks = 0;
+    for (const BenchCase& bench : g_Cases)
+    {
+        if (filter != NULL && strstr(bench.Name, filter) == NULL)
+            continue;
+        if (bench.Func == BenchConcaveFill && !CheckConcaveFill(bench.Name, bench.Param))
+        {
+            failed_checks++;
+            continue;
+        }
+        bench.Func(bench.Param); // Warm-up: grow buffers
+
+        // Report the best batch as well as the average, the former being less sensitive to noise from other processes
+        long long items = 0;
+        double elapsed = 0.0;
+        double best_rate = 0.0;
+        while (elapsed < seconds_per_case)
+        {
+            std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+            const int batch_items = bench.Func(bench.Param);
+            const double batch_elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            best_rate = ImMax(best_rate, batch_items / batch_elapsed);
+            items += batch_items;
+            elapsed += batch_elapsed;
+        }
+        printf("%-24s best %9.2f M %s/s, average %9.2f M %s/s\n", bench.Name, best_rate / 1000000.0, bench.Unit, items / elapsed / 1000000.0, bench.Unit);
+    }
+
+    ImGui::EndFrame();
+    IM_DELETE(g_DrawList);
+    ImGui::DestroyContext();
+    return failed_checks > 0 ? 1 : 0;
+}
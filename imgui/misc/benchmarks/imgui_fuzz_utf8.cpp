@@ -0,0 +1,306 @@
+// dear imgui
+// (imgui_fuzz_utf8.cpp)
+// Randomized equivalence test for the bulk UTF-8 conversion helpers, which have SSE2/NEON code paths:
+// ImTextStrFromUtf8(), ImTextCountCharsFromUtf8(), ImTextStrToUtf8() and ImTextCountUtf8BytesFromStr().
+// Each is compared against a one-character-at-a-time reference written here on top of ImTextCharFromUtf8(), on random valid,
+// invalid and truncated input, at every length up to a few blocks and every alignment, with and without end pointers.
+
+// Build, e.g: (see README.md)
+//   # g++ -O1 -g -fsanitize=address,undefined -I../.. imgui_fuzz_utf8.cpp ../../imgui*.cpp -o imgui_fuzz_utf8
+// Inputs and outputs are allocated to their exact size, so building with AddressSanitizer also catches reads or writes past them.
+// Also build with -DIMGUI_USE_WCHAR32, and with -DIMGUI_DISABLE_SSE (x86) or -DIMGUI_DISABLE_NEON (ARM) to check the scalar paths.
+
+// Usage:
+//   imgui_fuzz_utf8 [rounds] [seed]
+//   Returns 0 if all conversions matched the reference, 1 otherwise.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(IMGUI_ENABLE_SSE)
+#define SIMD_NAME "sse"
+#elif defined(IMGUI_ENABLE_NEON)
+#define SIMD_NAME "neon"
+#else
+#define SIMD_NAME "scalar"
+#endif
+
+static const int MAX_LENGTH = 80;       // Covers several 16 characters blocks, with every possible remainder
+static const int MAX_ALIGNMENT = 16;
+
+//-----------------------------------------------------------------------------
+// Helpers
+//-----------------------------------------------------------------------------
+
+static ImU32 g_Seed = 1;
+static int   g_Cases = 0;
+static int   g_Failures = 0;
+
+static ImU32 Rand()
+{
+    g_Seed ^= g_Seed << 13;
+    g_Seed ^= g_Seed >> 17;
+    g_Seed ^= g_Seed << 5;
+    return g_Seed;
+}
+
+// Fill 'out' with exactly 'len' bytes: mostly ASCII runs (so SIMD blocks are taken), valid multi-byte sequences,
+// and every kind of malformed input: stray continuation bytes, invalid lead bytes, overlong encodings, surrogate halves,
+// code points above 0x10FFFF, truncated sequences and embedded zeroes.
+static void GenerateUtf8(char* out, int len)
+{
+    int n = 0;
+    while (n < len)
+    {
+        char seq[8];
+        int seq_len = 0;
+        const ImU32 r = Rand() % 100;
+        if (r < 40)
+        {
+            const int run = 1 + Rand() % 24;
+            for (int i = 0; i < run && n < len; i++)
+                out[n++] = (char)(1 + Rand() % 0x7F);
+            continue;
+        }
+        else if (r < 60)
+        {
+            // Valid sequence (ImTextCharToUtf8() is not under test)
+            const ImU32 ranges[] = { 0x80, 0x800, 0x800, 0x10000, 0x10000, 0x110000 }; // The latter is decoded as invalid without IMGUI_USE_WCHAR32
+            const int range = (int)(Rand() % 3) * 2;
+            ImU32 c = ranges[range] + Rand() % (ranges[range + 1] - ranges[range]);
+            if (c >= 0xD800 && c <= 0xDFFF)
+                c = 0xFFFD;
+            seq_len = ImTextCharToUtf8(seq, c);
+        }
+        else if (r < 70)
+        {
+            // Truncated valid sequence
+            const ImU32 c = (Rand() & 1) ? 0x800 + Rand() % 0xC000 : 0x10000 + Rand() % 0x100000;
+            seq_len = ImTextCharToUtf8(seq, c) - 1 - (int)(Rand() % 2);
+        }
+        else if (r < 85)
+        {
+            // Malformed sequences
+            static const char* malformed[] = { "\x80", "\xBF", "\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xED\xBF\xBF", "\xF0\x80\x80\x80", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF8\x88\x80\x80\x80", "\xFE", "\xFF", "\xC3\x41", "\xE6\x97\x41", "\xF0\x9F\x98\x41" };
+            const char* p = malformed[Rand() % IM_ARRAYSIZE(malformed)];
+            seq_len = (int)strlen(p);
+            memcpy(seq, p, seq_len);
+        }
+        else if (r < 97)
+        {
+            seq[seq_len++] = (char)(0x80 + Rand() % 0x80);
+        }
+        else
+        {
+            seq[seq_len++] = 0;
+        }
+        for (int i = 0; i < seq_len && n < len; i++)
+            out[n++] = seq[i];
+    }
+}
+
+// Fill 'out' with exactly 'len' characters, mostly ASCII, with every range handled by the encoder
+static void GenerateWide(ImWchar* out, int len)
+{
+    for (int n = 0; n < len; n++)
+    {
+        const ImU32 r = Rand() % 100;
+        ImU32 c;
+        if (r < 60)
+            c = 1 + Rand() % 0x7F;
+        else if (r < 70)
+            c = 0x80 + Rand() % 0x780;
+        else if (r < 82)
+            c = 0x800 + Rand() % 0xF800;
+        else if (r < 85)
+            c = 0;
+        else if (r < 90)
+            c = (Rand() & 1) ? 0x7F + Rand() % 2 : 0x7FF + Rand() % 2; // Range boundaries
+        else
+            c = Rand(); // Anything that fits ImWchar, including values above 0x10FFFF with IMGUI_USE_WCHAR32
+        out[n] = (ImWchar)c;
+    }
+}
+
+static void PrintBytes(const char* label, const void* data, int size)
+{
+    printf("  %s:", label);
+    for (int n = 0; n < size; n++)
+        printf(" %02X", ((const unsigned char*)data)[n]);
+    printf("\n");
+}
+
+static bool Check(bool ok, const char* func, const char* what, int len, int align, bool has_end, int buf_size, const void* input, int input_size)
+{
+    g_Cases++;
+    if (ok)
+        return true;
+    if (g_Failures++ < 10)
+    {
+        printf("MISMATCH %s: %s (length %d, alignment %d, %s, buf_size %d)\n", func, what, len, align, has_end ? "with end" : "zero-terminated", buf_size);
+        PrintBytes("input", input, input_size);
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// Reference implementations, one character at a time
+//-----------------------------------------------------------------------------
+
+static int RefStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
+{
+    ImWchar* buf_out = buf;
+    ImWchar* buf_end = buf + buf_size;
+    while (buf_out < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
+    {
+        unsigned int c;
+        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        *buf_out++ = (ImWchar)c;
+    }
+    *buf_out = 0;
+    if (in_text_remaining)
+        *in_text_remaining = in_text;
+    return (int)(buf_out - buf);
+}
+
+static int RefCountCharsFromUtf8(const char* in_text, const char* in_text_end)
+{
+    int char_count = 0;
+    while ((!in_text_end || in_text < in_text_end) && *in_text)
+    {
+        unsigned int c;
+        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        char_count++;
+    }
+    return char_count;
+}
+
+static int RefCharToUtf8(char* buf, int buf_size, unsigned int c)
+{
+    char tmp[5];
+    const int count = (c < 0x80) ? 1 : ImTextCharToUtf8(tmp, c);
+    if (count > buf_size)
+        return 0;
+    if (c < 0x80)
+        buf[0] = (char)c;
+    else
+        memcpy(buf, tmp, count);
+    return count;
+}
+
+static int RefStrToUtf8(char* out_buf, int out_buf_size, const ImWchar* in_text, const ImWchar* in_text_end)
+{
+    char* buf_p = out_buf;
+    const char* buf_end = out_buf + out_buf_size;
+    while (buf_p < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
+        buf_p += RefCharToUtf8(buf_p, (int)(buf_end - buf_p - 1), (unsigned int)(*in_text++));
+    *buf_p = 0;
+    return (int)(buf_p - out_buf);
+}
+
+static int RefCountUtf8BytesFromStr(const ImWchar* in_text, const ImWchar* in_text_end)
+{
+    int bytes_count = 0;
+    while ((!in_text_end || in_text < in_text_end) && *in_text)
+    {
+        const unsigned int c = (unsigned int)(*in_text++);
+        bytes_count += (c < 0x80) ? 1 : (c < 0x800) ? 2 : (c < 0x10000) ? 3 : (c <= 0x10FFFF) ? 4 : 3; // Invalid code points count as 3 bytes, but are not output
+    }
+    return bytes_count;
+}
+
+//-----------------------------------------------------------------------------
+// Cases
+//-----------------------------------------------------------------------------
+
+// UTF-8 -> ImWchar. With an end pointer the input buffer ends exactly there.
+// Zero-terminated inputs are followed by 3 random bytes then 4 zeroes: without an end pointer ImTextCharFromUtf8() reads up to 4 bytes,
+// and a truncated sequence followed by the terminator and non-zero bytes is consumed along with the terminator (e.g. "\xED\0\xF9").
+static void FuzzFromUtf8(int len, int align, bool has_end)
+{
+    const int input_size = align + len + (has_end ? 0 : 8);
+    char* input_alloc = (char*)malloc(input_size > 0 ? input_size : 1);
+    char* input = input_alloc + align;
+    GenerateUtf8(input, len);
+    if (!has_end)
+        for (int n = 0; n < 8; n++)
+            input[len + n] = (n >= 1 && n < 4) ? (char)Rand() : 0;
+    const char* input_end = has_end ? input + len : NULL;
+
+    Check(ImTextCountCharsFromUtf8(input, input_end) == RefCountCharsFromUtf8(input, input_end), "ImTextCountCharsFromUtf8", "count", len, align, has_end, 0, input, len);
+
+    // Full output buffer, and a random smaller one (including one element: only the terminator fits)
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const int buf_size = (pass == 0) ? len + 1 : 1 + (int)(Rand() % (len + 1));
+        ImWchar* out = (ImWchar*)malloc(buf_size * sizeof(ImWchar));
+        ImWchar* ref_out = (ImWchar*)malloc(buf_size * sizeof(ImWchar));
+        const char* remaining = NULL;
+        const char* ref_remaining = NULL;
+        const int out_len = ImTextStrFromUtf8(out, buf_size, input, input_end, &remaining);
+        const int ref_len = RefStrFromUtf8(ref_out, buf_size, input, input_end, &ref_remaining);
+        if (Check(out_len == ref_len, "ImTextStrFromUtf8", "return value", len, align, has_end, buf_size, input, len))
+            Check(memcmp(out, ref_out, (ref_len + 1) * sizeof(ImWchar)) == 0, "ImTextStrFromUtf8", "output", len, align, has_end, buf_size, input, len);
+        Check(remaining == ref_remaining, "ImTextStrFromUtf8", "in_text_remaining", len, align, has_end, buf_size, input, len);
+        free(out);
+        free(ref_out);
+    }
+    free(input_alloc);
+}
+
+// ImWchar -> UTF-8. 'align' is in characters.
+static void FuzzToUtf8(int len, int align, bool has_end)
+{
+    const int input_size = align + len + (has_end ? 0 : 1);
+    ImWchar* input_alloc = (ImWchar*)malloc((input_size > 0 ? input_size : 1) * sizeof(ImWchar));
+    ImWchar* input = input_alloc + align;
+    GenerateWide(input, len);
+    if (!has_end)
+        input[len] = 0;
+    const ImWchar* input_end = has_end ? input + len : NULL;
+
+    Check(ImTextCountUtf8BytesFromStr(input, input_end) == RefCountUtf8BytesFromStr(input, input_end), "ImTextCountUtf8BytesFromStr", "count", len, align, has_end, 0, input, len * (int)sizeof(ImWchar));
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const int buf_size = (pass == 0) ? len * 4 + 1 : 1 + (int)(Rand() % (len * 4 + 1));
+        char* out = (char*)malloc(buf_size);
+        char* ref_out = (char*)malloc(buf_size);
+        const int out_len = ImTextStrToUtf8(out, buf_size, input, input_end);
+        const int ref_len = RefStrToUtf8(ref_out, buf_size, input, input_end);
+        if (Check(out_len == ref_len, "ImTextStrToUtf8", "return value", len, align, has_end, buf_size, input, len * (int)sizeof(ImWchar)))
+            Check(memcmp(out, ref_out, ref_len + 1) == 0, "ImTextStrToUtf8", "output", len, align, has_end, buf_size, input, len * (int)sizeof(ImWchar));
+        free(out);
+        free(ref_out);
+    }
+    free(input_alloc);
+}
+
+//-----------------------------------------------------------------------------
+// Main
+//-----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    const int rounds = (argc > 1) ? atoi(argv[1]) : 200;
+    g_Seed = (argc > 2) ? (ImU32)strtoul(argv[2], NULL, 10) : 1;
+    if (g_Seed == 0)
+        g_Seed = 1;
+
+    IMGUI_CHECKVERSION();
+    printf("imgui_fuzz_utf8 (%s, %d-bit ImWchar), %d rounds, seed %u\n", SIMD_NAME, (int)sizeof(ImWchar) * 8, rounds, g_Seed);
+    for (int round = 0; round < rounds; round++)
+        for (int len = 0; len <= MAX_LENGTH; len++)
+            for (int align = 0; align < MAX_ALIGNMENT; align++)
+                for (int has_end = 0; has_end < 2; has_end++)
+                {
+                    FuzzFromUtf8(len, align, has_end != 0);
+                    FuzzToUtf8(len, align, has_end != 0);
+                }
+
+    printf("%d checks, %d mismatches\n", g_Cases, g_Failures);
+    return g_Failures == 0 ? 0 : 1;
+}
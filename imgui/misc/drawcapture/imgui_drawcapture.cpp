@@ -0,0 +1,457 @@
+// dear imgui: ImDrawData capture and replay
+// See imgui_drawcapture.h for usage.
+
+// File format (all values in native endianness):
+//   Header     "IMDC", u32 version, u32 sizeof(ImDrawVert), u32 sizeof(ImDrawIdx), u32 sizeof(ImDrawQuad)
+//   Frame[]    u32 size of frame data in bytes, followed by:
+//              ImVec2 DisplayPos, ImVec2 DisplaySize, ImVec2 FramebufferScale
+//              u32 texture requests count, then for each request: u32 op, i32 texture index, then
+//                  op Create:  i32 format, i32 width, i32 height, u32 has_pixels, [width*height*bpp bytes]
+//                  op Update:  u16 x, u16 y, u16 w, u16 h, w*h*bpp bytes
+//                  op Destroy: nothing
+//              u32 draw lists count, then for each draw list:
+//                  u32 flags, u32 cmd count, u32 vtx count, u32 idx count, u32 quad count
+//                  ImDrawCaptureCmd[cmd count], ImDrawVert[vtx count], ImDrawIdx[idx count], ImDrawQuad[quad count]
+
+// Changelog:
+// - v1: Initial version.
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_drawcapture.h"
+#include "imgui_internal.h"     // ImFileOpen, ImFileWrite, ImFileLoadToMemory
+
+// Clang warnings with -Weverything
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsign-conversion"    // warning: implicit conversion changes signedness
+#endif
+
+#define IMGUI_DRAWCAPTURE_VERSION   1
+
+enum ImDrawCaptureTexOp
+{
+    ImDrawCaptureTexOp_Create = 1,
+    ImDrawCaptureTexOp_Update = 2,
+    ImDrawCaptureTexOp_Destroy = 3,
+};
+
+enum ImDrawCaptureCallback
+{
+    ImDrawCaptureCallback_None = 0,
+    ImDrawCaptureCallback_ResetRenderState = 1,
+    ImDrawCaptureCallback_Other = 2,                    // Dropped on replay
+};
+
+struct ImDrawCaptureFileHeader
+{
+    char            Magic[4];
+    ImU32           Version;
+    ImU32           SizeOfDrawVert;
+    ImU32           SizeOfDrawIdx;
+    ImU32           SizeOfDrawQuad;
+};
+
+// Serialized ImDrawCmd
+struct ImDrawCaptureCmd
+{
+    ImVec4          ClipRect;
+    int             TexIndex;                           // Index in file textures, -1 for a user ImTextureID
+    ImU32           Callback;                           // ImDrawCaptureCallback
+    ImU64           TexID;                              // Original ImTextureID, for reference only
+    ImU32           VtxOffset;
+    ImU32           IdxOffset;
+    ImU32           ElemCount;
+    ImU32           QuadOffset;
+    ImU32           QuadCount;
+    ImU32           _Padding;
+};
+
+//-----------------------------------------------------------------------------
+// ImDrawCaptureWriter
+//-----------------------------------------------------------------------------
+
+static void ImDrawCapture_Write(ImVector<unsigned char>& buf, const void* data, size_t size)
+{
+    const int offset = buf.Size;
+    buf.resize(offset + (int)size);
+    if (size > 0)
+        memcpy(buf.Data + offset, data, size);
+}
+
+template<typename T>
+static void ImDrawCapture_WriteValue(ImVector<unsigned char>& buf, const T& value)
+{
+    ImDrawCapture_Write(buf, &value, sizeof(T));
+}
+
+static void ImDrawCapture_WriteTextureRect(ImVector<unsigned char>& buf, ImTextureData* tex, int x, int y, int w, int h)
+{
+    for (int row = 0; row < h; row++)
+        ImDrawCapture_Write(buf, tex->GetPixelsAt(x, y + row), (size_t)w * tex->BytesPerPixel);
+}
+
+bool ImDrawCaptureWriter::Open(const char* filename)
+{
+    Close();
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (f == NULL)
+        return false;
+    ImDrawCaptureFileHeader header = { { 'I', 'M', 'D', 'C' }, IMGUI_DRAWCAPTURE_VERSION, (ImU32)sizeof(ImDrawVert), (ImU32)sizeof(ImDrawIdx), (ImU32)sizeof(ImDrawQuad) };
+    ImFileWrite(&header, sizeof(header), 1, f);
+    _File = (void*)f;
+    FrameCount = 0;
+    return true;
+}
+
+void ImDrawCaptureWriter::Close()
+{
+    if (_File != NULL)
+        ImFileClose((ImFileHandle)_File);
+    _File = NULL;
+    _Textures.clear();
+    _Buffer.clear();
+}
+
+void ImDrawCaptureWriter::WriteFrame(const ImDrawData* draw_data)
+{
+    IM_ASSERT(draw_data->Valid);
+    if (_File == NULL)
+        return;
+    ImVector<unsigned char>& buf = _Buffer;
+    buf.resize(0);
+    ImDrawCapture_WriteValue(buf, draw_data->DisplayPos);
+    ImDrawCapture_WriteValue(buf, draw_data->DisplaySize);
+    ImDrawCapture_WriteValue(buf, draw_data->FramebufferScale);
+
+    // Texture requests. Textures which we haven't seen yet (e.g. capture started after they were uploaded) are recorded as created with their current contents.
+    const int tex_ops_offset = buf.Size;
+    ImU32 tex_ops_count = 0;
+    ImDrawCapture_WriteValue(buf, tex_ops_count);
+    if (draw_data->Textures != NULL)
+        for (ImTextureData* tex : *draw_data->Textures)
+        {
+            int tex_index = _Textures.find_index(tex);
+            if (tex->Status == ImTextureStatus_Destroyed)
+                continue;
+            if (tex->Status == ImTextureStatus_WantDestroy)
+            {
+                if (tex_index == -1)
+                    continue;
+                ImDrawCapture_WriteValue(buf, (ImU32)ImDrawCaptureTexOp_Destroy);
+                ImDrawCapture_WriteValue(buf, tex_index);
+                _Textures[tex_index] = NULL;
+                tex_ops_count++;
+                continue;
+            }
+            if (tex_index != -1 && tex->Status == ImTextureStatus_WantCreate)
+                _Textures[tex_index] = NULL; // Being recreated, possibly with a different size: record as a new texture
+            if (tex_index == -1 || tex->Status == ImTextureStatus_WantCreate)
+            {
+                tex_index = _Textures.Size;
+                _Textures.push_back(tex);
+                ImDrawCapture_WriteValue(buf, (ImU32)ImDrawCaptureTexOp_Create);
+                ImDrawCapture_WriteValue(buf, tex_index);
+                ImDrawCapture_WriteValue(buf, (int)tex->Format);
+                ImDrawCapture_WriteValue(buf, tex->Width);
+                ImDrawCapture_WriteValue(buf, tex->Height);
+                ImDrawCapture_WriteValue(buf, (ImU32)(tex->Pixels != NULL ? 1 : 0));
+                if (tex->Pixels != NULL)
+                    ImDrawCapture_Write(buf, tex->Pixels, (size_t)tex->GetSizeInBytes());
+                tex_ops_count++;
+                continue;
+            }
+
+            // Known texture: record individual updates
+            if (tex->Status != ImTextureStatus_WantUpdates || tex->Pixels == NULL)
+                continue;
+            for (const ImTextureRect& r : tex->Updates)
+            {
+                ImDrawCapture_WriteValue(buf, (ImU32)ImDrawCaptureTexOp_Update);
+                ImDrawCapture_WriteValue(buf, tex_index);
+                ImDrawCapture_WriteValue(buf, r);
+                ImDrawCapture_WriteTextureRect(buf, tex, r.x, r.y, r.w, r.h);
+                tex_ops_count++;
+            }
+        }
+    memcpy(buf.Data + tex_ops_offset, &tex_ops_count, sizeof(tex_ops_count));
+
+    // Draw lists
+    ImDrawCapture_WriteValue(buf, (ImU32)draw_data->CmdLists.Size);
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        ImDrawCapture_WriteValue(buf, (ImU32)draw_list->Flags);
+        ImDrawCapture_WriteValue(buf, (ImU32)draw_list->CmdBuffer.Size);
+        ImDrawCapture_WriteValue(buf, (ImU32)draw_list->VtxBuffer.Size);
+        ImDrawCapture_WriteValue(buf, (ImU32)draw_list->IdxBuffer.Size);
+        ImDrawCapture_WriteValue(buf, (ImU32)draw_list->QuadBuffer.Size);
+        for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        {
+            ImDrawCaptureCmd out_cmd = ImDrawCaptureCmd();
+            out_cmd.ClipRect = cmd.ClipRect;
+            out_cmd.TexIndex = cmd.TexRef._TexData ? _Textures.find_index(cmd.TexRef._TexData) : -1;
+            out_cmd.Callback = (cmd.UserCallback == NULL) ? ImDrawCaptureCallback_None : (cmd.UserCallback == ImDrawCallback_ResetRenderState) ? ImDrawCaptureCallback_ResetRenderState : ImDrawCaptureCallback_Other;
+            out_cmd.TexID = (ImU64)(cmd.TexRef._TexData ? cmd.TexRef._TexData->TexID : cmd.TexRef._TexID); // May not be uploaded yet, don't use GetTexID()
+            out_cmd.VtxOffset = cmd.VtxOffset;
+            out_cmd.IdxOffset = cmd.IdxOffset;
+            out_cmd.ElemCount = cmd.ElemCount;
+            out_cmd.QuadOffset = cmd.QuadOffset;
+            out_cmd.QuadCount = cmd.QuadCount;
+            ImDrawCapture_WriteValue(buf, out_cmd);
+        }
+        ImDrawCapture_Write(buf, draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes());
+        ImDrawCapture_Write(buf, draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes());
+        ImDrawCapture_Write(buf, draw_list->QuadBuffer.Data, (size_t)draw_list->QuadBuffer.size_in_bytes());
+    }
+
+    const ImU32 frame_size = (ImU32)buf.Size;
+    ImFileWrite(&frame_size, sizeof(frame_size), 1, (ImFileHandle)_File);
+    ImFileWrite(buf.Data, 1, (ImU64)buf.Size, (ImFileHandle)_File);
+    FrameCount++;
+}
+
+//-----------------------------------------------------------------------------
+// ImDrawCaptureReader
+//-----------------------------------------------------------------------------
+
+// Bounds-checked reading from a frame
+struct ImDrawCaptureStream
+{
+    const unsigned char*    Data;
+    const unsigned char*    DataEnd;
+    bool                    Error;
+
+    ImDrawCaptureStream(const unsigned char* data, const unsigned char* data_end) { Data = data; DataEnd = data_end; Error = false; }
+    const void* Skip(size_t size)           { if (Error || (size_t)(DataEnd - Data) < size) { Error = true; return NULL; } const void* p = Data; Data += size; return p; }
+    bool        Read(void* dst, size_t size) { const void* src = Skip(size); if (src == NULL) return false; if (size > 0) memcpy(dst, src, size); return true; }
+    template<typename T> T ReadValue()      { T value; if (!Read(&value, sizeof(T))) value = T(); return value; }
+};
+
+bool ImDrawCaptureReader::Load(const char* filename)
+{
+    Clear();
+    size_t file_size = 0;
+    unsigned char* file_data = (unsigned char*)ImFileLoadToMemory(filename, "rb", &file_size);
+    if (file_data == NULL)
+        return false;
+
+    ImDrawCaptureFileHeader header;
+    ImDrawCaptureStream stream(file_data, file_data + file_size);
+    if (!stream.Read(&header, sizeof(header)) || memcmp(header.Magic, "IMDC", 4) != 0 || header.Version != IMGUI_DRAWCAPTURE_VERSION
+        || header.SizeOfDrawVert != sizeof(ImDrawVert) || header.SizeOfDrawIdx != sizeof(ImDrawIdx) || header.SizeOfDrawQuad != sizeof(ImDrawQuad))
+    {
+        IM_FREE(file_data);
+        return false;
+    }
+    while (stream.Data < stream.DataEnd)
+    {
+        const ImU32 frame_size = stream.ReadValue<ImU32>();
+        const unsigned int frame_offset = (unsigned int)(stream.Data - file_data);
+        if (stream.Skip(frame_size) == NULL)
+            break; // Truncated last frame (e.g. application was killed while capturing)
+        _FrameOffsets.push_back(frame_offset);
+    }
+    _FileData = file_data;
+    _FileSize = file_size;
+    return true;
+}
+
+void ImDrawCaptureReader::Clear()
+{
+    for (ImTextureData* tex : Textures)
+        IM_DELETE(tex);
+    for (ImDrawList* draw_list : _DrawLists)
+        IM_DELETE(draw_list);
+    if (_FileData != NULL)
+        IM_FREE(_FileData);
+    Textures.clear();
+    _DrawLists.clear();
+    _FrameOffsets.clear();
+    _FileData = NULL;
+    _FileSize = 0;
+    _NextTextureFrame = 0;
+    DrawData.Clear();
+}
+
+// Read texture requests of a frame. When 'apply' is false they are only skipped over (they have already been applied).
+static void ImDrawCapture_ReadTextureRequests(ImVector<ImTextureData*>& textures, ImDrawCaptureStream& stream, bool apply)
+{
+    const ImU32 tex_ops_count = stream.ReadValue<ImU32>();
+    for (ImU32 op_n = 0; op_n < tex_ops_count && !stream.Error; op_n++)
+    {
+        const ImU32 op = stream.ReadValue<ImU32>();
+        const int tex_index = stream.ReadValue<int>();
+        if (op == ImDrawCaptureTexOp_Create)
+        {
+            const ImTextureFormat format = (ImTextureFormat)stream.ReadValue<int>();
+            const int width = stream.ReadValue<int>();
+            const int height = stream.ReadValue<int>();
+            const bool has_pixels = stream.ReadValue<ImU32>() != 0;
+            if (stream.Error || width <= 0 || height <= 0 || (format != ImTextureFormat_RGBA32 && format != ImTextureFormat_Alpha8) || (apply && tex_index != textures.Size))
+            {
+                stream.Error = true;
+                break;
+            }
+            if (!apply)
+            {
+                if (has_pixels)
+                    stream.Skip((size_t)width * height * ImTextureDataGetFormatBytesPerPixel(format));
+                continue;
+            }
+            ImTextureData* tex = IM_NEW(ImTextureData)();
+            tex->Create(format, width, height);
+            tex->UniqueID = tex_index;
+            tex->RefCount = 1;
+            tex->UsedRect.w = (unsigned short)width;
+            tex->UsedRect.h = (unsigned short)height;
+            if (has_pixels)
+                stream.Read(tex->Pixels, (size_t)tex->GetSizeInBytes());
+            textures.push_back(tex);
+        }
+        else if (op == ImDrawCaptureTexOp_Update)
+        {
+            const ImTextureRect r = stream.ReadValue<ImTextureRect>();
+            ImTextureData* tex = (tex_index >= 0 && tex_index < textures.Size) ? textures[tex_index] : NULL;
+            if (tex == NULL || r.x + r.w > tex->Width || r.y + r.h > tex->Height)
+            {
+                stream.Error = true;
+                break;
+            }
+            if (!apply)
+            {
+                stream.Skip((size_t)r.w * r.h * tex->BytesPerPixel);
+                continue;
+            }
+            for (int row = 0; row < r.h; row++)
+                stream.Read(tex->GetPixelsAt(r.x, r.y + row), (size_t)r.w * tex->BytesPerPixel);
+            if (tex->Status == ImTextureStatus_WantCreate)
+                continue; // Will be uploaded whole
+            const int new_x1 = ImMax(tex->UpdateRect.w == 0 ? 0 : tex->UpdateRect.x + tex->UpdateRect.w, r.x + r.w);
+            const int new_y1 = ImMax(tex->UpdateRect.h == 0 ? 0 : tex->UpdateRect.y + tex->UpdateRect.h, r.y + r.h);
+            tex->UpdateRect.x = ImMin(tex->UpdateRect.x, r.x);
+            tex->UpdateRect.y = ImMin(tex->UpdateRect.y, r.y);
+            tex->UpdateRect.w = (unsigned short)(new_x1 - tex->UpdateRect.x);
+            tex->UpdateRect.h = (unsigned short)(new_y1 - tex->UpdateRect.y);
+            tex->Updates.push_back(r);
+            tex->SetStatus(ImTextureStatus_WantUpdates);
+        }
+        else if (op == ImDrawCaptureTexOp_Destroy)
+        {
+            // Not replayed: frames may be played again in any order, keep everything alive until DestroyTextures().
+        }
+        else
+        {
+            stream.Error = true;
+        }
+    }
+}
+
+ImDrawData* ImDrawCaptureReader::GetFrame(int frame_n)
+{
+    IM_ASSERT(frame_n >= 0 && frame_n < _FrameOffsets.Size);
+
+    // Forget about requests which the renderer honored since last call
+    for (ImTextureData* tex : Textures)
+        if (tex->Status == ImTextureStatus_OK)
+        {
+            tex->Updates.resize(0);
+            tex->UpdateRect.x = tex->UpdateRect.y = (unsigned short)~0;
+            tex->UpdateRect.w = tex->UpdateRect.h = 0;
+        }
+
+    // Apply texture requests in capture order
+    for (; _NextTextureFrame <= frame_n; _NextTextureFrame++)
+    {
+        const unsigned char* frame_data = _FileData + _FrameOffsets[_NextTextureFrame];
+        ImDrawCaptureStream stream(frame_data, _FileData + _FileSize);
+        stream.Skip(sizeof(ImVec2) * 3);
+        ImDrawCapture_ReadTextureRequests(Textures, stream, true);
+        if (stream.Error)
+            return NULL;
+    }
+
+    // Rebuild draw lists
+    const unsigned char* frame_data = _FileData + _FrameOffsets[frame_n];
+    ImDrawCaptureStream stream(frame_data, _FileData + _FileSize);
+    DrawData.Clear();
+    DrawData.DisplayPos = stream.ReadValue<ImVec2>();
+    DrawData.DisplaySize = stream.ReadValue<ImVec2>();
+    DrawData.FramebufferScale = stream.ReadValue<ImVec2>();
+    DrawData.Textures = &Textures;
+    ImDrawCapture_ReadTextureRequests(Textures, stream, false);
+
+    const int draw_lists_count = (int)stream.ReadValue<ImU32>();
+    for (int list_n = 0; list_n < draw_lists_count && !stream.Error; list_n++)
+    {
+        if (list_n >= _DrawLists.Size)
+            _DrawLists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+        ImDrawList* draw_list = _DrawLists[list_n];
+        draw_list->Flags = (ImDrawListFlags)stream.ReadValue<ImU32>();
+        const int cmd_count = (int)stream.ReadValue<ImU32>();
+        const int vtx_count = (int)stream.ReadValue<ImU32>();
+        const int idx_count = (int)stream.ReadValue<ImU32>();
+        const int quad_count = (int)stream.ReadValue<ImU32>();
+        if (stream.Error || cmd_count < 0 || vtx_count < 0 || idx_count < 0 || quad_count < 0)
+            break;
+        draw_list->CmdBuffer.resize(0);
+        for (int cmd_n = 0; cmd_n < cmd_count; cmd_n++)
+        {
+            const ImDrawCaptureCmd in_cmd = stream.ReadValue<ImDrawCaptureCmd>();
+            if (in_cmd.Callback == ImDrawCaptureCallback_Other)
+                continue;
+            ImDrawCmd cmd;
+            cmd.ClipRect = in_cmd.ClipRect;
+            if (in_cmd.TexIndex >= 0 && in_cmd.TexIndex < Textures.Size)
+                cmd.TexRef._TexData = Textures[in_cmd.TexIndex];
+            cmd.VtxOffset = in_cmd.VtxOffset;
+            cmd.IdxOffset = in_cmd.IdxOffset;
+            cmd.ElemCount = in_cmd.ElemCount;
+            cmd.QuadOffset = in_cmd.QuadOffset;
+            cmd.QuadCount = in_cmd.QuadCount;
+            cmd.UserCallback = (in_cmd.Callback == ImDrawCaptureCallback_ResetRenderState) ? ImDrawCallback_ResetRenderState : NULL;
+            if ((size_t)cmd.VtxOffset > (size_t)vtx_count || (size_t)cmd.IdxOffset + cmd.ElemCount > (size_t)idx_count || (size_t)cmd.QuadOffset + cmd.QuadCount > (size_t)quad_count)
+                stream.Error = true;
+            draw_list->CmdBuffer.push_back(cmd);
+        }
+        draw_list->VtxBuffer.resize(vtx_count);
+        draw_list->IdxBuffer.resize(idx_count);
+        draw_list->QuadBuffer.resize(quad_count);
+        stream.Read(draw_list->VtxBuffer.Data, (size_t)vtx_count * sizeof(ImDrawVert));
+        stream.Read(draw_list->IdxBuffer.Data, (size_t)idx_count * sizeof(ImDrawIdx));
+        stream.Read(draw_list->QuadBuffer.Data, (size_t)quad_count * sizeof(ImDrawQuad));
+        for (int idx_n = 0; idx_n < idx_count && !stream.Error; idx_n++)
+            if (draw_list->IdxBuffer.Data[idx_n] >= (unsigned int)vtx_count)
+                stream.Error = true; // Indices are relative to VtxOffset, only catch obviously corrupted data here
+        DrawData.CmdLists.push_back(draw_list);
+        DrawData.TotalVtxCount += vtx_count;
+        DrawData.TotalIdxCount += idx_count;
+        DrawData.TotalQuadCount += quad_count;
+    }
+    DrawData.CmdListsCount = DrawData.CmdLists.Size;
+    DrawData.Valid = !stream.Error;
+    return stream.Error ? NULL : &DrawData;
+}
+
+ImDrawData* ImDrawCaptureReader::DestroyTextures()
+{
+    for (ImTextureData* tex : Textures)
+        if (tex->Status != ImTextureStatus_Destroyed)
+        {
+            tex->WantDestroyNextFrame = true;
+            tex->UnusedFrames = 1;
+            tex->SetStatus(ImTextureStatus_WantDestroy);
+        }
+    DrawData.CmdLists.resize(0);
+    DrawData.CmdListsCount = DrawData.TotalVtxCount = DrawData.TotalIdxCount = DrawData.TotalQuadCount = 0;
+    DrawData.Textures = &Textures;
+    DrawData.Valid = true;
+    return &DrawData;
+}
+
+//-----------------------------------------------------------------------------
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+
+#endif // #ifndef IMGUI_DISABLE
@@ -0,0 +1,68 @@
+// dear imgui: ImDrawData capture and replay
+// (headers)
+
+// Save the complete output of frames (draw lists, commands, vertices, indices, quads, texture references and texture requests)
+// to a compact binary file, and play it back later into any renderer backend without running the UI code which produced it.
+// Use it to benchmark or debug renderer backends on identical workloads, see imgui_drawreplay.cpp for a command-line tool.
+
+// Usage:
+//   // Capture: in your main loop, between ImGui::Render() and your renderer's RenderDrawData():
+//   static ImDrawCaptureWriter capture;
+//   if (!capture.IsOpen()) capture.Open("frames.imdc");
+//   capture.WriteFrame(ImGui::GetDrawData());
+//
+//   // Replay (an ImGui context and a renderer backend need to be initialized):
+//   ImDrawCaptureReader replay;
+//   replay.Load("frames.imdc");
+//   for (int n = 0; n < replay.GetFrameCount(); n++)
+//       ImGui_ImplXXXX_RenderDrawData(replay.GetFrame(n));
+//   ImGui_ImplXXXX_RenderDrawData(replay.DestroyTextures());
+//   replay.Clear();
+
+// Limitations:
+// - Files store raw ImDrawVert/ImDrawIdx/ImDrawQuad data: they can only be replayed by a build using the same layout and endianness.
+// - User callbacks other than ImDrawCallback_ResetRenderState can't be serialized: their commands are dropped on replay.
+// - User textures (ImTextureID not backed by a ImTextureData) can't be serialized: they are replayed with ImTextureID_Invalid.
+// - Texture destruction requests are not replayed, so that frames may be played again in any order once they have been played once.
+
+#pragma once
+#include "imgui.h"      // IMGUI_API
+#ifndef IMGUI_DISABLE
+
+// Append frames to a capture file.
+struct ImDrawCaptureWriter
+{
+    int                         FrameCount;     // Number of frames written since Open()
+    void*                       _File;          // [Internal] ImFileHandle
+    ImVector<ImTextureData*>    _Textures;      // [Internal] Textures known to the capture file. Index == texture index in file. NULL once destroyed.
+    ImVector<unsigned char>     _Buffer;        // [Internal] Frame being serialized
+
+    ImDrawCaptureWriter()       { FrameCount = 0; _File = NULL; }
+    ~ImDrawCaptureWriter()      { Close(); }
+    IMGUI_API bool  Open(const char* filename);
+    IMGUI_API void  Close();
+    bool            IsOpen() const { return _File != NULL; }
+    IMGUI_API void  WriteFrame(const ImDrawData* draw_data); // Call after ImGui::Render() and BEFORE your renderer's RenderDrawData(), which honors and clears texture requests.
+};
+
+// Load a capture file and rebuild each frame as a ImDrawData which can be passed to any renderer backend.
+struct ImDrawCaptureReader
+{
+    ImDrawData                  DrawData;       // Returned by GetFrame()/DestroyTextures()
+    ImVector<ImTextureData*>    Textures;       // Textures created by replaying texture requests. DrawData.Textures points to this.
+    ImVector<ImDrawList*>       _DrawLists;     // [Internal]
+    ImVector<unsigned int>      _FrameOffsets;  // [Internal] Offset of each frame in _FileData
+    unsigned char*              _FileData;      // [Internal]
+    size_t                      _FileSize;      // [Internal]
+    int                         _NextTextureFrame; // [Internal] Texture requests of all frames before this one have been applied
+
+    ImDrawCaptureReader()       { _FileData = NULL; _FileSize = 0; _NextTextureFrame = 0; }
+    ~ImDrawCaptureReader()      { Clear(); }
+    IMGUI_API bool          Load(const char* filename);
+    IMGUI_API void          Clear();                    // Textures need to have been destroyed by the renderer first, see DestroyTextures(). Call before destroying the ImGui context.
+    int                     GetFrameCount() const       { return _FrameOffsets.Size; }
+    IMGUI_API ImDrawData*   GetFrame(int frame_n);      // Requires an ImGui context. Returns NULL if the frame data is corrupted. Also applies texture requests of all frames up to 'frame_n' which haven't been played yet.
+    IMGUI_API ImDrawData*   DestroyTextures();          // Returns an ImDrawData with no draw list which requests destruction of all textures: pass it to your renderer before calling Clear().
+};
+
+#endif // #ifndef IMGUI_DISABLE
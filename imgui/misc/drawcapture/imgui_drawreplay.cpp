@@ -0,0 +1,280 @@
+// dear imgui
+// (imgui_drawreplay.cpp)
+// Command-line tool to play frames recorded with ImDrawCaptureWriter into a renderer backend, and measure how long it takes.
+// Frames are played in a loop without running any UI code, so changes to a renderer backend can be compared on identical workloads.
+
+// Build with one of, e.g: (see README.md)
+//   # g++ -O2 -I../.. -I../../backends imgui_drawreplay.cpp imgui_drawcapture.cpp ../../imgui*.cpp ../../backends/imgui_impl_softraster.cpp
+//   # g++ -O2 -DIMGUI_DRAWREPLAY_OPENGL3 -I../.. -I../../backends imgui_drawreplay.cpp imgui_drawcapture.cpp ../../imgui*.cpp ../../backends/imgui_impl_opengl3.cpp -lEGL -lGL -ldl
+//   # g++ -O2 -DIMGUI_DRAWREPLAY_OPENGL3 -DIMGUI_IMPL_OPENGL_ES3 [...same...] -lEGL -lGLESv2
+//   # g++ -O2 -DIMGUI_DRAWREPLAY_SDLRENDERER2 `sdl2-config --cflags` -I../.. -I../../backends imgui_drawreplay.cpp imgui_drawcapture.cpp ../../imgui*.cpp ../../backends/imgui_impl_sdlrenderer2.cpp `sdl2-config --libs`
+// The OpenGL3 version renders into an off-screen EGL surface, so it runs on headless machines with e.g. Mesa's llvmpipe.
+
+// Usage:
+//   imgui_drawreplay <file.imdc> [loops]
+// Output:
+//   - "submit": time spent in RenderDrawData() (CPU cost of the backend + driver submission).
+//   - "complete": same + waiting for the GPU to be done with the frame (glFinish() or equivalent).
+//   Texture uploads are excluded: all frames are played once as a warm-up before measuring.
+
+#include "imgui.h"
+#include "imgui_drawcapture.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>    // std::sort
+#include <chrono>
+#include <vector>
+
+#if defined(IMGUI_DRAWREPLAY_OPENGL3)
+#include "imgui_impl_opengl3.h"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#if defined(IMGUI_IMPL_OPENGL_ES3)
+#include <GLES3/gl3.h>
+#else
+#include <GL/gl.h>
+#endif
+#define BACKEND_NAME "opengl3"
+#elif defined(IMGUI_DRAWREPLAY_SDLRENDERER2)
+#include "imgui_impl_sdlrenderer2.h"
+#include <SDL.h>
+#define BACKEND_NAME "sdlrenderer2"
+#else
+#include "imgui_impl_softraster.h"
+#define BACKEND_NAME "softraster"
+#endif
+
+//-----------------------------------------------------------------------------
+// Backend setup
+//-----------------------------------------------------------------------------
+
+#if defined(IMGUI_DRAWREPLAY_OPENGL3)
+
+static EGLDisplay   g_EglDisplay = EGL_NO_DISPLAY;
+static EGLSurface   g_EglSurface = EGL_NO_SURFACE;
+static EGLContext   g_EglContext = EGL_NO_CONTEXT;
+
+static bool BackendInit(int width, int height)
+{
+    PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplayEXT = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+    if (eglGetPlatformDisplayEXT != nullptr)
+        g_EglDisplay = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+#endif
+    if (g_EglDisplay == EGL_NO_DISPLAY)
+        g_EglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (g_EglDisplay == EGL_NO_DISPLAY || !eglInitialize(g_EglDisplay, nullptr, nullptr))
+        return false;
+#if defined(IMGUI_IMPL_OPENGL_ES3)
+    const EGLint renderable_type = EGL_OPENGL_ES3_BIT;
+    const EGLint context_attribs[] = { EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE };
+    const char* glsl_version = "#version 300 es";
+    eglBindAPI(EGL_OPENGL_ES_API);
+#else
+    const EGLint renderable_type = EGL_OPENGL_BIT;
+    const EGLint context_attribs[] = { EGL_CONTEXT_MAJOR_VERSION, 3, EGL_CONTEXT_MINOR_VERSION, 3, EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE };
+    const char* glsl_version = "#version 330 core";
+    eglBindAPI(EGL_OPENGL_API);
+#endif
+    const EGLint config_attribs[] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, renderable_type, EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8, EGL_NONE };
+    EGLConfig egl_config;
+    EGLint num_configs = 0;
+    if (!eglChooseConfig(g_EglDisplay, config_attribs, &egl_config, 1, &num_configs) || num_configs == 0)
+        return false;
+    const EGLint pbuffer_attribs[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+    g_EglSurface = eglCreatePbufferSurface(g_EglDisplay, egl_config, pbuffer_attribs);
+    g_EglContext = eglCreateContext(g_EglDisplay, egl_config, EGL_NO_CONTEXT, context_attribs);
+    if (g_EglSurface == EGL_NO_SURFACE || g_EglContext == EGL_NO_CONTEXT || !eglMakeCurrent(g_EglDisplay, g_EglSurface, g_EglSurface, g_EglContext))
+        return false;
+    printf("GL_RENDERER: %s\n", (const char*)glGetString(GL_RENDERER));
+    if (!ImGui_ImplOpenGL3_Init(glsl_version))
+        return false;
+    ImGui_ImplOpenGL3_EnableInstancedQuads(true);
+    ImGui_ImplOpenGL3_NewFrame();
+    return true;
+}
+
+static void BackendShutdown()
+{
+    if (ImGui::GetIO().BackendRendererUserData != nullptr)
+        ImGui_ImplOpenGL3_Shutdown();
+    eglMakeCurrent(g_EglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (g_EglContext != EGL_NO_CONTEXT)
+        eglDestroyContext(g_EglDisplay, g_EglContext);
+    if (g_EglSurface != EGL_NO_SURFACE)
+        eglDestroySurface(g_EglDisplay, g_EglSurface);
+    if (g_EglDisplay != EGL_NO_DISPLAY)
+        eglTerminate(g_EglDisplay);
+}
+
+static void BackendClear()                              { glClearColor(0.45f, 0.55f, 0.60f, 1.00f); glClear(GL_COLOR_BUFFER_BIT); }
+static void BackendRender(ImDrawData* draw_data)        { ImGui_ImplOpenGL3_RenderDrawData(draw_data); }
+static void BackendWaitIdle()                           { glFinish(); }
+
+#elif defined(IMGUI_DRAWREPLAY_SDLRENDERER2)
+
+static SDL_Window*      g_Window = nullptr;
+static SDL_Renderer*    g_Renderer = nullptr;
+
+static bool BackendInit(int width, int height)
+{
+    if (SDL_Init(SDL_INIT_VIDEO) != 0)
+        return false;
+    g_Window = SDL_CreateWindow("imgui_drawreplay", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, width, height, SDL_WINDOW_HIDDEN);
+    if (g_Window == nullptr)
+        return false;
+    g_Renderer = SDL_CreateRenderer(g_Window, -1, SDL_RENDERER_ACCELERATED);
+    if (g_Renderer == nullptr)
+        return false;
+    SDL_RendererInfo info;
+    SDL_GetRendererInfo(g_Renderer, &info);
+    printf("SDL_Renderer: %s\n", info.name);
+    if (!ImGui_ImplSDLRenderer2_Init(g_Renderer))
+        return false;
+    ImGui_ImplSDLRenderer2_NewFrame();
+    return true;
+}
+
+static void BackendShutdown()
+{
+    if (ImGui::GetIO().BackendRendererUserData != nullptr)
+        ImGui_ImplSDLRenderer2_Shutdown();
+    if (g_Renderer != nullptr)
+        SDL_DestroyRenderer(g_Renderer);
+    if (g_Window != nullptr)
+        SDL_DestroyWindow(g_Window);
+    SDL_Quit();
+}
+
+static void BackendClear()                              { SDL_SetRenderDrawColor(g_Renderer, 114, 140, 153, 255); SDL_RenderClear(g_Renderer); }
+static void BackendRender(ImDrawData* draw_data)        { ImGui_ImplSDLRenderer2_RenderDrawData(draw_data, g_Renderer); }
+static void BackendWaitIdle()                           { Uint32 pixel; SDL_Rect r = { 0, 0, 1, 1 }; SDL_RenderReadPixels(g_Renderer, &r, SDL_PIXELFORMAT_RGBA32, &pixel, 4); } // Read back to wait for completion
+
+#else
+
+static std::vector<ImU32>   g_Pixels;
+static int                  g_Width = 0;
+static int                  g_Height = 0;
+
+static bool BackendInit(int width, int height)
+{
+    g_Width = width;
+    g_Height = height;
+    g_Pixels.resize((size_t)width * height);
+    if (!ImGui_ImplSoftRaster_Init())
+        return false;
+    ImGui_ImplSoftRaster_NewFrame();
+    return true;
+}
+
+static void BackendShutdown()                           { if (ImGui::GetIO().BackendRendererUserData != nullptr) ImGui_ImplSoftRaster_Shutdown(); }
+static void BackendClear()                              { std::fill(g_Pixels.begin(), g_Pixels.end(), IM_COL32(114, 140, 153, 255)); }
+static void BackendRender(ImDrawData* draw_data)        { ImGui_ImplSoftRaster_RenderDrawData(draw_data, g_Pixels.data(), g_Width, g_Height, g_Width * 4); }
+static void BackendWaitIdle()                           { }
+
+#endif
+
+//-----------------------------------------------------------------------------
+// Main
+//-----------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock Clock;
+
+static double ElapsedMs(Clock::time_point t0, Clock::time_point t1)
+{
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+static void PrintStats(const char* label, std::vector<double>& samples)
+{
+    std::sort(samples.begin(), samples.end());
+    double total = 0.0;
+    for (double sample : samples)
+        total += sample;
+    printf("%-9s avg %8.3f ms, min %8.3f ms, median %8.3f ms, max %8.3f ms\n", label, total / (double)samples.size(), samples.front(), samples[samples.size() / 2], samples.back());
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        printf("Syntax: %s <file.imdc> [loops]\n", argv[0]);
+        return 0;
+    }
+    const char* filename = argv[1];
+    const int loops = (argc > 2) ? atoi(argv[2]) : 10;
+
+    ImGui::CreateContext();
+    ImGui::GetIO().IniFilename = nullptr;
+
+    ImDrawCaptureReader replay;
+    if (!replay.Load(filename) || replay.GetFrameCount() == 0)
+    {
+        fprintf(stderr, "Error loading '%s': not a capture file, made with a different ImDrawVert/ImDrawIdx layout, or empty.\n", filename);
+        ImGui::DestroyContext();
+        return 1;
+    }
+
+    // Size the render target from the largest frame
+    int width = 1, height = 1;
+    int max_quad_count = 0;
+    for (int frame_n = 0; frame_n < replay.GetFrameCount(); frame_n++)
+    {
+        ImDrawData* draw_data = replay.GetFrame(frame_n);
+        if (draw_data == nullptr)
+        {
+            fprintf(stderr, "Error loading '%s': frame %d is corrupted.\n", filename, frame_n);
+            ImGui::DestroyContext();
+            return 1;
+        }
+        width = std::max(width, (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x));
+        height = std::max(height, (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y));
+        max_quad_count = std::max(max_quad_count, draw_data->TotalQuadCount);
+    }
+
+    if (!BackendInit(width, height))
+    {
+        fprintf(stderr, "Error initializing %s backend.\n", BACKEND_NAME);
+        BackendShutdown();
+        ImGui::DestroyContext();
+        return 1;
+    }
+    printf("Backend: %s, %d frames, %dx%d, %d loops\n", BACKEND_NAME, replay.GetFrameCount(), width, height, loops);
+    if (max_quad_count > 0 && (ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasInstancedQuads) == 0)
+        printf("Warning: capture contains instanced quads which this backend doesn't support: they won't be rendered.\n");
+
+    // Warm-up: create textures, let the backend allocate its buffers
+    for (int frame_n = 0; frame_n < replay.GetFrameCount(); frame_n++)
+    {
+        BackendClear();
+        BackendRender(replay.GetFrame(frame_n));
+    }
+    BackendWaitIdle();
+
+    std::vector<double> submit_times, complete_times;
+    for (int loop_n = 0; loop_n < loops; loop_n++)
+        for (int frame_n = 0; frame_n < replay.GetFrameCount(); frame_n++)
+        {
+            ImDrawData* draw_data = replay.GetFrame(frame_n);
+            BackendClear();
+            BackendWaitIdle();
+            Clock::time_point t0 = Clock::now();
+            BackendRender(draw_data);
+            Clock::time_point t1 = Clock::now();
+            BackendWaitIdle();
+            Clock::time_point t2 = Clock::now();
+            submit_times.push_back(ElapsedMs(t0, t1));
+            complete_times.push_back(ElapsedMs(t0, t2));
+        }
+    if (loops > 0)
+    {
+        PrintStats("submit", submit_times);
+        PrintStats("complete", complete_times);
+    }
+
+    BackendRender(replay.DestroyTextures());
+    replay.Clear();
+    BackendShutdown();
+    ImGui::DestroyContext();
+    return 0;
+}
@@ -7,6 +7,7 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2026/10/19: added support for ImFontAtlasFlags_DistanceField using FT_RENDER_MODE_SDF (require FreeType 2.11+).
 //  2025/06/11: refactored for the new ImFontLoader architecture, and ImGuiBackendFlags_RendererHasTextures support.
 //  2024/10/17: added plutosvg support for SVG Fonts (seems faster/better than lunasvg). Enable by using '#define IMGUI_ENABLE_FREETYPE_PLUTOSVG'. (#7927)
 //  2023/11/13: added support for ImFontConfig::RasterizationDensity field for scaling render density without scaling metrics.
@@ -377,6 +378,12 @@ static bool ImGui_ImplFreeType_LoaderInit(ImFontAtlas* atlas)
     // With plutosvg, use provided hooks
     FT_Property_Set(bd->Library, "ot-svg", "svg-hooks", plutosvg_ft_svg_hooks());
 #endif // IMGUI_ENABLE_FREETYPE_PLUTOSVG
+#if ((FREETYPE_MAJOR >= 2) && (FREETYPE_MINOR >= 11))
+    // Use the same distance field spread as the stb_truetype loader (for ImFontAtlasFlags_DistanceField)
+    FT_Int sdf_spread = IM_FONTATLAS_DISTANCE_FIELD_SPREAD;
+    FT_Property_Set(bd->Library, "sdf", "spread", &sdf_spread);
+    FT_Property_Set(bd->Library, "bsdf", "spread", &sdf_spread);
+#endif
 
     // Store our data
     atlas->FontLoaderData = (void*)bd;
@@ -509,6 +516,14 @@ static bool ImGui_ImplFreeType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontConf
 
     // Render glyph into a bitmap (currently held by FreeType)
     FT_Render_Mode render_mode = (bd_font_data->UserFlags & ImGuiFreeTypeLoaderFlags_Monochrome) ? FT_RENDER_MODE_MONO : FT_RENDER_MODE_NORMAL;
+    if (atlas->Flags & ImFontAtlasFlags_DistanceField)
+    {
+#if ((FREETYPE_MAJOR >= 2) && (FREETYPE_MINOR >= 11))
+        render_mode = FT_RENDER_MODE_SDF;
+#else
+        IM_ASSERT(0 && "ImFontAtlasFlags_DistanceField requires FreeType 2.11+");
+#endif
+    }
     FT_Error error = FT_Render_Glyph(slot, render_mode);
     const FT_Bitmap* ft_bitmap = &slot->bitmap;
     if (error != 0 || ft_bitmap == nullptr)